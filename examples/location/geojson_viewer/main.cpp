@@ -191,18 +191,21 @@ public slots:
             return false;
         }
 
-        // Load the GeoJSON file using Qt's API
-        QJsonParseError err;
-        QJsonDocument loadDoc(QJsonDocument::fromJson(loadFile.readAll(), &err));
-        if (err.error) {
-             qWarning() << "Parsing while importing the JSON document:\n" << err.errorString();
-             return false;
-        }
-
-        // Import geographic data to a QVariantList
-        QVariantList modelList = QGeoJson::importGeoJson(loadDoc);
-        m_importedGeoJson =  modelList;
-        emit modelChanged();
+        // Import geographic data to a QVariantList without blocking the UI,
+        // a file loaded meanwhile supersedes this one
+        if (m_importTask)
+            m_importTask->abort();
+        m_importTask = QGeoJson::importGeoJsonAsync(loadFile.readAll(), this);
+        connect(m_importTask, &QGeoJsonImportTask::finished, this, [this]() {
+            QGeoJsonImportTask *task = m_importTask;
+            m_importTask = nullptr;
+            if (!task->errorString().isEmpty()) {
+                qWarning() << "Parsing while importing the JSON document:\n" << task->errorString();
+                return;
+            }
+            m_importedGeoJson = task->result();
+            emit modelChanged();
+        });
         return true;
     }
 
@@ -249,6 +252,7 @@ signals:
 
 public:
     QVariant m_importedGeoJson;
+    QGeoJsonImportTask *m_importTask = nullptr;
 };
 
 #include "main.moc"
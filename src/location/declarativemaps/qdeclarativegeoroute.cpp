@@ -94,7 +94,7 @@ QDeclarativeGeoRoute::~QDeclarativeGeoRoute() {}
 */
 QList<QGeoCoordinate> QDeclarativeGeoRoute::routePath()
 {
-    return route_.path();
+    return path();
 }
 
 /*!
@@ -149,15 +149,20 @@ qreal QDeclarativeGeoRoute::distance() const
 
 QList<QGeoCoordinate> QDeclarativeGeoRoute::path() const
 {
-    return route_.path();
+    if (!pathCreated_) {
+        path_ = route_.path();
+        pathCreated_ = true;
+    }
+    return path_;
 }
 
 void QDeclarativeGeoRoute::setPath(const QList<QGeoCoordinate> &value)
 {
-    if (route_.path() == value)
+    if (path() == value)
         return;
 
     route_.setPath(value);
+    path_ = value;
     emit pathChanged();
 }
 
@@ -111,6 +111,8 @@ private:
     QList<QGeoCoordinate> routePath();
 
     QGeoRoute route_;
+    mutable QList<QGeoCoordinate> path_; // created from the packed route path on first use
+    mutable bool pathCreated_ = false;
     mutable QDeclarativeGeoRouteQuery *routeQuery_ = nullptr;
 
     friend class QDeclarativeRouteMapItem;
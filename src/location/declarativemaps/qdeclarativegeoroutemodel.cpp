@@ -608,23 +608,9 @@ void QDeclarativeGeoRouteModel::setError(RouteError error, const QString& errorS
 */
 void QDeclarativeGeoRouteModel::update()
 {
-    if (!complete_)
-        return;
-
-    if (!plugin_) {
-        setError(EngineNotSetError, tr("Cannot route, plugin not set."));
-        return;
-    }
-
-    QGeoServiceProvider *serviceProvider = plugin_->sharedGeoServiceProvider();
-    if (!serviceProvider)
-        return;
-
-    QGeoRoutingManager *routingManager = serviceProvider->routingManager();
-    if (!routingManager) {
-        setError(EngineNotSetError, tr("Cannot route, route manager not set."));
+    QGeoRoutingManager *routingManager = readyRoutingManager();
+    if (!routingManager)
         return;
-    }
     if (!routeQuery_) {
         setError(ParseError, tr("Cannot route, valid query not set."));
         return;
@@ -638,7 +624,72 @@ void QDeclarativeGeoRouteModel::update()
 
     setError(NoError, QString());
 
-    QGeoRouteReply *reply = routingManager->calculateRoute(request);
+    handleReply(routingManager->calculateRoute(request));
+}
+
+/*!
+    \qmlmethod void QtLocation::RouteModel::refresh(coordinate position)
+    \since QtLocation 6.5
+
+    Updates the first route of the model for a traveler at \a position.
+    As long as \a position is on the route, the part that has been traveled
+    is removed from the route without contacting the routing service, and the
+    distance and travel time of the route are recomputed. Once \a position
+    has left the route, a new route is calculated from \a position to the
+    waypoints that have not been reached yet.
+
+    How far \a position can be from the route is set with the
+    \c routing.refresh.tolerance plugin parameter, in meters. Unless it is
+    set, or the plugin updates routes itself, refreshing fails with
+    \c RouteModel.UnsupportedOptionError.
+
+    If the model has no route yet, this is the same as \l update().
+
+    \sa update()
+*/
+void QDeclarativeGeoRouteModel::refresh(const QGeoCoordinate &position)
+{
+    if (routes_.isEmpty() || !position.isValid()) {
+        update();
+        return;
+    }
+    QGeoRoutingManager *routingManager = readyRoutingManager();
+    if (!routingManager)
+        return;
+
+    emit abortRequested(); // Clear previous requests
+    setError(NoError, QString());
+    handleReply(routingManager->updateRoute(routes_.first()->route(), position));
+}
+
+/*!
+    \internal
+*/
+QGeoRoutingManager *QDeclarativeGeoRouteModel::readyRoutingManager()
+{
+    if (!complete_)
+        return nullptr;
+
+    if (!plugin_) {
+        setError(EngineNotSetError, tr("Cannot route, plugin not set."));
+        return nullptr;
+    }
+
+    QGeoServiceProvider *serviceProvider = plugin_->sharedGeoServiceProvider();
+    if (!serviceProvider)
+        return nullptr;
+
+    QGeoRoutingManager *routingManager = serviceProvider->routingManager();
+    if (!routingManager)
+        setError(EngineNotSetError, tr("Cannot route, route manager not set."));
+    return routingManager;
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoRouteModel::handleReply(QGeoRouteReply *reply)
+{
     setStatus(QDeclarativeGeoRouteModel::Loading);
     if (!reply->isFinished()) {
         connect(this, &QDeclarativeGeoRouteModel::abortRequested, reply, &QGeoRouteReply::abort);
@@ -149,6 +149,7 @@ public:
     Q_INVOKABLE QDeclarativeGeoRoute *get(int index);
     Q_INVOKABLE void reset();
     Q_INVOKABLE void cancel();
+    Q_REVISION(6, 5) Q_INVOKABLE void refresh(const QGeoCoordinate &position);
 
 Q_SIGNALS:
     void countChanged();
@@ -175,6 +176,8 @@ private Q_SLOTS:
 private:
     void setStatus(Status status);
     void setError(RouteError error, const QString &errorString);
+    QGeoRoutingManager *readyRoutingManager();
+    void handleReply(QGeoRouteReply *reply);
 
     bool complete_ = false;
 
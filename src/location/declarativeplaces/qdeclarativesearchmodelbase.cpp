@@ -58,6 +58,9 @@ QT_BEGIN_NAMESPACE
 QDeclarativeSearchModelBase::QDeclarativeSearchModelBase(QObject *parent)
     : QAbstractListModel(parent)
 {
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(0);
+    connect(&m_updateTimer, &QTimer::timeout, this, &QDeclarativeSearchModelBase::sendRequest);
 }
 
 QDeclarativeSearchModelBase::~QDeclarativeSearchModelBase()
@@ -202,11 +205,54 @@ void QDeclarativeSearchModelBase::setStatus(Status status, const QString &errorS
 /*!
     \internal
 */
-void QDeclarativeSearchModelBase::update()
+int QDeclarativeSearchModelBase::updateDelay() const
+{
+    return m_updateTimer.interval();
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeSearchModelBase::setUpdateDelay(int delay)
 {
-    if (m_reply)
+    delay = qMax(0, delay);
+    if (m_updateTimer.interval() == delay)
         return;
 
+    m_updateTimer.setInterval(delay);
+    emit updateDelayChanged();
+}
+
+/*!
+    \internal
+    Sends the request once update() has not been called for updateDelay
+    milliseconds, so that typing a search term sends a single request.
+*/
+void QDeclarativeSearchModelBase::update()
+{
+    setStatus(Loading);
+    if (m_updateTimer.interval() > 0)
+        m_updateTimer.start();
+    else
+        sendRequest();
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeSearchModelBase::sendRequest()
+{
+    m_updateTimer.stop();
+
+    // The request in progress is superseded, abort it so that its results are not processed
+    if (m_reply) {
+        disconnect(m_reply, nullptr, this, nullptr);
+        if (!m_reply->isFinished())
+            m_reply->abort();
+        m_reply->deleteLater();
+        m_reply = nullptr;
+    }
+
     setStatus(Loading);
 
     if (!m_plugin) {
@@ -250,6 +296,10 @@ void QDeclarativeSearchModelBase::update()
 */
 void QDeclarativeSearchModelBase::cancel()
 {
+    if (m_updateTimer.isActive()) {
+        m_updateTimer.stop();
+        setStatus(Ready);
+    }
     if (!m_reply)
         return;
 
@@ -269,6 +319,7 @@ void QDeclarativeSearchModelBase::cancel()
 */
 void QDeclarativeSearchModelBase::reset()
 {
+    m_updateTimer.stop();
     beginResetModel();
     clearData();
     setStatus(Null);
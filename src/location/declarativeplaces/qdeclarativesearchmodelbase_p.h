@@ -54,6 +54,7 @@
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <QtLocation/private/qdeclarativegeoserviceprovider_p.h>
 #include <QtCore/QAbstractListModel>
+#include <QtCore/QTimer>
 #include <QtQml/QQmlParserStatus>
 #include <QtLocation/QPlaceSearchRequest>
 #include <QtLocation/QPlaceSearchResult>
@@ -76,6 +77,7 @@ class Q_LOCATION_PRIVATE_EXPORT QDeclarativeSearchModelBase : public QAbstractLi
     Q_PROPERTY(bool previousPagesAvailable READ previousPagesAvailable NOTIFY previousPagesAvailableChanged)
     Q_PROPERTY(bool nextPagesAvailable READ nextPagesAvailable NOTIFY nextPagesAvailableChanged)
     Q_PROPERTY(Status status READ status NOTIFY statusChanged)
+    Q_PROPERTY(int updateDelay READ updateDelay WRITE setUpdateDelay NOTIFY updateDelayChanged REVISION(6, 5))
 
     Q_ENUMS(Status)
 
@@ -107,6 +109,9 @@ public:
     Status status() const;
     void setStatus(Status status, const QString &errorString = QString());
 
+    int updateDelay() const;
+    void setUpdateDelay(int delay);
+
     Q_INVOKABLE void update();
 
     Q_INVOKABLE void cancel();
@@ -130,6 +135,7 @@ Q_SIGNALS:
     void previousPagesAvailableChanged();
     void nextPagesAvailableChanged();
     void statusChanged();
+    Q_REVISION(6, 5) void updateDelayChanged();
 
 protected:
     virtual void initializePlugin(QDeclarativeGeoServiceProvider *plugin);
@@ -140,6 +146,7 @@ protected Q_SLOTS:
 
 private Q_SLOTS:
     void pluginNameChanged();
+    void sendRequest();
 
 protected:
     virtual QPlaceReply *sendQuery(QPlaceManager *manager, const QPlaceSearchRequest &request) = 0;
@@ -156,6 +163,7 @@ private:
     QString m_errorString;
     QPlaceSearchRequest m_previousPageRequest;
     QPlaceSearchRequest m_nextPageRequest;
+    QTimer m_updateTimer;
 };
 
 QT_END_NAMESPACE
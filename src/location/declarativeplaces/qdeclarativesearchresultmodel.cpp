@@ -51,8 +51,17 @@
 #include <QtLocation/QPlaceProposedSearchResult>
 #include <QtLocation/private/qplacesearchrequest_p.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
+static QString resultPlaceId(const QPlaceSearchResult &result)
+{
+    if (result.type() != QPlaceSearchResult::PlaceResult)
+        return QString();
+    return QPlaceResult(result).place().placeId();
+}
+
 /*!
     \qmltype PlaceSearchModel
     \instantiates QDeclarativeSearchResultModel
@@ -225,6 +234,18 @@ QT_BEGIN_NAMESPACE
     This property holds the limit of the number of items that will be returned.
 */
 
+/*!
+    \qmlproperty int PlaceSearchModel::updateDelay
+    \since QtLocation 6.5
+
+    This property holds how long, in milliseconds, \l update() waits for
+    another call before it sends the request. When it is bound to the text of
+    a field, typing a search term then sends a single request. The default is
+    0, which sends the request right away.
+
+    A request still in progress when the next one is sent is aborted.
+*/
+
 /*!
     \qmlproperty bool PlaceSearchModel::previousPagesAvailable
 
@@ -611,7 +632,8 @@ void QDeclarativeSearchResultModel::clearData(bool suppressSignal)
 
     qDeleteAll(m_places);
     m_places.clear();
-    m_icons.clear();
+    m_favoritePlaces.clear();
+    clearRows();
     if (!m_results.isEmpty()) {
         m_results.clear();
 
@@ -622,7 +644,7 @@ void QDeclarativeSearchResultModel::clearData(bool suppressSignal)
 
 QVariant QDeclarativeSearchResultModel::data(const QModelIndex &index, int role) const
 {
-    if (index.row() > m_results.count())
+    if (index.row() < 0 || index.row() >= m_results.count())
         return QVariant();
 
     const QPlaceSearchResult &result = m_results.at(index.row());
@@ -634,7 +656,7 @@ QVariant QDeclarativeSearchResultModel::data(const QModelIndex &index, int role)
     case TitleRole:
         return result.title();
     case IconRole:
-        return QVariant::fromValue(m_icons.at(index.row()));
+        return QVariant::fromValue(result.icon());
     case DistanceRole:
         if (result.type() == QPlaceSearchResult::PlaceResult) {
             QPlaceResult placeResult = result;
@@ -643,7 +665,7 @@ QVariant QDeclarativeSearchResultModel::data(const QModelIndex &index, int role)
         break;
     case PlaceRole:
         if (result.type() == QPlaceSearchResult::PlaceResult)
-            return QVariant::fromValue(static_cast<QObject *>(m_places.at(index.row())));
+            return QVariant::fromValue(static_cast<QObject *>(place(index.row())));
         break;
     case SponsoredRole:
         if (result.type() == QPlaceSearchResult::PlaceResult) {
@@ -755,7 +777,7 @@ void QDeclarativeSearchResultModel::queryFinished()
     reply->deleteLater();
 
     if (!m_incremental)
-        m_pages.clear();
+        clearPages();
 
     if (reply->error() != QPlaceReply::NoError) {
         m_resultsBuffer.clear();
@@ -770,12 +792,12 @@ void QDeclarativeSearchResultModel::queryFinished()
 
         const QPlaceSearchRequestPrivate *rpimpl = QPlaceSearchRequestPrivate::get(searchReply->request());
         if (!rpimpl->related || !m_incremental)
-            m_pages.clear();
+            clearPages();
         m_resultsBuffer = searchReply->results();
         bool alreadyLoaded = false;
         if (m_pages.contains(rpimpl->page) && m_resultsBuffer == m_pages.value(rpimpl->page))
             alreadyLoaded = true;
-        m_pages.insert(rpimpl->page, m_resultsBuffer);
+        insertPage(rpimpl->page, m_resultsBuffer);
         setPreviousPageRequest(searchReply->previousPageRequest());
         setNextPageRequest(searchReply->nextPageRequest());
 
@@ -839,7 +861,7 @@ void QDeclarativeSearchResultModel::onContentUpdated()
     QPlaceReply *reply = m_reply; // not finished, don't delete.
 
     if (!m_incremental)
-        m_pages.clear();
+        clearPages();
 
     if (reply->error() != QPlaceReply::NoError) {
         m_resultsBuffer.clear();
@@ -854,10 +876,10 @@ void QDeclarativeSearchResultModel::onContentUpdated()
 
         const QPlaceSearchRequestPrivate *rpimpl = QPlaceSearchRequestPrivate::get(searchReply->request());
         if (!rpimpl->related || !m_incremental)
-            m_pages.clear();
+            clearPages();
         m_resultsBuffer = searchReply->results();
         if (!(m_pages.contains(rpimpl->page) && m_resultsBuffer == m_pages.value(rpimpl->page))) {
-            m_pages.insert(rpimpl->page, m_resultsBuffer);
+            insertPage(rpimpl->page, m_resultsBuffer);
             updateLayout();
         }
     } else if (reply->type() == QPlaceReply::MatchReply) {
@@ -892,13 +914,20 @@ void QDeclarativeSearchResultModel::updateLayout(const QList<QPlace> &favoritePl
 {
     const int oldRowCount = rowCount();
     int start = 0;
+    int indexStart = 0;
 
     if (m_incremental) {
         if (!m_resultsBuffer.size())
             return;
 
         beginInsertRows(QModelIndex(), oldRowCount , oldRowCount + m_resultsBuffer.size() - 1);
-        m_results = resultsFromPages();
+        if (m_appendedPage) {
+            m_results.append(m_resultsBuffer);
+            indexStart = oldRowCount;
+        } else {
+            m_results = resultsFromPages();
+            clearRows();
+        }
         start = oldRowCount;
     } else {
         beginResetModel();
@@ -907,24 +936,15 @@ void QDeclarativeSearchResultModel::updateLayout(const QList<QPlace> &favoritePl
     }
 
     m_resultsBuffer.clear();
-    for (qsizetype i = start; i < m_results.count(); ++i) {
-        const QPlaceSearchResult &result = m_results.at(i);
-
-        if (result.type() == QPlaceSearchResult::PlaceResult) {
-            QPlaceResult placeResult = result;
-            QDeclarativePlace *place = new QDeclarativePlace(placeResult.place(), plugin(), this);
-            m_places.append(place);
-
-            if ((favoritePlaces.count() == m_results.count()) && favoritePlaces.at(i) != QPlace())
-                m_places[i]->setFavorite(new QDeclarativePlace(favoritePlaces.at(i),
-                                                               m_favoritesPlugin, m_places[i]));
-        } else if (result.type() == QPlaceSearchResult::ProposedSearchResult) {
-            m_places.append(0);
-        }
 
-        if (!result.icon().isEmpty())
-            m_icons.append(result.icon());
+    // Places are created by place(), when they are first needed
+    m_places.resize(m_results.count(), nullptr);
+    m_favoritePlaces.resize(m_results.count());
+    if (favoritePlaces.count() == m_results.count()) {
+        for (qsizetype i = start; i < m_results.count(); ++i)
+            m_favoritePlaces[i] = favoritePlaces.at(i);
     }
+    indexRows(indexStart);
 
     if (m_incremental)
         endInsertRows();
@@ -943,6 +963,7 @@ void QDeclarativeSearchResultModel::placeUpdated(const QString &placeId)
     if (row < 0 || row > m_places.count())
         return;
 
+    // A place that hasn't been created yet will be made from the search result
     if (m_places.at(row))
         m_places.at(row)->getDetails();
 }
@@ -959,8 +980,16 @@ void QDeclarativeSearchResultModel::placeRemoved(const QString &placeId)
     beginRemoveRows(QModelIndex(), row, row);
     delete m_places.at(row);
     m_places.removeAt(row);
+    m_favoritePlaces.removeAt(row);
     m_results.removeAt(row);
     removePageRow(row);
+
+    // The rows after the removed one move up through the removed slot count.
+    // If another row had the same place, it is now the first one.
+    const auto it = m_rows.find(placeId);
+    removeSlot(it.value().takeFirst());
+    if (it.value().isEmpty())
+        m_rows.erase(it);
     endRemoveRows();
 
     emit rowCountChanged();
@@ -974,17 +1003,44 @@ QList<QPlaceSearchResult> QDeclarativeSearchResultModel::resultsFromPages() cons
     return res;
 }
 
+void QDeclarativeSearchResultModel::clearPages()
+{
+    m_pages.clear();
+    m_pageKeys.clear();
+    m_pageEnds.clear();
+    m_appendedPage = false;
+}
+
+/*!
+    \internal
+    Stores the \a results of \a page, and updates the table of the rows
+    at which each page ends.
+*/
+void QDeclarativeSearchResultModel::insertPage(int page, const QList<QPlaceSearchResult> &results)
+{
+    const bool newPage = !m_pages.contains(page);
+    m_pages.insert(page, results);
+    m_appendedPage = newPage && m_pages.lastKey() == page;
+
+    m_pageKeys = m_pages.keys();
+    m_pageEnds.resize(m_pageKeys.size());
+    qsizetype end = 0;
+    for (qsizetype i = 0; i < m_pageKeys.size(); ++i) {
+        end += m_pages.value(m_pageKeys.at(i)).size();
+        m_pageEnds[i] = end;
+    }
+}
+
 void QDeclarativeSearchResultModel::removePageRow(int row)
 {
-    int scanned = 0;
-    for (auto i = m_pages.begin(), end = m_pages.end(); i != end; ++i) {
-        QList<QPlaceSearchResult> &page = i.value();
-        scanned += page.size();
-        if (row >= scanned)
-            continue;
-        page.removeAt(row - scanned + page.size());
+    const auto it = std::upper_bound(m_pageEnds.begin(), m_pageEnds.end(), qsizetype(row));
+    if (it == m_pageEnds.end())
         return;
-    }
+    const qsizetype index = it - m_pageEnds.begin();
+    const qsizetype pageStart = index > 0 ? m_pageEnds.at(index - 1) : 0;
+    m_pages[m_pageKeys.at(index)].removeAt(row - pageStart);
+    for (qsizetype i = index; i < m_pageEnds.size(); ++i)
+        --m_pageEnds[i];
 }
 
 /*!
@@ -992,14 +1048,81 @@ void QDeclarativeSearchResultModel::removePageRow(int row)
 */
 int QDeclarativeSearchResultModel::getRow(const QString &placeId) const
 {
-    for (qsizetype i = 0; i < m_places.count(); ++i) {
-        if (!m_places.at(i))
-            continue;
-        else if (m_places.at(i)->placeId() == placeId)
-            return i;
+    const auto it = m_rows.constFind(placeId);
+    if (it == m_rows.cend())
+        return -1;
+    const qsizetype slot = it.value().first();
+    return int(slot - removedSlotsBefore(slot));
+}
+
+/*!
+    \internal
+    Rows are indexed by slot: the row they had when they were indexed. Removing
+    a row leaves its slot in place, and counts it as removed in m_removedSlots,
+    a binary indexed tree, so that the row of a slot is found in logarithmic time.
+*/
+void QDeclarativeSearchResultModel::clearRows()
+{
+    m_rows.clear();
+    m_removedSlots.clear();
+}
+
+/*!
+    \internal
+    Indexes the rows from \a start on, which follow all the indexed rows.
+*/
+void QDeclarativeSearchResultModel::indexRows(qsizetype start)
+{
+    for (qsizetype i = start; i < m_results.count(); ++i) {
+        // The tree node of the new slot counts the removed slots it covers
+        const qsizetype node = m_removedSlots.size() + 1;
+        m_removedSlots.append(removedSlotsBefore(node - 1)
+                              - removedSlotsBefore(node - (node & -node)));
+
+        const QString placeId = resultPlaceId(m_results.at(i));
+        if (!placeId.isEmpty())
+            m_rows[placeId].append(node - 1);
     }
+}
 
-    return -1;
+/*!
+    \internal
+*/
+void QDeclarativeSearchResultModel::removeSlot(qsizetype slot)
+{
+    for (qsizetype node = slot + 1; node <= m_removedSlots.size(); node += node & -node)
+        ++m_removedSlots[node - 1];
+}
+
+/*!
+    \internal
+    Returns the number of removed slots before \a slot.
+*/
+qsizetype QDeclarativeSearchResultModel::removedSlotsBefore(qsizetype slot) const
+{
+    qsizetype count = 0;
+    for (qsizetype node = slot; node > 0; node -= node & -node)
+        count += m_removedSlots.at(node - 1);
+    return count;
+}
+
+/*!
+    \internal
+    Returns the place of the place result at \a row, creating it, and its
+    favorite, on first access. Null for other results.
+*/
+QDeclarativePlace *QDeclarativeSearchResultModel::place(int row) const
+{
+    QDeclarativePlace *place = m_places.at(row);
+    if (place || m_results.at(row).type() != QPlaceSearchResult::PlaceResult)
+        return place;
+
+    auto *self = const_cast<QDeclarativeSearchResultModel *>(this);
+    place = new QDeclarativePlace(QPlaceResult(m_results.at(row)).place(), plugin(), self);
+    if (m_favoritePlaces.at(row) != QPlace())
+        place->setFavorite(new QDeclarativePlace(m_favoritePlaces.at(row), m_favoritesPlugin, place));
+    m_places[row] = place;
+    return place;
 }
 
 /*!
@@ -58,7 +58,6 @@
 
 QT_BEGIN_NAMESPACE
 
-class QPlaceIcon;
 class QDeclarativeGeoServiceProvider;
 
 class Q_LOCATION_PRIVATE_EXPORT QDeclarativeSearchResultModel : public QDeclarativeSearchModelBase
@@ -171,17 +170,29 @@ private:
     };
 
     int getRow(const QString &placeId) const;
+    void clearRows();
+    void indexRows(qsizetype start);
+    void removeSlot(qsizetype slot);
+    qsizetype removedSlotsBefore(qsizetype slot) const;
+    QDeclarativePlace *place(int row) const;
     QList<QPlaceSearchResult> resultsFromPages() const;
+    void clearPages();
+    void insertPage(int page, const QList<QPlaceSearchResult> &results);
     void removePageRow(int row);
 
     QList<QDeclarativeCategory *> m_categories;
     QLocation::VisibilityScope m_visibilityScope = QLocation::UnspecifiedVisibility;
 
     QMap<int, QList<QPlaceSearchResult>> m_pages;
+    QList<int> m_pageKeys; // keys of m_pages, in order
+    QList<qsizetype> m_pageEnds; // row after the last one of each page
+    bool m_appendedPage = false; // the last inserted page is new and follows the others
     QList<QPlaceSearchResult> m_results;
     QList<QPlaceSearchResult> m_resultsBuffer;
-    QList<QDeclarativePlace *> m_places;
-    QList<QPlaceIcon> m_icons;
+    mutable QList<QDeclarativePlace *> m_places; // null until place() is called for the row
+    QList<QPlace> m_favoritePlaces;
+    QHash<QString, QList<qsizetype>> m_rows; // place id to the slots of its rows, in order
+    QList<qsizetype> m_removedSlots; // binary indexed tree of the removed slots
 
     QDeclarativeGeoServiceProvider *m_favoritesPlugin = nullptr;
     QVariantMap m_matchParameters;
@@ -49,6 +49,25 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+// Finishes from the event loop with suggestions known without asking the plugin
+class LocalSuggestionReply : public QPlaceSearchSuggestionReply
+{
+public:
+    LocalSuggestionReply(const QStringList &suggestions, QObject *parent)
+        : QPlaceSearchSuggestionReply(parent)
+    {
+        setSuggestions(suggestions);
+        QMetaObject::invokeMethod(this, [this]() {
+            setFinished(true);
+            emit finished();
+        }, Qt::QueuedConnection);
+    }
+};
+
+} // namespace
+
 /*!
     \qmltype PlaceSearchSuggestionModel
     \instantiates QDeclarativeSearchSuggestionModel
@@ -204,6 +223,22 @@ QT_BEGIN_NAMESPACE
     \sa update(), status
 */
 
+/*!
+    \qmlproperty int PlaceSearchSuggestionModel::updateDelay
+    \since QtLocation 6.5
+
+    This property holds how long, in milliseconds, \l update() waits for
+    another call before it sends the request. When it is bound to the text of
+    a field, typing a search term then sends a single request. The default is
+    0, which sends the request right away.
+
+    A request still in progress when the next one is sent is aborted.
+
+    If \l limit is set and the plugin returned fewer suggestions than the limit,
+    the suggestions for a longer search term starting with the same text are
+    filtered from them, without sending a request.
+*/
+
 /*!
     \qmlmethod void PlaceSearchSuggestionModel::reset()
 
@@ -331,6 +366,18 @@ void QDeclarativeSearchSuggestionModel::queryFinished()
     QPlaceSearchSuggestionReply *suggestionReply = qobject_cast<QPlaceSearchSuggestionReply *>(reply);
     m_suggestions = suggestionReply->suggestions();
 
+    // A result that is not truncated by the limit has all the suggestions for longer terms
+    if (!m_sentLocally && suggestionReply->error() == QPlaceReply::NoError) {
+        const int limit = m_sentRequest.limit();
+        if (limit > 0 && m_suggestions.count() < limit) {
+            m_prefixRequest = m_sentRequest;
+            m_prefixSuggestions = m_suggestions;
+        } else {
+            m_prefixRequest = QPlaceSearchRequest();
+            m_prefixSuggestions.clear();
+        }
+    }
+
     if (initialCount != m_suggestions.count())
         emit suggestionsChanged();
 
@@ -351,7 +398,31 @@ void QDeclarativeSearchSuggestionModel::queryFinished()
 QPlaceReply *QDeclarativeSearchSuggestionModel::sendQuery(QPlaceManager *manager,
                                                         const QPlaceSearchRequest &request)
 {
+    m_sentRequest = request;
+
+    const QString prefix = m_prefixRequest.searchTerm();
+    QPlaceSearchRequest sameTerm = request;
+    sameTerm.setSearchTerm(prefix);
+    m_sentLocally = !prefix.isEmpty() && sameTerm == m_prefixRequest
+            && request.searchTerm().startsWith(prefix, Qt::CaseInsensitive);
+    if (m_sentLocally) {
+        const QStringList suggestions = m_prefixSuggestions.filter(request.searchTerm(),
+                                                                   Qt::CaseInsensitive);
+        return new LocalSuggestionReply(suggestions, this);
+    }
+
     return manager->searchSuggestions(request);
 }
 
+/*!
+    \internal
+*/
+void QDeclarativeSearchSuggestionModel::initializePlugin(QDeclarativeGeoServiceProvider *plugin)
+{
+    // Suggestions of another plugin can't be reused
+    m_prefixRequest = QPlaceSearchRequest();
+    m_prefixSuggestions.clear();
+    QDeclarativeSearchModelBase::initializePlugin(plugin);
+}
+
 QT_END_NAMESPACE
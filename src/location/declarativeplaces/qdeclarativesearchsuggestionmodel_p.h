@@ -99,9 +99,16 @@ Q_SIGNALS:
 
 protected:
     QPlaceReply *sendQuery(QPlaceManager *manager, const QPlaceSearchRequest &request) override;
+    void initializePlugin(QDeclarativeGeoServiceProvider *plugin) override;
 
 private:
     QStringList m_suggestions;
+
+    // Complete suggestions for a shorter search term, to filter for longer ones
+    QPlaceSearchRequest m_prefixRequest;
+    QStringList m_prefixSuggestions;
+    QPlaceSearchRequest m_sentRequest;
+    bool m_sentLocally = false;
 };
 
 QT_END_NAMESPACE
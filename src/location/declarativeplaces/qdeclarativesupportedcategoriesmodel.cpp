@@ -323,7 +323,7 @@ void QDeclarativeSupportedCategoriesModel::setHierarchical(bool hierarchical)
     m_hierarchical = hierarchical;
     emit hierarchicalChanged();
 
-    updateLayout();
+    resetLayout();
 }
 
 /*!
@@ -379,6 +379,7 @@ void QDeclarativeSupportedCategoriesModel::addedCategory(const QPlaceCategory &c
     if (!parentNode)
         return;
 
+    const bool firstChild = parentNode->childIds.isEmpty();
     int rowToBeAdded = rowToAddChild(parentNode, category);
     QModelIndex parentIndex = index(parentId);
     beginInsertRows(parentIndex, rowToBeAdded, rowToBeAdded);
@@ -392,8 +393,10 @@ void QDeclarativeSupportedCategoriesModel::addedCategory(const QPlaceCategory &c
 
     //this is a workaround to deal with the fact that the hasModelChildren field of DelegateModel
     //does not get updated when a child is added to a model
-    beginResetModel();
-    endResetModel();
+    if (firstChild && parentIndex.isValid()) {
+        beginResetModel();
+        endResetModel();
+    }
 }
 
 /*!
@@ -448,6 +451,7 @@ void QDeclarativeSupportedCategoriesModel::updatedCategory(const QPlaceCategory
             return;
         QModelIndex oldParentIndex = index(categoryNode->parentId);
         QModelIndex newParentIndex = index(parentId);
+        const bool firstChild = newParentNode->childIds.isEmpty();
 
         int rowToBeAdded = rowToAddChild(newParentNode, category);
         beginMoveRows(oldParentIndex, oldParentNode->childIds.indexOf(categoryId),
@@ -459,8 +463,10 @@ void QDeclarativeSupportedCategoriesModel::updatedCategory(const QPlaceCategory
 
         //this is a workaround to deal with the fact that the hasModelChildren field of DelegateModel
         //does not get updated when an index is updated to contain children
-        beginResetModel();
-        endResetModel();
+        if (firstChild && newParentIndex.isValid()) {
+            beginResetModel();
+            endResetModel();
+        }
     }
 }
 
@@ -481,7 +487,7 @@ void QDeclarativeSupportedCategoriesModel::removedCategory(const QString &catego
     beginRemoveRows(parentIndex, categoryIndex.row(), categoryIndex.row());
     PlaceCategoryNode *parentNode = m_categoriesTree.value(parentId);
     parentNode->childIds.removeAll(categoryId);
-    delete m_categoriesTree.take(categoryId);
+    deleteNode(categoryId);
     endRemoveRows();
 }
 
@@ -561,8 +567,59 @@ void QDeclarativeSupportedCategoriesModel::update()
 
 /*!
     \internal
+
+    Applies the categories of the place manager to the model. The rows that
+    are removed, moved, inserted or changed are reported as such, so that
+    views keep their state, and only the first layout or a change of plugin
+    or of hierarchical resets the model.
 */
 void QDeclarativeSupportedCategoriesModel::updateLayout()
+{
+    PlaceCategoryNode *root = m_categoriesTree.value(QString());
+    if (!m_hierarchical || !root || !m_plugin || root->declCategory->plugin() != m_plugin) {
+        resetLayout();
+        return;
+    }
+
+    QGeoServiceProvider *serviceProvider = m_plugin->sharedGeoServiceProvider();
+    if (!serviceProvider || serviceProvider->error() != QGeoServiceProvider::NoError
+            || !serviceProvider->placeManager()) {
+        resetLayout();
+        return;
+    }
+    QPlaceManager *placeManager = serviceProvider->placeManager();
+
+    const auto byName = [](const QPlaceCategory &lhs, const QPlaceCategory &rhs) {
+        return lhs.name() < rhs.name();
+    };
+
+    // Read the new tree without creating any QDeclarativeCategory
+    QHash<QString, QStringList> childIds;
+    QHash<QString, QPlaceCategory> categories;
+    QStringList pending(QString());
+    while (!pending.isEmpty()) {
+        const QString parentId = pending.takeLast();
+        auto children = placeManager->childCategories(parentId);
+        std::sort(children.begin(), children.end(), byName);
+        QStringList &ids = childIds[parentId];
+        for (const auto &category : qAsConst(children)) {
+            const QString id = category.categoryId();
+            if (id.isEmpty() || categories.contains(id))
+                continue;
+            categories.insert(id, category);
+            ids.append(id);
+            pending.append(id);
+        }
+    }
+
+    removeCategories(QString(), childIds);
+    mergeCategories(QString(), childIds, categories);
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeSupportedCategoriesModel::resetLayout()
 {
     beginResetModel();
     qDeleteAll(m_categoriesTree);
@@ -585,6 +642,100 @@ void QDeclarativeSupportedCategoriesModel::updateLayout()
     endResetModel();
 }
 
+/*!
+    \internal
+
+    Removes the children of \a parentId that are not its children in
+    \a childIds anymore. Categories that moved to another parent are
+    inserted back there by mergeCategories().
+*/
+void QDeclarativeSupportedCategoriesModel::removeCategories(const QString &parentId,
+                                                            const QHash<QString, QStringList> &childIds)
+{
+    PlaceCategoryNode *parentNode = m_categoriesTree.value(parentId);
+    const QStringList newChildIds = childIds.value(parentId);
+    const QModelIndex parentIndex = index(parentId);
+
+    for (qsizetype row = parentNode->childIds.count() - 1; row >= 0; --row) {
+        const QString categoryId = parentNode->childIds.at(row);
+        if (newChildIds.contains(categoryId)) {
+            removeCategories(categoryId, childIds);
+            continue;
+        }
+
+        beginRemoveRows(parentIndex, row, row);
+        parentNode->childIds.removeAt(row);
+        deleteNode(categoryId);
+        endRemoveRows();
+    }
+}
+
+/*!
+    \internal
+
+    Moves, inserts and updates the children of \a parentId so that they match
+    \a childIds, after removeCategories() dropped the ones that are gone.
+*/
+void QDeclarativeSupportedCategoriesModel::mergeCategories(const QString &parentId,
+                                                           const QHash<QString, QStringList> &childIds,
+                                                           const QHash<QString, QPlaceCategory> &categories)
+{
+    PlaceCategoryNode *parentNode = m_categoriesTree.value(parentId);
+    const QStringList newChildIds = childIds.value(parentId);
+    const QModelIndex parentIndex = index(parentId);
+    const bool hadChildren = !parentNode->childIds.isEmpty();
+
+    for (qsizetype row = 0; row < newChildIds.count(); ++row) {
+        const QString &categoryId = newChildIds.at(row);
+        const QPlaceCategory category = categories.value(categoryId);
+        const qsizetype oldRow = parentNode->childIds.indexOf(categoryId);
+
+        if (oldRow < 0) {
+            beginInsertRows(parentIndex, row, row);
+            PlaceCategoryNode *node = new PlaceCategoryNode;
+            node->parentId = parentId;
+            node->declCategory = QSharedPointer<QDeclarativeCategory>(new QDeclarativeCategory(category, m_plugin, this));
+            m_categoriesTree.insert(categoryId, node);
+            parentNode->childIds.insert(row, categoryId);
+            endInsertRows();
+            continue;
+        }
+
+        if (oldRow != row) {
+            beginMoveRows(parentIndex, oldRow, oldRow, parentIndex, row);
+            parentNode->childIds.move(oldRow, row);
+            endMoveRows();
+        }
+
+        PlaceCategoryNode *node = m_categoriesTree.value(categoryId);
+        if (node->declCategory->category() != category) {
+            node->declCategory->setCategory(category);
+            const QModelIndex categoryIndex = createIndex(row, 0, node);
+            emit dataChanged(categoryIndex, categoryIndex);
+        }
+    }
+
+    //hasModelChildren of DelegateModel is only refreshed with the data of the parent
+    if (parentIndex.isValid() && hadChildren != !parentNode->childIds.isEmpty())
+        emit dataChanged(parentIndex, parentIndex);
+
+    for (const QString &categoryId : newChildIds)
+        mergeCategories(categoryId, childIds, categories);
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeSupportedCategoriesModel::deleteNode(const QString &categoryId)
+{
+    PlaceCategoryNode *node = m_categoriesTree.take(categoryId);
+    if (!node)
+        return;
+    for (const QString &childId : qAsConst(node->childIds))
+        deleteNode(childId);
+    delete node;
+}
+
 QString QDeclarativeSupportedCategoriesModel::errorString() const
 {
     return m_errorString;
@@ -151,6 +151,11 @@ private:
     QModelIndex index(const QString &categoryId) const;
     int rowToAddChild(PlaceCategoryNode *, const QPlaceCategory &category);
     void updateLayout();
+    void resetLayout();
+    void removeCategories(const QString &parentId, const QHash<QString, QStringList> &childIds);
+    void mergeCategories(const QString &parentId, const QHash<QString, QStringList> &childIds,
+                         const QHash<QString, QPlaceCategory> &categories);
+    void deleteNode(const QString &categoryId);
     void emitDataChanged() { Q_EMIT dataChanged(); }
 
     QPlaceReply *m_response = nullptr;
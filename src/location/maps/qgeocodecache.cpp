@@ -0,0 +1,256 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qgeocodecache_p.h"
+#include "qgeocodingmanagerengine.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+enum KeyType : quint8
+{
+    AddressKey,
+    SearchStringKey,
+    CoordinateKey
+};
+
+// Addresses typed or generated differently still name the same place
+QString normalized(const QString &text)
+{
+    return text.simplified().toCaseFolded();
+}
+
+} // namespace
+
+QGeoCodeCacheReply::QGeoCodeCacheReply(QObject *parent)
+    : QGeoCodeReply(parent)
+{
+}
+
+void QGeoCodeCacheReply::abort()
+{
+    m_follower.abort(this);
+    QGeoCodeReply::abort();
+}
+
+/*
+    See the QGeoCodingManagerEngine documentation for the geocoding.cache parameters.
+*/
+QGeoCodeCache::QGeoCodeCache(QGeoCodingManagerEngine *engine, const QVariantMap &parameters)
+    : QObject(engine), m_engine(engine),
+      m_requests(this, &QGeoCodeCache::result,
+                 [this](const QByteArray &key, Entry *entry) { return find(key, entry); },
+                 [this](const QByteArray &key, const Entry &entry) { insert(key, entry); },
+                 [this](const QByteArray &key) { m_entries.remove(key); },
+                 [this](QGeoCodeCacheReply *reply, const Entry &entry) { finish(reply, entry); })
+{
+    m_entries.setMaxCost(qMax(1, parameters.value(QStringLiteral("geocoding.cache.size")).toInt()));
+    if (parameters.contains(QStringLiteral("geocoding.cache.ttl")))
+        m_ttl = qMax(0, parameters.value(QStringLiteral("geocoding.cache.ttl")).toInt()) * qint64(1000);
+    if (parameters.contains(QStringLiteral("geocoding.cache.precision"))) {
+        const int decimals = qBound(0, parameters.value(QStringLiteral("geocoding.cache.precision")).toInt(), 9);
+        m_precision = std::pow(10.0, decimals);
+    }
+}
+
+QGeoCodeCache::~QGeoCodeCache() = default;
+
+bool QGeoCodeCache::isEnabled(const QVariantMap &parameters)
+{
+    return parameters.value(QStringLiteral("geocoding.cache.size")).toInt() > 0;
+}
+
+QGeoCodeReply *QGeoCodeCache::geocode(const QGeoAddress &address, const QGeoShape &bounds)
+{
+    return request(addressKey(address, bounds), [this, address, bounds]() {
+        return m_engine->geocode(address, bounds);
+    });
+}
+
+QGeoCodeReply *QGeoCodeCache::geocode(const QString &address, int limit, int offset,
+                                      const QGeoShape &bounds)
+{
+    return request(addressKey(address, limit, offset, bounds), [this, address, limit, offset, bounds]() {
+        return m_engine->geocode(address, limit, offset, bounds);
+    });
+}
+
+/*
+    Coordinates falling in the same cell of the grid share the locations found
+    for the first of them that was looked up.
+*/
+QGeoCodeReply *QGeoCodeCache::reverseGeocode(const QGeoCoordinate &coordinate, const QGeoShape &bounds)
+{
+    return request(coordinateKey(coordinate, bounds), [this, coordinate, bounds]() {
+        return m_engine->reverseGeocode(coordinate, bounds);
+    });
+}
+
+void QGeoCodeCache::writeEngineKey(QDataStream &out) const
+{
+    out.setVersion(QDataStream::Qt_6_5);
+    out << m_engine->managerName() << m_engine->managerVersion() << m_engine->locale().name();
+}
+
+QByteArray QGeoCodeCache::addressKey(const QGeoAddress &address, const QGeoShape &bounds) const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    writeEngineKey(out);
+
+    out << quint8(AddressKey) << normalized(address.country()) << normalized(address.countryCode())
+        << normalized(address.state()) << normalized(address.county()) << normalized(address.city())
+        << normalized(address.district()) << normalized(address.street())
+        << normalized(address.streetNumber()) << normalized(address.postalCode())
+        << (address.isTextGenerated() ? QString() : normalized(address.text())) << bounds;
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+QByteArray QGeoCodeCache::addressKey(const QString &address, int limit, int offset,
+                                     const QGeoShape &bounds) const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    writeEngineKey(out);
+
+    out << quint8(SearchStringKey) << normalized(address) << limit << offset << bounds;
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+/*
+    The coordinate is rounded to the configured number of decimals, which sets
+    the size of the grid cells reverse geocoding requests are bucketed in.
+*/
+QByteArray QGeoCodeCache::coordinateKey(const QGeoCoordinate &coordinate, const QGeoShape &bounds) const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    writeEngineKey(out);
+
+    out << quint8(CoordinateKey) << qint64(std::round(coordinate.latitude() * m_precision))
+        << qint64(std::round(coordinate.longitude() * m_precision)) << bounds;
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+void QGeoCodeCache::clear()
+{
+    m_entries.clear();
+}
+
+qsizetype QGeoCodeCache::size() const
+{
+    return m_entries.size();
+}
+
+qsizetype QGeoCodeCache::inFlightCount() const
+{
+    return m_requests.inFlightCount();
+}
+
+QGeoCodeCache::Entry QGeoCodeCache::result(const QGeoCodeReply *reply)
+{
+    Entry entry;
+    entry.error = reply->error();
+    entry.errorString = reply->errorString();
+    entry.locations = reply->locations();
+    entry.viewport = reply->viewport();
+    entry.limit = reply->limit();
+    entry.offset = reply->offset();
+    return entry;
+}
+
+QGeoCodeReply *QGeoCodeCache::request(const QByteArray &key, const Requests::Request &request)
+{
+    return m_requests.request(key, request, [this]() {
+        return new QGeoCodeCacheReply(m_engine);
+    });
+}
+
+void QGeoCodeCache::finish(QGeoCodeCacheReply *reply, const Entry &entry)
+{
+    if (entry.error != QGeoCodeReply::NoError) {
+        reply->setError(entry.error, entry.errorString);
+        emit m_engine->errorOccurred(reply, entry.error, entry.errorString);
+        return;
+    }
+
+    reply->setLocations(entry.locations);
+    reply->setViewport(entry.viewport);
+    reply->setLimit(entry.limit);
+    reply->setOffset(entry.offset);
+    reply->setFinished(true);
+    emit m_engine->finished(reply);
+}
+
+bool QGeoCodeCache::find(const QByteArray &key, Entry *entry)
+{
+    if (Entry *cached = m_entries.object(key)) {
+        if (cached->expiry > QDateTime::currentMSecsSinceEpoch()) {
+            *entry = *cached;
+            return true;
+        }
+        m_entries.remove(key);
+    }
+    return false;
+}
+
+void QGeoCodeCache::insert(const QByteArray &key, const Entry &entry)
+{
+    if (entry.error != QGeoCodeReply::NoError || entry.locations.isEmpty() || m_ttl <= 0)
+        return;
+
+    Entry *cached = new Entry(entry);
+    cached->expiry = QDateTime::currentMSecsSinceEpoch() + m_ttl;
+    m_entries.insert(key, cached);
+}
+
+QT_END_NAMESPACE
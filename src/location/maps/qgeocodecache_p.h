@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QGEOCODECACHE_P_H
+#define QGEOCODECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qlocationcacherequests_p.h>
+#include <QtLocation/QGeoCodeReply>
+#include <QtPositioning/QGeoLocation>
+#include <QtCore/QCache>
+#include <QtCore/QObject>
+
+QT_BEGIN_NAMESPACE
+
+class QDataStream;
+class QGeoAddress;
+class QGeoCodingManagerEngine;
+class QGeoCoordinate;
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoCodeCacheReply : public QGeoCodeReply
+{
+    Q_OBJECT
+public:
+    explicit QGeoCodeCacheReply(QObject *parent = nullptr);
+
+    void abort() override;
+
+private:
+    QLocationCacheFollower<QGeoCodeReply> m_follower;
+
+    friend class QGeoCodeCache;
+    template <typename, typename, typename>
+    friend class QLocationCacheRequests;
+};
+
+/*
+    Remembers the locations found by an engine for an address or a coordinate,
+    and lets identical requests in flight share one reply. Reverse geocoding
+    requests are bucketed on a coordinate grid.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoCodeCache : public QObject
+{
+    Q_OBJECT
+public:
+    QGeoCodeCache(QGeoCodingManagerEngine *engine, const QVariantMap &parameters);
+    ~QGeoCodeCache();
+
+    static bool isEnabled(const QVariantMap &parameters);
+
+    QGeoCodeReply *geocode(const QGeoAddress &address, const QGeoShape &bounds);
+    QGeoCodeReply *geocode(const QString &address, int limit, int offset, const QGeoShape &bounds);
+    QGeoCodeReply *reverseGeocode(const QGeoCoordinate &coordinate, const QGeoShape &bounds);
+
+    QByteArray addressKey(const QGeoAddress &address, const QGeoShape &bounds) const;
+    QByteArray addressKey(const QString &address, int limit, int offset,
+                          const QGeoShape &bounds) const;
+    QByteArray coordinateKey(const QGeoCoordinate &coordinate, const QGeoShape &bounds) const;
+    void clear();
+
+    qsizetype size() const;
+    qsizetype inFlightCount() const;
+
+private:
+    struct Entry
+    {
+        QGeoCodeReply::Error error = QGeoCodeReply::NoError;
+        QString errorString;
+        QList<QGeoLocation> locations;
+        QGeoShape viewport;
+        qsizetype limit = -1;
+        qsizetype offset = 0;
+        qint64 expiry = 0; // msecs since epoch
+    };
+
+    using Requests = QLocationCacheRequests<QGeoCodeReply, QGeoCodeCacheReply, Entry>;
+
+    static Entry result(const QGeoCodeReply *reply);
+
+    QGeoCodeReply *request(const QByteArray &key, const Requests::Request &request);
+    void finish(QGeoCodeCacheReply *reply, const Entry &entry);
+
+    bool find(const QByteArray &key, Entry *entry);
+    void insert(const QByteArray &key, const Entry &entry);
+    void writeEngineKey(QDataStream &out) const;
+
+    QGeoCodingManagerEngine *m_engine;
+    QCache<QByteArray, Entry> m_entries;
+    Requests m_requests;
+    qint64 m_ttl = 300000;
+    double m_precision = 1e4;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODECACHE_P_H
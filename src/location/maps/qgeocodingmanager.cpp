@@ -40,6 +40,8 @@
 #include "qgeocodingmanager.h"
 #include "qgeocodingmanager_p.h"
 #include "qgeocodingmanagerengine.h"
+#include "qgeocodingmanagerengine_p.h"
+#include "qgeocodecache_p.h"
 
 #include "qgeorectangle.h"
 #include "qgeocircle.h"
@@ -169,6 +171,8 @@ int QGeoCodingManager::managerVersion() const
 */
 QGeoCodeReply *QGeoCodingManager::geocode(const QGeoAddress &address, const QGeoShape &bounds)
 {
+    if (QGeoCodeCache *cache = d_ptr->engine->d_ptr->geocodeCache)
+        return cache->geocode(address, bounds);
     return d_ptr->engine->geocode(address, bounds);
 }
 
@@ -211,6 +215,8 @@ QGeoCodeReply *QGeoCodingManager::geocode(const QGeoAddress &address, const QGeo
 */
 QGeoCodeReply *QGeoCodingManager::reverseGeocode(const QGeoCoordinate &coordinate, const QGeoShape &bounds)
 {
+    if (QGeoCodeCache *cache = d_ptr->engine->d_ptr->geocodeCache)
+        return cache->reverseGeocode(coordinate, bounds);
     return d_ptr->engine->reverseGeocode(coordinate, bounds);
 }
 
@@ -248,6 +254,9 @@ QGeoCodeReply *QGeoCodingManager::geocode(const QString &address,
         int offset,
         const QGeoShape &bounds)
 {
+    if (QGeoCodeCache *cache = d_ptr->engine->d_ptr->geocodeCache)
+        return cache->geocode(address, limit, offset, bounds);
+
     QGeoCodeReply *reply = d_ptr->engine->geocode(address,
                              limit,
                              offset,
@@ -39,6 +39,7 @@
 
 #include "qgeocodingmanagerengine.h"
 #include "qgeocodingmanagerengine_p.h"
+#include "qgeocodecache_p.h"
 
 #include "qgeoaddress.h"
 #include "qgeocoordinate.h"
@@ -70,6 +71,30 @@ QT_BEGIN_NAMESPACE
     setSupportsReverseGeocoding(true) at some point in time before
     reverseGeocode() is called.
 
+    Results can be cached by the manager, for all engines, with these plugin
+    parameters:
+
+    \table
+    \header
+        \li Parameter
+        \li Description
+    \row
+        \li geocoding.cache.size
+        \li The number of requests whose locations are kept in memory. The
+            cache is disabled when this is 0, the default.
+    \row
+        \li geocoding.cache.ttl
+        \li How long, in seconds, cached locations are reused. Defaults to 300.
+    \row
+        \li geocoding.cache.precision
+        \li How many decimals of the coordinates are compared to tell reverse
+            geocoding requests apart. Defaults to 4, about ten meters.
+    \endtable
+
+    Addresses are compared case insensitively and without extra whitespace.
+    While the cache is enabled, identical requests that are in progress at the
+    same time share the reply of the engine.
+
     A subclass of QGeoCodingManagerEngine will often make use of a subclass
     fo QGeoCodeReply internally, in order to add any engine-specific
     data (such as a QNetworkReply object for network-based services) to the
@@ -86,7 +111,8 @@ QGeoCodingManagerEngine::QGeoCodingManagerEngine(const QVariantMap &parameters,
     : QObject(parent),
       d_ptr(new QGeoCodingManagerEnginePrivate())
 {
-    Q_UNUSED(parameters);
+    if (QGeoCodeCache::isEnabled(parameters))
+        d_ptr->geocodeCache = new QGeoCodeCache(this, parameters);
 }
 
 /*!
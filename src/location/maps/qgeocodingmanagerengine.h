@@ -87,6 +87,7 @@ private:
 
     friend class QGeoServiceProvider;
     friend class QGeoServiceProviderPrivate;
+    friend class QGeoCodingManager;
 };
 
 QT_END_NAMESPACE
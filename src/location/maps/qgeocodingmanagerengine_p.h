@@ -57,6 +57,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QGeoCodeCache;
+
 class QGeoCodingManagerEnginePrivate
 {
 public:
@@ -66,6 +68,8 @@ public:
     QLocale locale;
     int managerVersion = -1;
 
+    QGeoCodeCache *geocodeCache = nullptr; // child of the engine, if enabled
+
 private:
     Q_DISABLE_COPY(QGeoCodingManagerEnginePrivate)
 };
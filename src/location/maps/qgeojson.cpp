@@ -44,12 +44,28 @@
 #include <qjsonobject.h>
 #include <qjsonvalue.h>
 #include <qjsonarray.h>
+#include <qiodevice.h>
+#include <qmutex.h>
+#include <qsemaphore.h>
+#include <qcryptographichash.h>
+#include <qdatastream.h>
+#include <qdatetime.h>
+#include <qdir.h>
+#include <qendian.h>
+#include <qfileinfo.h>
+#include <qhash.h>
+#include <qsavefile.h>
 #include <qgeocoordinate.h>
 #include <qgeocircle.h>
 #include <qgeopath.h>
 #include <qgeopolygon.h>
+#include <qgeorectangle.h>
 #include <qtextstream.h>
 
+#include <functional>
+#include <limits>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 /*! \namespace QGeoJson
@@ -70,6 +86,11 @@ QT_BEGIN_NAMESPACE
 
     The importGeoJson() method accepts a \l QJsonDocument from which it
     extracts a single \l {https://tools.ietf.org/html/rfc7159} {JSON} object.
+    Its QByteArray and QIODevice overloads return the same structure, but parse
+    the document as they read it, which avoids holding the whole document and
+    every coordinate as QJsonValue and QVariant first. The importGeoJsonAsync()
+    method does the same on a thread pool, converting the features of a
+    FeatureCollection in parallel.
     The GeoJSON RFC expects that a valid GeoJSON Document has in its root
     a single JSON object. This method doesn't perform any validation on the
     input. The importer returns a QVariantList containing a single QVariantMap.
@@ -945,6 +966,1369 @@ static QJsonObject exportFeatureCollection(const QVariantMap &featureCollection)
     return exportedFeatureCollection;
 }
 
+namespace {
+
+/*
+    Pull parser for GeoJSON, over a byte array or over a device that is read in
+    chunks. Coordinates are read straight into the lists that back QGeoPath and
+    QGeoPolygon, only the remaining members (properties, id, bbox) are converted
+    to QVariant, with the same rules as QJsonValue::toVariant().
+*/
+class GeoJsonReader
+{
+public:
+    using Range = std::pair<qsizetype, qsizetype>;
+
+    explicit GeoJsonReader(const QByteArray &data, qint64 offset = 0)
+        : m_buffer(data), m_offset(offset) {}
+    explicit GeoJsonReader(QIODevice *device) : m_device(device) {}
+
+    QVariantList read();
+    QString errorString() const { return m_error; }
+
+    // A FeatureCollection can be read in parts: the root object first, with
+    // the byte ranges of its features, then each feature on its own.
+    bool readSplit(QList<Range> *featureRanges);
+    QVariantList splitResult(const QVariantList &features);
+    bool readFeature(QVariantMap *feature);
+
+private:
+    // Positions of any depth, from a Point (1) to a MultiPolygon (4)
+    struct Coordinates
+    {
+        int depth = 0;
+        bool empty = false;
+        QGeoCoordinate point;
+        QList<QGeoCoordinate> line;
+        QList<QList<QGeoCoordinate>> lines;
+        QList<QList<QList<QGeoCoordinate>>> polygons;
+    };
+
+    // The members of a GeoJSON object that the importer uses
+    struct Object
+    {
+        QString type;
+        Coordinates coordinates;
+        QVariantList geometries;
+        QVariantMap geometry;
+        QVariantList features;
+        QVariant properties;
+        QVariant id;
+        QVariant bbox;
+        bool hasId = false;
+        bool hasBbox = false;
+    };
+
+    static QVariantList toResult(const Object &root);
+    static QVariantMap toGeometry(const Object &object);
+    static QVariantMap toFeature(const Object &object);
+    static QGeoPolygon toPolygon(const QList<QList<QGeoCoordinate>> &rings);
+
+    bool readRoot();
+    bool readObject(Object *object);
+    bool readObjectList(QVariantList *list, bool features);
+    bool readCoordinates(Coordinates *coordinates, int depth);
+    bool readPosition(QGeoCoordinate *position);
+    bool readString(QString *string);
+    bool readNumber(double *number);
+    bool readVariant(QVariant *variant);
+    bool skipValue();
+
+    int peekChar();
+    int peekToken();
+    int getChar();
+    bool consumeIf(char c);
+    bool expect(char c);
+    bool setError(const QString &error);
+
+    QIODevice *m_device = nullptr;
+    QByteArray m_buffer;
+    qsizetype m_pos = 0;
+    qint64 m_offset = 0; // of the buffer in the input
+    QByteArray *m_capture = nullptr;
+    int m_depth = 0;
+    QString m_error;
+    Object m_root;
+    QList<Range> *m_featureRanges = nullptr;
+};
+
+constexpr qint64 readChunkSize = 64 * 1024;
+constexpr int maximumDepth = 256;
+
+inline bool isNumberChar(int c)
+{
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+QVariantList GeoJsonReader::read()
+{
+    if (!readRoot())
+        return QVariantList();
+    return toResult(m_root);
+}
+
+bool GeoJsonReader::readSplit(QList<Range> *featureRanges)
+{
+    m_featureRanges = featureRanges;
+    const bool ok = readRoot();
+    m_featureRanges = nullptr;
+    return ok;
+}
+
+QVariantList GeoJsonReader::splitResult(const QVariantList &features)
+{
+    m_root.features = features;
+    return toResult(m_root);
+}
+
+bool GeoJsonReader::readFeature(QVariantMap *feature)
+{
+    Object object;
+    if (peekToken() == '{' ? !readObject(&object) : !skipValue())
+        return false;
+    if (peekToken() != -1)
+        return setError(QStringLiteral("Garbage after the feature"));
+    *feature = toFeature(object);
+    return true;
+}
+
+bool GeoJsonReader::readRoot()
+{
+    if (!readObject(&m_root))
+        return false;
+    if (peekToken() != -1)
+        return setError(QStringLiteral("Garbage after the GeoJSON object"));
+    return true;
+}
+
+QVariantList GeoJsonReader::toResult(const Object &root)
+{
+    QVariantMap parsedGeoJsonMap;
+    if (root.type == QLatin1String("Feature")) {
+        parsedGeoJsonMap = toFeature(root);
+    } else if (root.type == QLatin1String("FeatureCollection")) {
+        parsedGeoJsonMap.insert(QStringLiteral("type"), root.type);
+        parsedGeoJsonMap.insert(QStringLiteral("data"), root.features);
+    } else {
+        parsedGeoJsonMap = toGeometry(root);
+        if (parsedGeoJsonMap.isEmpty())
+            return QVariantList();
+    }
+    if (root.hasBbox)
+        parsedGeoJsonMap.insert(QStringLiteral("bbox"), root.bbox);
+    return QVariantList{ parsedGeoJsonMap };
+}
+
+QVariantMap GeoJsonReader::toGeometry(const Object &object)
+{
+    const Coordinates &coordinates = object.coordinates;
+    QVariant data;
+    if (object.type == QLatin1String("Point")) {
+        QGeoCircle circle;
+        circle.setCenter(coordinates.point);
+        data = QVariant::fromValue(circle);
+    } else if (object.type == QLatin1String("LineString")) {
+        data = QVariant::fromValue(QGeoPath(coordinates.line));
+    } else if (object.type == QLatin1String("Polygon")) {
+        data = QVariant::fromValue(toPolygon(coordinates.lines));
+    } else if (object.type == QLatin1String("MultiPoint")) {
+        QVariantList points;
+        points.reserve(coordinates.line.size());
+        for (const QGeoCoordinate &position : coordinates.line) {
+            QGeoCircle circle;
+            circle.setCenter(position);
+            points.append(QVariantMap{ { QStringLiteral("type"), QStringLiteral("Point") },
+                                       { QStringLiteral("data"), QVariant::fromValue(circle) } });
+        }
+        data = points;
+    } else if (object.type == QLatin1String("MultiLineString")) {
+        QVariantList lineStrings;
+        lineStrings.reserve(coordinates.lines.size());
+        for (const QList<QGeoCoordinate> &line : coordinates.lines) {
+            lineStrings.append(QVariantMap{ { QStringLiteral("type"), QStringLiteral("LineString") },
+                                            { QStringLiteral("data"), QVariant::fromValue(QGeoPath(line)) } });
+        }
+        data = lineStrings;
+    } else if (object.type == QLatin1String("MultiPolygon")) {
+        QVariantList polygons;
+        polygons.reserve(coordinates.polygons.size());
+        for (const QList<QList<QGeoCoordinate>> &rings : coordinates.polygons) {
+            polygons.append(QVariantMap{ { QStringLiteral("type"), QStringLiteral("Polygon") },
+                                         { QStringLiteral("data"), QVariant::fromValue(toPolygon(rings)) } });
+        }
+        data = polygons;
+    } else if (object.type == QLatin1String("GeometryCollection")) {
+        data = object.geometries;
+    } else {
+        return QVariantMap();
+    }
+
+    return QVariantMap{ { QStringLiteral("type"), object.type }, { QStringLiteral("data"), data } };
+}
+
+QVariantMap GeoJsonReader::toFeature(const Object &object)
+{
+    QVariantMap feature = object.geometry;
+    feature.insert(QStringLiteral("properties"), object.properties.toMap());
+    if (object.hasId)
+        feature.insert(QStringLiteral("id"), object.id);
+    return feature;
+}
+
+QGeoPolygon GeoJsonReader::toPolygon(const QList<QList<QGeoCoordinate>> &rings)
+{
+    QGeoPolygon polygon;
+    for (qsizetype i = 0; i < rings.size(); ++i) {
+        if (i == 0)
+            polygon.setPerimeter(rings.at(i)); // External perimeter
+        else
+            polygon.addHole(rings.at(i)); // Inner perimeters
+    }
+    return polygon;
+}
+
+bool GeoJsonReader::readObject(Object *object)
+{
+    if (++m_depth > maximumDepth)
+        return setError(QStringLiteral("GeoJSON objects are nested too deeply"));
+    if (!expect('{'))
+        return false;
+
+    if (!consumeIf('}')) {
+        do {
+            QString key;
+            if (!readString(&key) || !expect(':'))
+                return false;
+
+            bool ok = true;
+            if (key == QLatin1String("type")) {
+                ok = peekToken() == '"' ? readString(&object->type) : skipValue();
+            } else if (key == QLatin1String("coordinates")) {
+                object->coordinates = Coordinates();
+                ok = peekToken() == '[' ? readCoordinates(&object->coordinates, 1) : skipValue();
+            } else if (key == QLatin1String("geometries")) {
+                ok = readObjectList(&object->geometries, false);
+            } else if (key == QLatin1String("features")) {
+                ok = readObjectList(&object->features, true);
+            } else if (key == QLatin1String("geometry")) {
+                object->geometry.clear();
+                if (peekToken() == '{') {
+                    Object geometry;
+                    ok = readObject(&geometry);
+                    object->geometry = toGeometry(geometry);
+                } else {
+                    ok = skipValue();
+                }
+            } else if (key == QLatin1String("properties")) {
+                ok = readVariant(&object->properties);
+            } else if (key == QLatin1String("id")) {
+                ok = readVariant(&object->id);
+                object->hasId = true;
+            } else if (key == QLatin1String("bbox")) {
+                ok = readVariant(&object->bbox);
+                object->hasBbox = true;
+            } else {
+                ok = skipValue();
+            }
+            if (!ok)
+                return false;
+        } while (consumeIf(','));
+
+        if (!expect('}'))
+            return false;
+    }
+
+    --m_depth;
+    return true;
+}
+
+/*
+    Geometries and features are converted as soon as they are read, so that
+    only one of them is held in the intermediate form at a time.
+*/
+bool GeoJsonReader::readObjectList(QVariantList *list, bool features)
+{
+    list->clear();
+    if (peekToken() != '[')
+        return skipValue();
+    getChar();
+    if (consumeIf(']'))
+        return true;
+
+    if (features && m_featureRanges && m_depth == 1) {
+        do {
+            peekToken();
+            const qsizetype start = m_offset + m_pos;
+            if (!skipValue())
+                return false;
+            m_featureRanges->append({ start, m_offset + m_pos });
+        } while (consumeIf(','));
+        return expect(']');
+    }
+
+    do {
+        Object object;
+        if (peekToken() == '{') {
+            if (!readObject(&object))
+                return false;
+        } else if (!skipValue()) {
+            return false;
+        }
+        list->append(features ? toFeature(object) : toGeometry(object));
+    } while (consumeIf(','));
+    return expect(']');
+}
+
+/*
+    The depth of the nested arrays is only known once the positions are
+    reached, empty arrays count as empty lists of positions.
+*/
+bool GeoJsonReader::readCoordinates(Coordinates *coordinates, int depth)
+{
+    if (depth > 4)
+        return setError(QStringLiteral("Coordinates are nested too deeply"));
+    if (!expect('['))
+        return false;
+
+    const int c = peekToken();
+    if (c == ']') {
+        getChar();
+        coordinates->depth = 2;
+        coordinates->empty = true;
+        return true;
+    }
+    if (c != '[') {
+        coordinates->depth = 1;
+        return readPosition(&coordinates->point);
+    }
+
+    do {
+        Coordinates child;
+        if (!readCoordinates(&child, depth + 1))
+            return false;
+
+        if (child.empty && coordinates->depth == 2) {
+            coordinates->line.append(QGeoCoordinate());
+            continue;
+        }
+        if (coordinates->depth == 0)
+            coordinates->depth = child.depth + 1;
+        else if (coordinates->depth != child.depth + 1)
+            return setError(QStringLiteral("Positions are nested unevenly"));
+
+        switch (child.depth) {
+        case 1:
+            coordinates->line.append(child.point);
+            break;
+        case 2:
+            coordinates->lines.append(std::move(child.line));
+            break;
+        case 3:
+            coordinates->polygons.append(std::move(child.lines));
+            break;
+        default:
+            return setError(QStringLiteral("Coordinates are nested too deeply"));
+        }
+    } while (consumeIf(','));
+    return expect(']');
+}
+
+// Reads the members of a position, after its opening bracket
+bool GeoJsonReader::readPosition(QGeoCoordinate *position)
+{
+    for (int i = 0; ; ++i) {
+        double value = 0.0;
+        if (isNumberChar(peekToken())) {
+            if (!readNumber(&value))
+                return false;
+        } else if (!skipValue()) {
+            return false;
+        }
+
+        switch (i) {
+        case 0:
+            position->setLongitude(value);
+            break;
+        case 1:
+            position->setLatitude(value);
+            break;
+        case 2:
+            position->setAltitude(value);
+            break;
+        default:
+            break;
+        }
+
+        if (!consumeIf(','))
+            return expect(']');
+    }
+}
+
+bool GeoJsonReader::readString(QString *string)
+{
+    if (!expect('"'))
+        return false;
+
+    QByteArray utf8;
+    char16_t highSurrogate = 0;
+    for (;;) {
+        int c = getChar();
+        if (c == -1)
+            return setError(QStringLiteral("Unterminated string"));
+        if (c == '"')
+            break;
+        if (c != '\\') {
+            if (string)
+                utf8.append(char(c));
+            continue;
+        }
+
+        c = getChar();
+        switch (c) {
+        case '"': case '\\': case '/':
+            break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u': {
+            char hex[4];
+            for (char &digit : hex) {
+                const int h = getChar();
+                if (h == -1)
+                    return setError(QStringLiteral("Unterminated string"));
+                digit = char(h);
+            }
+            bool ok = false;
+            const char16_t unit = char16_t(QByteArrayView(hex, 4).toUShort(&ok, 16));
+            if (!ok)
+                return setError(QStringLiteral("Invalid escape sequence"));
+            if (!string)
+                continue;
+            // Surrogate pairs are escaped as two units
+            if (QChar::isHighSurrogate(unit)) {
+                highSurrogate = unit;
+            } else if (QChar::isLowSurrogate(unit) && highSurrogate) {
+                const char16_t pair[] = { highSurrogate, unit };
+                utf8.append(QStringView(pair, 2).toUtf8());
+                highSurrogate = 0;
+            } else {
+                utf8.append(QStringView(&unit, 1).toUtf8());
+            }
+            continue;
+        }
+        default:
+            return setError(QStringLiteral("Invalid escape sequence"));
+        }
+        if (string)
+            utf8.append(char(c));
+    }
+
+    if (string)
+        *string = QString::fromUtf8(utf8);
+    return true;
+}
+
+bool GeoJsonReader::readNumber(double *number)
+{
+    char buffer[64];
+    qsizetype length = 0;
+    for (int c = peekChar(); isNumberChar(c); c = peekChar()) {
+        if (length == qsizetype(sizeof(buffer)))
+            return setError(QStringLiteral("Number too long"));
+        buffer[length++] = char(getChar());
+    }
+
+    bool ok = false;
+    *number = QByteArrayView(buffer, length).toDouble(&ok);
+    return ok || setError(QStringLiteral("Invalid number"));
+}
+
+/*
+    Members that are not geometry are rare and small, they are converted by
+    QJsonDocument so that they end up exactly like with importGeoJson().
+*/
+bool GeoJsonReader::readVariant(QVariant *variant)
+{
+    QByteArray raw("[");
+    peekToken();
+    m_capture = &raw;
+    const bool ok = skipValue();
+    m_capture = nullptr;
+    if (!ok)
+        return false;
+    raw.append(']');
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(raw, &error);
+    if (error.error != QJsonParseError::NoError)
+        return setError(error.errorString());
+    *variant = document.array().at(0).toVariant();
+    return true;
+}
+
+bool GeoJsonReader::skipValue()
+{
+    int nesting = 0;
+    do {
+        const int c = peekToken();
+        switch (c) {
+        case -1:
+            return setError(QStringLiteral("Unexpected end of data"));
+        case '"':
+            if (!readString(nullptr))
+                return false;
+            break;
+        case '{':
+        case '[':
+            getChar();
+            ++nesting;
+            break;
+        case '}':
+        case ']':
+        case ',':
+        case ':':
+            if (nesting == 0)
+                return setError(QStringLiteral("Unexpected character"));
+            getChar();
+            if (c == '}' || c == ']')
+                --nesting;
+            break;
+        default:
+            if (!isNumberChar(c) && !(c >= 'a' && c <= 'z'))
+                return setError(QStringLiteral("Unexpected character"));
+            for (int d = c; isNumberChar(d) || (d >= 'a' && d <= 'z'); d = peekChar())
+                getChar();
+            break;
+        }
+    } while (nesting > 0);
+    return true;
+}
+
+int GeoJsonReader::peekChar()
+{
+    if (m_pos == m_buffer.size()) {
+        if (!m_device)
+            return -1;
+        m_offset += m_pos;
+        m_buffer = m_device->read(readChunkSize);
+        m_pos = 0;
+        if (m_buffer.isEmpty())
+            return -1;
+    }
+    return uchar(m_buffer.constData()[m_pos]);
+}
+
+int GeoJsonReader::peekToken()
+{
+    int c = peekChar();
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+        ++m_pos;
+        c = peekChar();
+    }
+    return c;
+}
+
+int GeoJsonReader::getChar()
+{
+    const int c = peekChar();
+    if (c != -1) {
+        ++m_pos;
+        if (m_capture)
+            m_capture->append(char(c));
+    }
+    return c;
+}
+
+bool GeoJsonReader::consumeIf(char c)
+{
+    if (peekToken() != uchar(c))
+        return false;
+    getChar();
+    return true;
+}
+
+bool GeoJsonReader::expect(char c)
+{
+    return consumeIf(c)
+            || setError(QStringLiteral("Expected '%1'").arg(QLatin1Char(c)));
+}
+
+bool GeoJsonReader::setError(const QString &error)
+{
+    if (m_error.isEmpty())
+        m_error = QStringLiteral("%1 at offset %2").arg(error).arg(m_offset + m_pos);
+    return false;
+}
+
+} // namespace
+
+namespace {
+
+/*
+    The features of a FeatureCollection that are shared by the threads that
+    import them. Batches are claimed in turn, a claimed batch always completes
+    before QGeoJsonImportTask::run() returns, so only then is the task used.
+*/
+struct FeatureImport
+{
+    QByteArray data;
+    QList<GeoJsonReader::Range> ranges;
+    QVariant *features = nullptr; // one slot per range, each written by one thread
+    qsizetype batchSize = 1;
+    qsizetype batchCount = 0;
+    std::atomic<qsizetype> nextBatch = 0;
+    std::atomic<qsizetype> importedFeatures = 0;
+    std::atomic<bool> failed = false;
+    const std::atomic<bool> *aborted = nullptr;
+    std::function<void(qsizetype)> reportProgress;
+    QSemaphore finishedBatches;
+    QMutex errorMutex;
+    QString errorString;
+
+    void importBatches();
+};
+
+void FeatureImport::importBatches()
+{
+    for (qsizetype batch = nextBatch++; batch < batchCount; batch = nextBatch++) {
+        const qsizetype first = batch * batchSize;
+        const qsizetype last = qMin(ranges.size(), first + batchSize);
+        for (qsizetype i = first; i < last && !*aborted && !failed; ++i) {
+            const auto [begin, end] = ranges.at(i);
+            GeoJsonReader reader(QByteArray::fromRawData(data.constData() + begin, end - begin), begin);
+            QVariantMap feature;
+            if (!reader.readFeature(&feature)) {
+                QMutexLocker locker(&errorMutex);
+                if (!failed.exchange(true))
+                    errorString = reader.errorString();
+                break;
+            }
+            features[i] = feature;
+        }
+        reportProgress(importedFeatures += last - first);
+        finishedBatches.release();
+    }
+}
+
+} // namespace
+
+/*
+    QGeoJsonImportTask
+*/
+
+QGeoJsonImportTask::QGeoJsonImportTask(const QByteArray &data, QObject *parent)
+    : QObject(parent), m_data(data)
+{
+    setAutoDelete(false);
+}
+
+/*
+    A task deleted with its parent while it runs stops and waits for run() to
+    return, so that the threads never use a deleted task.
+*/
+QGeoJsonImportTask::~QGeoJsonImportTask()
+{
+    m_aborted = true;
+    if (m_pool && !m_pool->tryTake(this))
+        m_runFinished.acquire();
+}
+
+void QGeoJsonImportTask::start(QThreadPool *pool)
+{
+    m_pool = pool;
+    pool->start(this);
+}
+
+/*
+    The root object is read first, leaving the features of a FeatureCollection
+    as byte ranges. These are converted in batches by this thread and by up to
+    one helper per other thread of the pool, then put back in document order.
+*/
+void QGeoJsonImportTask::run()
+{
+    if (!m_aborted) {
+        GeoJsonReader reader(m_data);
+        QList<GeoJsonReader::Range> ranges;
+        if (!reader.readSplit(&ranges)) {
+            m_errorString = reader.errorString();
+        } else if (ranges.isEmpty()) {
+            m_result = reader.splitResult(QVariantList());
+        } else {
+            QVariantList features(ranges.size());
+            const qsizetype total = ranges.size();
+            const int threads = qMax(1, m_pool->maxThreadCount());
+
+            auto import = std::make_shared<FeatureImport>();
+            import->data = m_data;
+            import->ranges = ranges;
+            import->features = features.data();
+            import->batchSize = qMax(qsizetype(1), total / (threads * 4));
+            import->batchCount = (total + import->batchSize - 1) / import->batchSize;
+            import->aborted = &m_aborted;
+            import->reportProgress = [this, total](qsizetype imported) {
+                QMetaObject::invokeMethod(this, [this, imported, total]() {
+                    notifyProgress(imported, total);
+                }, Qt::QueuedConnection);
+            };
+
+            const qsizetype helpers = qMin(qsizetype(threads), import->batchCount) - 1;
+            for (qsizetype i = 0; i < helpers; ++i)
+                m_pool->start([import]() { import->importBatches(); });
+            import->importBatches();
+            import->finishedBatches.acquire(int(import->batchCount));
+
+            if (import->failed)
+                m_errorString = import->errorString;
+            else if (!m_aborted)
+                m_result = reader.splitResult(features);
+        }
+    }
+    QMetaObject::invokeMethod(this, &QGeoJsonImportTask::notifyFinished, Qt::QueuedConnection);
+    m_runFinished.release();
+}
+
+// Batches finish in any order, only increasing counts are reported
+void QGeoJsonImportTask::notifyProgress(qsizetype importedFeatures, qsizetype totalFeatures)
+{
+    if (m_aborted || importedFeatures <= m_reportedFeatures)
+        return;
+    m_reportedFeatures = importedFeatures;
+    emit progress(importedFeatures, totalFeatures);
+}
+
+void QGeoJsonImportTask::notifyFinished()
+{
+    if (!m_aborted)
+        emit finished();
+    deleteLater();
+}
+
+/*
+    The imported document, structured like the result of
+    QGeoJson::importGeoJson(). Empty if the document could not be parsed.
+*/
+QVariantList QGeoJsonImportTask::result() const
+{
+    return m_result;
+}
+
+QString QGeoJsonImportTask::errorString() const
+{
+    return m_errorString;
+}
+
+bool QGeoJsonImportTask::isAborted() const
+{
+    return m_aborted;
+}
+
+/*
+    Stops converting features as soon as possible, and suppresses progress()
+    and finished(). The task still deletes itself once the threads are done.
+*/
+void QGeoJsonImportTask::abort()
+{
+    m_aborted = true;
+}
+
+namespace {
+
+/*
+    Layout of a QGeoJsonCache file, all values being little endian:
+
+    header       magic, version, size, modification time and SHA-1 of the
+                 source file, feature and coordinate counts, offsets of the
+                 sections below, offset and size of the root record
+    coordinates  latitude, longitude and altitude of every coordinate, as
+                 doubles, in the order the shapes use them
+    index        for each feature of a FeatureCollection, the offset and size
+                 of its record and its bounding box
+    records      the items, see GeoJsonCacheWriter::writeItem()
+    strings      the type names and the keys used by the records
+*/
+constexpr quint32 GeoJsonCacheMagic = 0x434a4751; // "QGJC"
+constexpr quint32 GeoJsonCacheVersion = 1;
+constexpr quint64 GeoJsonCacheHeaderSize = 112;
+constexpr quint64 GeoJsonCacheCoordinateSize = 3 * sizeof(double);
+constexpr quint64 GeoJsonCacheIndexEntrySize = 2 * sizeof(quint64) + 4 * sizeof(double);
+
+enum GeoJsonCacheData : quint8 {
+    NoData,
+    CircleData,
+    PathData,
+    PolygonData,
+    ListData,
+    FeaturesData // the features are in the index
+};
+
+enum GeoJsonCacheMember : quint8 {
+    VariantMember,
+    PropertiesMember
+};
+
+void prepareStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+template <typename T>
+void appendLittleEndian(QByteArray *bytes, T value)
+{
+    char buffer[sizeof(T)];
+    qToLittleEndian(value, buffer);
+    bytes->append(buffer, sizeof(T));
+}
+
+qint64 modificationTime(const QFileInfo &info)
+{
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+QByteArray sourceHash(const QString &fileName)
+{
+    QFile file(fileName);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file))
+        return QByteArray();
+    return hash.result();
+}
+
+class GeoJsonCacheWriter
+{
+public:
+    bool write(const QVariantMap &root);
+
+    QByteArray coordinates;
+    QByteArray index;
+    QByteArray records;
+    QStringList strings;
+    quint64 coordinateCount = 0;
+    quint32 featureCount = 0;
+    quint64 rootOffset = 0;
+    quint64 rootSize = 0;
+
+private:
+    struct Bounds
+    {
+        double minLatitude = qInf();
+        double minLongitude = qInf();
+        double maxLatitude = -qInf();
+        double maxLongitude = -qInf();
+    };
+
+    bool writeRecord(const QVariantMap &item, bool features, Bounds *bounds,
+                     quint64 *offset, quint64 *size);
+    bool writeItem(QDataStream &stream, const QVariantMap &item, bool features, Bounds *bounds);
+    quint32 writeCoordinates(const QList<QGeoCoordinate> &path, Bounds *bounds);
+    quint32 string(const QString &string);
+
+    QHash<QString, quint32> m_stringIndex;
+};
+
+bool GeoJsonCacheWriter::write(const QVariantMap &root)
+{
+    const QVariant data = root.value(QStringLiteral("data"));
+    const bool features = root.value(QStringLiteral("type")).toString() == QLatin1String("FeatureCollection")
+            && data.typeId() == QMetaType::QVariantList;
+    if (features) {
+        const QVariantList list = data.toList();
+        for (const QVariant &feature : list) {
+            Bounds bounds;
+            quint64 offset = 0;
+            quint64 size = 0;
+            if (feature.typeId() != QMetaType::QVariantMap
+                    || !writeRecord(feature.toMap(), false, &bounds, &offset, &size)) {
+                return false;
+            }
+            appendLittleEndian(&index, offset);
+            appendLittleEndian(&index, size);
+            appendLittleEndian(&index, bounds.minLatitude);
+            appendLittleEndian(&index, bounds.minLongitude);
+            appendLittleEndian(&index, bounds.maxLatitude);
+            appendLittleEndian(&index, bounds.maxLongitude);
+        }
+        featureCount = quint32(list.size());
+    }
+
+    Bounds bounds;
+    return writeRecord(root, features, &bounds, &rootOffset, &rootSize)
+            && coordinateCount <= std::numeric_limits<quint32>::max();
+}
+
+bool GeoJsonCacheWriter::writeRecord(const QVariantMap &item, bool features, Bounds *bounds,
+                                     quint64 *offset, quint64 *size)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    prepareStream(stream);
+    if (!writeItem(stream, item, features, bounds))
+        return false;
+    *offset = quint64(records.size());
+    *size = quint64(record.size());
+    records.append(record);
+    return true;
+}
+
+/*
+    An item is the index of its type, its data, which refers to ranges of
+    coordinates or holds nested items, then its other members. The
+    properties of a feature are written as a table of key indexes and values.
+*/
+bool GeoJsonCacheWriter::writeItem(QDataStream &stream, const QVariantMap &item, bool features,
+                                   Bounds *bounds)
+{
+    stream << string(item.value(QStringLiteral("type")).toString());
+
+    const QVariant data = item.value(QStringLiteral("data"));
+    const QMetaType type = data.metaType();
+    if (!item.contains(QStringLiteral("data"))) {
+        stream << quint8(NoData);
+    } else if (features) {
+        stream << quint8(FeaturesData);
+    } else if (type == QMetaType::fromType<QGeoCircle>()) {
+        const QGeoCircle circle = data.value<QGeoCircle>();
+        stream << quint8(CircleData) << writeCoordinates({ circle.center() }, bounds)
+               << double(circle.radius());
+    } else if (type == QMetaType::fromType<QGeoPath>()) {
+        const QGeoPath path = data.value<QGeoPath>();
+        stream << quint8(PathData) << writeCoordinates(path.path(), bounds)
+               << quint32(path.size()) << double(path.width());
+    } else if (type == QMetaType::fromType<QGeoPolygon>()) {
+        const QGeoPolygon polygon = data.value<QGeoPolygon>();
+        const QList<QGeoCoordinate> perimeter = polygon.perimeter();
+        stream << quint8(PolygonData) << quint32(1 + polygon.holesCount())
+               << writeCoordinates(perimeter, bounds) << quint32(perimeter.size());
+        for (qsizetype i = 0; i < polygon.holesCount(); ++i) {
+            const QList<QGeoCoordinate> hole = polygon.holePath(i);
+            stream << writeCoordinates(hole, bounds) << quint32(hole.size());
+        }
+    } else if (data.typeId() == QMetaType::QVariantList) {
+        const QVariantList list = data.toList();
+        stream << quint8(ListData) << quint32(list.size());
+        for (const QVariant &element : list) {
+            if (element.typeId() != QMetaType::QVariantMap
+                    || !writeItem(stream, element.toMap(), false, bounds)) {
+                return false;
+            }
+        }
+    } else {
+        return false;
+    }
+
+    quint32 members = 0;
+    for (auto it = item.cbegin(); it != item.cend(); ++it) {
+        if (it.key() != QLatin1String("type") && it.key() != QLatin1String("data"))
+            ++members;
+    }
+    stream << members;
+    for (auto it = item.cbegin(); it != item.cend(); ++it) {
+        if (it.key() == QLatin1String("type") || it.key() == QLatin1String("data"))
+            continue;
+        stream << string(it.key());
+        if (it.key() == QLatin1String("properties") && it.value().typeId() == QMetaType::QVariantMap) {
+            const QVariantMap properties = it.value().toMap();
+            stream << quint8(PropertiesMember) << quint32(properties.size());
+            for (auto property = properties.cbegin(); property != properties.cend(); ++property)
+                stream << string(property.key()) << property.value();
+        } else {
+            stream << quint8(VariantMember) << it.value();
+        }
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+quint32 GeoJsonCacheWriter::writeCoordinates(const QList<QGeoCoordinate> &path, Bounds *bounds)
+{
+    const quint32 first = quint32(coordinateCount);
+    for (const QGeoCoordinate &coordinate : path) {
+        appendLittleEndian(&coordinates, coordinate.latitude());
+        appendLittleEndian(&coordinates, coordinate.longitude());
+        appendLittleEndian(&coordinates, coordinate.altitude());
+        if (coordinate.isValid()) {
+            bounds->minLatitude = qMin(bounds->minLatitude, coordinate.latitude());
+            bounds->minLongitude = qMin(bounds->minLongitude, coordinate.longitude());
+            bounds->maxLatitude = qMax(bounds->maxLatitude, coordinate.latitude());
+            bounds->maxLongitude = qMax(bounds->maxLongitude, coordinate.longitude());
+        }
+    }
+    coordinateCount += quint64(path.size());
+    return first;
+}
+
+quint32 GeoJsonCacheWriter::string(const QString &string)
+{
+    const auto it = m_stringIndex.constFind(string);
+    if (it != m_stringIndex.cend())
+        return *it;
+    const quint32 index = quint32(strings.size());
+    m_stringIndex.insert(string, index);
+    strings.append(string);
+    return index;
+}
+
+} // namespace
+
+/*
+    QGeoJsonCache
+*/
+
+QGeoJsonCache::QGeoJsonCache()
+{
+}
+
+QGeoJsonCache::~QGeoJsonCache()
+{
+    close();
+}
+
+/*
+    Writes \a importedGeoJson, structured like the result of
+    QGeoJson::importGeoJson(), to \a cacheFile, along with the size,
+    modification time and hash of \a sourceFile it was imported from.
+    Returns false if the file cannot be written or if the document holds
+    data that cannot be cached.
+*/
+bool QGeoJsonCache::write(const QString &cacheFile, const QString &sourceFile,
+                          const QVariantList &importedGeoJson)
+{
+    if (importedGeoJson.size() != 1 || importedGeoJson.first().typeId() != QMetaType::QVariantMap)
+        return false;
+
+    const QFileInfo source(sourceFile);
+    const QByteArray hash = sourceHash(sourceFile);
+    if (hash.isEmpty())
+        return false;
+
+    GeoJsonCacheWriter writer;
+    if (!writer.write(importedGeoJson.first().toMap()))
+        return false;
+
+    QByteArray strings;
+    QDataStream stringStream(&strings, QIODevice::WriteOnly);
+    prepareStream(stringStream);
+    stringStream << writer.strings;
+
+    const quint64 coordinatesOffset = GeoJsonCacheHeaderSize;
+    const quint64 indexOffset = coordinatesOffset + quint64(writer.coordinates.size());
+    const quint64 recordsOffset = indexOffset + quint64(writer.index.size());
+    const quint64 stringsOffset = recordsOffset + quint64(writer.records.size());
+
+    QByteArray header;
+    QDataStream headerStream(&header, QIODevice::WriteOnly);
+    prepareStream(headerStream);
+    headerStream << GeoJsonCacheMagic << GeoJsonCacheVersion
+                 << qint64(source.size()) << modificationTime(source);
+    headerStream.writeRawData(hash.constData(), int(hash.size()));
+    headerStream << writer.featureCount << writer.coordinateCount
+                 << coordinatesOffset << indexOffset << recordsOffset << stringsOffset
+                 << writer.rootOffset << writer.rootSize;
+    header.resize(qsizetype(GeoJsonCacheHeaderSize), '\0');
+
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(header);
+    file.write(writer.coordinates);
+    file.write(writer.index);
+    file.write(writer.records);
+    file.write(strings);
+    return file.commit();
+}
+
+/*
+    Maps \a cacheFile, and checks that it was written from the current content
+    of \a sourceFile. Returns false, leaving the cache closed, otherwise.
+*/
+bool QGeoJsonCache::open(const QString &cacheFile, const QString &sourceFile)
+{
+    close();
+
+    m_file.setFileName(cacheFile);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+    m_size = m_file.size();
+    if (quint64(m_size) < GeoJsonCacheHeaderSize || !(m_data = m_file.map(0, m_size))) {
+        close();
+        return false;
+    }
+
+    QDataStream headerStream(QByteArray::fromRawData(reinterpret_cast<const char *>(m_data),
+                                                     qsizetype(GeoJsonCacheHeaderSize)));
+    prepareStream(headerStream);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 sourceSize = 0;
+    qint64 sourceModified = 0;
+    QByteArray hash(QCryptographicHash::hashLength(QCryptographicHash::Sha1), Qt::Uninitialized);
+    quint64 stringsOffset = 0;
+    headerStream >> magic >> version >> sourceSize >> sourceModified;
+    headerStream.readRawData(hash.data(), int(hash.size()));
+    headerStream >> m_featureCount >> m_coordinateCount
+                 >> m_coordinatesOffset >> m_indexOffset >> m_recordsOffset >> stringsOffset
+                 >> m_rootOffset >> m_rootSize;
+
+    // Sections must follow each other, the records are checked when read
+    const quint64 size = quint64(m_size);
+    bool valid = headerStream.status() == QDataStream::Ok
+            && magic == GeoJsonCacheMagic && version == GeoJsonCacheVersion
+            && m_coordinatesOffset == GeoJsonCacheHeaderSize
+            && m_coordinateCount <= (size - m_coordinatesOffset) / GeoJsonCacheCoordinateSize
+            && m_indexOffset == m_coordinatesOffset + m_coordinateCount * GeoJsonCacheCoordinateSize
+            && m_featureCount <= (size - m_indexOffset) / GeoJsonCacheIndexEntrySize
+            && m_recordsOffset == m_indexOffset + m_featureCount * GeoJsonCacheIndexEntrySize
+            && m_recordsOffset <= stringsOffset && stringsOffset <= size;
+
+    if (valid) {
+        m_recordsSize = stringsOffset - m_recordsOffset;
+        QDataStream stringStream(QByteArray::fromRawData(reinterpret_cast<const char *>(m_data) + stringsOffset,
+                                                         qsizetype(size - stringsOffset)));
+        prepareStream(stringStream);
+        stringStream >> m_strings;
+        valid = stringStream.status() == QDataStream::Ok;
+    }
+
+    // The hash is only computed when the cheaper checks pass
+    const QFileInfo source(sourceFile);
+    valid = valid && source.size() == sourceSize && modificationTime(source) == sourceModified
+            && sourceHash(sourceFile) == hash;
+    if (!valid)
+        close();
+    return valid;
+}
+
+void QGeoJsonCache::close()
+{
+    if (m_data)
+        m_file.unmap(m_data);
+    m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+    m_featureCount = 0;
+    m_coordinateCount = 0;
+    m_coordinatesOffset = 0;
+    m_indexOffset = 0;
+    m_recordsOffset = 0;
+    m_recordsSize = 0;
+    m_rootOffset = 0;
+    m_rootSize = 0;
+    m_strings.clear();
+}
+
+bool QGeoJsonCache::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+/*
+    The number of features in the index, that is of the FeatureCollection at
+    the root of the document. Zero for any other document.
+*/
+qsizetype QGeoJsonCache::featureCount() const
+{
+    return m_featureCount;
+}
+
+/*
+    The bounding box of the valid coordinates of the feature at \a index, or
+    an invalid rectangle if it has none. It is not adjusted for features that
+    cross the antimeridian, and then covers more longitudes than needed.
+*/
+QGeoRectangle QGeoJsonCache::featureBounds(qsizetype index) const
+{
+    if (index < 0 || index >= qsizetype(m_featureCount))
+        return QGeoRectangle();
+    const uchar *entry = m_data + m_indexOffset + quint64(index) * GeoJsonCacheIndexEntrySize
+            + 2 * sizeof(quint64);
+    const double minLatitude = qFromLittleEndian<double>(entry);
+    const double minLongitude = qFromLittleEndian<double>(entry + sizeof(double));
+    const double maxLatitude = qFromLittleEndian<double>(entry + 2 * sizeof(double));
+    const double maxLongitude = qFromLittleEndian<double>(entry + 3 * sizeof(double));
+    if (!(minLatitude <= maxLatitude && minLongitude <= maxLongitude))
+        return QGeoRectangle();
+    return QGeoRectangle(QGeoCoordinate(maxLatitude, minLongitude),
+                         QGeoCoordinate(minLatitude, maxLongitude));
+}
+
+/*
+    The cached document, structured like the result of
+    QGeoJson::importGeoJson(). Empty if the cache is not open or corrupt.
+*/
+QVariantList QGeoJsonCache::read() const
+{
+    return readDocument(nullptr);
+}
+
+/*
+    The cached document, keeping only the features whose bounding box
+    intersects \a area if the root of the document is a FeatureCollection.
+    The other features are skipped without being decoded.
+*/
+QVariantList QGeoJsonCache::read(const QGeoRectangle &area) const
+{
+    return readDocument(&area);
+}
+
+QVariantList QGeoJsonCache::readDocument(const QGeoRectangle *area) const
+{
+    if (!m_data)
+        return QVariantList();
+
+    QDataStream rootStream(record(m_rootOffset, m_rootSize));
+    prepareStream(rootStream);
+    bool features = false;
+    QVariantMap root = readItem(rootStream, &features);
+    if (rootStream.status() != QDataStream::Ok)
+        return QVariantList();
+
+    if (features) {
+        QVariantList list;
+        for (quint32 i = 0; i < m_featureCount; ++i) {
+            if (area) {
+                const QGeoRectangle bounds = featureBounds(i);
+                if (!bounds.isValid() || !area->intersects(bounds))
+                    continue;
+            }
+            const uchar *entry = m_data + m_indexOffset + quint64(i) * GeoJsonCacheIndexEntrySize;
+            QDataStream featureStream(record(qFromLittleEndian<quint64>(entry),
+                                             qFromLittleEndian<quint64>(entry + sizeof(quint64))));
+            prepareStream(featureStream);
+            const QVariantMap feature = readItem(featureStream);
+            if (featureStream.status() != QDataStream::Ok)
+                return QVariantList();
+            list.append(feature);
+        }
+        root.insert(QStringLiteral("data"), list);
+    }
+    return QVariantList{ root };
+}
+
+// Sets features if the features of the item are in the index
+QVariantMap QGeoJsonCache::readItem(QDataStream &stream, bool *features) const
+{
+    QVariantMap item;
+    quint32 type = 0;
+    quint8 data = NoData;
+    stream >> type >> data;
+    item.insert(QStringLiteral("type"), m_strings.value(type));
+
+    switch (data) {
+    case NoData:
+        break;
+    case FeaturesData:
+        if (features)
+            *features = true;
+        break;
+    case CircleData: {
+        quint32 center = 0;
+        double radius = 0;
+        stream >> center >> radius;
+        QGeoCircle circle;
+        circle.setCenter(coordinate(center));
+        circle.setRadius(radius);
+        item.insert(QStringLiteral("data"), QVariant::fromValue(circle));
+        break;
+    }
+    case PathData: {
+        quint32 first = 0;
+        quint32 count = 0;
+        double width = 0;
+        stream >> first >> count >> width;
+        item.insert(QStringLiteral("data"),
+                    QVariant::fromValue(QGeoPath(coordinates(first, count), width)));
+        break;
+    }
+    case PolygonData: {
+        quint32 rings = 0;
+        stream >> rings;
+        QGeoPolygon polygon;
+        for (quint32 i = 0; i < rings && stream.status() == QDataStream::Ok; ++i) {
+            quint32 first = 0;
+            quint32 count = 0;
+            stream >> first >> count;
+            if (i == 0)
+                polygon.setPerimeter(coordinates(first, count));
+            else
+                polygon.addHole(coordinates(first, count));
+        }
+        item.insert(QStringLiteral("data"), QVariant::fromValue(polygon));
+        break;
+    }
+    case ListData: {
+        quint32 count = 0;
+        stream >> count;
+        QVariantList list;
+        for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+            list.append(readItem(stream));
+        item.insert(QStringLiteral("data"), list);
+        break;
+    }
+    default:
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return item;
+    }
+
+    quint32 members = 0;
+    stream >> members;
+    for (quint32 i = 0; i < members && stream.status() == QDataStream::Ok; ++i) {
+        quint32 key = 0;
+        quint8 kind = VariantMember;
+        stream >> key >> kind;
+        if (kind == PropertiesMember) {
+            quint32 count = 0;
+            stream >> count;
+            QVariantMap properties;
+            for (quint32 j = 0; j < count && stream.status() == QDataStream::Ok; ++j) {
+                quint32 name = 0;
+                QVariant value;
+                stream >> name >> value;
+                properties.insert(m_strings.value(name), value);
+            }
+            item.insert(m_strings.value(key), properties);
+        } else {
+            QVariant value;
+            stream >> value;
+            item.insert(m_strings.value(key), value);
+        }
+    }
+    return item;
+}
+
+QGeoCoordinate QGeoJsonCache::coordinate(quint32 index) const
+{
+    if (index >= m_coordinateCount)
+        return QGeoCoordinate();
+    // The setters keep values that the constructor would reject
+    const uchar *data = m_data + m_coordinatesOffset + quint64(index) * GeoJsonCacheCoordinateSize;
+    QGeoCoordinate coordinate;
+    coordinate.setLatitude(qFromLittleEndian<double>(data));
+    coordinate.setLongitude(qFromLittleEndian<double>(data + sizeof(double)));
+    coordinate.setAltitude(qFromLittleEndian<double>(data + 2 * sizeof(double)));
+    return coordinate;
+}
+
+QList<QGeoCoordinate> QGeoJsonCache::coordinates(quint32 first, quint32 count) const
+{
+    QList<QGeoCoordinate> path;
+    if (quint64(first) + count > m_coordinateCount)
+        return path;
+    path.reserve(count);
+    for (quint32 i = 0; i < count; ++i)
+        path.append(coordinate(first + i));
+    return path;
+}
+
+// An empty array, failing the stream reading it, if out of the records
+QByteArray QGeoJsonCache::record(quint64 offset, quint64 size) const
+{
+    if (offset > m_recordsSize || size > m_recordsSize - offset)
+        return QByteArray();
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(m_data) + m_recordsOffset + offset,
+                                   qsizetype(size));
+}
+
 namespace QGeoJson
 {
 
@@ -1083,6 +2467,107 @@ QVariantList importGeoJson(const QJsonDocument &geoJson)
     return returnedList;
 }
 
+/*!
+This method imports the GeoJSON document in \a data into a QVariantList
+structured like described in the section \l {Importing GeoJSON}, the same way
+as the QJsonDocument overload does.
+
+The document is parsed as it is read and coordinates are written directly into
+the resulting shapes, without a QJsonDocument nor intermediate QVariant values.
+If the document cannot be parsed, an empty list is returned and, if \a
+errorString is not null, it is set to a description of the error.
+
+\since 6.5
+\sa exportGeoJson
+*/
+QVariantList importGeoJson(const QByteArray &data, QString *errorString)
+{
+    GeoJsonReader reader(data);
+    const QVariantList result = reader.read();
+    if (errorString)
+        *errorString = reader.errorString();
+    return result;
+}
+
+/*!
+\overload
+
+This method imports the GeoJSON document read from \a device, which must be
+open. The device is read in chunks, so that the document is never held as a
+whole in memory.
+
+\since 6.5
+*/
+QVariantList importGeoJson(QIODevice *device, QString *errorString)
+{
+    GeoJsonReader reader(device);
+    const QVariantList result = reader.read();
+    if (errorString)
+        *errorString = reader.errorString();
+    return result;
+}
+
+/*!
+This method starts importing the GeoJSON document in \a data on the global
+thread pool, and returns the task doing it, which has \a parent as parent.
+
+The features of a FeatureCollection are converted in parallel. The task
+reports its progress with \c progress(), and emits \c finished() when the
+result is available, unless \c abort() was called before. It deletes itself
+after that. Deleting the task before, for instance with \a parent, aborts it
+and waits for the thread importing the document to stop.
+
+\since 6.5
+\sa importGeoJson
+*/
+QGeoJsonImportTask *importGeoJsonAsync(const QByteArray &data, QObject *parent)
+{
+    QGeoJsonImportTask *task = new QGeoJsonImportTask(data, parent);
+    task->start();
+    return task;
+}
+
+/*!
+This method imports the GeoJSON file \a fileName like importGeoJson() does,
+through the binary cache in \a cacheFile.
+
+If the cache was written from the current content of the file, the document is
+read from it without parsing any JSON. Otherwise the file is imported and the
+cache is written for the next call. If the file cannot be imported, an empty
+list is returned and, if \a errorString is not null, it is set to a
+description of the error.
+
+\since 6.5
+\sa importGeoJson
+*/
+QVariantList importGeoJsonCached(const QString &fileName, const QString &cacheFile,
+                                 QString *errorString)
+{
+    QGeoJsonCache cache;
+    if (cache.open(cacheFile, fileName)) {
+        const QVariantList result = cache.read();
+        if (!result.isEmpty()) {
+            if (errorString)
+                errorString->clear();
+            return result;
+        }
+    }
+    cache.close();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString)
+            *errorString = file.errorString();
+        return QVariantList();
+    }
+    const QVariantList result = importGeoJson(&file, errorString);
+    if (!result.isEmpty()) {
+        QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+        QGeoJsonCache::write(cacheFile, fileName, result);
+    }
+    return result;
+}
+
 /*!
 This method exports the QVariantList \a geoData, expected to be structured like
 described in the section \l {Importing GeoJSON}, to a QJsonDocument containing
@@ -42,8 +42,16 @@
 #define QGEOJSON_H
 
 #include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QFile>
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
 #include <QtCore/QVariantList>
 
+#include <atomic>
+
 //
 //  W A R N I N G
 //  -------------
@@ -57,13 +65,116 @@
 
 QT_BEGIN_NAMESPACE
 
+class QDataStream;
+class QGeoCoordinate;
+class QGeoRectangle;
+class QIODevice;
 class QJsonDocument;
 class QString;
 
+/*
+    Imports a GeoJSON document on a thread pool. The features of a
+    FeatureCollection are converted in parallel, on the same pool.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoJsonImportTask : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    explicit QGeoJsonImportTask(const QByteArray &data, QObject *parent = nullptr);
+    ~QGeoJsonImportTask() override;
+
+    void start(QThreadPool *pool = QThreadPool::globalInstance());
+    void run() override;
+
+    QVariantList result() const;
+    QString errorString() const;
+    bool isAborted() const;
+
+public Q_SLOTS:
+    void abort();
+
+Q_SIGNALS:
+    void progress(qsizetype importedFeatures, qsizetype totalFeatures);
+    void finished();
+
+private:
+    void notifyProgress(qsizetype importedFeatures, qsizetype totalFeatures);
+    void notifyFinished();
+
+    QByteArray m_data;
+    QThreadPool *m_pool = nullptr;
+    QVariantList m_result;
+    QString m_errorString;
+    qsizetype m_reportedFeatures = 0;
+    std::atomic<bool> m_aborted = false;
+    QSemaphore m_runFinished;
+};
+
+/*
+    A compact binary copy of an imported GeoJSON document, memory mapped when
+    read. It is tied to the source file it was imported from, and features can
+    be selected by bounding box without being decoded.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoJsonCache
+{
+public:
+    QGeoJsonCache();
+    ~QGeoJsonCache();
+
+    static bool write(const QString &cacheFile, const QString &sourceFile,
+                      const QVariantList &importedGeoJson);
+
+    bool open(const QString &cacheFile, const QString &sourceFile);
+    void close();
+    bool isOpen() const;
+
+    qsizetype featureCount() const;
+    QGeoRectangle featureBounds(qsizetype index) const;
+    QVariantList read() const;
+    QVariantList read(const QGeoRectangle &area) const;
+
+private:
+    Q_DISABLE_COPY(QGeoJsonCache)
+
+    QVariantList readDocument(const QGeoRectangle *area) const;
+    QVariantMap readItem(QDataStream &stream, bool *features = nullptr) const;
+    QGeoCoordinate coordinate(quint32 index) const;
+    QList<QGeoCoordinate> coordinates(quint32 first, quint32 count) const;
+    QByteArray record(quint64 offset, quint64 size) const;
+
+    QFile m_file;
+    uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    quint32 m_featureCount = 0;
+    quint64 m_coordinateCount = 0;
+    quint64 m_coordinatesOffset = 0;
+    quint64 m_indexOffset = 0;
+    quint64 m_recordsOffset = 0;
+    quint64 m_recordsSize = 0;
+    quint64 m_rootOffset = 0;
+    quint64 m_rootSize = 0;
+    QStringList m_strings;
+};
+
 namespace QGeoJson {
     // This method imports a GeoJSON file to a QVariantList
     Q_LOCATION_PRIVATE_EXPORT QVariantList importGeoJson(const QJsonDocument &doc);
 
+    // These methods import a GeoJSON file to a QVariantList while parsing it
+    Q_LOCATION_PRIVATE_EXPORT QVariantList importGeoJson(const QByteArray &data,
+                                                         QString *errorString = nullptr);
+    Q_LOCATION_PRIVATE_EXPORT QVariantList importGeoJson(QIODevice *device,
+                                                         QString *errorString = nullptr);
+
+    // This method imports a GeoJSON file on a thread pool, see QGeoJsonImportTask
+    Q_LOCATION_PRIVATE_EXPORT QGeoJsonImportTask *importGeoJsonAsync(const QByteArray &data,
+                                                                     QObject *parent = nullptr);
+
+    // This method imports a GeoJSON file through a QGeoJsonCache
+    Q_LOCATION_PRIVATE_EXPORT QVariantList importGeoJsonCached(const QString &fileName,
+                                                               const QString &cacheFile,
+                                                               QString *errorString = nullptr);
+
     // This method exports a GeoJSON file from a QVariantList
     Q_LOCATION_PRIVATE_EXPORT QJsonDocument exportGeoJson(const QVariantList &list);
 
@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeopackedpath_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Refers to \a count points of \a values starting at point \a from,
+    or to all the points after \a from if \a count is negative.
+*/
+QGeoPackedPath::QGeoPackedPath(const QList<double> &values, qsizetype from, qsizetype count)
+    : m_values(values)
+{
+    const qsizetype points = values.size() / 2;
+    m_from = qBound(qsizetype(0), from, points);
+    m_count = (count < 0 || count > points - m_from) ? points - m_from : count;
+}
+
+QGeoPackedPath QGeoPackedPath::mid(qsizetype from, qsizetype count) const
+{
+    from = qBound(qsizetype(0), from, m_count);
+    if (count < 0 || count > m_count - from)
+        count = m_count - from;
+    QGeoPackedPath path;
+    path.m_values = m_values;
+    path.m_from = m_from + from;
+    path.m_count = count;
+    return path;
+}
+
+QList<QGeoCoordinate> QGeoPackedPath::coordinates() const
+{
+    QList<QGeoCoordinate> path;
+    if (!m_count)
+        return path;
+    path.reserve(m_count);
+    const double *values = constData();
+    for (qsizetype i = 0; i < m_count; ++i, values += 2)
+        path.append(QGeoCoordinate(values[0], values[1]));
+    return path;
+}
+
+/*
+    Returns the bounding rectangle of the path like QGeoPath does, unwrapping
+    longitudes along the path so that it can cross the antimeridian.
+*/
+QGeoRectangle QGeoPackedPath::boundingGeoRectangle() const
+{
+    if (!m_count)
+        return QGeoRectangle();
+
+    const double *values = constData();
+    double minLatitude = values[0];
+    double maxLatitude = values[0];
+    double minLongitude = values[1];
+    double maxLongitude = values[1];
+    double x = 0.0;
+    double minX = 0.0;
+    double maxX = 0.0;
+    for (qsizetype i = 1; i < m_count; ++i) {
+        const double latitude = values[2 * i];
+        const double longitude = values[2 * i + 1];
+        double delta = longitude - values[2 * i - 1];
+        if (delta > 180.0)
+            delta -= 360.0;
+        else if (delta < -180.0)
+            delta += 360.0;
+        x += delta;
+        if (x < minX) {
+            minX = x;
+            minLongitude = longitude;
+        } else if (x > maxX) {
+            maxX = x;
+            maxLongitude = longitude;
+        }
+        minLatitude = qMin(minLatitude, latitude);
+        maxLatitude = qMax(maxLatitude, latitude);
+    }
+
+    QGeoRectangle bounds(QGeoCoordinate(maxLatitude, minLongitude),
+                         QGeoCoordinate(minLatitude, maxLongitude));
+    if (maxX - minX >= 360.0)
+        bounds.setWidth(360.0);
+    return bounds;
+}
+
+QGeoPackedPath QGeoPackedPath::fromCoordinates(const QList<QGeoCoordinate> &path)
+{
+    QList<double> values;
+    values.reserve(2 * path.size());
+    for (const QGeoCoordinate &c : path)
+        values << c.latitude() << c.longitude();
+    return QGeoPackedPath(values);
+}
+
+bool operator==(const QGeoPackedPath &lhs, const QGeoPackedPath &rhs)
+{
+    if (lhs.m_count != rhs.m_count)
+        return false;
+    if (lhs.constData() == rhs.constData() || !lhs.m_count)
+        return true;
+    // Same comparison as QGeoCoordinate, so that packed and unpacked paths compare alike
+    for (qsizetype i = 0; i < lhs.m_count; ++i) {
+        if (lhs.at(i) != rhs.at(i))
+            return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOPACKEDPATH_P_H
+#define QGEOPACKEDPATH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QList>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    A range of an implicitly shared, immutable buffer of interleaved latitudes and
+    longitudes. A route owns the buffer, and its legs and segments refer to slices
+    of it, so that every vertex is stored once.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoPackedPath
+{
+public:
+    QGeoPackedPath() = default;
+    explicit QGeoPackedPath(const QList<double> &values, qsizetype from = 0, qsizetype count = -1);
+
+    inline qsizetype size() const { return m_count; }
+    inline bool isEmpty() const { return !m_count; }
+    inline const double *constData() const { return m_values.constData() + 2 * m_from; }
+    inline QGeoCoordinate at(qsizetype i) const
+    {
+        const double *value = constData() + 2 * i;
+        return QGeoCoordinate(value[0], value[1]);
+    }
+
+    QGeoPackedPath mid(qsizetype from, qsizetype count = -1) const;
+    QList<QGeoCoordinate> coordinates() const;
+    QGeoRectangle boundingGeoRectangle() const;
+
+    static QGeoPackedPath fromCoordinates(const QList<QGeoCoordinate> &path);
+
+    friend bool operator==(const QGeoPackedPath &lhs, const QGeoPackedPath &rhs);
+    friend inline bool operator!=(const QGeoPackedPath &lhs, const QGeoPackedPath &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    QList<double> m_values;
+    qsizetype m_from = 0;
+    qsizetype m_count = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOPACKEDPATH_P_H
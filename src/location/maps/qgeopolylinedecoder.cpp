@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeopolylinedecoder_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QGeoPolylineDecoder::QGeoPolylineDecoder(Precision precision)
+    : m_divisor(precision == Polyline5 ? 1e5 : 1e6)
+{
+}
+
+/*
+    Returns how many points \a polyline encodes. Every value ends with a chunk
+    that doesn't have the continuation bit set, and a point is made of two values.
+*/
+qsizetype QGeoPolylineDecoder::pointCount(QByteArrayView polyline)
+{
+    qsizetype values = 0;
+    for (const char c : polyline)
+        values += !((uchar(c) - 63) & 0x20);
+    return values / 2;
+}
+
+/*
+    Appends the points encoded in \a polyline to the buffer, and returns
+    how many were appended. Trailing incomplete data is ignored.
+*/
+qsizetype QGeoPolylineDecoder::decode(QByteArrayView polyline)
+{
+    const qsizetype count = pointCount(polyline);
+    if (!count)
+        return 0;
+
+    const qsizetype first = m_values.size();
+    m_values.resize(first + 2 * count);
+    double *out = m_values.data() + first;
+    double *const end = out + 2 * count;
+
+    // Each polyline restarts from 0, 0
+    qint64 latitude = 0;
+    qint64 longitude = 0;
+    qint64 *current = &latitude;
+    qint64 value = 0;
+    int shift = 0;
+    for (const char ch : polyline) {
+        const uchar c = uchar(ch) - 63;
+        if (shift < 60)
+            value |= qint64(c & 0x1f) << shift;
+        shift += 5;
+        if (c & 0x20) // another chunk
+            continue;
+
+        *current += (value & 1) ? ~(value >> 1) : (value >> 1);
+        value = 0;
+        shift = 0;
+        if (current == &latitude) {
+            current = &longitude;
+        } else {
+            *out++ = double(latitude) / m_divisor;
+            *out++ = double(longitude) / m_divisor;
+            if (out == end)
+                break;
+            current = &latitude;
+        }
+    }
+    return count;
+}
+
+void QGeoPolylineDecoder::clear()
+{
+    m_values.clear();
+}
+
+/*
+    Creates the coordinates of \a count points starting at \a from,
+    or of all the points after \a from if \a count is negative.
+*/
+QList<QGeoCoordinate> QGeoPolylineDecoder::coordinates(qsizetype from, qsizetype count) const
+{
+    return path(from, count).coordinates();
+}
+
+/*
+    Shares the buffer with the returned path. Decoding more polylines
+    afterwards detaches, so decode everything first.
+*/
+QGeoPackedPath QGeoPolylineDecoder::path(qsizetype from, qsizetype count) const
+{
+    return QGeoPackedPath(m_values, from, count);
+}
+
+QList<QGeoCoordinate> QGeoPolylineDecoder::decodeCoordinates(QByteArrayView polyline, Precision precision)
+{
+    QGeoPolylineDecoder decoder(precision);
+    decoder.decode(polyline);
+    return decoder.coordinates();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOPOLYLINEDECODER_P_H
+#define QGEOPOLYLINEDECODER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qgeopackedpath_p.h>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+#include <QtPositioning/QGeoCoordinate>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Decodes encoded polylines, as used by OSRM and Mapbox, into a contiguous buffer of
+    interleaved latitudes and longitudes. Several polylines can be decoded in sequence,
+    for instance all the steps of a route, and QGeoCoordinates are only created for the
+    ranges of points that are asked for.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoPolylineDecoder
+{
+public:
+    enum Precision {
+        Polyline5 = 5, // "polyline", 1e5
+        Polyline6 = 6  // "polyline6", 1e6
+    };
+
+    explicit QGeoPolylineDecoder(Precision precision = Polyline6);
+
+    qsizetype decode(QByteArrayView polyline);
+    void clear();
+
+    inline qsizetype size() const { return m_values.size() / 2; }
+    inline bool isEmpty() const { return m_values.isEmpty(); }
+    inline const double *constData() const { return m_values.constData(); }
+    inline QGeoCoordinate at(qsizetype i) const
+    {
+        return QGeoCoordinate(m_values.at(2 * i), m_values.at(2 * i + 1));
+    }
+
+    QList<QGeoCoordinate> coordinates(qsizetype from = 0, qsizetype count = -1) const;
+    QGeoPackedPath path(qsizetype from = 0, qsizetype count = -1) const;
+
+    static qsizetype pointCount(QByteArrayView polyline);
+    static QList<QGeoCoordinate> decodeCoordinates(QByteArrayView polyline, Precision precision = Polyline6);
+
+private:
+    QList<double> m_values;
+    double m_divisor;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOPOLYLINEDECODER_P_H
@@ -429,6 +429,143 @@ QGeoCoordinate QGeoProjectionWebMercator::wrappedMapProjectionToGeo(const QDoubl
     return mapProjectionToGeo(unwrapMapProjection(wrappedProjection));
 }
 
+/*
+    Batched projection.
+
+    The camera dependent terms (the 2D part of m_transformation, the wrap
+    direction, the near plane and the viewport bounds) are read once per call
+    instead of once per point. The loops are not vectorized: the loops over
+    coordinates call QWebMercator::coordToMercator(), which uses log and tan.
+    The results are the same as those of the per-point functions.
+*/
+namespace {
+struct MapToItemTransform
+{
+    explicit MapToItemTransform(const QDoubleMatrix4x4 &m)
+        : m00(m(0,0)), m01(m(0,1)), m03(m(0,3)),
+          m10(m(1,0)), m11(m(1,1)), m13(m(1,3)),
+          m30(m(3,0)), m31(m(3,1)), m33(m(3,3))
+    {
+    }
+
+    // m_transformation applied to (x, y, 0, 1). Dividing by w == 1 is exact,
+    // so unlike QDoubleMatrix4x4 there is no need to test for it.
+    inline QDoubleVector2D map(double x, double y) const
+    {
+        const double w = x * m30 + y * m31 + m33;
+        return QDoubleVector2D((x * m00 + y * m01 + m03) / w,
+                               (x * m10 + y * m11 + m13) / w);
+    }
+
+    double m00, m01, m03;
+    double m10, m11, m13;
+    double m30, m31, m33;
+};
+}
+
+void QGeoProjectionWebMercator::geoToMapProjection(const QGeoCoordinate *coordinates,
+                                                   QDoubleVector2D *projections,
+                                                   qsizetype count) const
+{
+    for (qsizetype i = 0; i < count; ++i)
+        projections[i] = QWebMercator::coordToMercator(coordinates[i]);
+}
+
+void QGeoProjectionWebMercator::wrappedMapProjectionToItemPosition(const QDoubleVector2D *wrappedProjections,
+                                                                   QDoubleVector2D *itemPositions,
+                                                                   qsizetype count) const
+{
+    const MapToItemTransform transform(m_transformation);
+    for (qsizetype i = 0; i < count; ++i)
+        itemPositions[i] = transform.map(wrappedProjections[i].x(), wrappedProjections[i].y());
+}
+
+void QGeoProjectionWebMercator::coordinateToItemPosition(const QGeoCoordinate *coordinates,
+                                                         QDoubleVector2D *itemPositions,
+                                                         qsizetype count, bool clipToViewport) const
+{
+    const MapToItemTransform transform(m_transformation);
+    const QDoubleVector2D invalid(qQNaN(), qQNaN());
+
+    // projectionWrapFactor(), as an offset applied past a threshold
+    const double centerX = m_cameraCenterXMercator;
+    double wrapThreshold = qInf();
+    double wrapOffset = 0.0;
+    if (centerX < 0.5) {
+        wrapThreshold = 0.5;
+        wrapOffset = -1.0;
+    } else if (centerX > 0.5) {
+        wrapThreshold = -0.5;
+        wrapOffset = 1.0;
+    }
+
+    // isProjectable(), with the z term of the dot product hoisted
+    const bool tilted = m_cameraData.tilt() != 0.0;
+    const double nearPlaneDotZ = m_centerNearPlane.z() * m_viewNormalized.z();
+
+    const int w = m_viewportWidth;
+    const int h = m_viewportHeight;
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const QGeoCoordinate &coordinate = coordinates[i];
+        if (!coordinate.isValid()) {
+            itemPositions[i] = invalid;
+            continue;
+        }
+
+        const QDoubleVector2D projection = QWebMercator::coordToMercator(coordinate);
+        double x = projection.x();
+        const double y = projection.y();
+        const double dx = x - centerX;
+        if ((wrapOffset < 0.0 && dx > wrapThreshold) || (wrapOffset > 0.0 && dx < wrapThreshold))
+            x += wrapOffset;
+
+        if (tilted) {
+            const double px = m_centerNearPlane.x() - x * m_sideLengthPixels;
+            const double py = m_centerNearPlane.y() - y * m_sideLengthPixels;
+            if (px * m_viewNormalized.x() + py * m_viewNormalized.y() + nearPlaneDotZ < 0.0) {
+                itemPositions[i] = invalid;
+                continue;
+            }
+        }
+
+        const QDoubleVector2D pos = transform.map(x, y);
+        if (clipToViewport) {
+            const double px = pos.x();
+            const double py = pos.y();
+            if ((px < -0.5) || (px > w + 0.5) || (py < -0.5) || (py > h + 0.5) || qIsNaN(px) || qIsNaN(py)) {
+                itemPositions[i] = invalid;
+                continue;
+            }
+        }
+        itemPositions[i] = pos;
+    }
+}
+
+QList<QDoubleVector2D> QGeoProjectionWebMercator::geoToMapProjection(const QList<QGeoCoordinate> &coordinates) const
+{
+    QList<QDoubleVector2D> projections(coordinates.size());
+    geoToMapProjection(coordinates.constData(), projections.data(), coordinates.size());
+    return projections;
+}
+
+QList<QDoubleVector2D> QGeoProjectionWebMercator::wrappedMapProjectionToItemPosition(const QList<QDoubleVector2D> &wrappedProjections) const
+{
+    QList<QDoubleVector2D> itemPositions(wrappedProjections.size());
+    wrappedMapProjectionToItemPosition(wrappedProjections.constData(), itemPositions.data(),
+                                       wrappedProjections.size());
+    return itemPositions;
+}
+
+QList<QDoubleVector2D> QGeoProjectionWebMercator::coordinateToItemPosition(const QList<QGeoCoordinate> &coordinates,
+                                                                           bool clipToViewport) const
+{
+    QList<QDoubleVector2D> itemPositions(coordinates.size());
+    coordinateToItemPosition(coordinates.constData(), itemPositions.data(), coordinates.size(),
+                             clipToViewport);
+    return itemPositions;
+}
+
 QMatrix4x4 QGeoProjectionWebMercator::quickItemTransformation(const QGeoCoordinate &coordinate, const QPointF &anchorPoint, qreal zoomLevel) const
 {
     const QDoubleVector2D coordWrapped = geoToWrappedMapProjection(coordinate);
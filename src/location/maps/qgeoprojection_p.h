@@ -177,6 +177,21 @@ public:
 
     QDoubleVector2D geoToWrappedMapProjection(const QGeoCoordinate &coordinate) const;
     QGeoCoordinate wrappedMapProjectionToGeo(const QDoubleVector2D &wrappedProjection) const;
+
+    // Batched variants of the above, projecting count points in a single pass.
+    // Only wrappedMapProjectionToItemPosition() accepts the input buffer as the
+    // output buffer. The others take coordinates and need a separate buffer.
+    void geoToMapProjection(const QGeoCoordinate *coordinates, QDoubleVector2D *projections,
+                            qsizetype count) const;
+    void wrappedMapProjectionToItemPosition(const QDoubleVector2D *wrappedProjections,
+                                            QDoubleVector2D *itemPositions, qsizetype count) const;
+    void coordinateToItemPosition(const QGeoCoordinate *coordinates, QDoubleVector2D *itemPositions,
+                                  qsizetype count, bool clipToViewport = true) const;
+    QList<QDoubleVector2D> geoToMapProjection(const QList<QGeoCoordinate> &coordinates) const;
+    QList<QDoubleVector2D> wrappedMapProjectionToItemPosition(const QList<QDoubleVector2D> &wrappedProjections) const;
+    QList<QDoubleVector2D> coordinateToItemPosition(const QList<QGeoCoordinate> &coordinates,
+                                                    bool clipToViewport = true) const;
+
     QMatrix4x4 quickItemTransformation(const QGeoCoordinate &coordinate, const QPointF &anchorPoint, qreal zoomLevel) const;
 
     bool isProjectable(const QDoubleVector2D &wrappedProjection) const;
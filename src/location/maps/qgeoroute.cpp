@@ -369,6 +369,11 @@ QGeoRoute QGeoRoute::overallRoute() const
 /*******************************************************************************
 *******************************************************************************/
 
+QGeoRoutePrivate *QGeoRoutePrivate::get(QGeoRoute &route)
+{
+    return route.d_ptr.data();
+}
+
 bool QGeoRoutePrivate::operator ==(const QGeoRoutePrivate &other) const
 {
     return equals(other);
@@ -397,7 +402,7 @@ bool QGeoRoutePrivate::equals(const QGeoRoutePrivate &other) const
         && travelTime() == other.travelTime()
         && distance() == other.distance()
         && travelMode() == other.travelMode()
-        && path() == other.path()
+        && samePath(other)
         && routeLegs() == other.routeLegs()
         && extendedAttributes() == other.extendedAttributes();
 }
@@ -465,11 +470,38 @@ QGeoRouteRequest::TravelMode QGeoRoutePrivate::travelMode() const
 void QGeoRoutePrivate::setPath(const QList<QGeoCoordinate> &path)
 {
     m_path = path;
+    m_packedPath = QGeoPackedPath();
 }
 
 QList<QGeoCoordinate> QGeoRoutePrivate::path() const
 {
-    return m_path;
+    return m_packedPath.isEmpty() ? m_path : m_packedPath.coordinates();
+}
+
+/*
+    Parsers store the route path once, and the legs and segments refer to
+    ranges of it. path() creates the coordinates each time it is called, they
+    are not kept.
+*/
+void QGeoRoutePrivate::setPackedPath(const QGeoPackedPath &path)
+{
+    m_packedPath = path;
+    m_path.clear();
+}
+
+QGeoPackedPath QGeoRoutePrivate::packedPath() const
+{
+    return m_packedPath.isEmpty() ? QGeoPackedPath::fromCoordinates(m_path) : m_packedPath;
+}
+
+// Packed paths are compared without creating their coordinates
+bool QGeoRoutePrivate::samePath(const QGeoRoutePrivate &other) const
+{
+    if (!m_packedPath.isEmpty() && !other.m_packedPath.isEmpty())
+        return m_packedPath == other.m_packedPath;
+    if (m_packedPath.isEmpty() && other.m_packedPath.isEmpty())
+        return m_path == other.m_path;
+    return path() == other.path();
 }
 
 void QGeoRoutePrivate::setFirstSegment(const QGeoRouteSegment &firstSegment)
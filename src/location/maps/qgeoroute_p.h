@@ -56,6 +56,7 @@
 #include "qgeorouterequest.h"
 #include "qgeorectangle.h"
 #include "qgeoroutesegment.h"
+#include "qgeopackedpath_p.h"
 
 #include <QSharedData>
 #include <QVariantMap>
@@ -68,6 +69,8 @@ class QGeoCoordinate;
 class Q_LOCATION_PRIVATE_EXPORT QGeoRoutePrivate : public QSharedData
 {
 public:
+    static QGeoRoutePrivate *get(QGeoRoute &route);
+
     bool operator==(const QGeoRoutePrivate &other) const;
     bool equals(const QGeoRoutePrivate &other) const;
 
@@ -91,6 +94,9 @@ public:
 
     void setPath(const QList<QGeoCoordinate> &path);
     QList<QGeoCoordinate> path() const;
+    void setPackedPath(const QGeoPackedPath &path);
+    QGeoPackedPath packedPath() const;
+    bool samePath(const QGeoRoutePrivate &other) const;
 
     void setFirstSegment(const QGeoRouteSegment &firstSegment);
     QGeoRouteSegment firstSegment() const;
@@ -133,7 +139,8 @@ private:
 
     QGeoRouteRequest::TravelMode m_travelMode;
 
-    QList<QGeoCoordinate> m_path;
+    QList<QGeoCoordinate> m_path; // empty when m_packedPath is set
+    QGeoPackedPath m_packedPath; // used instead of m_path when set by a parser
     QList<QGeoRoute> m_legs;
     QGeoRouteSegment m_firstSegment;
     mutable int m_numSegments = -1;
@@ -0,0 +1,603 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeoroutecache_p.h"
+#include "qgeoroute_p.h"
+#include "qgeoroutesegment_p.h"
+#include "qgeoroutingmanagerengine.h"
+#include "qgeomaneuver.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtPositioning/QGeoRectangle>
+
+#include <algorithm>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const quint32 diskMagic = 0x51475243; // "QGRC"
+const quint32 diskVersion = 1;
+
+// The expiry of a stored entry, 0 if the file is not one
+qint64 diskExpiry(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 expiry = 0;
+    in >> magic >> version >> expiry;
+    return magic == diskMagic && version == diskVersion ? expiry : 0;
+}
+
+void writePackedPath(QDataStream &out, const QGeoPackedPath &path)
+{
+    out << qint64(path.size());
+    const double *values = path.constData();
+    for (qsizetype i = 0; i < 2 * path.size(); ++i)
+        out << values[i];
+}
+
+QGeoPackedPath readPackedPath(QDataStream &in)
+{
+    qint64 size = 0;
+    in >> size;
+    if (size < 0 || in.status() != QDataStream::Ok)
+        return QGeoPackedPath();
+    QList<double> values;
+    values.reserve(2 * size);
+    for (qint64 i = 0; i < 2 * size && in.status() == QDataStream::Ok; ++i) {
+        double value;
+        in >> value;
+        values << value;
+    }
+    return QGeoPackedPath(values);
+}
+
+void writeSegment(QDataStream &out, QGeoRouteSegment segment)
+{
+    const QGeoManeuver maneuver = segment.maneuver();
+    out << segment.travelTime() << segment.distance() << segment.isLegLastSegment();
+    writePackedPath(out, QGeoRouteSegmentPrivate::get(segment)->packedPath());
+    out << maneuver.isValid();
+    if (maneuver.isValid()) {
+        out << maneuver.position() << maneuver.instructionText() << int(maneuver.direction())
+            << maneuver.timeToNextInstruction() << maneuver.distanceToNextInstruction()
+            << maneuver.waypoint() << maneuver.extendedAttributes();
+    }
+}
+
+QGeoRouteSegment readSegment(QDataStream &in)
+{
+    int travelTime;
+    qreal distance;
+    bool legLastSegment;
+    in >> travelTime >> distance >> legLastSegment;
+
+    QGeoRouteSegment segment;
+    segment.setTravelTime(travelTime);
+    segment.setDistance(distance);
+    QGeoRouteSegmentPrivate *segmentPrivate = QGeoRouteSegmentPrivate::get(segment);
+    segmentPrivate->setPackedPath(readPackedPath(in));
+    segmentPrivate->setLegLastSegment(legLastSegment);
+
+    bool hasManeuver;
+    in >> hasManeuver;
+    if (hasManeuver) {
+        QGeoCoordinate position;
+        QString instructionText;
+        int direction;
+        int timeToNextInstruction;
+        qreal distanceToNextInstruction;
+        QGeoCoordinate waypoint;
+        QVariantMap extendedAttributes;
+        in >> position >> instructionText >> direction >> timeToNextInstruction
+           >> distanceToNextInstruction >> waypoint >> extendedAttributes;
+
+        QGeoManeuver maneuver;
+        maneuver.setPosition(position);
+        maneuver.setInstructionText(instructionText);
+        maneuver.setDirection(QGeoManeuver::InstructionDirection(direction));
+        maneuver.setTimeToNextInstruction(timeToNextInstruction);
+        maneuver.setDistanceToNextInstruction(distanceToNextInstruction);
+        maneuver.setWaypoint(waypoint);
+        maneuver.setExtendedAttributes(extendedAttributes);
+        segment.setManeuver(maneuver);
+    }
+    return segment;
+}
+
+void writeRoute(QDataStream &out, QGeoRoute route)
+{
+    out << route.routeId() << QGeoShape(route.bounds()) << route.travelTime() << route.distance()
+        << int(route.travelMode()) << route.extendedAttributes();
+    writePackedPath(out, QGeoRoutePrivate::get(route)->packedPath());
+
+    // Segments are written once, legs refer to their first one by index
+    QHash<const QGeoRouteSegmentPrivate *, int> segmentIndexes;
+    QList<QGeoRouteSegment> segments;
+    for (QGeoRouteSegment s = route.firstRouteSegment(); s.isValid(); s = s.nextRouteSegment()) {
+        segmentIndexes.insert(QGeoRouteSegmentPrivate::get(s), int(segments.size()));
+        segments << s;
+    }
+    out << qint32(segments.size());
+    for (const QGeoRouteSegment &s : std::as_const(segments))
+        writeSegment(out, s);
+
+    const QList<QGeoRoute> legs = route.routeLegs();
+    out << qint32(legs.size());
+    for (QGeoRoute leg : legs) {
+        QGeoRouteSegment first = leg.firstRouteSegment();
+        out << leg.legIndex() << leg.travelTime() << leg.distance() << leg.extendedAttributes()
+            << segmentIndexes.value(QGeoRouteSegmentPrivate::get(first), -1);
+        writePackedPath(out, QGeoRoutePrivate::get(leg)->packedPath());
+    }
+}
+
+QGeoRoute readRoute(QDataStream &in)
+{
+    QString id;
+    QGeoShape bounds;
+    int travelTime;
+    qreal distance;
+    int travelMode;
+    QVariantMap extendedAttributes;
+    in >> id >> bounds >> travelTime >> distance >> travelMode >> extendedAttributes;
+
+    QGeoRoute route;
+    route.setRouteId(id);
+    route.setBounds(QGeoRectangle(bounds));
+    route.setTravelTime(travelTime);
+    route.setDistance(distance);
+    route.setTravelMode(QGeoRouteRequest::TravelMode(travelMode));
+    route.setExtendedAttributes(extendedAttributes);
+    QGeoRoutePrivate::get(route)->setPackedPath(readPackedPath(in));
+
+    qint32 segmentCount = 0;
+    in >> segmentCount;
+    QList<QGeoRouteSegment> segments;
+    for (qint32 i = 0; i < segmentCount && in.status() == QDataStream::Ok; ++i)
+        segments << readSegment(in);
+    for (qsizetype i = segments.size() - 1; i > 0; --i)
+        segments[i - 1].setNextRouteSegment(segments[i]);
+    if (!segments.isEmpty())
+        route.setFirstRouteSegment(segments.first());
+
+    qint32 legCount = 0;
+    in >> legCount;
+    QList<QGeoRoute> legs;
+    for (qint32 i = 0; i < legCount && in.status() == QDataStream::Ok; ++i) {
+        int legIndex;
+        int legTravelTime;
+        qreal legDistance;
+        QVariantMap legAttributes;
+        int firstSegment;
+        in >> legIndex >> legTravelTime >> legDistance >> legAttributes >> firstSegment;
+
+        QGeoRoute leg;
+        leg.setLegIndex(legIndex);
+        leg.setOverallRoute(route);
+        leg.setTravelTime(legTravelTime);
+        leg.setDistance(legDistance);
+        leg.setExtendedAttributes(legAttributes);
+        QGeoRoutePrivate::get(leg)->setPackedPath(readPackedPath(in));
+        if (firstSegment >= 0 && firstSegment < segments.size())
+            leg.setFirstRouteSegment(segments.at(firstSegment));
+        legs << leg;
+    }
+    route.setRouteLegs(legs);
+    return route;
+}
+
+/*
+    QGeoRoute and QGeoRouteSegment are explicitly shared, so the routes kept by
+    the cache and the ones handed out are copied through the setters: a route
+    changed by one user must not change the cache or another reply.
+*/
+QGeoRouteSegment detachSegment(QGeoRouteSegment segment)
+{
+    QGeoRouteSegment copy;
+    copy.setTravelTime(segment.travelTime());
+    copy.setDistance(segment.distance());
+    copy.setManeuver(segment.maneuver());
+    QGeoRouteSegmentPrivate *segmentPrivate = QGeoRouteSegmentPrivate::get(segment);
+    QGeoRouteSegmentPrivate *copyPrivate = QGeoRouteSegmentPrivate::get(copy);
+    copyPrivate->setPackedPath(segmentPrivate->packedPath());
+    copyPrivate->setLegLastSegment(segmentPrivate->isLegLastSegment());
+    return copy;
+}
+
+// Copies the chain starting at first, reusing the segments already copied
+QGeoRouteSegment detachSegments(QGeoRouteSegment first,
+                                QHash<const QGeoRouteSegmentPrivate *, QGeoRouteSegment> *copies)
+{
+    QGeoRouteSegment head;
+    QGeoRouteSegment previous;
+    for (QGeoRouteSegment s = first; s.isValid(); s = s.nextRouteSegment()) {
+        const QGeoRouteSegmentPrivate *key = QGeoRouteSegmentPrivate::get(s);
+        const auto it = copies->constFind(key);
+        const bool copied = it != copies->cend();
+        QGeoRouteSegment segment = copied ? *it : detachSegment(s);
+        if (!copied)
+            copies->insert(key, segment);
+        if (previous.isValid())
+            previous.setNextRouteSegment(segment);
+        else
+            head = segment;
+        if (copied)
+            break;
+        previous = segment;
+    }
+    return head;
+}
+
+void detachRouteData(QGeoRoute &copy, QGeoRoute route, const QGeoRouteRequest &request)
+{
+    copy.setRouteId(route.routeId());
+    copy.setRequest(request);
+    copy.setBounds(route.bounds());
+    copy.setTravelTime(route.travelTime());
+    copy.setDistance(route.distance());
+    copy.setTravelMode(route.travelMode());
+    copy.setExtendedAttributes(route.extendedAttributes());
+    QGeoRoutePrivate::get(copy)->setPackedPath(QGeoRoutePrivate::get(route)->packedPath());
+}
+
+QGeoRoute detachRoute(QGeoRoute route, const QGeoRouteRequest &request)
+{
+    QHash<const QGeoRouteSegmentPrivate *, QGeoRouteSegment> copies;
+
+    QGeoRoute copy;
+    detachRouteData(copy, route, request);
+    const QGeoRouteSegment first = detachSegments(route.firstRouteSegment(), &copies);
+    if (first.isValid())
+        copy.setFirstRouteSegment(first);
+
+    const QList<QGeoRoute> legs = route.routeLegs();
+    QList<QGeoRoute> legCopies;
+    legCopies.reserve(legs.size());
+    for (QGeoRoute leg : legs) {
+        QGeoRoute legCopy;
+        detachRouteData(legCopy, leg, request);
+        legCopy.setLegIndex(leg.legIndex());
+        legCopy.setOverallRoute(copy);
+        const QGeoRouteSegment legFirst = detachSegments(leg.firstRouteSegment(), &copies);
+        if (legFirst.isValid())
+            legCopy.setFirstRouteSegment(legFirst);
+        legCopies << legCopy;
+    }
+    copy.setRouteLegs(legCopies);
+    return copy;
+}
+
+QList<QGeoRoute> detachRoutes(const QList<QGeoRoute> &routes, const QGeoRouteRequest &request)
+{
+    QList<QGeoRoute> copies;
+    copies.reserve(routes.size());
+    for (const QGeoRoute &route : routes)
+        copies << detachRoute(route, request);
+    return copies;
+}
+
+} // namespace
+
+QGeoRouteCacheReply::QGeoRouteCacheReply(const QGeoRouteRequest &request, QObject *parent)
+    : QGeoRouteReply(request, parent)
+{
+}
+
+void QGeoRouteCacheReply::abort()
+{
+    m_follower.abort(this);
+    QGeoRouteReply::abort();
+}
+
+/*
+    See the QGeoRoutingManagerEngine documentation for the routing.cache parameters.
+*/
+QGeoRouteCache::QGeoRouteCache(QGeoRoutingManagerEngine *engine, const QVariantMap &parameters)
+    : QObject(engine), m_engine(engine),
+      m_requests(this, &QGeoRouteCache::result,
+                 [this](const QByteArray &key, Entry *entry) { return find(key, entry); },
+                 [this](const QByteArray &key, const Entry &entry) { insert(key, entry); },
+                 [this](const QByteArray &key) { remove(key); },
+                 [this](QGeoRouteCacheReply *reply, const Entry &entry) { finish(reply, entry); })
+{
+    m_entries.setMaxCost(qMax(1, parameters.value(QStringLiteral("routing.cache.size")).toInt()));
+    if (parameters.contains(QStringLiteral("routing.cache.ttl")))
+        m_ttl = qMax(0, parameters.value(QStringLiteral("routing.cache.ttl")).toInt()) * qint64(1000);
+    if (parameters.contains(QStringLiteral("routing.cache.precision"))) {
+        const int decimals = qBound(0, parameters.value(QStringLiteral("routing.cache.precision")).toInt(), 9);
+        m_precision = std::pow(10.0, decimals);
+    }
+    if (parameters.contains(QStringLiteral("routing.cache.disk.size")))
+        m_diskSizeLimit = qMax(0, parameters.value(QStringLiteral("routing.cache.disk.size")).toInt());
+    m_directory = parameters.value(QStringLiteral("routing.cache.directory")).toString();
+    if (!m_directory.isEmpty() && !QDir::root().mkpath(m_directory)) {
+        qWarning("Cannot create route cache directory %s", qPrintable(m_directory));
+        m_directory.clear();
+    }
+    // Drops what expired since the last run, and measures the stored entries
+    scheduleDiskSweep();
+}
+
+QGeoRouteCache::~QGeoRouteCache() = default;
+
+bool QGeoRouteCache::isEnabled(const QVariantMap &parameters)
+{
+    return parameters.value(QStringLiteral("routing.cache.size")).toInt() > 0;
+}
+
+QGeoRouteReply *QGeoRouteCache::calculateRoute(const QGeoRouteRequest &request)
+{
+    return m_requests.request(requestKey(request), [this, request]() {
+        return m_engine->calculateRoute(request);
+    }, [this, request]() {
+        return new QGeoRouteCacheReply(request, m_engine);
+    });
+}
+
+/*
+    The key covers everything that changes the answer of the service: the request,
+    with waypoints rounded to the configured precision, and the engine settings.
+*/
+QByteArray QGeoRouteCache::requestKey(const QGeoRouteRequest &request) const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_5);
+
+    out << m_engine->managerName() << m_engine->managerVersion()
+        << m_engine->locale().name() << int(m_engine->measurementSystem());
+
+    const QList<QGeoCoordinate> waypoints = request.waypoints();
+    out << qint32(waypoints.size());
+    for (const QGeoCoordinate &c : waypoints) {
+        out << qint64(std::round(c.latitude() * m_precision))
+            << qint64(std::round(c.longitude() * m_precision));
+    }
+    out << request.waypointsMetadata();
+
+    const QList<QGeoRectangle> excludeAreas = request.excludeAreas();
+    out << qint32(excludeAreas.size());
+    for (const QGeoRectangle &area : excludeAreas)
+        out << QGeoShape(area);
+
+    QList<QGeoRouteRequest::FeatureType> featureTypes = request.featureTypes();
+    std::sort(featureTypes.begin(), featureTypes.end());
+    out << qint32(featureTypes.size());
+    for (QGeoRouteRequest::FeatureType type : std::as_const(featureTypes))
+        out << int(type) << int(request.featureWeight(type));
+
+    out << request.numberAlternativeRoutes() << int(request.travelModes())
+        << int(request.routeOptimization()) << int(request.segmentDetail())
+        << int(request.maneuverDetail()) << request.departureTime()
+        << request.extraParameters();
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+/*
+    Routes read back from disk get the request they are reused for when they
+    are handed out, it is not stored.
+*/
+bool QGeoRouteCache::find(const QByteArray &key, Entry *entry)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (const Entry *cached = m_entries.object(key)) {
+        if (cached->expiry > now) {
+            *entry = *cached;
+            return true;
+        }
+        m_entries.remove(key);
+    }
+
+    if (m_directory.isEmpty() || !readDiskEntry(key, entry))
+        return false;
+    if (entry->expiry <= now) {
+        QFile::remove(diskFileName(key));
+        return false;
+    }
+    m_entries.insert(key, new Entry(*entry));
+    return true;
+}
+
+void QGeoRouteCache::insert(const QByteArray &key, const Entry &entry)
+{
+    if (entry.error != QGeoRouteReply::NoError || entry.routes.isEmpty() || m_ttl <= 0)
+        return;
+
+    Entry *cached = new Entry(entry);
+    cached->expiry = QDateTime::currentMSecsSinceEpoch() + m_ttl;
+    if (!m_directory.isEmpty())
+        writeDiskEntry(key, *cached);
+    m_entries.insert(key, cached);
+}
+
+void QGeoRouteCache::remove(const QByteArray &key)
+{
+    m_entries.remove(key);
+    if (!m_directory.isEmpty())
+        QFile::remove(diskFileName(key));
+}
+
+void QGeoRouteCache::clear()
+{
+    m_entries.clear();
+    if (m_directory.isEmpty())
+        return;
+    QDir dir(m_directory);
+    const QStringList files = dir.entryList({ QStringLiteral("*.route") }, QDir::Files);
+    for (const QString &file : files)
+        dir.remove(file);
+    m_diskSize = 0;
+}
+
+qsizetype QGeoRouteCache::size() const
+{
+    return m_entries.size();
+}
+
+qsizetype QGeoRouteCache::inFlightCount() const
+{
+    return m_requests.inFlightCount();
+}
+
+// The routes of the reply may still be changed by its owner
+QGeoRouteCache::Entry QGeoRouteCache::result(const QGeoRouteReply *reply)
+{
+    Entry entry;
+    entry.error = reply->error();
+    entry.errorString = reply->errorString();
+    entry.routes = detachRoutes(reply->routes(), QGeoRouteRequest());
+    return entry;
+}
+
+void QGeoRouteCache::finish(QGeoRouteCacheReply *reply, const Entry &entry)
+{
+    if (entry.error != QGeoRouteReply::NoError) {
+        reply->setError(entry.error, entry.errorString);
+        emit m_engine->errorOccurred(reply, entry.error, entry.errorString);
+        return;
+    }
+
+    reply->setRoutes(detachRoutes(entry.routes, reply->request()));
+    reply->setFinished(true);
+    emit m_engine->finished(reply);
+}
+
+QString QGeoRouteCache::diskFileName(const QByteArray &key) const
+{
+    return m_directory + QLatin1Char('/') + QString::fromLatin1(key.toHex()) + QStringLiteral(".route");
+}
+
+bool QGeoRouteCache::readDiskEntry(const QByteArray &key, Entry *entry) const
+{
+    QFile file(diskFileName(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+    in >> magic >> version >> entry->expiry >> count;
+    if (magic != diskMagic || version != diskVersion || count < 0)
+        return false;
+
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i)
+        entry->routes << readRoute(in);
+    return in.status() == QDataStream::Ok;
+}
+
+void QGeoRouteCache::writeDiskEntry(const QByteArray &key, const Entry &entry)
+{
+    QSaveFile file(diskFileName(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << diskMagic << diskVersion << entry.expiry << qint32(entry.routes.size());
+    for (const QGeoRoute &route : entry.routes)
+        writeRoute(out, route);
+
+    if (out.status() != QDataStream::Ok)
+        return;
+    const qint64 written = file.size();
+    if (!file.commit())
+        return;
+    m_diskSize += written;
+    if (m_diskSize > m_diskSizeLimit)
+        scheduleDiskSweep();
+}
+
+void QGeoRouteCache::scheduleDiskSweep()
+{
+    if (m_directory.isEmpty() || m_diskSweepScheduled)
+        return;
+    m_diskSweepScheduled = true;
+    QMetaObject::invokeMethod(this, &QGeoRouteCache::sweepDisk, Qt::QueuedConnection);
+}
+
+/*
+    Removes the expired files. If the others exceed routing.cache.disk.size,
+    the least recently written ones are removed until they fill three quarters of it.
+*/
+void QGeoRouteCache::sweepDisk()
+{
+    m_diskSweepScheduled = false;
+    QDir dir(m_directory);
+    // Most recently written first
+    QFileInfoList files = dir.entryInfoList({ QStringLiteral("*.route") }, QDir::Files, QDir::Time);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 size = 0;
+    for (auto it = files.begin(); it != files.end();) {
+        if (diskExpiry(it->filePath()) <= now) {
+            dir.remove(it->fileName());
+            it = files.erase(it);
+        } else {
+            size += it->size();
+            ++it;
+        }
+    }
+
+    if (size > m_diskSizeLimit) {
+        const qint64 target = m_diskSizeLimit - m_diskSizeLimit / 4;
+        while (size > target && !files.isEmpty()) {
+            const QFileInfo oldest = files.takeLast();
+            dir.remove(oldest.fileName());
+            size -= oldest.size();
+        }
+    }
+    m_diskSize = size;
+}
+
+QT_END_NAMESPACE
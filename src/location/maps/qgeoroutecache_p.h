@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOROUTECACHE_P_H
+#define QGEOROUTECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qlocationcacherequests_p.h>
+#include <QtLocation/QGeoRouteReply>
+#include <QtLocation/QGeoRouteRequest>
+#include <QtCore/QCache>
+#include <QtCore/QObject>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRoutingManagerEngine;
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoRouteCacheReply : public QGeoRouteReply
+{
+    Q_OBJECT
+public:
+    explicit QGeoRouteCacheReply(const QGeoRouteRequest &request, QObject *parent = nullptr);
+
+    void abort() override;
+
+private:
+    QLocationCacheFollower<QGeoRouteReply> m_follower;
+
+    friend class QGeoRouteCache;
+    template <typename, typename, typename>
+    friend class QLocationCacheRequests;
+};
+
+/*
+    Remembers the routes calculated by an engine for a request, in memory and
+    optionally on disk, and lets identical requests in flight share one reply.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoRouteCache : public QObject
+{
+    Q_OBJECT
+public:
+    QGeoRouteCache(QGeoRoutingManagerEngine *engine, const QVariantMap &parameters);
+    ~QGeoRouteCache();
+
+    static bool isEnabled(const QVariantMap &parameters);
+
+    QGeoRouteReply *calculateRoute(const QGeoRouteRequest &request);
+
+    QByteArray requestKey(const QGeoRouteRequest &request) const;
+    void clear();
+
+    qsizetype size() const;
+    qsizetype inFlightCount() const;
+
+private:
+    struct Entry
+    {
+        QGeoRouteReply::Error error = QGeoRouteReply::NoError;
+        QString errorString;
+        QList<QGeoRoute> routes;
+        qint64 expiry = 0; // msecs since epoch
+    };
+
+    using Requests = QLocationCacheRequests<QGeoRouteReply, QGeoRouteCacheReply, Entry>;
+
+    static Entry result(const QGeoRouteReply *reply);
+    bool find(const QByteArray &key, Entry *entry);
+    void insert(const QByteArray &key, const Entry &entry);
+    void remove(const QByteArray &key);
+    void finish(QGeoRouteCacheReply *reply, const Entry &entry);
+
+    QString diskFileName(const QByteArray &key) const;
+    bool readDiskEntry(const QByteArray &key, Entry *entry) const;
+    void writeDiskEntry(const QByteArray &key, const Entry &entry);
+    void scheduleDiskSweep();
+    void sweepDisk();
+
+    QGeoRoutingManagerEngine *m_engine;
+    QCache<QByteArray, Entry> m_entries;
+    Requests m_requests;
+    QString m_directory;
+    qint64 m_ttl = 300000;
+    double m_precision = 1e5;
+    qint64 m_diskSizeLimit = 10 * 1024 * 1024;
+    qint64 m_diskSize = 0; // estimated, updated by sweepDisk()
+    bool m_diskSweepScheduled = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOROUTECACHE_P_H
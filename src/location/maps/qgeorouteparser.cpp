@@ -45,6 +45,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
+#include <QtCore/QMetaObject>
 
 #include <QtCore/private/qobject_p.h>
 #include <QtPositioning/private/qlocationutils_p.h>
@@ -64,13 +65,26 @@ QGeoRouteParserPrivate::~QGeoRouteParserPrivate()
 {
 }
 
+QGeoRouteParseTask::ParseFunction QGeoRouteParserPrivate::parseFunction() const
+{
+    const QGeoRouteParser::TrafficSide side = trafficSide;
+    return [this, side](QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) {
+        return parseReply(routes, errorString, reply, side);
+    };
+}
+
 /*
     Public class implementations
 */
 
 QGeoRouteParser::~QGeoRouteParser()
 {
-
+    Q_D(QGeoRouteParser);
+    // The tasks still running use the private data of this parser
+    const QList<QGeoRouteParseTask *> tasks = findChildren<QGeoRouteParseTask *>(Qt::FindDirectChildrenOnly);
+    for (QGeoRouteParseTask *task : tasks)
+        task->abort();
+    d->threadPool.waitForDone();
 }
 
 QGeoRouteParser::QGeoRouteParser(QGeoRouteParserPrivate &dd, QObject *parent) : QObject(dd, parent)
@@ -81,7 +95,22 @@ QGeoRouteParser::QGeoRouteParser(QGeoRouteParserPrivate &dd, QObject *parent) :
 QGeoRouteReply::Error QGeoRouteParser::parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const
 {
     Q_D(const QGeoRouteParser);
-    return d->parseReply(routes, errorString, reply);
+    return d->parseReply(routes, errorString, reply, d->trafficSide);
+}
+
+/*!
+    \internal
+
+    Parses \a reply on a worker thread, with the settings the parser has when this
+    is called. The returned task emits finished() on the thread of this parser once
+    the routes are built, unless it was aborted, and deletes itself afterwards.
+*/
+QGeoRouteParseTask *QGeoRouteParser::parseReplyAsync(const QByteArray &reply, const QGeoRouteRequest &request)
+{
+    Q_D(QGeoRouteParser);
+    QGeoRouteParseTask *task = new QGeoRouteParseTask(reply, request, d->parseFunction(), this);
+    task->start(&d->threadPool);
+    return task;
 }
 
 QUrl QGeoRouteParser::requestUrl(const QGeoRouteRequest &request, const QString &prefix) const
@@ -104,6 +133,83 @@ void QGeoRouteParser::setTrafficSide(QGeoRouteParser::TrafficSide trafficSide)
     Q_EMIT trafficSideChanged(trafficSide);
 }
 
+/*
+    QGeoRouteParseTask
+*/
+
+QGeoRouteParseTask::QGeoRouteParseTask(const QByteArray &reply, const QGeoRouteRequest &request,
+                                       const ParseFunction &parse, QObject *parent)
+    : QObject(parent), m_reply(reply), m_request(request), m_parse(parse)
+{
+    setAutoDelete(false);
+}
+
+QGeoRouteParseTask::~QGeoRouteParseTask()
+{
+}
+
+void QGeoRouteParseTask::start(QThreadPool *pool)
+{
+    pool->start(this);
+}
+
+void QGeoRouteParseTask::run()
+{
+    if (!m_aborted) {
+        m_error = m_parse(m_routes, m_errorString, m_reply);
+        // Setting the request into the result
+        for (QGeoRoute &route : m_routes) {
+            route.setRequest(m_request);
+            for (QGeoRoute &leg: route.routeLegs())
+                leg.setRequest(m_request);
+        }
+    }
+    QMetaObject::invokeMethod(this, &QGeoRouteParseTask::notifyFinished, Qt::QueuedConnection);
+}
+
+void QGeoRouteParseTask::notifyFinished()
+{
+    if (!m_aborted)
+        emit finished();
+    deleteLater();
+}
+
+/*
+    The raw reply, as handed to the parser.
+*/
+QByteArray QGeoRouteParseTask::reply() const
+{
+    return m_reply;
+}
+
+QList<QGeoRoute> QGeoRouteParseTask::routes() const
+{
+    return m_routes;
+}
+
+QGeoRouteReply::Error QGeoRouteParseTask::error() const
+{
+    return m_error;
+}
+
+QString QGeoRouteParseTask::errorString() const
+{
+    return m_errorString;
+}
+
+bool QGeoRouteParseTask::isAborted() const
+{
+    return m_aborted;
+}
+
+/*
+    Skips the parsing if it has not started yet, and suppresses finished() in any case.
+*/
+void QGeoRouteParseTask::abort()
+{
+    m_aborted = true;
+}
+
 QT_END_NAMESPACE
 
 
@@ -53,13 +53,58 @@
 
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <QtLocation/qgeoroutereply.h>
+#include <QtLocation/qgeorouterequest.h>
+#include <QtCore/QByteArray>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+#include <atomic>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
-class QByteArray;
 class QUrl;
-class QGeoRouteRequest;
 class QGeoRouteParserPrivate;
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoRouteParseTask : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    using ParseFunction = std::function<QGeoRouteReply::Error(QList<QGeoRoute> &routes,
+                                                              QString &errorString,
+                                                              const QByteArray &reply)>;
+
+    QGeoRouteParseTask(const QByteArray &reply, const QGeoRouteRequest &request,
+                       const ParseFunction &parse, QObject *parent = nullptr);
+    ~QGeoRouteParseTask() override;
+
+    void start(QThreadPool *pool = QThreadPool::globalInstance());
+    void run() override;
+
+    QByteArray reply() const;
+    QList<QGeoRoute> routes() const;
+    QGeoRouteReply::Error error() const;
+    QString errorString() const;
+    bool isAborted() const;
+
+public Q_SLOTS:
+    void abort();
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    void notifyFinished();
+
+    QByteArray m_reply;
+    QGeoRouteRequest m_request;
+    ParseFunction m_parse;
+    QList<QGeoRoute> m_routes;
+    QGeoRouteReply::Error m_error = QGeoRouteReply::NoError;
+    QString m_errorString;
+    std::atomic<bool> m_aborted = false;
+};
+
 class Q_LOCATION_PRIVATE_EXPORT QGeoRouteParser : public QObject
 {
     Q_OBJECT
@@ -73,6 +118,7 @@ public:
     };
     virtual ~QGeoRouteParser();
     QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const;
+    QGeoRouteParseTask *parseReplyAsync(const QByteArray &reply, const QGeoRouteRequest &request);
     QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const;
 
     TrafficSide trafficSide() const;
@@ -53,8 +53,10 @@
 
 #include <QtCore/private/qobject_p.h>
 #include <QtCore/QUrl>
+#include <QtCore/QThreadPool>
 #include <QtLocation/qgeoroutereply.h>
 #include <QtLocation/qgeorouterequest.h>
+#include <QtLocation/private/qgeorouteparser_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -65,10 +67,14 @@ public:
     QGeoRouteParserPrivate();
     virtual ~QGeoRouteParserPrivate();
 
-    virtual QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const = 0;
+    virtual QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply,
+                                             QGeoRouteParser::TrafficSide trafficSide) const = 0;
+    // Parses with a copy of the current settings, as the tasks run on other threads
+    virtual QGeoRouteParseTask::ParseFunction parseFunction() const;
     virtual QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const = 0;
 
     QGeoRouteParser::TrafficSide trafficSide = QGeoRouteParser::RightHandTraffic;
+    QThreadPool threadPool; // runs the QGeoRouteParseTasks using this parser
 };
 
 QT_END_NAMESPACE
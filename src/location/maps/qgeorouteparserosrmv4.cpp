@@ -41,6 +41,7 @@
 #include "qgeorouteparser_p_p.h"
 #include "qgeoroutesegment.h"
 #include "qgeomaneuver.h"
+#include "qgeopolylinedecoder_p.h"
 
 #include <QtCore/private/qobject_p.h>
 #include <QtCore/QJsonDocument>
@@ -50,45 +51,6 @@
 
 QT_BEGIN_NAMESPACE
 
-static QList<QGeoCoordinate> parsePolyline(const QByteArray &data)
-{
-    QList<QGeoCoordinate> path;
-
-    bool parsingLatitude = true;
-
-    int shift = 0;
-    int value = 0;
-
-    QGeoCoordinate coord(0, 0);
-
-    for (int i = 0; i < data.length(); ++i) {
-        unsigned char c = data.at(i) - 63;
-
-        value |= (c & 0x1f) << shift;
-        shift += 5;
-
-        // another chunk
-        if (c & 0x20)
-            continue;
-
-        int diff = (value & 1) ? ~(value >> 1) : (value >> 1);
-
-        if (parsingLatitude) {
-            coord.setLatitude(coord.latitude() + (double)diff/1e6);
-        } else {
-            coord.setLongitude(coord.longitude() + (double)diff/1e6);
-            path.append(coord);
-        }
-
-        parsingLatitude = !parsingLatitude;
-
-        value = 0;
-        shift = 0;
-    }
-
-    return path;
-}
-
 static QGeoManeuver::InstructionDirection osrmInstructionDirection(const QString &instructionCode, QGeoRouteParser::TrafficSide trafficSide)
 {
     if (instructionCode == QLatin1String("0"))
@@ -253,7 +215,7 @@ static QGeoRoute constructRoute(const QByteArray &geometry, const QJsonArray &in
 {
     QGeoRoute route;
 
-    const QList<QGeoCoordinate> path = parsePolyline(geometry);
+    const QList<QGeoCoordinate> path = QGeoPolylineDecoder::decodeCoordinates(geometry, QGeoPolylineDecoder::Polyline6);
 
     QGeoRouteSegment firstSegment;
     int firstPosition = -1;
@@ -315,7 +277,8 @@ public:
     QGeoRouteParserOsrmV4Private();
     virtual ~QGeoRouteParserOsrmV4Private();
 
-    QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const override;
+    QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply,
+                                     QGeoRouteParser::TrafficSide trafficSide) const override;
     QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const override;
 };
 
@@ -327,7 +290,8 @@ QGeoRouteParserOsrmV4Private::~QGeoRouteParserOsrmV4Private()
 {
 }
 
-QGeoRouteReply::Error QGeoRouteParserOsrmV4Private::parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const
+QGeoRouteReply::Error QGeoRouteParserOsrmV4Private::parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply,
+                                                               QGeoRouteParser::TrafficSide trafficSide) const
 {
     // OSRM v4 specs: https://github.com/Project-OSRM/osrm-backend/wiki/Server-API---v4,-old
     QJsonDocument document = QJsonDocument::fromJson(reply);
@@ -44,61 +44,18 @@
 #include "qgeoroutesegment.h"
 #include "qgeoroutesegment_p.h"
 #include "qgeomaneuver.h"
+#include "qgeopolylinedecoder_p.h"
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
 #include <QtCore/QUrlQuery>
-#include <QtPositioning/qgeopath.h>
 
 #include <QtCore/private/qobject_p.h>
 #include <QtPositioning/private/qlocationutils_p.h>
 
 QT_BEGIN_NAMESPACE
 
-static QList<QGeoCoordinate> decodePolyline(const QString &polylineString)
-{
-    QList<QGeoCoordinate> path;
-    if (polylineString.isEmpty())
-        return path;
-
-    const QByteArray data = polylineString.toLatin1();
-
-    bool parsingLatitude = true;
-
-    int shift = 0;
-    int value = 0;
-
-    QGeoCoordinate coord(0, 0);
-
-    for (qsizetype i = 0; i < data.length(); ++i) {
-        unsigned char c = data.at(i) - 63;
-
-        value |= (c & 0x1f) << shift;
-        shift += 5;
-
-        // another chunk
-        if (c & 0x20)
-            continue;
-
-        int diff = (value & 1) ? ~(value >> 1) : (value >> 1);
-
-        if (parsingLatitude) {
-            coord.setLatitude(coord.latitude() + (double)diff/1e6);
-        } else {
-            coord.setLongitude(coord.longitude() + (double)diff/1e6);
-            path.append(coord);
-        }
-
-        parsingLatitude = !parsingLatitude;
-
-        value = 0;
-        shift = 0;
-    }
-
-    return path;
-}
-
 static QString cardinalDirection4(QLocationUtils::CardinalDirection direction)
 {
     switch (direction) {
@@ -814,11 +771,18 @@ public:
     QGeoRouteParserOsrmV5Private();
     virtual ~QGeoRouteParserOsrmV5Private();
 
-    QGeoRouteSegment parseStep(const QJsonObject &step, int legIndex, int stepIndex) const;
+    QGeoRouteSegment parseStep(const QJsonObject &step, int legIndex, int stepIndex,
+                               QGeoRouteParser::TrafficSide trafficSide,
+                               const QGeoRouteParserOsrmV5Extension *extension) const;
+    QGeoRouteReply::Error parseRoutes(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply,
+                                      QGeoRouteParser::TrafficSide trafficSide,
+                                      const QGeoRouteParserOsrmV5Extension *extension) const;
 
     // QGeoRouteParserPrivate
 
-    QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const override;
+    QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply,
+                                     QGeoRouteParser::TrafficSide trafficSide) const override;
+    QGeoRouteParseTask::ParseFunction parseFunction() const override;
     QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const override;
 
     QVariantMap m_vendorParams;
@@ -835,7 +799,9 @@ QGeoRouteParserOsrmV5Private::~QGeoRouteParserOsrmV5Private()
     delete m_extension;
 }
 
-QGeoRouteSegment QGeoRouteParserOsrmV5Private::parseStep(const QJsonObject &step, int legIndex, int stepIndex) const {
+QGeoRouteSegment QGeoRouteParserOsrmV5Private::parseStep(const QJsonObject &step, int legIndex, int stepIndex,
+                                                         QGeoRouteParser::TrafficSide trafficSide,
+                                                         const QGeoRouteParserOsrmV5Extension *extension) const {
     // OSRM Instructions documentation: https://github.com/Project-OSRM/osrm-text-instructions
     // This goes on top of OSRM: https://github.com/Project-OSRM/osrm-backend/blob/master/docs/http.md
     // Mapbox however, includes this in the reply, under "instruction".
@@ -862,9 +828,6 @@ QGeoRouteSegment QGeoRouteParserOsrmV5Private::parseStep(const QJsonObject &step
     double longitude = position[0].toDouble();
     QGeoCoordinate coord(latitude, longitude);
 
-    QString geometry = step.value(QLatin1String("geometry")).toString();
-    QList<QGeoCoordinate> path = decodePolyline(geometry);
-
     QGeoManeuver::InstructionDirection maneuverInstructionDirection = instructionDirection(maneuver, trafficSide);
 
     QString maneuverInstructionText = instructionText(step, maneuver, maneuverInstructionDirection);
@@ -896,15 +859,32 @@ QGeoRouteSegment QGeoRouteParserOsrmV5Private::parseStep(const QJsonObject &step
     geoManeuver.setExtendedAttributes(extraAttributes);
 
     segment.setDistance(distance);
-    segment.setPath(path);
     segment.setTravelTime(time);
     segment.setManeuver(geoManeuver);
-    if (m_extension)
-        m_extension->updateSegment(segment, step, maneuver);
+    if (extension)
+        extension->updateSegment(segment, step, maneuver);
     return segment;
 }
 
-QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const
+QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply,
+                                                               QGeoRouteParser::TrafficSide trafficSide) const
+{
+    return parseRoutes(routes, errorString, reply, trafficSide, m_extension);
+}
+
+QGeoRouteParseTask::ParseFunction QGeoRouteParserOsrmV5Private::parseFunction() const
+{
+    // setExtension() leaves the previous extensions alive, the one taken here outlives the task
+    const QGeoRouteParser::TrafficSide side = trafficSide;
+    const QGeoRouteParserOsrmV5Extension *extension = m_extension;
+    return [this, side, extension](QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) {
+        return parseRoutes(routes, errorString, reply, side, extension);
+    };
+}
+
+QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseRoutes(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply,
+                                                                QGeoRouteParser::TrafficSide trafficSide,
+                                                                const QGeoRouteParserOsrmV5Extension *extension) const
 {
     // OSRM v5 specs: https://github.com/Project-OSRM/osrm-backend/blob/master/docs/http.md
     // Mapbox Directions API spec: https://www.mapbox.com/api-documentation/#directions
@@ -938,10 +918,13 @@ QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute>
             double travelTime = routeObject.value(QLatin1String("duration")).toDouble();
             bool error = false;
             QList<QGeoRouteSegment> segments;
+            QList<qsizetype> segmentFirstPoints;
+            QList<qsizetype> legFirstPoints;
 
             const QJsonArray legs = routeObject.value(QLatin1String("legs")).toArray();
             QList<QGeoRoute> routeLegs;
             QGeoRoute route;
+            QGeoPolylineDecoder decoder(QGeoPolylineDecoder::Polyline6);
             for (int legIndex = 0; legIndex < legs.size(); ++legIndex) {
                 const QJsonValue &l = legs.at(legIndex);
                 QGeoRoute routeLeg;
@@ -958,6 +941,7 @@ QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute>
                 const double legDistance = leg.value(QLatin1String("distance")).toDouble();
                 const double legTravelTime = leg.value(QLatin1String("duration")).toDouble();
                 const QJsonArray steps = leg.value(QLatin1String("steps")).toArray();
+                legFirstPoints << decoder.size();
                 QGeoRouteSegment segment;
                 for (int stepIndex = 0; stepIndex < steps.size(); ++stepIndex) {
                     const QJsonValue &s = steps.at(stepIndex);
@@ -965,10 +949,15 @@ QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute>
                         error = true;
                         break;
                     }
-                    segment = parseStep(s.toObject(), legIndex, stepIndex);
+                    const QJsonObject step = s.toObject();
+                    segment = parseStep(step, legIndex, stepIndex, trafficSide, extension);
                     if (segment.isValid()) {
                         // setNextRouteSegment done below for all segments in the route.
                         legSegments.append(segment);
+                        // The geometries of the valid steps are decoded back to back into
+                        // the route buffer, segment paths are sliced out of it below.
+                        segmentFirstPoints << decoder.size();
+                        decoder.decode(step.value(QLatin1String("geometry")).toString().toLatin1());
                     } else {
                         error = true;
                         break;
@@ -979,26 +968,33 @@ QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute>
 
                 QGeoRouteSegmentPrivate *segmentPrivate = QGeoRouteSegmentPrivate::get(segment);
                 segmentPrivate->setLegLastSegment(true);
-                QList<QGeoCoordinate> path;
-                for (const QGeoRouteSegment &s: qAsConst(legSegments))
-                    path.append(s.path());
                 routeLeg.setLegIndex(legIndex);
                 routeLeg.setOverallRoute(route); // QGeoRoute::d_ptr is explicitlySharedDataPointer. Modifiers below won't detach it.
                 routeLeg.setDistance(legDistance);
                 routeLeg.setTravelTime(legTravelTime);
-                if (!path.isEmpty()) {
-                    routeLeg.setPath(path);
+                if (decoder.size() > legFirstPoints.last())
                     routeLeg.setFirstRouteSegment(legSegments.first());
-                }
                 routeLegs << routeLeg;
 
                 segments.append(legSegments);
             }
 
             if (!error) {
-                QList<QGeoCoordinate> path;
-                for (const QGeoRouteSegment &s : segments)
-                    path.append(s.path());
+                // The route owns the coordinates, legs and segments refer to ranges of them.
+                // Taking the buffer only now avoids detaching it while decoding.
+                const QGeoPackedPath path = decoder.path();
+                segmentFirstPoints << path.size();
+                legFirstPoints << path.size();
+                for (qsizetype i = 0; i < segments.size(); ++i) {
+                    const qsizetype first = segmentFirstPoints.at(i);
+                    QGeoRouteSegmentPrivate::get(segments[i])->setPackedPath(
+                            path.mid(first, segmentFirstPoints.at(i + 1) - first));
+                }
+                for (qsizetype i = 0; i < routeLegs.size(); ++i) {
+                    const qsizetype first = legFirstPoints.at(i);
+                    QGeoRoutePrivate::get(routeLegs[i])->setPackedPath(
+                            path.mid(first, legFirstPoints.at(i + 1) - first));
+                }
 
                 for (qsizetype i = segments.size() - 1; i > 0; --i)
                     segments[i-1].setNextRouteSegment(segments[i]);
@@ -1006,8 +1002,8 @@ QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute>
                 route.setDistance(distance);
                 route.setTravelTime(travelTime);
                 if (!path.isEmpty()) {
-                    route.setPath(path);
-                    route.setBounds(QGeoPath(path).boundingGeoRectangle());
+                    QGeoRoutePrivate::get(route)->setPackedPath(path);
+                    route.setBounds(path.boundingGeoRectangle());
                     route.setFirstRouteSegment(segments.first());
                 }
                 route.setRouteLegs(routeLegs);
@@ -1052,7 +1048,8 @@ QUrl QGeoRouteParserOsrmV5Private::requestUrl(const QGeoRouteRequest &request, c
 
     QUrl url(routingUrl);
     QUrlQuery query;
-    query.addQueryItem(QLatin1String("overview"), QLatin1String("full"));
+    // The route path is made of the step geometries, no overview is needed
+    query.addQueryItem(QLatin1String("overview"), QLatin1String("false"));
     query.addQueryItem(QLatin1String("steps"), QLatin1String("true"));
     query.addQueryItem(QLatin1String("geometries"), QLatin1String("polyline6"));
     query.addQueryItem(QLatin1String("alternatives"), QLatin1String("true"));
@@ -0,0 +1,331 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeorouteprogress_p.h"
+#include "qgeoroute_p.h"
+#include "qgeoroutesegment_p.h"
+
+#include <QtPositioning/private/qlocationutils_p.h>
+
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+double edgeLength(const double *a, const double *b)
+{
+    // Haversine, a and b are latitude, longitude pairs
+    const double lat1 = QLocationUtils::radians(a[0]);
+    const double lat2 = QLocationUtils::radians(b[0]);
+    const double sinLat = std::sin((lat2 - lat1) / 2.0);
+    const double sinLon = std::sin(QLocationUtils::radians(b[1] - a[1]) / 2.0);
+    const double h = sinLat * sinLat + std::cos(lat1) * std::cos(lat2) * sinLon * sinLon;
+    return 2.0 * QLocationUtils::earthMeanRadius() * std::asin(std::sqrt(qMin(1.0, h)));
+}
+
+double pathLength(const double *values, qsizetype count)
+{
+    double length = 0.0;
+    for (qsizetype i = 1; i < count; ++i)
+        length += edgeLength(values + 2 * (i - 1), values + 2 * i);
+    return length;
+}
+
+// Legs share their data explicitly, a leg of another route is rebuilt
+QGeoRoute legOf(const QGeoRoute &overallRoute, QGeoRoute leg)
+{
+    QGeoRoute copy;
+    copy.setRouteId(leg.routeId());
+    copy.setRequest(leg.request());
+    copy.setBounds(leg.bounds());
+    copy.setTravelTime(leg.travelTime());
+    copy.setDistance(leg.distance());
+    copy.setTravelMode(leg.travelMode());
+    copy.setExtendedAttributes(leg.extendedAttributes());
+    QGeoRoutePrivate::get(copy)->setPackedPath(QGeoRoutePrivate::get(leg)->packedPath());
+    copy.setLegIndex(leg.legIndex());
+    copy.setOverallRoute(overallRoute);
+    if (leg.firstRouteSegment().isValid())
+        copy.setFirstRouteSegment(leg.firstRouteSegment());
+    return copy;
+}
+
+QList<QGeoRoute> legsOf(const QGeoRoute &overallRoute, const QList<QGeoRoute> &legs)
+{
+    QList<QGeoRoute> copies;
+    copies.reserve(legs.size());
+    for (const QGeoRoute &leg : legs)
+        copies << legOf(overallRoute, leg);
+    return copies;
+}
+
+} // namespace
+
+/*
+    Finds the point of the path of \a route that is closest to \a position,
+    in a plane tangent to the earth at \a position, and the route segment
+    and leg it belongs to.
+*/
+QGeoRouteProgress::QGeoRouteProgress(const QGeoRoute &route, const QGeoCoordinate &position)
+    : m_route(route), m_position(position)
+{
+    const QGeoPackedPath path = QGeoRoutePrivate::get(m_route)->packedPath();
+    if (path.isEmpty() || !position.isValid())
+        return;
+
+    const double latitude = position.latitude();
+    const double longitude = position.longitude();
+    const double ky = QLocationUtils::radians(QLocationUtils::earthMeanRadius());
+    const double kx = ky * std::cos(QLocationUtils::radians(latitude));
+    const double *values = path.constData();
+    auto x = [&](qsizetype i) { return std::remainder(values[2 * i + 1] - longitude, 360.0) * kx; };
+    auto y = [&](qsizetype i) { return (values[2 * i] - latitude) * ky; };
+
+    double best = qInf();
+    double bestX = x(0);
+    double bestY = y(0);
+    m_vertex = 0;
+    if (path.size() == 1)
+        best = std::hypot(bestX, bestY);
+    for (qsizetype i = 0; i + 1 < path.size(); ++i) {
+        const double ax = x(i);
+        const double ay = y(i);
+        const double dx = x(i + 1) - ax;
+        const double dy = y(i + 1) - ay;
+        const double length2 = dx * dx + dy * dy;
+        const double t = length2 > 0.0 ? qBound(0.0, -(ax * dx + ay * dy) / length2, 1.0) : 0.0;
+        const double px = ax + t * dx;
+        const double py = ay + t * dy;
+        const double d = std::hypot(px, py);
+        if (d < best) {
+            best = d;
+            bestX = px;
+            bestY = py;
+            m_vertex = i;
+            m_edgeFraction = t;
+        }
+    }
+    m_distance = best;
+    m_projection = QGeoCoordinate(latitude + bestY / ky,
+                                  QLocationUtils::wrapLong(longitude + bestX / kx));
+
+    // Segments usually split the route path, in order. A projection on the edge
+    // joining two segments belongs to the next one.
+    qsizetype offset = 0;
+    int leg = 0;
+    int index = 0;
+    for (QGeoRouteSegment s = m_route.firstRouteSegment(); s.isValid(); s = s.nextRouteSegment(), ++index) {
+        const qsizetype size = QGeoRouteSegmentPrivate::get(s)->pathSize();
+        if (m_segment < 0 && m_vertex < offset + size - 1) {
+            m_segment = index;
+            m_segmentVertex = offset;
+            m_legIndex = leg;
+        }
+        offset += size;
+        if (s.isLegLastSegment())
+            ++leg;
+    }
+    if (offset != path.size())
+        m_segment = -1;
+}
+
+bool QGeoRouteProgress::isValid() const
+{
+    return m_vertex >= 0;
+}
+
+bool QGeoRouteProgress::isOnRoute(qreal tolerance) const
+{
+    return isValid() && m_distance <= tolerance;
+}
+
+/*
+    In meters.
+*/
+qreal QGeoRouteProgress::distanceFromRoute() const
+{
+    return m_distance;
+}
+
+int QGeoRouteProgress::legIndex() const
+{
+    return m_legIndex;
+}
+
+/*
+    The route from the closest point to the position on. The segment the position
+    is in is cut, with its distance and travel time reduced in proportion, and
+    the segments and legs already travelled are left out. If the segments don't
+    follow the path, the totals of the route are reduced in proportion instead.
+*/
+QGeoRoute QGeoRouteProgress::remainingRoute() const
+{
+    if (!isValid())
+        return m_route;
+
+    QGeoRoute route = m_route;
+    const QGeoPackedPath path = QGeoRoutePrivate::get(route)->packedPath();
+    const double *values = path.constData();
+
+    QList<double> remainingValues;
+    remainingValues.reserve(2 * (path.size() - m_vertex));
+    remainingValues << m_projection.latitude() << m_projection.longitude();
+    for (qsizetype i = m_vertex + 1; i < path.size(); ++i)
+        remainingValues << values[2 * i] << values[2 * i + 1];
+    const QGeoPackedPath remainingPath(remainingValues);
+
+    QGeoRoute remaining;
+    remaining.setRouteId(m_route.routeId());
+    remaining.setRequest(remainingRequest());
+    remaining.setBounds(m_route.bounds()); // still encloses the remaining path
+    remaining.setTravelMode(m_route.travelMode());
+    remaining.setExtendedAttributes(m_route.extendedAttributes());
+    QGeoRoutePrivate::get(remaining)->setPackedPath(remainingPath);
+
+    if (m_segment < 0) {
+        const double total = pathLength(values, path.size());
+        const double fraction = total > 0.0
+                ? pathLength(remainingPath.constData(), remainingPath.size()) / total : 1.0;
+        remaining.setDistance(m_route.distance() * fraction);
+        remaining.setTravelTime(qRound(m_route.travelTime() * fraction));
+        remaining.setFirstRouteSegment(m_route.firstRouteSegment());
+        remaining.setRouteLegs(legsOf(remaining, m_route.routeLegs()));
+        return remaining;
+    }
+
+    QGeoRouteSegment segment = m_route.firstRouteSegment();
+    for (int i = 0; i < m_segment; ++i)
+        segment = segment.nextRouteSegment();
+
+    // How much of the current segment is left
+    const QGeoPackedPath segmentPath = path.mid(m_segmentVertex, QGeoRouteSegmentPrivate::get(segment)->pathSize());
+    const qsizetype local = m_vertex - m_segmentVertex; // -1 on the edge before the segment
+    double fraction = 1.0;
+    if (local >= 0) {
+        const double length = pathLength(segmentPath.constData(), segmentPath.size());
+        const double *edge = segmentPath.constData() + 2 * local;
+        const double travelled = pathLength(segmentPath.constData(), local + 1)
+                + m_edgeFraction * edgeLength(edge, edge + 2);
+        if (length > 0.0)
+            fraction = qMax(0.0, 1.0 - travelled / length);
+    }
+
+    QGeoRouteSegment first;
+    first.setDistance(segment.distance() * fraction);
+    first.setTravelTime(qRound(segment.travelTime() * fraction));
+    first.setManeuver(segment.maneuver());
+    first.setNextRouteSegment(segment.nextRouteSegment());
+    QGeoRouteSegmentPrivate *firstPrivate = QGeoRouteSegmentPrivate::get(first);
+    firstPrivate->setPackedPath(remainingPath.mid(0, segmentPath.size() - local));
+    firstPrivate->setLegLastSegment(segment.isLegLastSegment());
+
+    // Totals of the route, and of the current leg
+    qreal distance = first.distance();
+    int travelTime = first.travelTime();
+    qreal legDistance = distance;
+    int legTravelTime = travelTime;
+    qsizetype legEnd = m_segmentVertex + segmentPath.size();
+    bool inLeg = !segment.isLegLastSegment();
+    for (QGeoRouteSegment s = segment.nextRouteSegment(); s.isValid(); s = s.nextRouteSegment()) {
+        distance += s.distance();
+        travelTime += s.travelTime();
+        if (inLeg) {
+            legDistance += s.distance();
+            legTravelTime += s.travelTime();
+            legEnd += QGeoRouteSegmentPrivate::get(s)->pathSize();
+            inLeg = !s.isLegLastSegment();
+        }
+    }
+    remaining.setDistance(distance);
+    remaining.setTravelTime(travelTime);
+    remaining.setFirstRouteSegment(first);
+
+    const QList<QGeoRoute> legs = m_route.routeLegs();
+    if (m_legIndex < legs.size()) {
+        const QGeoRoute &currentLeg = legs.at(m_legIndex);
+        QGeoRoute leg;
+        leg.setLegIndex(currentLeg.legIndex());
+        leg.setOverallRoute(remaining);
+        leg.setRequest(remaining.request());
+        leg.setDistance(legDistance);
+        leg.setTravelTime(legTravelTime);
+        leg.setExtendedAttributes(currentLeg.extendedAttributes());
+        leg.setFirstRouteSegment(first);
+        QGeoRoutePrivate::get(leg)->setPackedPath(remainingPath.mid(0, legEnd - m_vertex));
+        remaining.setRouteLegs(QList<QGeoRoute>() << leg << legsOf(remaining, legs.mid(m_legIndex + 1)));
+    }
+    return remaining;
+}
+
+/*
+    The request for the rest of the route from the position,
+    to the waypoints that have not been reached yet.
+*/
+QGeoRouteRequest QGeoRouteProgress::remainingRequest() const
+{
+    QGeoRouteRequest request = m_route.request();
+    const QList<QGeoCoordinate> waypoints = request.waypoints();
+    if (waypoints.size() < 2) {
+        QGeoRoute route = m_route;
+        const QGeoPackedPath path = QGeoRoutePrivate::get(route)->packedPath();
+        if (!path.isEmpty()) {
+            const double *last = path.constData() + 2 * (path.size() - 1);
+            request.setWaypoints({ m_position, QGeoCoordinate(last[0], last[1]) });
+        }
+        return request;
+    }
+
+    const qsizetype passed = qMin(qsizetype(m_legIndex + 1), waypoints.size() - 1);
+    request.setWaypoints(QList<QGeoCoordinate>() << m_position << waypoints.mid(passed));
+    const QList<QVariantMap> metadata = request.waypointsMetadata();
+    if (metadata.size() == waypoints.size())
+        request.setWaypointsMetadata(QList<QVariantMap>() << QVariantMap() << metadata.mid(passed));
+    return request;
+}
+
+QGeoRouteProgressReply::QGeoRouteProgressReply(const QGeoRouteRequest &request, const QGeoRoute &route,
+                                               QObject *parent)
+    : QGeoRouteReply(request, parent)
+{
+    setRoutes({ route });
+    setFinished(true);
+}
+
+QT_END_NAMESPACE
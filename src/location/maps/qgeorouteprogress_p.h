@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOROUTEPROGRESS_P_H
+#define QGEOROUTEPROGRESS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteReply>
+#include <QtLocation/QGeoRouteRequest>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtCore/qnumeric.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Where a position is along a route: how far it is from the route path and,
+    if it is on it, what is left of the route from there. The remaining route
+    is made from the segments of the route, without asking the service.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoRouteProgress
+{
+public:
+    QGeoRouteProgress(const QGeoRoute &route, const QGeoCoordinate &position);
+
+    bool isValid() const;
+    bool isOnRoute(qreal tolerance) const;
+    qreal distanceFromRoute() const;
+    int legIndex() const;
+
+    QGeoRoute remainingRoute() const;
+    QGeoRouteRequest remainingRequest() const;
+
+private:
+    QGeoRoute m_route;
+    QGeoCoordinate m_position;
+    QGeoCoordinate m_projection; // closest point on the path
+    qsizetype m_vertex = -1; // the path edge of m_projection starts at this vertex
+    double m_edgeFraction = 0.0;
+    qreal m_distance = qInf();
+    int m_segment = -1; // -1 if the segments don't split the path
+    qsizetype m_segmentVertex = 0; // first vertex of m_segment
+    int m_legIndex = 0;
+};
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoRouteProgressReply : public QGeoRouteReply
+{
+    Q_OBJECT
+public:
+    QGeoRouteProgressReply(const QGeoRouteRequest &request, const QGeoRoute &route,
+                           QObject *parent = nullptr);
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOROUTEPROGRESS_P_H
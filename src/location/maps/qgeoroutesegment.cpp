@@ -319,7 +319,7 @@ bool operator==(const QGeoRouteSegmentPrivate &lhs, const QGeoRouteSegmentPrivat
     return lhs.m_valid == rhs.m_valid
         && lhs.m_travelTime == rhs.m_travelTime
         && lhs.m_distance == rhs.m_distance
-        && lhs.m_path == rhs.m_path
+        && lhs.samePath(rhs)
         && lhs.m_maneuver == rhs.m_maneuver;
 }
 
@@ -365,12 +365,43 @@ void QGeoRouteSegmentPrivate::setDistance(qreal distance)
 
 QList<QGeoCoordinate> QGeoRouteSegmentPrivate::path() const
 {
-    return m_path;
+    return m_packedPath.isEmpty() ? m_path : m_packedPath.coordinates();
 }
 
 void QGeoRouteSegmentPrivate::setPath(const QList<QGeoCoordinate> &path)
 {
     m_path = path;
+    m_packedPath = QGeoPackedPath();
+}
+
+QGeoPackedPath QGeoRouteSegmentPrivate::packedPath() const
+{
+    return m_packedPath.isEmpty() ? QGeoPackedPath::fromCoordinates(m_path) : m_packedPath;
+}
+
+/*
+    Refers to a range of the coordinates of the route, instead of
+    holding a copy of them. path() creates the coordinates each time.
+*/
+void QGeoRouteSegmentPrivate::setPackedPath(const QGeoPackedPath &path)
+{
+    m_packedPath = path;
+    m_path.clear();
+}
+
+qsizetype QGeoRouteSegmentPrivate::pathSize() const
+{
+    return m_packedPath.isEmpty() ? m_path.size() : m_packedPath.size();
+}
+
+// Packed paths are compared without creating their coordinates
+bool QGeoRouteSegmentPrivate::samePath(const QGeoRouteSegmentPrivate &other) const
+{
+    if (!m_packedPath.isEmpty() && !other.m_packedPath.isEmpty())
+        return m_packedPath == other.m_packedPath;
+    if (m_packedPath.isEmpty() && other.m_packedPath.isEmpty())
+        return m_path == other.m_path;
+    return path() == other.path();
 }
 
 QGeoManeuver QGeoRouteSegmentPrivate::maneuver() const
@@ -54,6 +54,7 @@
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <QtLocation/qgeomaneuver.h>
 #include <QtLocation/qgeoroutesegment.h>
+#include <QtLocation/private/qgeopackedpath_p.h>
 
 
 #include <QSharedData>
@@ -84,6 +85,10 @@ public:
 
     QList<QGeoCoordinate> path() const;
     void setPath(const QList<QGeoCoordinate> &path);
+    QGeoPackedPath packedPath() const;
+    void setPackedPath(const QGeoPackedPath &path);
+    qsizetype pathSize() const;
+    bool samePath(const QGeoRouteSegmentPrivate &other) const;
 
     QGeoManeuver maneuver() const;
     void setManeuver(const QGeoManeuver &maneuver);
@@ -96,7 +101,8 @@ public:
     bool m_legLastSegment = false;
     int m_travelTime = 0;
     qreal m_distance = 0.0;
-    QList<QGeoCoordinate> m_path;
+    QList<QGeoCoordinate> m_path; // empty when m_packedPath is set
+    QGeoPackedPath m_packedPath; // used instead of m_path when set by a parser
     QGeoManeuver m_maneuver;
 
     friend bool operator==(const QGeoRouteSegmentPrivate &lhs, const QGeoRouteSegmentPrivate &rhs);
@@ -40,6 +40,8 @@
 #include "qgeoroutingmanager.h"
 #include "qgeoroutingmanager_p.h"
 #include "qgeoroutingmanagerengine.h"
+#include "qgeoroutingmanagerengine_p.h"
+#include "qgeoroutecache_p.h"
 
 #include <QLocale>
 
@@ -160,6 +162,8 @@ int QGeoRoutingManager::managerVersion() const
 */
 QGeoRouteReply *QGeoRoutingManager::calculateRoute(const QGeoRouteRequest &request)
 {
+    if (QGeoRouteCache *cache = d_ptr->engine->d_ptr->routeCache)
+        return cache->calculateRoute(request);
     return d_ptr->engine->calculateRoute(request);
 }
 
@@ -39,6 +39,8 @@
 
 #include "qgeoroutingmanagerengine.h"
 #include "qgeoroutingmanagerengine_p.h"
+#include "qgeoroutecache_p.h"
+#include "qgeorouteprogress_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -55,10 +57,6 @@ QT_BEGIN_NAMESPACE
     Subclasses of QGeoRoutingManagerEngine need to provide an implementation of
     calculateRoute().
 
-    In the default implementation, supportsRouteUpdates() returns false and
-    updateRoute() returns a QGeoRouteReply object containing a
-    QGeoRouteReply::UnsupportedOptionError.
-
     If the routing service supports updating routes as they are being
     traveled, the subclass should provide an implementation of updateRoute()
     and call setSupportsRouteUpdates(true) at some point in time before
@@ -73,6 +71,45 @@ QT_BEGIN_NAMESPACE
     or any of the capability reporting functions are used to prevent
     incorrect or inconsistent behavior.
 
+    Routes can be cached by the manager, for all engines, with these plugin
+    parameters:
+
+    \table
+    \header
+        \li Parameter
+        \li Description
+    \row
+        \li routing.cache.size
+        \li The number of requests whose routes are kept in memory. The cache
+            is disabled when this is 0, the default.
+    \row
+        \li routing.cache.ttl
+        \li How long, in seconds, cached routes are reused. Defaults to 300.
+    \row
+        \li routing.cache.precision
+        \li How many decimals of the waypoint coordinates are compared to tell
+            requests apart. Defaults to 5, about one meter.
+    \row
+        \li routing.cache.directory
+        \li A directory where cached routes are also stored, so that they
+            survive the application. Not set by default.
+    \row
+        \li routing.cache.disk.size
+        \li The size, in bytes, of the routes stored in routing.cache.directory.
+            Once it is exceeded, the least recently stored routes are removed.
+            Expired routes are removed as well. Defaults to 10 MiB.
+    \endtable
+
+    While the cache is enabled, identical requests that are in progress at the
+    same time share the reply of the engine.
+
+    The default implementation of updateRoute() fails, unless the
+    routing.refresh.tolerance parameter is set. It is how far, in meters, a
+    position can be from the route and still be on it; 30 suits most travel
+    modes. The part of the route that has been traveled is then trimmed
+    locally, and a new route is calculated with calculateRoute() once the
+    position has left the route.
+
     A subclass of QGeoRouteManagerEngine will often make use of a subclass
     fo QGeoRouteReply internally, in order to add any engine-specific
     data (such as a QNetworkReply object for network-based services) to the
@@ -89,7 +126,10 @@ QGeoRoutingManagerEngine::QGeoRoutingManagerEngine(const QVariantMap &parameters
     : QObject(parent),
       d_ptr(new QGeoRoutingManagerEnginePrivate())
 {
-    Q_UNUSED(parameters);
+    if (QGeoRouteCache::isEnabled(parameters))
+        d_ptr->routeCache = new QGeoRouteCache(this, parameters);
+    if (parameters.contains(QStringLiteral("routing.refresh.tolerance")))
+        d_ptr->routeRefreshTolerance = qMax(0.0, parameters.value(QStringLiteral("routing.refresh.tolerance")).toReal());
 }
 
 /*!
@@ -180,8 +220,15 @@ int QGeoRoutingManagerEngine::managerVersion() const
     This engine and the returned QGeoRouteReply object will emit signals
     indicating if the operation completes or if errors occur.
 
-    If supportsRouteUpdates() returns false an
-    QGeoRouteReply::UnsupportedOptionError will occur.
+    The default implementation returns a reply with a
+    QGeoRouteReply::UnsupportedOptionError, unless the routing.refresh.tolerance
+    plugin parameter is set. In that case, it doesn't contact the service while
+    \a position is on the route, within that tolerance. It returns a finished
+    reply with the rest of the route, whose distance and travel time are
+    recomputed from the route segments. Otherwise, it calculates a route, through
+    the route cache when it is enabled, with the request of the route, from
+    \a position to the waypoints which have not been reached yet. Routes without
+    a path still cause a QGeoRouteReply::UnsupportedOptionError.
 
     Once the operation has completed, QGeoRouteReply::routes can be used to
     retrieve the updated route.
@@ -199,10 +246,22 @@ int QGeoRoutingManagerEngine::managerVersion() const
 */
 QGeoRouteReply *QGeoRoutingManagerEngine::updateRoute(const QGeoRoute &route, const QGeoCoordinate &position)
 {
-    Q_UNUSED(route);
-    Q_UNUSED(position);
-    return new QGeoRouteReply(QGeoRouteReply::UnsupportedOptionError,
-                              QLatin1String("The updating of routes is not supported by this service provider."), this);
+    if (d_ptr->routeRefreshTolerance <= 0.0) {
+        return new QGeoRouteReply(QGeoRouteReply::UnsupportedOptionError,
+                                  QLatin1String("The updating of routes is not supported by this service provider."), this);
+    }
+    const QGeoRouteProgress progress(route, position);
+    if (!progress.isValid()) {
+        return new QGeoRouteReply(QGeoRouteReply::UnsupportedOptionError,
+                                  QLatin1String("The updating of routes without a path is not supported by this service provider."), this);
+    }
+    if (progress.isOnRoute(d_ptr->routeRefreshTolerance)) {
+        const QGeoRoute remaining = progress.remainingRoute();
+        return new QGeoRouteProgressReply(remaining.request(), remaining, this);
+    }
+    if (QGeoRouteCache *cache = d_ptr->routeCache)
+        return cache->calculateRoute(progress.remainingRequest());
+    return calculateRoute(progress.remainingRequest());
 }
 
 /*!
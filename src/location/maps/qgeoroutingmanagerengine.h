@@ -97,6 +97,7 @@ private:
 
     friend class QGeoServiceProvider;
     friend class QGeoServiceProviderPrivate;
+    friend class QGeoRoutingManager;
 };
 
 QT_END_NAMESPACE
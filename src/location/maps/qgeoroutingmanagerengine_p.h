@@ -59,6 +59,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QGeoRouteCache;
+
 class QGeoRoutingManagerEnginePrivate
 {
 public:
@@ -73,6 +75,9 @@ public:
 
     QLocale locale;
     QLocale::MeasurementSystem measurementSystem = locale.measurementSystem();
+
+    QGeoRouteCache *routeCache = nullptr; // child of the engine, if enabled
+    qreal routeRefreshTolerance = 0.0; // meters, routes are updated locally when set
 };
 
 QT_END_NAMESPACE
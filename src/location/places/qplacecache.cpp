@@ -0,0 +1,844 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplacecache_p.h"
+#include "qplacemanagerengine.h"
+#include "qplacemanagerengine_p.h"
+#include "qplacesearchrequest_p.h"
+#include "qplaceattribute.h"
+#include "qplacecategory.h"
+#include "qplacecontactdetail.h"
+#include "qplaceicon.h"
+#include "qplaceproposedsearchresult.h"
+#include "qplaceratings.h"
+#include "qplaceresult.h"
+#include "qplacesupplier.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoLocation>
+#include <QtPositioning/QGeoShape>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const quint32 diskMagic = 0x51504c43; // "QPLC"
+const quint32 diskVersion = 2;
+
+const QPlaceContent::Type contentTypes[] = {
+    QPlaceContent::ImageType, QPlaceContent::ReviewType, QPlaceContent::EditorialType
+};
+
+void writeIcon(QDataStream &out, const QPlaceIcon &icon)
+{
+    out << icon.parameters();
+}
+
+QPlaceIcon readIcon(QDataStream &in, QPlaceManager *manager)
+{
+    QVariantMap parameters;
+    in >> parameters;
+    QPlaceIcon icon;
+    if (!parameters.isEmpty()) {
+        icon.setParameters(parameters);
+        icon.setManager(manager);
+    }
+    return icon;
+}
+
+void writeCategories(QDataStream &out, const QList<QPlaceCategory> &categories)
+{
+    out << qint32(categories.size());
+    for (const QPlaceCategory &category : categories) {
+        out << category.categoryId() << category.name() << int(category.visibility());
+        writeIcon(out, category.icon());
+    }
+}
+
+QList<QPlaceCategory> readCategories(QDataStream &in, QPlaceManager *manager)
+{
+    qint32 count = 0;
+    in >> count;
+    QList<QPlaceCategory> categories;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString id;
+        QString name;
+        int visibility;
+        in >> id >> name >> visibility;
+        QPlaceCategory category;
+        category.setCategoryId(id);
+        category.setName(name);
+        category.setVisibility(QLocation::Visibility(visibility));
+        category.setIcon(readIcon(in, manager));
+        categories << category;
+    }
+    return categories;
+}
+
+void writeLocation(QDataStream &out, const QGeoLocation &location)
+{
+    const QGeoAddress address = location.address();
+    out << location.coordinate() << location.boundingShape() << location.extendedAttributes()
+        << address.isTextGenerated() << address.text() << address.country()
+        << address.countryCode() << address.state() << address.county() << address.city()
+        << address.district() << address.postalCode() << address.street()
+        << address.streetNumber();
+}
+
+QGeoLocation readLocation(QDataStream &in)
+{
+    QGeoCoordinate coordinate;
+    QGeoShape boundingShape;
+    QVariantMap extendedAttributes;
+    bool textGenerated;
+    QString text, country, countryCode, state, county, city, district, postalCode, street,
+            streetNumber;
+    in >> coordinate >> boundingShape >> extendedAttributes >> textGenerated >> text >> country
+       >> countryCode >> state >> county >> city >> district >> postalCode >> street
+       >> streetNumber;
+
+    QGeoAddress address;
+    address.setCountry(country);
+    address.setCountryCode(countryCode);
+    address.setState(state);
+    address.setCounty(county);
+    address.setCity(city);
+    address.setDistrict(district);
+    address.setPostalCode(postalCode);
+    address.setStreet(street);
+    address.setStreetNumber(streetNumber);
+    if (!textGenerated)
+        address.setText(text);
+
+    QGeoLocation location;
+    location.setCoordinate(coordinate);
+    location.setBoundingShape(boundingShape);
+    location.setExtendedAttributes(extendedAttributes);
+    location.setAddress(address);
+    return location;
+}
+
+void writePlace(QDataStream &out, const QPlace &place)
+{
+    out << place.placeId() << place.name() << place.attribution() << int(place.visibility())
+        << place.detailsFetched();
+    writeLocation(out, place.location());
+    writeCategories(out, place.categories());
+    writeIcon(out, place.icon());
+
+    const QPlaceRatings ratings = place.ratings();
+    out << ratings.average() << ratings.maximum() << ratings.count();
+    const QPlaceSupplier supplier = place.supplier();
+    out << supplier.name() << supplier.supplierId() << supplier.url();
+    writeIcon(out, supplier.icon());
+
+    const QStringList contactTypes = place.contactTypes();
+    out << qint32(contactTypes.size());
+    for (const QString &type : contactTypes) {
+        const QList<QPlaceContactDetail> details = place.contactDetails(type);
+        out << type << qint32(details.size());
+        for (const QPlaceContactDetail &detail : details)
+            out << detail.label() << detail.value();
+    }
+
+    const QStringList attributeTypes = place.extendedAttributeTypes();
+    out << qint32(attributeTypes.size());
+    for (const QString &type : attributeTypes) {
+        const QPlaceAttribute attribute = place.extendedAttribute(type);
+        out << type << attribute.label() << attribute.text();
+    }
+
+    // Content itself is fetched with getPlaceContent(), only the totals are kept
+    for (QPlaceContent::Type type : contentTypes)
+        out << place.totalContentCount(type);
+}
+
+QPlace readPlace(QDataStream &in, QPlaceManager *manager)
+{
+    QString id;
+    QString name;
+    QString attribution;
+    int visibility;
+    bool detailsFetched;
+    in >> id >> name >> attribution >> visibility >> detailsFetched;
+
+    QPlace place;
+    place.setPlaceId(id);
+    place.setName(name);
+    place.setAttribution(attribution);
+    place.setVisibility(QLocation::Visibility(visibility));
+    place.setLocation(readLocation(in));
+    place.setCategories(readCategories(in, manager));
+    place.setIcon(readIcon(in, manager));
+
+    qreal average;
+    qreal maximum;
+    int count;
+    in >> average >> maximum >> count;
+    QPlaceRatings ratings;
+    ratings.setAverage(average);
+    ratings.setMaximum(maximum);
+    ratings.setCount(count);
+    place.setRatings(ratings);
+
+    QString supplierName;
+    QString supplierId;
+    QUrl supplierUrl;
+    in >> supplierName >> supplierId >> supplierUrl;
+    QPlaceSupplier supplier;
+    supplier.setName(supplierName);
+    supplier.setSupplierId(supplierId);
+    supplier.setUrl(supplierUrl);
+    supplier.setIcon(readIcon(in, manager));
+    place.setSupplier(supplier);
+
+    qint32 contactTypeCount = 0;
+    in >> contactTypeCount;
+    for (qint32 i = 0; i < contactTypeCount && in.status() == QDataStream::Ok; ++i) {
+        QString type;
+        qint32 detailCount = 0;
+        in >> type >> detailCount;
+        QList<QPlaceContactDetail> details;
+        for (qint32 j = 0; j < detailCount && in.status() == QDataStream::Ok; ++j) {
+            QString label;
+            QString value;
+            in >> label >> value;
+            QPlaceContactDetail detail;
+            detail.setLabel(label);
+            detail.setValue(value);
+            details << detail;
+        }
+        place.setContactDetails(type, details);
+    }
+
+    qint32 attributeCount = 0;
+    in >> attributeCount;
+    for (qint32 i = 0; i < attributeCount && in.status() == QDataStream::Ok; ++i) {
+        QString type;
+        QString label;
+        QString text;
+        in >> type >> label >> text;
+        QPlaceAttribute attribute;
+        attribute.setLabel(label);
+        attribute.setText(text);
+        place.setExtendedAttribute(type, attribute);
+    }
+
+    for (QPlaceContent::Type type : contentTypes) {
+        int total;
+        in >> total;
+        place.setTotalContentCount(type, total);
+    }
+    place.setDetailsFetched(detailsFetched);
+    return place;
+}
+
+// Variants are written with the stream operators of their type, which not all types have
+bool canWrite(const QVariant &value)
+{
+    if (!value.isValid())
+        return true;
+    switch (value.typeId()) {
+    case QMetaType::QVariantList: {
+        const QVariantList list = value.toList();
+        return std::all_of(list.cbegin(), list.cend(),
+                           [](const QVariant &item) { return canWrite(item); });
+    }
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        return std::all_of(map.cbegin(), map.cend(),
+                           [](const QVariant &item) { return canWrite(item); });
+    }
+    case QMetaType::QVariantHash: {
+        const QVariantHash hash = value.toHash();
+        return std::all_of(hash.cbegin(), hash.cend(),
+                           [](const QVariant &item) { return canWrite(item); });
+    }
+    default:
+        return value.metaType().hasRegisteredDataStreamOperators();
+    }
+}
+
+// Routes are not stored either
+bool canWrite(const QPlaceSearchRequest &request)
+{
+    const QPlaceSearchRequestPrivate *d = QPlaceSearchRequestPrivate::get(request);
+    return d->routeSearchArea.path().isEmpty() && canWrite(d->searchContext);
+}
+
+bool canWrite(const QList<QPlaceSearchResult> &results)
+{
+    return std::all_of(results.cbegin(), results.cend(), [](const QPlaceSearchResult &result) {
+        return result.type() != QPlaceSearchResult::ProposedSearchResult
+                || canWrite(QPlaceProposedSearchResult(result).searchRequest());
+    });
+}
+
+// The expiry of a stored entry, 0 if the file is not one
+struct DiskHeader
+{
+    qint64 written = 0; // QPlaceCache::diskTime()
+    qint64 expiry = 0; // msecs since epoch
+};
+
+bool readHeader(QDataStream &in, DiskHeader *header)
+{
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version >> header->written >> header->expiry;
+    return magic == diskMagic && version == diskVersion && in.status() == QDataStream::Ok;
+}
+
+// The header of a stored entry, a null one if the file is not an entry
+DiskHeader diskHeader(const QString &fileName)
+{
+    DiskHeader header;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return header;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+    if (!readHeader(in, &header))
+        return DiskHeader();
+    return header;
+}
+
+void writeRequest(QDataStream &out, const QPlaceSearchRequest &request)
+{
+    const QPlaceSearchRequestPrivate *d = QPlaceSearchRequestPrivate::get(request);
+    if (!canWrite(request)) {
+        out.setStatus(QDataStream::WriteFailed);
+        return;
+    }
+    out << d->searchTerm;
+    writeCategories(out, d->categories);
+    out << d->searchArea << d->recommendationId << int(d->visibilityScope)
+        << int(d->relevanceHint) << d->limit << d->searchContext << d->related << d->page;
+}
+
+QPlaceSearchRequest readRequest(QDataStream &in, QPlaceManager *manager)
+{
+    QPlaceSearchRequest request;
+    QPlaceSearchRequestPrivate *d = QPlaceSearchRequestPrivate::get(request);
+    in >> d->searchTerm;
+    d->categories = readCategories(in, manager);
+    int visibilityScope;
+    int relevanceHint;
+    in >> d->searchArea >> d->recommendationId >> visibilityScope >> relevanceHint >> d->limit
+       >> d->searchContext >> d->related >> d->page;
+    d->visibilityScope = QLocation::VisibilityScope(visibilityScope);
+    d->relevanceHint = QPlaceSearchRequest::RelevanceHint(relevanceHint);
+    return request;
+}
+
+void writeResult(QDataStream &out, const QPlaceSearchResult &result)
+{
+    out << int(result.type()) << result.title();
+    writeIcon(out, result.icon());
+    if (result.type() == QPlaceSearchResult::PlaceResult) {
+        const QPlaceResult placeResult(result);
+        out << placeResult.distance() << placeResult.isSponsored();
+        writePlace(out, placeResult.place());
+    } else if (result.type() == QPlaceSearchResult::ProposedSearchResult) {
+        writeRequest(out, QPlaceProposedSearchResult(result).searchRequest());
+    }
+}
+
+QPlaceSearchResult readResult(QDataStream &in, QPlaceManager *manager)
+{
+    int type;
+    QString title;
+    in >> type >> title;
+    const QPlaceIcon icon = readIcon(in, manager);
+
+    QPlaceSearchResult result;
+    if (type == QPlaceSearchResult::PlaceResult) {
+        qreal distance;
+        bool sponsored;
+        in >> distance >> sponsored;
+        QPlaceResult placeResult;
+        placeResult.setDistance(distance);
+        placeResult.setSponsored(sponsored);
+        placeResult.setPlace(readPlace(in, manager));
+        result = placeResult;
+    } else if (type == QPlaceSearchResult::ProposedSearchResult) {
+        QPlaceProposedSearchResult proposed;
+        proposed.setSearchRequest(readRequest(in, manager));
+        result = proposed;
+    }
+    result.setTitle(title);
+    result.setIcon(icon);
+    return result;
+}
+
+void writeEngine(QDataStream &out, const QPlaceManagerEngine *engine)
+{
+    out << engine->managerName() << engine->managerVersion();
+    const QList<QLocale> locales = engine->locales();
+    for (const QLocale &locale : locales)
+        out << locale.name();
+}
+
+} // namespace
+
+QPlaceSearchCacheReply::QPlaceSearchCacheReply(QObject *parent)
+    : QPlaceSearchReply(parent)
+{
+}
+
+void QPlaceSearchCacheReply::abort()
+{
+    m_follower.abort(this);
+    QPlaceSearchReply::abort();
+}
+
+QPlaceDetailsCacheReply::QPlaceDetailsCacheReply(QObject *parent)
+    : QPlaceDetailsReply(parent)
+{
+}
+
+void QPlaceDetailsCacheReply::abort()
+{
+    m_follower.abort(this);
+    QPlaceDetailsReply::abort();
+}
+
+/*
+    See the QPlaceManagerEngine documentation for the places.cache parameters.
+*/
+QPlaceCache::QPlaceCache(QPlaceManagerEngine *engine, const QVariantMap &parameters)
+    : QObject(engine), m_engine(engine),
+      m_searches(this, [](const QPlaceSearchReply *reply) { return result(reply); },
+                 [this](const QByteArray &key, Entry *entry) { return find(key, Search, entry); },
+                 [this](const QByteArray &key, const Entry &entry) { insert(key, entry); },
+                 [this](const QByteArray &key) { remove(key, Search); },
+                 [this](QPlaceSearchCacheReply *reply, const Entry &entry) { finish(reply, entry); }),
+      m_details(this, [](const QPlaceDetailsReply *reply) { return result(reply); },
+                [this](const QByteArray &key, Entry *entry) { return find(key, Details, entry); },
+                [this](const QByteArray &key, const Entry &entry) { insert(key, entry); },
+                [this](const QByteArray &key) { remove(key, Details); },
+                [this](QPlaceDetailsCacheReply *reply, const Entry &entry) { finish(reply, entry); })
+{
+    m_entries.setMaxCost(qMax(1, parameters.value(QStringLiteral("places.cache.size")).toInt()));
+    if (parameters.contains(QStringLiteral("places.cache.ttl.search")))
+        m_searchTtl = qMax(0, parameters.value(QStringLiteral("places.cache.ttl.search")).toInt()) * qint64(1000);
+    if (parameters.contains(QStringLiteral("places.cache.ttl.details")))
+        m_detailsTtl = qMax(0, parameters.value(QStringLiteral("places.cache.ttl.details")).toInt()) * qint64(1000);
+    if (parameters.contains(QStringLiteral("places.cache.disk.size")))
+        m_diskSizeLimit = qMax(0, parameters.value(QStringLiteral("places.cache.disk.size")).toInt());
+    m_directory = parameters.value(QStringLiteral("places.cache.directory")).toString();
+    if (!m_directory.isEmpty() && !QDir::root().mkpath(m_directory)) {
+        qWarning("Cannot create place cache directory %s", qPrintable(m_directory));
+        m_directory.clear();
+    }
+    // Drops what expired since the last run, and measures the stored entries
+    scheduleDiskSweep();
+
+    // Searches may return added, changed or removed places differently
+    connect(engine, &QPlaceManagerEngine::placeAdded, this, &QPlaceCache::invalidateSearches);
+    connect(engine, &QPlaceManagerEngine::placeUpdated, this, &QPlaceCache::placeChanged);
+    connect(engine, &QPlaceManagerEngine::placeRemoved, this, &QPlaceCache::placeChanged);
+    connect(engine, &QPlaceManagerEngine::categoryAdded, this, &QPlaceCache::invalidateSearches);
+    connect(engine, &QPlaceManagerEngine::categoryUpdated, this, &QPlaceCache::invalidateSearches);
+    connect(engine, &QPlaceManagerEngine::categoryRemoved, this, &QPlaceCache::invalidateSearches);
+    connect(engine, &QPlaceManagerEngine::dataChanged, this, &QPlaceCache::clear);
+}
+
+QPlaceCache::~QPlaceCache() = default;
+
+bool QPlaceCache::isEnabled(const QVariantMap &parameters)
+{
+    return parameters.value(QStringLiteral("places.cache.size")).toInt() > 0;
+}
+
+QPlaceSearchReply *QPlaceCache::search(const QPlaceSearchRequest &request)
+{
+    const QByteArray key = searchKey(request);
+    if (key.isEmpty())
+        return m_engine->search(request);
+
+    return m_searches.request(key, [this, request]() {
+        return m_engine->search(request);
+    }, [this, request]() {
+        QPlaceSearchCacheReply *reply = new QPlaceSearchCacheReply(m_engine);
+        reply->setRequest(request);
+        return reply;
+    });
+}
+
+QPlaceDetailsReply *QPlaceCache::getPlaceDetails(const QString &placeId)
+{
+    if (placeId.isEmpty())
+        return m_engine->getPlaceDetails(placeId);
+
+    return m_details.request(detailsKey(placeId), [this, placeId]() {
+        return m_engine->getPlaceDetails(placeId);
+    }, [this]() {
+        return new QPlaceDetailsCacheReply(m_engine);
+    });
+}
+
+/*
+    The key covers everything that changes the answer of the service: the request
+    and the engine settings. Requests whose search context cannot be serialized
+    have no key, and are not cached.
+*/
+QByteArray QPlaceCache::searchKey(const QPlaceSearchRequest &request) const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_5);
+
+    out << quint8(Search);
+    writeEngine(out, m_engine);
+
+    const QPlaceSearchRequestPrivate *d = QPlaceSearchRequestPrivate::get(request);
+    QStringList categoryIds;
+    for (const QPlaceCategory &category : d->categories)
+        categoryIds << category.categoryId();
+    std::sort(categoryIds.begin(), categoryIds.end());
+    if (!canWrite(d->searchContext))
+        return QByteArray();
+    out << d->searchTerm << categoryIds << d->searchArea << d->recommendationId
+        << int(d->visibilityScope) << int(d->relevanceHint) << d->limit << d->searchContext
+        << d->related << d->page << d->routeSearchArea.path();
+    if (out.status() != QDataStream::Ok)
+        return QByteArray();
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+QByteArray QPlaceCache::detailsKey(const QString &placeId) const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_5);
+
+    out << quint8(Details);
+    writeEngine(out, m_engine);
+    out << placeId;
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+void QPlaceCache::clear()
+{
+    m_entries.clear();
+    m_searches.clearInFlight();
+    m_details.clearInFlight();
+    if (m_directory.isEmpty())
+        return;
+    m_diskSearchesInvalidated = diskTime();
+    m_diskDetailsInvalidated = m_diskSearchesInvalidated;
+    scheduleDiskSweep();
+}
+
+/*
+    The number of entries in memory that were not invalidated.
+*/
+qsizetype QPlaceCache::size() const
+{
+    const QList<QByteArray> keys = m_entries.keys();
+    return std::count_if(keys.cbegin(), keys.cend(), [this](const QByteArray &key) {
+        return isCurrent(*m_entries.object(key));
+    });
+}
+
+bool QPlaceCache::isCurrent(const Entry &entry) const
+{
+    return entry.kind != Search || entry.generation == m_searchGeneration;
+}
+
+bool QPlaceCache::find(const QByteArray &key, Kind kind, Entry *entry)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (const Entry *cached = m_entries.object(key)) {
+        if (cached->expiry > now && isCurrent(*cached)) {
+            *entry = *cached;
+            return true;
+        }
+        m_entries.remove(key);
+    }
+
+    if (m_directory.isEmpty() || !readDiskEntry(key, kind, entry))
+        return false;
+    if (entry->expiry <= now) {
+        QFile::remove(diskFileName(key, kind));
+        return false;
+    }
+    entry->generation = m_searchGeneration;
+    m_entries.insert(key, new Entry(*entry));
+    return true;
+}
+
+void QPlaceCache::insert(const QByteArray &key, const Entry &entry)
+{
+    const qint64 ttl = entry.kind == Search ? m_searchTtl : m_detailsTtl;
+    if (entry.error != QPlaceReply::NoError || ttl <= 0)
+        return;
+
+    Entry *cached = new Entry(entry);
+    cached->expiry = QDateTime::currentMSecsSinceEpoch() + ttl;
+    cached->generation = m_searchGeneration;
+    if (!m_directory.isEmpty())
+        writeDiskEntry(key, *cached);
+    m_entries.insert(key, cached);
+}
+
+void QPlaceCache::remove(const QByteArray &key, Kind kind)
+{
+    m_entries.remove(key);
+    if (!m_directory.isEmpty())
+        QFile::remove(diskFileName(key, kind));
+}
+
+/*
+    Search entries stored before are dropped when they are found. Their files are
+    removed by a single sweep for all the invalidations of an event loop iteration.
+*/
+void QPlaceCache::invalidateSearches()
+{
+    ++m_searchGeneration;
+    m_searches.clearInFlight();
+    if (m_directory.isEmpty())
+        return;
+    m_diskSearchesInvalidated = diskTime();
+    scheduleDiskSweep();
+}
+
+void QPlaceCache::placeChanged(const QString &placeId)
+{
+    remove(detailsKey(placeId), Details);
+    invalidateSearches();
+}
+
+QPlaceCache::Entry QPlaceCache::result(const QPlaceSearchReply *reply)
+{
+    Entry entry;
+    entry.kind = Search;
+    entry.error = reply->error();
+    entry.errorString = reply->errorString();
+    entry.results = reply->results();
+    entry.previousPage = reply->previousPageRequest();
+    entry.nextPage = reply->nextPageRequest();
+    return entry;
+}
+
+QPlaceCache::Entry QPlaceCache::result(const QPlaceDetailsReply *reply)
+{
+    Entry entry;
+    entry.kind = Details;
+    entry.error = reply->error();
+    entry.errorString = reply->errorString();
+    entry.place = reply->place();
+    return entry;
+}
+
+// Place replies emit their signals themselves, as engines do for theirs
+template <typename Reply>
+void QPlaceCache::finishReply(Reply *reply, const Entry &entry)
+{
+    reply->setFinished(true);
+    if (entry.error != QPlaceReply::NoError) {
+        reply->setError(entry.error, entry.errorString);
+        emit reply->errorOccurred(entry.error, entry.errorString);
+        emit m_engine->errorOccurred(reply, entry.error, entry.errorString);
+    }
+    emit reply->finished();
+    emit m_engine->finished(reply);
+}
+
+void QPlaceCache::finish(QPlaceSearchCacheReply *reply, const Entry &entry)
+{
+    if (entry.error == QPlaceReply::NoError) {
+        reply->setResults(entry.results);
+        reply->setPreviousPageRequest(entry.previousPage);
+        reply->setNextPageRequest(entry.nextPage);
+    }
+    finishReply(reply, entry);
+}
+
+void QPlaceCache::finish(QPlaceDetailsCacheReply *reply, const Entry &entry)
+{
+    if (entry.error == QPlaceReply::NoError)
+        reply->setPlace(entry.place);
+    finishReply(reply, entry);
+}
+
+QString QPlaceCache::diskFileName(const QByteArray &key, Kind kind) const
+{
+    return m_directory + QLatin1Char('/') + QString::fromLatin1(key.toHex())
+            + (kind == Search ? QStringLiteral(".search") : QStringLiteral(".place"));
+}
+
+bool QPlaceCache::readDiskEntry(const QByteArray &key, Kind kind, Entry *entry) const
+{
+    QFile file(diskFileName(key, kind));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+    DiskHeader header;
+    if (!readHeader(in, &header) || isStale(header.written, kind))
+        return false;
+    entry->expiry = header.expiry;
+
+    QPlaceManager *manager = m_engine->d_ptr->manager;
+    entry->kind = kind;
+    if (kind == Search) {
+        qint32 count = 0;
+        in >> count;
+        for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i)
+            entry->results << readResult(in, manager);
+        entry->previousPage = readRequest(in, manager);
+        entry->nextPage = readRequest(in, manager);
+    } else {
+        entry->place = readPlace(in, manager);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+void QPlaceCache::writeDiskEntry(const QByteArray &key, const Entry &entry)
+{
+    // Routes, and search contexts some engines use, stay in memory
+    if (entry.kind == Search
+            && (!canWrite(entry.results) || !canWrite(entry.previousPage)
+                || !canWrite(entry.nextPage))) {
+        return;
+    }
+
+    QSaveFile file(diskFileName(key, entry.kind));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << diskMagic << diskVersion << diskTime() << entry.expiry;
+    if (entry.kind == Search) {
+        out << qint32(entry.results.size());
+        for (const QPlaceSearchResult &result : entry.results)
+            writeResult(out, result);
+        writeRequest(out, entry.previousPage);
+        writeRequest(out, entry.nextPage);
+    } else {
+        writePlace(out, entry.place);
+    }
+
+    if (out.status() != QDataStream::Ok)
+        return;
+    const qint64 written = file.size();
+    if (!file.commit())
+        return;
+    m_diskSize += written;
+    if (m_diskSize > m_diskSizeLimit)
+        scheduleDiskSweep();
+}
+
+void QPlaceCache::scheduleDiskSweep()
+{
+    if (m_directory.isEmpty() || m_diskSweepScheduled)
+        return;
+    m_diskSweepScheduled = true;
+    QMetaObject::invokeMethod(this, &QPlaceCache::sweepDisk, Qt::QueuedConnection);
+}
+
+/*
+    Increases with each call, so that the files written after an invalidation
+    are told apart from the ones written before it, even within a millisecond.
+*/
+qint64 QPlaceCache::diskTime()
+{
+    m_diskTime = qMax(QDateTime::currentMSecsSinceEpoch(), m_diskTime + 1);
+    return m_diskTime;
+}
+
+// Invalidated files are not read, until sweepDisk() removes them
+bool QPlaceCache::isStale(qint64 written, Kind kind) const
+{
+    return written <= (kind == Search ? m_diskSearchesInvalidated : m_diskDetailsInvalidated);
+}
+
+/*
+    Removes the invalidated and expired files. If the others exceed
+    places.cache.disk.size, the least recently written ones are removed
+    until they fill three quarters of it.
+*/
+void QPlaceCache::sweepDisk()
+{
+    m_diskSweepScheduled = false;
+    QDir dir(m_directory);
+    // Most recently written first
+    QFileInfoList files = dir.entryInfoList({ QStringLiteral("*.search"), QStringLiteral("*.place") },
+                                            QDir::Files, QDir::Time);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 size = 0;
+    for (auto it = files.begin(); it != files.end();) {
+        const Kind kind = it->suffix() == QLatin1String("search") ? Search : Details;
+        const DiskHeader header = diskHeader(it->filePath());
+        if (isStale(header.written, kind) || header.expiry <= now) {
+            dir.remove(it->fileName());
+            it = files.erase(it);
+        } else {
+            size += it->size();
+            ++it;
+        }
+    }
+
+    if (size > m_diskSizeLimit) {
+        const qint64 target = m_diskSizeLimit - m_diskSizeLimit / 4;
+        while (size > target && !files.isEmpty()) {
+            const QFileInfo oldest = files.takeLast();
+            dir.remove(oldest.fileName());
+            size -= oldest.size();
+        }
+    }
+    m_diskSize = size;
+}
+
+QT_END_NAMESPACE
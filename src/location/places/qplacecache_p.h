@@ -0,0 +1,185 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QPLACECACHE_P_H
+#define QPLACECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qlocationcacherequests_p.h>
+#include <QtLocation/QPlace>
+#include <QtLocation/QPlaceDetailsReply>
+#include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/QPlaceSearchRequest>
+#include <QtLocation/QPlaceSearchResult>
+#include <QtCore/QCache>
+#include <QtCore/QObject>
+
+QT_BEGIN_NAMESPACE
+
+class QPlaceManagerEngine;
+
+class Q_LOCATION_PRIVATE_EXPORT QPlaceSearchCacheReply : public QPlaceSearchReply
+{
+    Q_OBJECT
+public:
+    explicit QPlaceSearchCacheReply(QObject *parent = nullptr);
+
+    void abort() override;
+
+private:
+    QLocationCacheFollower<QPlaceSearchReply> m_follower;
+
+    friend class QPlaceCache;
+    template <typename, typename, typename>
+    friend class QLocationCacheRequests;
+};
+
+class Q_LOCATION_PRIVATE_EXPORT QPlaceDetailsCacheReply : public QPlaceDetailsReply
+{
+    Q_OBJECT
+public:
+    explicit QPlaceDetailsCacheReply(QObject *parent = nullptr);
+
+    void abort() override;
+
+private:
+    QLocationCacheFollower<QPlaceDetailsReply> m_follower;
+
+    friend class QPlaceCache;
+    template <typename, typename, typename>
+    friend class QLocationCacheRequests;
+};
+
+/*
+    Remembers the search results and the place details returned by an engine,
+    in memory and optionally on disk, for a time that depends on the kind of reply,
+    and lets identical requests in flight share one reply.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QPlaceCache : public QObject
+{
+    Q_OBJECT
+public:
+    QPlaceCache(QPlaceManagerEngine *engine, const QVariantMap &parameters);
+    ~QPlaceCache();
+
+    static bool isEnabled(const QVariantMap &parameters);
+
+    QPlaceSearchReply *search(const QPlaceSearchRequest &request);
+    QPlaceDetailsReply *getPlaceDetails(const QString &placeId);
+
+    QByteArray searchKey(const QPlaceSearchRequest &request) const;
+    QByteArray detailsKey(const QString &placeId) const;
+    void clear();
+
+    qsizetype size() const;
+
+private:
+    enum Kind {
+        Search,
+        Details
+    };
+
+    struct Entry
+    {
+        Kind kind = Search;
+        QPlaceReply::Error error = QPlaceReply::NoError;
+        QString errorString;
+        QList<QPlaceSearchResult> results; // search entries
+        QPlaceSearchRequest previousPage;
+        QPlaceSearchRequest nextPage;
+        QPlace place; // details entries
+        qint64 expiry = 0; // msecs since epoch
+        quint64 generation = 0; // m_searchGeneration when stored
+    };
+
+    using SearchRequests = QLocationCacheRequests<QPlaceSearchReply, QPlaceSearchCacheReply, Entry>;
+    using DetailsRequests = QLocationCacheRequests<QPlaceDetailsReply, QPlaceDetailsCacheReply, Entry>;
+
+    static Entry result(const QPlaceSearchReply *reply);
+    static Entry result(const QPlaceDetailsReply *reply);
+    void finish(QPlaceSearchCacheReply *reply, const Entry &entry);
+    void finish(QPlaceDetailsCacheReply *reply, const Entry &entry);
+    template <typename Reply>
+    void finishReply(Reply *reply, const Entry &entry);
+
+    bool isCurrent(const Entry &entry) const;
+    bool find(const QByteArray &key, Kind kind, Entry *entry);
+    void insert(const QByteArray &key, const Entry &entry);
+    void remove(const QByteArray &key, Kind kind);
+    void invalidateSearches();
+    void placeChanged(const QString &placeId);
+
+    QString diskFileName(const QByteArray &key, Kind kind) const;
+    bool readDiskEntry(const QByteArray &key, Kind kind, Entry *entry) const;
+    void writeDiskEntry(const QByteArray &key, const Entry &entry);
+    qint64 diskTime();
+    bool isStale(qint64 written, Kind kind) const;
+    void scheduleDiskSweep();
+    void sweepDisk();
+
+    QPlaceManagerEngine *m_engine;
+    QCache<QByteArray, Entry> m_entries;
+    SearchRequests m_searches;
+    DetailsRequests m_details;
+    quint64 m_searchGeneration = 0;
+    QString m_directory;
+    qint64 m_diskSizeLimit = 10 * 1024 * 1024;
+    qint64 m_diskSize = 0; // estimated, updated by sweepDisk()
+    qint64 m_diskTime = 0;
+    qint64 m_diskSearchesInvalidated = 0; // diskTime(), files written until then are stale
+    qint64 m_diskDetailsInvalidated = 0;
+    bool m_diskSweepScheduled = false;
+    qint64 m_searchTtl = 300000;
+    qint64 m_detailsTtl = 3600000;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACECACHE_P_H
@@ -0,0 +1,276 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplacecategorycache_p.h"
+#include "qplacemanagerengine.h"
+#include "qplacemanagerengine_p.h"
+#include "qplaceicon.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const quint32 diskMagic = 0x51504354; // "QPCT"
+const quint32 diskVersion = 1;
+
+} // namespace
+
+bool QPlaceCategoryTree::isEmpty() const
+{
+    return childIds(QString()).isEmpty();
+}
+
+void QPlaceCategoryTree::clear()
+{
+    m_nodes.clear();
+}
+
+/*
+    Appends \a category to the children of \a parentId. The parent must have
+    been inserted before, categories that are already in the tree are ignored.
+*/
+void QPlaceCategoryTree::insert(const QPlaceCategory &category, const QString &parentId)
+{
+    const QString categoryId = category.categoryId();
+    if (categoryId.isEmpty() || m_nodes.contains(categoryId))
+        return;
+    if (!parentId.isEmpty() && !m_nodes.contains(parentId))
+        return;
+
+    Node &node = m_nodes[categoryId];
+    node.category = category;
+    node.parentId = parentId;
+    m_nodes[parentId].childIds.append(categoryId);
+}
+
+bool QPlaceCategoryTree::contains(const QString &categoryId) const
+{
+    return !categoryId.isEmpty() && m_nodes.contains(categoryId);
+}
+
+QPlaceCategory QPlaceCategoryTree::category(const QString &categoryId) const
+{
+    return m_nodes.value(categoryId).category;
+}
+
+QString QPlaceCategoryTree::parentId(const QString &categoryId) const
+{
+    return m_nodes.value(categoryId).parentId;
+}
+
+QStringList QPlaceCategoryTree::childIds(const QString &categoryId) const
+{
+    return m_nodes.value(categoryId).childIds;
+}
+
+QList<QPlaceCategory> QPlaceCategoryTree::childCategories(const QString &parentId) const
+{
+    QList<QPlaceCategory> categories;
+    for (const QString &id : m_nodes.value(parentId).childIds)
+        categories.append(m_nodes.value(id).category);
+    return categories;
+}
+
+/*
+    Replaces the categories with those of \a tree, and reports the differences
+    through the category signals of \a engine. Parents are added before their
+    children, and children are moved away before their old parent is removed.
+*/
+void QPlaceCategoryTree::update(const QPlaceCategoryTree &tree, QPlaceManagerEngine *engine)
+{
+    const QPlaceCategoryTree old = *this;
+    *this = tree;
+    changed(QString(), old, engine);
+    old.removed(QString(), tree, engine);
+}
+
+void QPlaceCategoryTree::removed(const QString &categoryId, const QPlaceCategoryTree &tree,
+                                 QPlaceManagerEngine *engine) const
+{
+    const Node node = m_nodes.value(categoryId);
+    for (const QString &childId : node.childIds)
+        removed(childId, tree, engine);
+    if (!categoryId.isEmpty() && !tree.contains(categoryId))
+        emit engine->categoryRemoved(categoryId, node.parentId);
+}
+
+void QPlaceCategoryTree::changed(const QString &categoryId, const QPlaceCategoryTree &old,
+                                 QPlaceManagerEngine *engine) const
+{
+    for (const QString &childId : m_nodes.value(categoryId).childIds) {
+        const QPlaceCategory category = m_nodes.value(childId).category;
+        if (!old.contains(childId))
+            emit engine->categoryAdded(category, categoryId);
+        else if (old.category(childId) != category || old.parentId(childId) != categoryId)
+            emit engine->categoryUpdated(category, categoryId);
+        changed(childId, old, engine);
+    }
+}
+
+/*
+    Categories are written parents first, in the order of their siblings, so
+    that reading inserts them back in the same order.
+*/
+void QPlaceCategoryTree::write(QDataStream &out) const
+{
+    out << qint32(m_nodes.size() - (m_nodes.contains(QString()) ? 1 : 0));
+
+    QStringList pending = childIds(QString());
+    for (qsizetype i = 0; i < pending.size(); ++i) {
+        const Node node = m_nodes.value(pending.at(i));
+        const QPlaceCategory &category = node.category;
+        out << category.categoryId() << node.parentId << category.name()
+            << int(category.visibility()) << category.icon().parameters();
+        pending.append(node.childIds);
+    }
+}
+
+bool QPlaceCategoryTree::read(QDataStream &in, QPlaceManager *manager)
+{
+    clear();
+
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString id;
+        QString parentId;
+        QString name;
+        int visibility;
+        QVariantMap iconParameters;
+        in >> id >> parentId >> name >> visibility >> iconParameters;
+
+        QPlaceCategory category;
+        category.setCategoryId(id);
+        category.setName(name);
+        category.setVisibility(QLocation::Visibility(visibility));
+        if (!iconParameters.isEmpty()) {
+            QPlaceIcon icon;
+            icon.setParameters(iconParameters);
+            icon.setManager(manager);
+            category.setIcon(icon);
+        }
+        insert(category, parentId);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+/*
+    The tree is stored in places.cache.directory, see the QPlaceManagerEngine
+    documentation. Parameters are part of the key, except for the cache ones.
+*/
+QPlaceCategoryCache::QPlaceCategoryCache(const QVariantMap &parameters)
+    : m_directory(parameters.value(QStringLiteral("places.cache.directory")).toString())
+{
+    QDataStream out(&m_parameters, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_5);
+    for (auto it = parameters.cbegin(); it != parameters.cend(); ++it) {
+        if (!it.key().startsWith(QLatin1String("places.cache.")))
+            out << it.key() << it.value().toString();
+    }
+}
+
+bool QPlaceCategoryCache::isEnabled() const
+{
+    return !m_directory.isEmpty();
+}
+
+QString QPlaceCategoryCache::fileName(const QPlaceManagerEngine *engine) const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << engine->managerName() << engine->managerVersion();
+    const QList<QLocale> locales = engine->locales();
+    for (const QLocale &locale : locales)
+        out << locale.name();
+    out << m_parameters;
+
+    const QByteArray key = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    return m_directory + QLatin1Char('/') + QString::fromLatin1(key.toHex())
+            + QStringLiteral(".categories");
+}
+
+bool QPlaceCategoryCache::load(const QPlaceManagerEngine *engine, QPlaceCategoryTree *tree) const
+{
+    if (!isEnabled())
+        return false;
+
+    QFile file(fileName(engine));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != diskMagic || version != diskVersion)
+        return false;
+
+    return tree->read(in, engine->d_ptr->manager);
+}
+
+bool QPlaceCategoryCache::save(const QPlaceManagerEngine *engine, const QPlaceCategoryTree &tree) const
+{
+    if (!isEnabled() || !QDir::root().mkpath(m_directory))
+        return false;
+
+    QSaveFile file(fileName(engine));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << diskMagic << diskVersion;
+    tree.write(out);
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+QT_END_NAMESPACE
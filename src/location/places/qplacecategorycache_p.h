@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QPLACECATEGORYCACHE_P_H
+#define QPLACECATEGORYCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/QPlaceCategory>
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+#include <QtCore/QVariantMap>
+
+QT_BEGIN_NAMESPACE
+
+class QDataStream;
+class QPlaceManager;
+class QPlaceManagerEngine;
+
+/*
+    The categories of an engine, with the root category having an empty id.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QPlaceCategoryTree
+{
+public:
+    bool isEmpty() const;
+    void clear();
+
+    void insert(const QPlaceCategory &category, const QString &parentId = QString());
+    bool contains(const QString &categoryId) const;
+
+    QPlaceCategory category(const QString &categoryId) const;
+    QString parentId(const QString &categoryId) const;
+    QStringList childIds(const QString &categoryId) const;
+    QList<QPlaceCategory> childCategories(const QString &parentId) const;
+
+    void update(const QPlaceCategoryTree &tree, QPlaceManagerEngine *engine);
+
+    void write(QDataStream &out) const;
+    bool read(QDataStream &in, QPlaceManager *manager);
+
+private:
+    void removed(const QString &categoryId, const QPlaceCategoryTree &tree,
+                 QPlaceManagerEngine *engine) const;
+    void changed(const QString &categoryId, const QPlaceCategoryTree &old,
+                 QPlaceManagerEngine *engine) const;
+
+    struct Node
+    {
+        QPlaceCategory category;
+        QString parentId;
+        QStringList childIds;
+    };
+
+    QHash<QString, Node> m_nodes;
+};
+
+/*
+    Stores the category tree of an engine on disk, so that it is available
+    before the service answers.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QPlaceCategoryCache
+{
+public:
+    explicit QPlaceCategoryCache(const QVariantMap &parameters);
+
+    bool isEnabled() const;
+    QString fileName(const QPlaceManagerEngine *engine) const;
+
+    bool load(const QPlaceManagerEngine *engine, QPlaceCategoryTree *tree) const;
+    bool save(const QPlaceManagerEngine *engine, const QPlaceCategoryTree &tree) const;
+
+private:
+    QString m_directory;
+    QByteArray m_parameters; // engine parameters, part of the key
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACECATEGORYCACHE_P_H
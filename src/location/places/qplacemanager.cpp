@@ -41,6 +41,7 @@
 
 #include "qplacemanagerengine.h"
 #include "qplacemanagerengine_p.h"
+#include "qplacecache_p.h"
 
 #include <QtCore/QDebug>
 #include <QtCore/QLocale>
@@ -220,6 +221,8 @@ int QPlaceManager::managerVersion() const
 */
 QPlaceDetailsReply *QPlaceManager::getPlaceDetails(const QString &placeId) const
 {
+    if (QPlaceCache *cache = d->d_ptr->placeCache)
+        return cache->getPlaceDetails(placeId);
     return d->getPlaceDetails(placeId);
 }
 
@@ -240,6 +243,8 @@ QPlaceContentReply *QPlaceManager::getPlaceContent(const QPlaceContentRequest &r
 */
 QPlaceSearchReply *QPlaceManager::search(const QPlaceSearchRequest &request) const
 {
+    if (QPlaceCache *cache = d->d_ptr->placeCache)
+        return cache->search(request);
     return d->search(request);
 }
 
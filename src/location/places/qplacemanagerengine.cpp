@@ -40,6 +40,7 @@
 #include "qplacemanagerengine.h"
 #include "qplacemanagerengine_p.h"
 #include "unsupportedreplies_p.h"
+#include "qplacecache_p.h"
 
 #include <QtCore/QLocale>
 #include <QtCore/QMap>
@@ -71,6 +72,48 @@ QT_BEGIN_NAMESPACE
 
     For more information on writing a backend see the \l {Places Backend} documentation.
 
+    Search results and place details can be cached by the manager, for all
+    engines, with these plugin parameters:
+
+    \table
+    \header
+        \li Parameter
+        \li Description
+    \row
+        \li places.cache.size
+        \li The number of searches and places that are kept in memory. The
+            cache is disabled when this is 0, the default.
+    \row
+        \li places.cache.ttl.search
+        \li How long, in seconds, search results are reused. Defaults to 300.
+    \row
+        \li places.cache.ttl.details
+        \li How long, in seconds, place details are reused. Defaults to 3600.
+    \row
+        \li places.cache.directory
+        \li A directory where cached replies are also stored, so that they
+            survive the application. Engines that support it also store their
+            category tree there, whether or not places.cache.size is set. Not
+            set by default.
+    \row
+        \li places.cache.disk.size
+        \li The size, in bytes, of the cached replies stored in
+            places.cache.directory. Once it is exceeded, the least recently
+            stored replies are removed. Defaults to 10 MiB.
+    \endtable
+
+    Cached replies finish from the event loop, like the replies of the engine.
+    Identical requests that are in progress at the same time share the reply
+    of the engine. Places that the engine reports as added, updated or removed are dropped
+    from the cache. Searches whose search context cannot be written to a
+    QDataStream are not cached. Replies with such contexts in their page
+    requests are only kept in memory.
+
+    Stored category trees are keyed by the engine name, version, locales and
+    parameters. Such engines answer initializeCategories() from the stored tree,
+    then fetch the categories again in the background and report the
+    differences with categoryAdded(), categoryUpdated() and categoryRemoved().
+
     \sa QPlaceManager
 */
 
@@ -84,7 +127,8 @@ QPlaceManagerEngine::QPlaceManagerEngine(const QVariantMap &parameters,
 {
     qRegisterMetaType<QPlaceReply::Error>();
     qRegisterMetaType<QPlaceReply *>();
-    Q_UNUSED(parameters);
+    if (QPlaceCache::isEnabled(parameters))
+        d_ptr->placeCache = new QPlaceCache(this, parameters);
 }
 
 /*!
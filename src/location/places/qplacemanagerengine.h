@@ -118,6 +118,8 @@ private:
 
     friend class QGeoServiceProviderPrivate;
     friend class QPlaceManager;
+    friend class QPlaceCache;
+    friend class QPlaceCategoryCache;
 };
 
 QT_END_NAMESPACE
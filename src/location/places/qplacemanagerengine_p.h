@@ -57,6 +57,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QPlaceCache;
+
 class QPlaceManagerEnginePrivate
 {
 public:
@@ -65,6 +67,7 @@ public:
     QString managerName;
     int managerVersion = -1;
     QPlaceManager *manager = nullptr;
+    QPlaceCache *placeCache = nullptr; // child of the engine, if enabled
 
 private:
     Q_DISABLE_COPY(QPlaceManagerEnginePrivate)
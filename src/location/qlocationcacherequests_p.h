@@ -0,0 +1,286 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QLOCATIONCACHEREQUESTS_P_H
+#define QLOCATIONCACHEREQUESTS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+
+#include <functional>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Kept by the replies a cache returns, as m_follower, while they follow the
+    reply of an identical request. Their abort() calls abort() on it.
+*/
+template <typename Reply>
+struct QLocationCacheFollower
+{
+    void abort(QObject *reply)
+    {
+        if (source) {
+            QObject::disconnect(source, nullptr, reply, nullptr);
+            // A request issued again for this reply only is owned by it
+            if (source->parent() == reply)
+                source->abort();
+            source.clear();
+        }
+        // What was scheduled to finish the reply is dropped
+        ++generation;
+    }
+
+    QPointer<Reply> source;
+    std::function<Reply *()> request;
+    int generation = 0;
+    bool resultPending = false;
+};
+
+/*
+    Answers requests from a cache, or lets identical requests in flight share
+    the reply of the engine. The cache snapshots the results of replies, finds,
+    stores and drops them, and finishes its own replies with them.
+*/
+template <typename Reply, typename CacheReply, typename Result>
+class QLocationCacheRequests
+{
+public:
+    using Request = std::function<Reply *()>;
+    using Snapshot = std::function<Result(const Reply *)>;
+    using Find = std::function<bool(const QByteArray &, Result *)>;
+    using Insert = std::function<void(const QByteArray &, const Result &)>;
+    using Remove = std::function<void(const QByteArray &)>;
+    using Finish = std::function<void(CacheReply *, const Result &)>;
+
+    QLocationCacheRequests(QObject *context, const Snapshot &snapshot, const Find &find,
+                           const Insert &insert, const Remove &remove, const Finish &finish)
+        : m_context(context), m_snapshot(snapshot), m_find(find), m_insert(insert),
+          m_remove(remove), m_finish(finish)
+    {
+    }
+
+    Reply *request(const QByteArray &key, const Request &request,
+                   const std::function<CacheReply *()> &createReply)
+    {
+        Result result;
+        if (m_find(key, &result)) {
+            CacheReply *reply = createReply();
+            finishLater(reply, result);
+            return reply;
+        }
+
+        if (Reply *source = m_inFlight.value(key)) {
+            CacheReply *reply = createReply();
+            reply->m_follower.request = request;
+            follow(reply, source, key);
+            return reply;
+        }
+
+        return issue(key, request);
+    }
+
+    // Requests made from now on don't follow the replies in flight
+    void clearInFlight()
+    {
+        m_inFlight.clear();
+    }
+
+    qsizetype inFlightCount() const
+    {
+        return m_inFlight.size();
+    }
+
+private:
+    Reply *issue(const QByteArray &key, const Request &request)
+    {
+        Reply *reply = request();
+        if (!reply)
+            return reply;
+        if (reply->isFinished()) {
+            m_insert(key, m_snapshot(reply));
+            return reply;
+        }
+
+        m_inFlight.insert(key, reply);
+        auto done = [this, key, reply]() {
+            const auto it = m_inFlight.constFind(key);
+            if (it != m_inFlight.cend() && (it->isNull() || it->data() == reply))
+                m_inFlight.erase(it);
+        };
+        // Some replies, QGeoCodeReply for one, emit finished() from abort() before
+        // aborted(). Their result is dropped again if aborted() follows before
+        // the event loop runs.
+        auto finishing = std::make_shared<bool>(false);
+        QObject::connect(reply, &Reply::finished, m_context, [this, key, reply, done, finishing]() {
+            done();
+            m_insert(key, m_snapshot(reply));
+            *finishing = true;
+            QMetaObject::invokeMethod(m_context, [finishing]() {
+                *finishing = false;
+            }, Qt::QueuedConnection);
+        });
+        QObject::connect(reply, &Reply::aborted, m_context, [this, key, done, finishing]() {
+            done();
+            if (*finishing)
+                m_remove(key);
+        });
+        QObject::connect(reply, &QObject::destroyed, m_context, done);
+        return reply;
+    }
+
+    void follow(CacheReply *reply, Reply *source, const QByteArray &key)
+    {
+        QLocationCacheFollower<Reply> &follower = reply->m_follower;
+        follower.source = source;
+        follower.resultPending = false;
+        const int generation = ++follower.generation;
+        // The cache may be deleted before the replies it returned
+        const QPointer<QObject> context = m_context;
+
+        // The result is delivered from the event loop, for the same reason as
+        // in issue(): an aborted() that follows has the request issued again.
+        QObject::connect(source, &Reply::finished, reply, [this, context, reply, source, generation]() {
+            if (!context)
+                return;
+            reply->m_follower.resultPending = true;
+            QMetaObject::invokeMethod(reply, [this, context, reply, generation,
+                                              result = m_snapshot(source)]() {
+                if (context && generation == reply->m_follower.generation)
+                    finishFollower(reply, result);
+            }, Qt::QueuedConnection);
+        });
+        QObject::connect(source, &Reply::aborted, reply, [this, context, reply, key]() {
+            if (context)
+                sourceLost(reply, key);
+        });
+        QObject::connect(source, &QObject::destroyed, reply, [this, context, reply, key]() {
+            if (context && !reply->isFinished() && !reply->m_follower.resultPending)
+                sourceLost(reply, key);
+        });
+    }
+
+    /*
+        Cached replies finish from the event loop, like the replies of engines,
+        so that their signals can be connected to after they are returned.
+    */
+    void finishLater(CacheReply *reply, const Result &result)
+    {
+        const int generation = reply->m_follower.generation;
+        QMetaObject::invokeMethod(reply, [this, context = QPointer<QObject>(m_context), reply,
+                                          generation, result]() {
+            if (context && generation == reply->m_follower.generation)
+                m_finish(reply, result);
+        }, Qt::QueuedConnection);
+    }
+
+    void finishFollower(CacheReply *reply, const Result &result)
+    {
+        QLocationCacheFollower<Reply> &follower = reply->m_follower;
+        if (Reply *source = follower.source) {
+            QObject::disconnect(source, nullptr, reply, nullptr);
+            if (source->parent() == reply)
+                source->deleteLater();
+        }
+        follower.source.clear();
+        follower.resultPending = false;
+        m_finish(reply, result);
+    }
+
+    /*
+        The reply being shared was aborted or deleted by its owner,
+        so the request is issued again for the replies that followed it.
+    */
+    void sourceLost(CacheReply *reply, const QByteArray &key)
+    {
+        QLocationCacheFollower<Reply> &follower = reply->m_follower;
+        if (follower.source)
+            QObject::disconnect(follower.source, nullptr, reply, nullptr);
+        follower.source.clear();
+        follower.resultPending = false;
+        ++follower.generation;
+
+        Result result;
+        if (m_find(key, &result)) {
+            finishFollower(reply, result);
+            return;
+        }
+
+        Reply *source = m_inFlight.value(key);
+        if (!source) {
+            source = issue(key, follower.request);
+            if (!source)
+                return;
+            source->setParent(reply);
+            if (source->isFinished()) {
+                follower.source = source;
+                finishFollower(reply, m_snapshot(source));
+                return;
+            }
+        }
+        follow(reply, source, key);
+    }
+
+    QObject *m_context;
+    Snapshot m_snapshot;
+    Find m_find;
+    Insert m_insert;
+    Remove m_remove;
+    Finish m_finish;
+    QHash<QByteArray, QPointer<Reply>> m_inFlight;
+};
+
+QT_END_NAMESPACE
+
+#endif // QLOCATIONCACHEREQUESTS_P_H
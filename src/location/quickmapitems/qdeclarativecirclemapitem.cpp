@@ -40,6 +40,7 @@
 #include "qdeclarativecirclemapitem_p.h"
 #include "qdeclarativepolygonmapitem_p.h"
 #include "qdeclarativecirclemapitem_p_p.h"
+#include "qgeomapitemclipper_p.h"
 
 #include <QtCore/QScopedValueRollback>
 #include <QPen>
@@ -47,6 +48,7 @@
 #include <qgeocircle.h>
 
 #include <QtGui/private/qtriangulator_p.h>
+#include <QtQuick/private/qsgmaterialshader_p.h>
 #include <QtLocation/private/qgeomap_p.h>
 #include <QtPositioning/private/qlocationutils_p.h>
 #include <QtPositioning/private/qclipperutils_p.h>
@@ -96,6 +98,11 @@ QT_BEGIN_NAMESPACE
     the same number of vertices. There is a small amount of additional
     overhead with respect to calculating the vertices first.
 
+    With the OpenGL \l backend, circles that don't cross the poles or the
+    dateline are instead drawn as a single quad, the shader computing the
+    distance of each pixel to the center. Changing the center, the radius or
+    the camera then has a constant cost, independent of the size of the circle.
+
     Like the other map objects, MapCircle is normally drawn without a smooth
     appearance. Setting the opacity property will force the object to be
     blended, which decreases performance considerably depending on the graphics
@@ -195,12 +202,7 @@ void QGeoMapCircleGeometry::updateScreenPointsInvert(const QList<QDoubleVector2D
     QList<QList<QDoubleVector2D> > clippedPaths;
     const QList<QDoubleVector2D> &visibleRegion = p.visibleGeometry();
     if (visibleRegion.size()) {
-        clipper.clearClipper();
-        for (const auto &p: difference)
-            clipper.addSubjectPath(p, true);
-        clipper.addClipPolygon(visibleRegion);
-        clippedPaths = clipper.execute(QClipperUtils::Intersection, QClipperUtils::pftEvenOdd,
-                                       QClipperUtils::pftEvenOdd);
+        clippedPaths = QGeoMapItemClipper(visibleRegion).clipPolygons(difference);
 
         // 2.1) update srcOrigin_ with the point with minimum X/Y
         lb = QDoubleVector2D(qInf(), qInf());
@@ -228,14 +230,15 @@ void QGeoMapCircleGeometry::updateScreenPointsInvert(const QList<QDoubleVector2D
     QPainterPath ppi;
     for (const QList<QDoubleVector2D> &path: clippedPaths) {
         QDoubleVector2D lastAddedPoint;
-        for (qsizetype i = 0; i < path.size(); ++i) {
-            QDoubleVector2D point = p.wrappedMapProjectionToItemPosition(path.at(i));
+        const QList<QDoubleVector2D> points = p.wrappedMapProjectionToItemPosition(path);
+        for (qsizetype i = 0; i < points.size(); ++i) {
+            const QDoubleVector2D &point = points.at(i);
             //point = point - origin; // Do this using ppi.translate()
 
             if (i == 0) {
                 ppi.moveTo(point.toPointF());
                 lastAddedPoint = point;
-            } else if ((point - lastAddedPoint).manhattanLength() > 3 || i == path.size() - 1) {
+            } else if ((point - lastAddedPoint).manhattanLength() > 3 || i == points.size() - 1) {
                 ppi.lineTo(point.toPointF());
                 lastAddedPoint = point;
             }
@@ -431,27 +434,58 @@ void QDeclarativeCircleMapItem::updatePolish()
     m_d->updatePolish();
 }
 
+enum CircleRenderer {
+    SoftwareRenderer,
+    TessellatedRenderer,
+    DistanceFieldRenderer
+};
+
+/*
+    The OpenGL backends don't do circles crossing poles yet, so these use the CPU backend instead.
+    Circles crossing the dateline are tessellated, as the quad used by the distance field
+    renderer would only be drawn on one side of it.
+*/
+static CircleRenderer circleRenderer(QDeclarativeCircleMapItem::Backend backend,
+                                     const QGeoCoordinate &center, qreal radius)
+{
+    if (backend != QDeclarativeCircleMapItem::OpenGL
+            || QDeclarativeCircleMapItemPrivate::crossEarthPole(center, radius))
+        return SoftwareRenderer;
+    if (QDeclarativeCircleMapItemPrivate::crossDateline(center, radius))
+        return TessellatedRenderer;
+    return DistanceFieldRenderer;
+}
+
+static QDeclarativeCircleMapItemPrivate *createCirclePrivate(QDeclarativeCircleMapItem &circle,
+                                                             CircleRenderer renderer)
+{
+    switch (renderer) {
+    case TessellatedRenderer:
+        return new QDeclarativeCircleMapItemPrivateOpenGL(circle);
+    case DistanceFieldRenderer:
+        return new QDeclarativeCircleMapItemPrivateDistanceField(circle);
+    case SoftwareRenderer:
+        break;
+    }
+    return new QDeclarativeCircleMapItemPrivateCPU(circle);
+}
+
 /*!
     \internal
 
-    The OpenGL backend doesn't do circles crossing poles yet.
-    So if that backend is selected and the circle crosses the poles, use the CPU backend instead.
+    Switches the renderer of the OpenGL backend if the circle starts or stops
+    crossing the poles or the dateline.
 */
 void QDeclarativeCircleMapItem::possiblySwitchBackend(const QGeoCoordinate &oldCenter, qreal oldRadius, const QGeoCoordinate &newCenter, qreal newRadius)
 {
     if (m_backend != QDeclarativeCircleMapItem::OpenGL)
         return;
 
-    // if old does not cross and new crosses, move to CPU.
-    if (!QDeclarativeCircleMapItemPrivate::crossEarthPole(oldCenter, oldRadius)
-            && !QDeclarativeCircleMapItemPrivate::crossEarthPole(newCenter, newRadius)) {
-        std::unique_ptr<QDeclarativeCircleMapItemPrivate> d(static_cast<QDeclarativeCircleMapItemPrivate *>(new QDeclarativeCircleMapItemPrivateCPU(*this)));
-        std::swap(m_d, d);
-    } else if (QDeclarativeCircleMapItemPrivate::crossEarthPole(oldCenter, oldRadius)
-               && !QDeclarativeCircleMapItemPrivate::crossEarthPole(newCenter, newRadius)) { // else if old crosses and new does not cross, move back to OpenGL
-        std::unique_ptr<QDeclarativeCircleMapItemPrivate> d(static_cast<QDeclarativeCircleMapItemPrivate *>(new QDeclarativeCircleMapItemPrivateOpenGL(*this)));
-        std::swap(m_d, d);
-    }
+    const CircleRenderer renderer = circleRenderer(m_backend, newCenter, newRadius);
+    if (renderer == circleRenderer(m_backend, oldCenter, oldRadius))
+        return;
+    std::unique_ptr<QDeclarativeCircleMapItemPrivate> d(createCirclePrivate(*this, renderer));
+    std::swap(m_d, d);
 }
 
 /*!
@@ -528,10 +562,7 @@ void QDeclarativeCircleMapItem::setBackend(QDeclarativeCircleMapItem::Backend b)
         return;
     m_backend = b;
     std::unique_ptr<QDeclarativeCircleMapItemPrivate> d(
-            (m_backend == Software) ? static_cast<QDeclarativeCircleMapItemPrivate *>(
-                    new QDeclarativeCircleMapItemPrivateCPU(*this))
-                                    : static_cast<QDeclarativeCircleMapItemPrivate *>(
-                                            new QDeclarativeCircleMapItemPrivateOpenGL(*this)));
+            createCirclePrivate(*this, circleRenderer(m_backend, m_circle.center(), m_circle.radius())));
     std::swap(m_d, d);
     m_d->onGeoGeometryChanged();
     emit backendChanged();
@@ -562,6 +593,137 @@ QDeclarativeCircleMapItemPrivateCPU::~QDeclarativeCircleMapItemPrivateCPU() {}
 
 QDeclarativeCircleMapItemPrivateOpenGL::~QDeclarativeCircleMapItemPrivateOpenGL() {}
 
+QDeclarativeCircleMapItemPrivateDistanceField::~QDeclarativeCircleMapItemPrivateDistanceField() {}
+
+void QDeclarativeCircleMapItemPrivateDistanceField::updateSourceQuad()
+{
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_circle.map()->geoProjection());
+    const QGeoCoordinate &center = m_circle.m_circle.center();
+    const qreal radius = m_circle.m_circle.radius();
+
+    // Bounding box of the circle: the latitude extent is the angular radius,
+    // the longitude extent is widened by the latitude.
+    m_radiusAngle = radius / QLocationUtils::earthMeanRadius();
+    m_centerMercator = p.geoToMapProjection(center);
+    const qreal latitudeExtent = QLocationUtils::degrees(m_radiusAngle);
+    const qreal halfWidth = longitudeExtent(center, radius) / 360.0;
+    const double top = p.geoToMapProjection(
+                QGeoCoordinate(qMin(center.latitude() + latitudeExtent, 90.0), center.longitude())).y();
+    const double bottom = p.geoToMapProjection(
+                QGeoCoordinate(qMax(center.latitude() - latitudeExtent, -90.0), center.longitude())).y();
+    m_sourceQuad = QRectF(-halfWidth, top - m_centerMercator.y(), 2.0 * halfWidth, bottom - top);
+    m_sourceDirty = false;
+}
+
+void QDeclarativeCircleMapItemPrivateDistanceField::updatePolish()
+{
+    if (!m_circle.m_circle.isValid()) {
+        m_onScreen = false;
+        m_circle.setWidth(0);
+        m_circle.setHeight(0);
+        return;
+    }
+
+    QScopedValueRollback<bool> rollback(m_circle.m_updatingGeometry);
+    m_circle.m_updatingGeometry = true;
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_circle.map()->geoProjection());
+    if (m_sourceDirty)
+        updateSourceQuad();
+
+    // Grow the quad to fit the border and the antialiasing. The margin is doubled,
+    // as pixels cover more of the map on the far side of a tilted map.
+    m_pixelsPerMercator = p.mapWidth();
+    const qreal borderWidth = (m_circle.m_border.color().alpha() != 0) ? m_circle.m_border.width() : 0.0;
+    const qreal margin = 2.0 * (0.5 * borderWidth + 1.0) / m_pixelsPerMercator;
+    const QRectF quad = m_sourceQuad.adjusted(-margin, -margin, margin, margin);
+    if (quad != m_quad) {
+        m_quad = quad;
+        m_quadChanged = true;
+    }
+    m_wrapOffset = p.projectionWrapFactor(m_centerMercator);
+
+    // The item geometry is only used for the interaction with QtQuick
+    const QDoubleVector2D wrappedCenter = m_centerMercator + QDoubleVector2D(m_wrapOffset, 0.0);
+    const QList<QDoubleVector2D> wrappedQuad = {
+        wrappedCenter + QDoubleVector2D(quad.left(), quad.top()),
+        wrappedCenter + QDoubleVector2D(quad.right(), quad.top()),
+        wrappedCenter + QDoubleVector2D(quad.right(), quad.bottom()),
+        wrappedCenter + QDoubleVector2D(quad.left(), quad.bottom())
+    };
+    QList<QList<QDoubleVector2D>> clippedQuad;
+    QDeclarativeGeoMapItemUtils::clipPolygon(wrappedQuad, p, clippedQuad);
+    if (clippedQuad.isEmpty() || clippedQuad.first().size() < 3) {
+        m_onScreen = false;
+        m_circle.setWidth(0);
+        m_circle.setHeight(0);
+        return;
+    }
+
+    QPainterPath ppi;
+    QDeclarativeGeoMapItemUtils::projectBbox(clippedQuad.first(), p, ppi);
+    const QRectF brect = ppi.boundingRect();
+    m_onScreen = true;
+    m_circle.setWidth(brect.width());
+    m_circle.setHeight(brect.height());
+    m_circle.setPosition(brect.topLeft());
+}
+
+QSGNode *QDeclarativeCircleMapItemPrivateDistanceField::updateMapItemPaintNode(QSGNode *oldNode,
+                                                                              QQuickItem::UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+
+    if (!m_node || !oldNode) {
+        m_node = new MapCircleNodeDistanceField();
+        m_quadChanged = true;
+        if (oldNode)
+            delete oldNode;
+    } else {
+        m_node = static_cast<MapCircleNodeDistanceField *>(oldNode);
+    }
+
+    if (!m_onScreen) {
+        m_node->setSubtreeBlocked(true);
+        return m_node;
+    }
+
+    const QGeoMap *map = m_circle.map();
+    m_node->update(m_circle.m_color,
+                   m_circle.m_border.color(),
+                   m_circle.m_border.width(),
+                   m_centerMercator,
+                   m_radiusAngle,
+                   m_quad,
+                   m_quadChanged,
+                   m_wrapOffset,
+                   map->geoProjection().qsgTransform(),
+                   map->geoProjection().centerMercator());
+    m_quadChanged = false;
+    m_circle.m_dirtyMaterial = false;
+    return m_node;
+}
+
+bool QDeclarativeCircleMapItemPrivateDistanceField::contains(const QPointF &point) const
+{
+    QDeclarativeGeoMap *m = m_circle.quickMap();
+    if (!m || !m_onScreen)
+        return false;
+    const QGeoCoordinate crd = m->toCoordinate(m->mapFromItem(&m_circle, point));
+    if (!crd.isValid())
+        return false;
+
+    // Half of the border is outside of the circle. At the center latitude,
+    // a mercator unit is one parallel long.
+    qreal tolerance = 0;
+    const qreal lineWidth = m_circle.m_border.width();
+    if (m_circle.m_border.color().alpha() != 0 && lineWidth > 0 && m_pixelsPerMercator > 0) {
+        const qreal parallelLength = 2.0 * M_PI * QLocationUtils::earthMeanRadius()
+                * std::cos(QLocationUtils::radians(m_circle.m_circle.center().latitude()));
+        tolerance = 0.5 * lineWidth / m_pixelsPerMercator * parallelLength;
+    }
+    return crd.distanceTo(m_circle.m_circle.center()) <= m_circle.m_circle.radius() + tolerance;
+}
+
 bool QDeclarativeCircleMapItemPrivate::preserveCircleGeometry (QList<QDoubleVector2D> &path,
                                     const QGeoCoordinate &center, qreal distance, const QGeoProjectionWebMercator &p)
 {
@@ -662,6 +824,26 @@ bool QDeclarativeCircleMapItemPrivate::crossEarthPole(const QGeoCoordinate &cent
     return false;
 }
 
+/*
+    Returns how many degrees of longitude the circle spans on each side of its center.
+    Only meaningful for circles that don't cross the poles.
+*/
+qreal QDeclarativeCircleMapItemPrivate::longitudeExtent(const QGeoCoordinate &center, qreal distance)
+{
+    if (!(distance > 0))
+        return 0;
+    const qreal cosLat = std::cos(QLocationUtils::radians(center.latitude()));
+    const qreal sinExtent = std::sin(distance / QLocationUtils::earthMeanRadius()) / cosLat;
+    if (!(cosLat > 0) || sinExtent >= 1)
+        return 180;
+    return QLocationUtils::degrees(std::asin(sinExtent));
+}
+
+bool QDeclarativeCircleMapItemPrivate::crossDateline(const QGeoCoordinate &center, qreal distance)
+{
+    return qAbs(center.longitude()) + longitudeExtent(center, distance) > 180;
+}
+
 void QDeclarativeCircleMapItemPrivate::calculatePeripheralPoints(QList<QGeoCoordinate> &path,
                                       const QGeoCoordinate &center,
                                       qreal distance,
@@ -711,4 +893,133 @@ void QDeclarativeCircleMapItemPrivate::calculatePeripheralPoints(QList<QGeoCoord
 
 //////////////////////////////////////////////////////////////////////
 
+QSGMaterialShader *MapCircleMaterial::createShader(QSGRendererInterface::RenderMode renderMode) const
+{
+    Q_UNUSED(renderMode);
+    return new MapCircleShader();
+}
+
+int MapCircleMaterial::compare(const QSGMaterial *other) const
+{
+    const MapCircleMaterial &o = *static_cast<const MapCircleMaterial *>(other);
+    if (o.m_center == m_center && o.m_geoProjection == m_geoProjection && o.m_wrapOffset == m_wrapOffset
+            && o.m_circleCenter == m_circleCenter && o.m_radius == m_radius
+            && o.m_borderWidth == m_borderWidth && o.m_color == m_color
+            && o.m_borderColor == m_borderColor)
+        return 0;
+    return -1;
+}
+
+QSGMaterialType *MapCircleMaterial::type() const
+{
+    static QSGMaterialType type;
+    return &type;
+}
+
+MapCircleNodeDistanceField::MapCircleNodeDistanceField() :
+    geometry_(QSGGeometry::defaultAttributes_Point2D(), 0)
+{
+    geometry_.setDrawingMode(QSGGeometry::DrawTriangleStrip);
+    QSGGeometryNode::setMaterial(&material_);
+    QSGGeometryNode::setGeometry(&geometry_);
+}
+
+MapCircleNodeDistanceField::~MapCircleNodeDistanceField()
+{
+}
+
+/*!
+    \internal
+
+    \a quad is relative to \a circleCenter, so that the vertices keep their
+    precision at high zoom levels.
+*/
+void MapCircleNodeDistanceField::update(const QColor &fillColor, const QColor &borderColor, qreal borderWidth,
+                                        const QDoubleVector2D &circleCenter, qreal radius, const QRectF &quad,
+                                        bool quadChanged, int wrapOffset,
+                                        const QMatrix4x4 &geoProjection, const QDoubleVector3D &center)
+{
+    const bool hasBorder = borderColor.alpha() != 0 && borderWidth > 0;
+    if (fillColor.alpha() == 0 && !hasBorder) {
+        setSubtreeBlocked(true);
+        return;
+    }
+    setSubtreeBlocked(false);
+
+    if (quadChanged || !geometry_.vertexCount()) {
+        QGeoMapItemGeometry::reserveGeometry(&geometry_, 4);
+        QSGGeometry::Point2D *vertices = geometry_.vertexDataAsPoint2D();
+        vertices[0].set(quad.left(), quad.top());
+        vertices[1].set(quad.right(), quad.top());
+        vertices[2].set(quad.left(), quad.bottom());
+        vertices[3].set(quad.right(), quad.bottom());
+        QGeoMapItemGeometry::commitGeometry(&geometry_, 4);
+        markDirty(DirtyGeometry);
+    }
+
+    material_.m_geoProjection = geoProjection;
+    material_.m_center = center;
+    material_.m_circleCenter = circleCenter;
+    material_.m_color = fillColor;
+    material_.m_borderColor = borderColor;
+    material_.m_wrapOffset = wrapOffset;
+    material_.m_radius = float(radius);
+    material_.m_borderWidth = hasBorder ? float(borderWidth) : 0.0f;
+    markDirty(DirtyMaterial);
+}
+
+MapCircleShader::MapCircleShader() : QSGMaterialShader(*new QSGMaterialShaderPrivate(this))
+{
+    setShaderFileName(VertexStage, QLatin1String(":/location/quickmapitems/shaders/circle.vert.qsb"));
+    setShaderFileName(FragmentStage, QLatin1String(":/location/quickmapitems/shaders/circle.frag.qsb"));
+}
+
+bool MapCircleShader::updateUniformData(RenderState &state, QSGMaterial *newEffect, QSGMaterial *oldEffect)
+{
+    Q_ASSERT(oldEffect == nullptr || newEffect->type() == oldEffect->type());
+    Q_UNUSED(oldEffect);
+    MapCircleMaterial *newMaterial = static_cast<MapCircleMaterial *>(newEffect);
+
+    const QDoubleVector3D &center = newMaterial->m_center;
+    const QDoubleVector2D &circleCenter = newMaterial->m_circleCenter;
+
+    QVector4D vecCenter, vecCenter_lowpart, vecCircleCenter;
+    for (int i = 0; i < 3; i++)
+        QLocationUtils::split_double(center.get(i), &vecCenter[i], &vecCenter_lowpart[i]);
+    vecCenter[3] = 0;
+    vecCenter_lowpart[3] = 0;
+    QLocationUtils::split_double(circleCenter.x(), &vecCircleCenter[0], &vecCircleCenter[2]);
+    QLocationUtils::split_double(circleCenter.y(), &vecCircleCenter[1], &vecCircleCenter[3]);
+
+    const auto premultiplied = [&state](const QColor &c) {
+        const float opacity = state.opacity() * c.alphaF();
+        return QVector4D(c.redF() * opacity, c.greenF() * opacity, c.blueF() * opacity, opacity);
+    };
+    const QVector4D color = premultiplied(newMaterial->m_color);
+    const QVector4D borderColor = premultiplied(newMaterial->m_borderColor);
+
+    int offset = 0;
+    char *buf_p = state.uniformData()->data();
+
+    if (state.isMatrixDirty()) {
+        const QMatrix4x4 m = state.projectionMatrix();
+        memcpy(buf_p + offset, m.constData(), 4*4*4);
+    }
+    offset += 4*4*4;
+
+    memcpy(buf_p + offset, newMaterial->m_geoProjection.constData(), 4*4*4); offset += 4*4*4;
+    memcpy(buf_p + offset, &vecCenter, 4*4); offset += 4*4;
+    memcpy(buf_p + offset, &vecCenter_lowpart, 4*4); offset += 4*4;
+    memcpy(buf_p + offset, &vecCircleCenter, 4*4); offset += 4*4;
+    memcpy(buf_p + offset, &color, 4*4); offset += 4*4;
+    memcpy(buf_p + offset, &borderColor, 4*4); offset += 4*4;
+
+    const float wrapOffset = newMaterial->m_wrapOffset;
+    memcpy(buf_p + offset, &wrapOffset, 4); offset += 4;
+    memcpy(buf_p + offset, &newMaterial->m_radius, 4); offset += 4;
+    memcpy(buf_p + offset, &newMaterial->m_borderWidth, 4); offset += 4;
+
+    return true;
+}
+
 QT_END_NAMESPACE
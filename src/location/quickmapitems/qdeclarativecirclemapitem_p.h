@@ -136,6 +136,7 @@ private:
     friend class QDeclarativeCircleMapItemPrivate;
     friend class QDeclarativeCircleMapItemPrivateCPU;
     friend class QDeclarativeCircleMapItemPrivateOpenGL;
+    friend class QDeclarativeCircleMapItemPrivateDistanceField;
 };
 
 //////////////////////////////////////////////////////////////////////
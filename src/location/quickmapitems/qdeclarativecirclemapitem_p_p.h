@@ -66,6 +66,52 @@ public:
     void updateScreenPointsInvert(const QList<QDoubleVector2D> &circlePath, const QGeoMap &map);
 };
 
+class Q_LOCATION_PRIVATE_EXPORT MapCircleShader : public QSGMaterialShader
+{
+public:
+    MapCircleShader();
+
+    bool updateUniformData(RenderState &state, QSGMaterial *newEffect, QSGMaterial *oldEffect) override;
+};
+
+class Q_LOCATION_PRIVATE_EXPORT MapCircleMaterial : public QSGMaterial
+{
+public:
+    MapCircleMaterial()
+    {
+        // See MapPolygonMaterial: the shader needs the untransformed mercator offsets.
+        setFlag(Blending | RequiresFullMatrix);
+    }
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode renderMode) const override;
+    int compare(const QSGMaterial *other) const override;
+    QSGMaterialType *type() const override;
+
+    QMatrix4x4 m_geoProjection;
+    QDoubleVector3D m_center;       // camera center, in mercator
+    QDoubleVector2D m_circleCenter; // in mercator
+    QColor m_color;
+    QColor m_borderColor;
+    int m_wrapOffset = 0;
+    float m_radius = 0;             // angular radius, in radians
+    float m_borderWidth = 0;        // in pixels
+};
+
+class Q_LOCATION_PRIVATE_EXPORT MapCircleNodeDistanceField : public MapItemGeometryNode
+{
+public:
+    MapCircleNodeDistanceField();
+    ~MapCircleNodeDistanceField() override;
+
+    void update(const QColor &fillColor, const QColor &borderColor, qreal borderWidth,
+                const QDoubleVector2D &circleCenter, qreal radius, const QRectF &quad,
+                bool quadChanged, int wrapOffset,
+                const QMatrix4x4 &geoProjection, const QDoubleVector3D &center);
+
+    MapCircleMaterial material_;
+    QSGGeometry geometry_;
+};
+
 class Q_LOCATION_PRIVATE_EXPORT QDeclarativeCircleMapItemPrivate
 {
 public:
@@ -98,12 +144,12 @@ public:
         const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_circle.map()->geoProjection());
         QList<QGeoCoordinate> path;
         calculatePeripheralPoints(path, m_circle.center(), m_circle.radius(), CircleSamples, m_leftBound);
-        m_circlePath.clear();
-        for (const QGeoCoordinate &c : path)
-            m_circlePath << p.geoToMapProjection(c);
+        m_circlePath = p.geoToMapProjection(path);
     }
 
     static bool crossEarthPole(const QGeoCoordinate &center, qreal distance);
+    static bool crossDateline(const QGeoCoordinate &center, qreal distance);
+    static qreal longitudeExtent(const QGeoCoordinate &center, qreal distance);
 
     static bool preserveCircleGeometry(QList<QDoubleVector2D> &path, const QGeoCoordinate &center,
                                 qreal distance, const QGeoProjectionWebMercator &p);
@@ -447,6 +493,69 @@ public:
     MapPolylineNodeOpenGLExtruded *m_polylinenode = nullptr;
 };
 
+/*
+    Draws the circle as a single quad, computing the great circle distance of each
+    fragment to the center in the shader. Used by the OpenGL backend for the circles
+    that don't cross the poles or the dateline.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QDeclarativeCircleMapItemPrivateDistanceField: public QDeclarativeCircleMapItemPrivate
+{
+public:
+    QDeclarativeCircleMapItemPrivateDistanceField(QDeclarativeCircleMapItem &circle) : QDeclarativeCircleMapItemPrivate(circle)
+    {
+    }
+
+    QDeclarativeCircleMapItemPrivateDistanceField(QDeclarativeCircleMapItemPrivate &other)
+    : QDeclarativeCircleMapItemPrivate(other)
+    {
+    }
+
+    ~QDeclarativeCircleMapItemPrivateDistanceField() override;
+
+    void onLinePropertiesChanged() override
+    {
+        m_circle.m_dirtyMaterial = true;
+        m_circle.polishAndUpdate();
+    }
+    void markSourceDirtyAndUpdate() override
+    {
+        m_sourceDirty = true;
+        m_circle.polishAndUpdate();
+    }
+    void onMapSet() override
+    {
+        markSourceDirtyAndUpdate();
+    }
+    void onGeoGeometryChanged() override
+    {
+        markSourceDirtyAndUpdate();
+    }
+    void onItemGeometryChanged() override
+    {
+        onGeoGeometryChanged();
+    }
+    void afterViewportChanged() override
+    {
+        m_circle.polishAndUpdate();
+    }
+    void updatePolish() override;
+    QSGNode * updateMapItemPaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *data) override;
+    bool contains(const QPointF &point) const override;
+
+    void updateSourceQuad();
+
+    QDoubleVector2D m_centerMercator;
+    QRectF m_sourceQuad;            // relative to m_centerMercator, without the border
+    QRectF m_quad;                  // m_sourceQuad grown by the border and antialiasing margin
+    qreal m_radiusAngle = 0;
+    qreal m_pixelsPerMercator = 0;
+    int m_wrapOffset = 0;
+    bool m_sourceDirty = true;
+    bool m_quadChanged = true;
+    bool m_onScreen = false;
+    MapCircleNodeDistanceField *m_node = nullptr;
+};
+
 QT_END_NAMESPACE
 
 #endif // QDECLARATIVECIRCLEMAPITEM_P_P_H
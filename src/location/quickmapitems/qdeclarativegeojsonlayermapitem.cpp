@@ -0,0 +1,1102 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qdeclarativegeojsonlayermapitem_p.h"
+#include "qdeclarativegeojsonlayermapitem_p_p.h"
+#include "qdeclarativecirclemapitem_p_p.h"
+#include "qgeosimplify_p.h"
+#include "qgeomapitemearcut_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QThreadPool>
+#include <QtQml/QJSValue>
+#include <QtLocation/private/qgeomap_p.h>
+#include <QtLocation/private/qgeoprojection_p.h>
+#include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoPath>
+#include <QtPositioning/QGeoPolygon>
+#include <QtPositioning/private/qwebmercator_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \qmltype MapGeoJsonLayer
+    \instantiates QDeclarativeGeoJsonLayerMapItem
+    \inqmlmodule QtLocation
+    \ingroup qml-QtLocation5-maps
+    \since QtLocation 6.5
+
+    \brief The MapGeoJsonLayer type displays a whole GeoJSON document on a Map.
+
+    The MapGeoJsonLayer type draws the geometry imported from a GeoJSON
+    document, as returned by QGeoJson::importGeoJson(), without creating a
+    map item per geometry. Polygons, MultiPolygons and Points are filled,
+    LineStrings and MultiLineStrings are drawn as lines. Points are drawn as
+    circles with a radius of \l pointRadius meters.
+
+    Each feature is filled with the color held by its \l colorProperty
+    property, or with \l color if it has none. Lines use the color of their
+    feature too, or \l line.color. Polygons and circles are outlined with
+    \l border.color.
+
+    The features are flattened, triangulated and simplified on a worker
+    thread, and the whole document is then drawn with one scene graph node
+    per color. This makes the cost of a layer per frame independent of the
+    number of features, while a \l MapItemView instantiating a delegate per
+    geometry pays for one QML object, with its bindings, and one node per
+    geometry. Like the one of \l MapPolyline, the geometry is simplified at
+    zoom levels below \c lodThreshold.
+
+    Features can be picked with \l featureAt(), which uses a spatial index
+    rather than testing every feature.
+
+    \note Features are drawn grouped by color, so overlapping features with
+    different colors are not necessarily drawn in document order.
+    MapGeoJsonLayer requires a scene graph backend supporting shaders, as
+    the OpenGL backends of the other map items do.
+
+    \section2 Example Usage
+
+    \code
+    Map {
+        MapGeoJsonLayer {
+            geoJson: geoJsonData.model
+            color: "lightsteelblue"
+            border.color: "white"
+            opacity: 0.6
+
+            MouseArea {
+                anchors.fill: parent
+                onClicked: (mouse) => console.log(parent.featureAt(Qt.point(mouse.x, mouse.y)).properties.name)
+            }
+        }
+    }
+    \endcode
+*/
+
+namespace {
+
+const QString typeKey = QStringLiteral("type");
+const QString dataKey = QStringLiteral("data");
+const QString propertiesKey = QStringLiteral("properties");
+
+// An invalid color when the item, or the style, has no color property
+QColor propertyColor(const QVariantMap &item, const QString &colorProperty)
+{
+    if (colorProperty.isEmpty())
+        return QColor();
+    const QVariant value = item.value(propertiesKey).toMap().value(colorProperty);
+    if (value.typeId() == QMetaType::QColor)
+        return value.value<QColor>();
+    return QColor(value.toString());
+}
+
+// Mercator coordinates unwrapped relative to leftBound, or an empty list if
+// one of them can't be projected.
+QList<QDoubleVector2D> unwrappedPath(const QList<QGeoCoordinate> &path, double leftBound)
+{
+    QList<QDoubleVector2D> res;
+    res.reserve(path.size());
+    for (const QGeoCoordinate &c : path) {
+        QDoubleVector2D p = QWebMercator::coordToMercator(c);
+        if (!qIsFinite(p.x()) || !qIsFinite(p.y()))
+            return {};
+        if (p.x() < leftBound)
+            p.setX(p.x() + 1.0);
+        res << p;
+    }
+    return res;
+}
+
+QRectF pathBounds(const QList<QDoubleVector2D> &path)
+{
+    double minX = path.first().x();
+    double maxX = minX;
+    double minY = path.first().y();
+    double maxY = minY;
+    for (const QDoubleVector2D &p : path) {
+        minX = qMin(minX, p.x());
+        maxX = qMax(maxX, p.x());
+        minY = qMin(minY, p.y());
+        maxY = qMax(maxY, p.y());
+    }
+    return QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+}
+
+QRectF unitedBounds(const QRectF &a, const QRectF &b)
+{
+    // QRectF::united() ignores empty rectangles, such as the bounds of a vertical line
+    if (a.isNull())
+        return b;
+    return QRectF(QPointF(qMin(a.left(), b.left()), qMin(a.top(), b.top())),
+                  QPointF(qMax(a.right(), b.right()), qMax(a.bottom(), b.bottom())));
+}
+
+QList<QDeclarativeGeoMapItemUtils::vec2> toVec2(const QList<QDoubleVector2D> &path, bool closed)
+{
+    QList<QDeclarativeGeoMapItemUtils::vec2> res;
+    res.reserve(path.size() + 1);
+    for (const QDoubleVector2D &p : path)
+        res << p;
+    if (closed)
+        res << path.first();
+    return res;
+}
+
+void appendEntries(QGeoJsonLayerGeometry::LineBatch &batch, const QList<QDoubleVector2D> &path,
+                   bool closed)
+{
+    const QList<QDeclarativeGeoMapItemUtils::vec2> v = toVec2(path, closed);
+    if (v.size() < 2)
+        return;
+    const qsizetype first = batch.entries.size();
+    batch.entries.resize(first + (v.size() - 1) * 6); // six vertices per line segment
+    MapPolylineNodeOpenGLExtruded::fillEntries(batch.entries.data() + first, v, closed);
+}
+
+void updateRange(double &minX, double &maxX, const QList<QDoubleVector2D> &path, bool first)
+{
+    for (const QDoubleVector2D &p : path) {
+        if (first) {
+            minX = maxX = p.x();
+            first = false;
+        } else {
+            minX = qMin(minX, p.x());
+            maxX = qMax(maxX, p.x());
+        }
+    }
+}
+
+} // anonymous namespace
+
+/*!
+    \internal
+*/
+int QGeoJsonLayerIndex::column(double x)
+{
+    return qBound(0, int(x * 0.5 * Columns), Columns - 1);
+}
+
+/*!
+    \internal
+*/
+int QGeoJsonLayerIndex::row(double y)
+{
+    return qBound(0, int(y * Rows), Rows - 1);
+}
+
+/*!
+    \internal
+*/
+void QGeoJsonLayerIndex::build(const QList<QGeoJsonLayerFeature> &features)
+{
+    m_cells = QList<QList<qsizetype>>(Columns * Rows);
+    for (qsizetype i = 0; i < features.size(); ++i) {
+        const QGeoJsonLayerFeature &feature = features.at(i);
+        if (feature.shapes.isEmpty())
+            continue;
+        const int right = column(feature.bounds.right());
+        const int bottom = row(feature.bounds.bottom());
+        for (int r = row(feature.bounds.top()); r <= bottom; ++r) {
+            for (int c = column(feature.bounds.left()); c <= right; ++c)
+                m_cells[r * Columns + c] << i;
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Returns, in increasing order, the features whose bounds may lie within
+    \a tolerance of \a point.
+*/
+QList<qsizetype> QGeoJsonLayerIndex::candidates(const QDoubleVector2D &point, double tolerance) const
+{
+    QList<qsizetype> res;
+    if (m_cells.isEmpty())
+        return res;
+    const int right = column(point.x() + tolerance);
+    const int bottom = row(point.y() + tolerance);
+    for (int r = row(point.y() - tolerance); r <= bottom; ++r) {
+        for (int c = column(point.x() - tolerance); c <= right; ++c)
+            res << m_cells.at(r * Columns + c);
+    }
+    std::sort(res.begin(), res.end());
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+    return res;
+}
+
+/*!
+    \internal
+
+    Flattens the imported GeoJSON document \a geoJson into features styled
+    with \a style. The items of a FeatureCollection are features, any other
+    item at the top level is a feature too. A color property applies to the
+    item holding it and to the items nested in it.
+*/
+std::shared_ptr<const QGeoJsonLayerData> QGeoJsonLayerData::create(const QVariantList &geoJson,
+                                                                   const Style &style)
+{
+    auto data = std::make_shared<QGeoJsonLayerData>();
+    for (const QVariant &v : geoJson) {
+        const QVariantMap item = v.toMap();
+        if (item.value(typeKey).toString() == QLatin1String("FeatureCollection")) {
+            const QColor color = propertyColor(item, style.colorProperty);
+            const QVariantList features = item.value(dataKey).toList();
+            for (const QVariant &f : features) {
+                QGeoJsonLayerFeature feature;
+                feature.item = f.toMap();
+                data->addItem(feature.item, feature, color, style);
+                data->features << feature;
+            }
+        } else {
+            QGeoJsonLayerFeature feature;
+            feature.item = item;
+            data->addItem(item, feature, QColor(), style);
+            data->features << feature;
+        }
+    }
+    data->index.build(data->features);
+    return data;
+}
+
+void QGeoJsonLayerData::addItem(const QVariantMap &item, QGeoJsonLayerFeature &feature,
+                                QColor color, const Style &style)
+{
+    const QColor itemColor = propertyColor(item, style.colorProperty);
+    if (itemColor.isValid())
+        color = itemColor;
+
+    const QString type = item.value(typeKey).toString();
+    const QVariant data = item.value(dataKey);
+    QGeoJsonLayerShape shape;
+    QGeoRectangle bounds;
+    if (type == QLatin1String("Polygon")) {
+        const QGeoPolygon polygon = data.value<QGeoPolygon>();
+        bounds = polygon.boundingGeoRectangle();
+        shape.type = QGeoJsonLayerShape::Polygon;
+        shape.color = color.isValid() ? color : style.color;
+        shape.leftBound = QWebMercator::coordToMercator(bounds.topLeft()).x();
+        shape.paths << unwrappedPath(polygon.perimeter(), shape.leftBound);
+        for (qsizetype i = 0; i < polygon.holesCount(); ++i)
+            shape.paths << unwrappedPath(polygon.holePath(i), shape.leftBound);
+        if (shape.paths.first().size() < 3)
+            return;
+    } else if (type == QLatin1String("LineString")) {
+        const QGeoPath path = data.value<QGeoPath>();
+        bounds = path.boundingGeoRectangle();
+        shape.type = QGeoJsonLayerShape::Line;
+        shape.color = color.isValid() ? color : style.lineColor;
+        shape.leftBound = QWebMercator::coordToMercator(bounds.topLeft()).x();
+        shape.paths << unwrappedPath(path.path(), shape.leftBound);
+        if (shape.paths.first().size() < 2)
+            return;
+    } else if (type == QLatin1String("Point")) {
+        const QGeoCircle point = data.value<QGeoCircle>();
+        const QGeoCircle circle(point.center(),
+                                point.radius() > 0 ? point.radius() : style.pointRadius);
+        if (!circle.isValid())
+            return;
+        bounds = circle.boundingGeoRectangle();
+        QList<QGeoCoordinate> perimeter;
+        QGeoCoordinate leftBound;
+        QDeclarativeCircleMapItemPrivate::calculatePeripheralPoints(perimeter, circle.center(),
+                                                                    circle.radius(), CircleSamples,
+                                                                    leftBound);
+        shape.type = QGeoJsonLayerShape::Circle;
+        shape.color = color.isValid() ? color : style.color;
+        shape.leftBound = QWebMercator::coordToMercator(leftBound).x();
+        shape.paths << unwrappedPath(perimeter, shape.leftBound);
+        if (shape.paths.first().isEmpty())
+            return;
+    } else {
+        // MultiPoint, MultiLineString, MultiPolygon and GeometryCollection
+        const QVariantList children = data.toList();
+        for (const QVariant &child : children)
+            addItem(child.toMap(), feature, color, style);
+        return;
+    }
+
+    shape.paths.removeIf([](const QList<QDoubleVector2D> &path) { return path.isEmpty(); });
+    feature.bounds = unitedBounds(feature.bounds, pathBounds(shape.paths.first()));
+    feature.shapes << shape;
+    if (!boundingRectangle.isValid())
+        boundingRectangle = bounds;
+    else
+        boundingRectangle |= bounds;
+}
+
+/*!
+    \internal
+
+    Returns true if \a point, unwrapped like the paths of \a shape, lies in
+    the polygon or the circle, or within \a tolerance of the line.
+*/
+bool QGeoJsonLayerData::contains(const QGeoJsonLayerShape &shape, const QDoubleVector2D &point,
+                                 double tolerance)
+{
+    if (shape.type == QGeoJsonLayerShape::Line) {
+        const QList<QDoubleVector2D> &path = shape.paths.first();
+        for (qsizetype i = 1; i < path.size(); ++i) {
+            if (QGeoMapPolylineGeometryOpenGL::distanceTo(path.at(i - 1), path.at(i), point)
+                    <= tolerance) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Even-odd rule, so that holes are excluded
+    bool inside = false;
+    for (const QList<QDoubleVector2D> &path : shape.paths) {
+        for (qsizetype i = 0, j = path.size() - 1; i < path.size(); j = i++) {
+            const QDoubleVector2D &a = path.at(i);
+            const QDoubleVector2D &b = path.at(j);
+            if ((a.y() > point.y()) != (b.y() > point.y())
+                    && point.x() < (b.x() - a.x()) * (point.y() - a.y()) / (b.y() - a.y()) + a.x()) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+/*!
+    \internal
+
+    Returns the index of the last feature at \a mercator, or -1. Lines are
+    hit within \a tolerance, in mercator units.
+*/
+qsizetype QGeoJsonLayerData::featureAt(const QDoubleVector2D &mercator, double tolerance) const
+{
+    qsizetype res = -1;
+    // A feature crossing the antimeridian extends past x = 1
+    for (const double offset : { 0.0, 1.0 }) {
+        const QDoubleVector2D point(mercator.x() + offset, mercator.y());
+        const QList<qsizetype> candidates = index.candidates(point, tolerance);
+        for (const qsizetype i : candidates) {
+            if (i <= res)
+                continue;
+            const QGeoJsonLayerFeature &feature = features.at(i);
+            if (!feature.bounds.adjusted(-tolerance, -tolerance, tolerance, tolerance)
+                         .contains(point.toPointF())) {
+                continue;
+            }
+            for (const QGeoJsonLayerShape &shape : feature.shapes) {
+                if (contains(shape, point, tolerance)) {
+                    res = i;
+                    break;
+                }
+            }
+        }
+    }
+    return res;
+}
+
+/*!
+    \internal
+
+    Triangulates and batches the features of \a data, simplified for \a lod
+    unless it is 0.
+*/
+std::shared_ptr<const QGeoJsonLayerGeometry> QGeoJsonLayerGeometry::create(const QGeoJsonLayerData &data,
+                                                                           unsigned int lod)
+{
+    auto geometry = std::make_shared<QGeoJsonLayerGeometry>();
+    geometry->lod = lod;
+    const int zoom = int(QGeoMapItemLODGeometry::zoomForLOD(lod * 3));
+    QHash<QRgb, qsizetype> fillBatches;
+    QHash<QRgb, qsizetype> lineBatches;
+    bool firstOutline = true;
+
+    for (const QGeoJsonLayerFeature &feature : data.features) {
+        for (const QGeoJsonLayerShape &shape : feature.shapes) {
+            const bool isLine = shape.type == QGeoJsonLayerShape::Line;
+            QList<QList<QDoubleVector2D>> paths;
+            for (const QList<QDoubleVector2D> &path : shape.paths) {
+                // The simplification wraps x back into [0, 1] by subtracting its leftBound
+                const QList<QDoubleVector2D> simplified =
+                        lod ? QGeoSimplify::geoSimplifyZL(path, 1.0, zoom) : path;
+                if (simplified.size() >= (isLine ? 2 : 3))
+                    paths << simplified;
+                else if (paths.isEmpty())
+                    break; // without a perimeter, there is nothing to draw
+            }
+            if (paths.isEmpty())
+                continue;
+
+            if (isLine) {
+                auto it = lineBatches.constFind(shape.color.rgba());
+                if (it == lineBatches.cend()) {
+                    it = lineBatches.insert(shape.color.rgba(), geometry->lines.size());
+                    geometry->lines.append(LineBatch());
+                    geometry->lines.last().color = shape.color;
+                    geometry->lines.last().minX = geometry->lines.last().maxX = paths.first().first().x();
+                }
+                LineBatch &batch = geometry->lines[it.value()];
+                appendEntries(batch, paths.first(), false);
+                updateRange(batch.minX, batch.maxX, paths.first(), false);
+                continue;
+            }
+
+            auto it = fillBatches.constFind(shape.color.rgba());
+            if (it == fillBatches.cend()) {
+                it = fillBatches.insert(shape.color.rgba(), geometry->fills.size());
+                geometry->fills.append(FillBatch());
+                geometry->fills.last().color = shape.color;
+                geometry->fills.last().minX = geometry->fills.last().maxX = paths.first().first().x();
+            }
+            FillBatch &batch = geometry->fills[it.value()];
+            const quint32 first = quint32(batch.vertices.size());
+            for (const QList<QDoubleVector2D> &path : std::as_const(paths)) {
+                for (const QDoubleVector2D &p : path)
+                    batch.vertices << p;
+            }
+            const std::vector<quint32> indices = qt_mapbox::earcut<quint32>(paths);
+            batch.indices.reserve(batch.indices.size() + qsizetype(indices.size()));
+            for (const quint32 i : indices)
+                batch.indices << first + i;
+            updateRange(batch.minX, batch.maxX, paths.first(), false);
+
+            for (const QList<QDoubleVector2D> &path : std::as_const(paths))
+                appendEntries(geometry->outlines, path, true);
+            updateRange(geometry->outlines.minX, geometry->outlines.maxX, paths.first(),
+                        firstOutline);
+            firstOutline = false;
+        }
+    }
+    return geometry;
+}
+
+/*!
+    \internal
+*/
+qsizetype QGeoJsonLayerGeometry::byteSize() const
+{
+    qsizetype res = outlines.entries.size()
+            * qsizetype(sizeof(MapPolylineNodeOpenGLExtruded::MapPolylineEntry));
+    for (const FillBatch &batch : fills) {
+        res += batch.vertices.size() * qsizetype(sizeof(QDeclarativeGeoMapItemUtils::vec2))
+                + batch.indices.size() * qsizetype(sizeof(quint32));
+    }
+    for (const LineBatch &batch : lines)
+        res += batch.entries.size() * qsizetype(sizeof(MapPolylineNodeOpenGLExtruded::MapPolylineEntry));
+    return res;
+}
+
+QGeoJsonLayerBuilder::QGeoJsonLayerBuilder(const std::shared_ptr<const QGeoJsonLayerData> &data,
+                                           const QVariantList &geoJson,
+                                           const QGeoJsonLayerData::Style &style,
+                                           unsigned int lod, quint64 serial)
+    : m_data(data), m_geoJson(geoJson), m_style(style), m_lod(lod), m_serial(serial)
+{
+    setAutoDelete(false);
+}
+
+void QGeoJsonLayerBuilder::start()
+{
+    QThreadPool::globalInstance()->start(this);
+}
+
+void QGeoJsonLayerBuilder::run()
+{
+    if (!m_data)
+        m_data = QGeoJsonLayerData::create(m_geoJson, m_style);
+    m_geometry = QGeoJsonLayerGeometry::create(*m_data, m_lod);
+    emit finished();
+}
+
+/*
+    One node per batch and per copy of the map, see QGeoJsonLayerNode::update().
+*/
+class QGeoJsonLayerNode::FillNode : public MapItemGeometryNode
+{
+public:
+    FillNode(QSGGeometry *geometry, qsizetype batch, int wrapOffset)
+        : m_batch(batch), m_wrapOffset(wrapOffset)
+    {
+        setGeometry(geometry);
+        setMaterial(&m_material);
+    }
+
+    MapPolygonMaterial m_material;
+    qsizetype m_batch;
+    int m_wrapOffset;
+};
+
+class QGeoJsonLayerNode::LineNode : public MapItemGeometryNode
+{
+public:
+    LineNode(QSGGeometry *geometry, qsizetype batch, int wrapOffset)
+        : m_batch(batch), m_wrapOffset(wrapOffset)
+    {
+        setGeometry(geometry);
+        setMaterial(&m_material);
+    }
+
+    MapPolylineMaterialExtruded m_material;
+    qsizetype m_batch; // the outlines when equal to the number of line batches
+    int m_wrapOffset;
+};
+
+QGeoJsonLayerNode::QGeoJsonLayerNode() = default;
+
+QGeoJsonLayerNode::~QGeoJsonLayerNode()
+{
+    // The child nodes use the geometries
+    clearNodes();
+}
+
+void QGeoJsonLayerNode::clearNodes()
+{
+    removeAllChildNodes();
+    qDeleteAll(m_fillNodes);
+    qDeleteAll(m_lineNodes);
+    m_fillNodes.clear();
+    m_lineNodes.clear();
+}
+
+/*!
+    \internal
+
+    Uploads \a geometry. The QSGGeometry objects of the previous one are
+    reused, so that switching between levels of detail does not reallocate
+    them when their sizes are close.
+*/
+void QGeoJsonLayerNode::setGeometry(const std::shared_ptr<const QGeoJsonLayerGeometry> &geometry)
+{
+    if (geometry == m_geometry)
+        return;
+    m_geometry = geometry;
+    clearNodes();
+
+    const qsizetype lineBatches = geometry->lines.size() + 1;
+    while (m_fillGeometries.size() < size_t(geometry->fills.size())) {
+        m_fillGeometries.emplace_back(new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(),
+                                                      0, 0, QSGGeometry::UnsignedIntType));
+        m_fillGeometries.back()->setDrawingMode(QSGGeometry::DrawTriangles);
+    }
+    m_fillGeometries.resize(geometry->fills.size());
+    while (m_lineGeometries.size() < size_t(lineBatches)) {
+        m_lineGeometries.emplace_back(new QSGGeometry(MapPolylineNodeOpenGLExtruded::attributesMapPolylineTriangulated(),
+                                                      0, 0, QSGGeometry::UnsignedIntType));
+        m_lineGeometries.back()->setDrawingMode(QSGGeometry::DrawTriangles);
+    }
+    m_lineGeometries.resize(lineBatches);
+
+    static_assert(sizeof(QDeclarativeGeoMapItemUtils::vec2) == sizeof(QSGGeometry::Point2D));
+    for (qsizetype i = 0; i < geometry->fills.size(); ++i) {
+        const QGeoJsonLayerGeometry::FillBatch &batch = geometry->fills.at(i);
+        QSGGeometry *geom = m_fillGeometries.at(i).get();
+        QGeoMapItemGeometry::reserveGeometry(geom, int(batch.vertices.size()), int(batch.indices.size()));
+        memcpy(geom->vertexData(), batch.vertices.constData(),
+               batch.vertices.size() * sizeof(QSGGeometry::Point2D));
+        memcpy(geom->indexDataAsUInt(), batch.indices.constData(),
+               batch.indices.size() * sizeof(quint32));
+        QGeoMapItemGeometry::commitGeometry(geom, int(batch.vertices.size()), int(batch.indices.size()));
+        for (int wrapOffset = -1; wrapOffset <= 1; ++wrapOffset) {
+            FillNode *node = new FillNode(geom, i, wrapOffset);
+            appendChildNode(node);
+            m_fillNodes << node;
+        }
+    }
+    for (qsizetype i = 0; i < lineBatches; ++i) {
+        const QGeoJsonLayerGeometry::LineBatch &batch =
+                (i < geometry->lines.size()) ? geometry->lines.at(i) : geometry->outlines;
+        QSGGeometry *geom = m_lineGeometries.at(i).get();
+        QGeoMapItemGeometry::reserveGeometry(geom, int(batch.entries.size()));
+        memcpy(geom->vertexData(), batch.entries.constData(),
+               batch.entries.size() * sizeof(MapPolylineNodeOpenGLExtruded::MapPolylineEntry));
+        QGeoMapItemGeometry::commitGeometry(geom, int(batch.entries.size()));
+        if (batch.entries.isEmpty())
+            continue;
+        for (int wrapOffset = -1; wrapOffset <= 1; ++wrapOffset) {
+            LineNode *node = new LineNode(geom, i, wrapOffset);
+            appendChildNode(node);
+            m_lineNodes << node;
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Updates the materials for the camera of \a p. The vertices span x in
+    [0, 2), so the map copies on both sides of the camera are drawn by nodes
+    with a wrap offset of -1 and 1. Nodes whose batch is outside of the
+    visible region are blocked.
+*/
+void QGeoJsonLayerNode::update(const QGeoProjectionWebMercator &p, const QColor &borderColor,
+                               qreal borderWidth, qreal lineWidth)
+{
+    const QList<QDoubleVector2D> visibleRegion = p.visibleGeometryExpanded();
+    if (!m_geometry || visibleRegion.isEmpty()) {
+        setSubtreeBlocked(true);
+        return;
+    }
+    setSubtreeBlocked(false);
+
+    double visibleMinX = visibleRegion.first().x();
+    double visibleMaxX = visibleMinX;
+    updateRange(visibleMinX, visibleMaxX, visibleRegion, false);
+    const auto isVisible = [visibleMinX, visibleMaxX](double minX, double maxX, int wrapOffset) {
+        return minX + wrapOffset <= visibleMaxX && maxX + wrapOffset >= visibleMinX;
+    };
+    const auto setBlocked = [](MapItemGeometryNode *node, bool blocked) {
+        if (node->subtreeBlocked() == blocked)
+            return;
+        node->setSubtreeBlocked(blocked);
+        node->markDirty(QSGNode::DirtySubtreeBlocked);
+    };
+
+    const QMatrix4x4 &geoProjection = p.qsgTransform();
+    const QDoubleVector3D center = p.centerMercator();
+    for (FillNode *node : std::as_const(m_fillNodes)) {
+        const QGeoJsonLayerGeometry::FillBatch &batch = m_geometry->fills.at(node->m_batch);
+        const bool visible = batch.color.alpha() != 0
+                && isVisible(batch.minX, batch.maxX, node->m_wrapOffset);
+        setBlocked(node, !visible);
+        if (!visible)
+            continue;
+        node->m_material.setColor(batch.color);
+        node->m_material.setGeoProjection(geoProjection);
+        node->m_material.setCenter(center);
+        node->m_material.setWrapOffset(node->m_wrapOffset);
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+    for (LineNode *node : std::as_const(m_lineNodes)) {
+        const bool isOutline = node->m_batch == m_geometry->lines.size();
+        const QGeoJsonLayerGeometry::LineBatch &batch =
+                isOutline ? m_geometry->outlines : m_geometry->lines.at(node->m_batch);
+        const QColor &color = isOutline ? borderColor : batch.color;
+        const qreal width = isOutline ? borderWidth : lineWidth;
+        const bool visible = color.alpha() != 0 && width >= 0.5
+                && isVisible(batch.minX, batch.maxX, node->m_wrapOffset);
+        setBlocked(node, !visible);
+        if (!visible)
+            continue;
+        node->m_material.setColor(color);
+        node->m_material.setGeoProjection(geoProjection);
+        node->m_material.setCenter(center);
+        node->m_material.setWrapOffset(node->m_wrapOffset);
+        node->m_material.setLineWidth(float(width));
+        node->m_material.setMiter(isOutline); // like MapPolygon borders
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+/*
+ * QDeclarativeGeoJsonLayerMapItem Implementation
+ */
+
+static QGeoJsonLayerData::Style layerStyle(const QColor &color, const QString &colorProperty,
+                                           const QColor &lineColor, qreal pointRadius)
+{
+    QGeoJsonLayerData::Style style;
+    style.color = color;
+    style.colorProperty = colorProperty;
+    style.lineColor = lineColor;
+    style.pointRadius = pointRadius;
+    return style;
+}
+
+QDeclarativeGeoJsonLayerMapItem::QDeclarativeGeoJsonLayerMapItem(QQuickItem *parent)
+    : QDeclarativeGeoMapItemBase(parent), m_border(this), m_line(this)
+{
+    setFlag(ItemHasContents, true);
+    // The layer covers the whole map, fading it in would hide every feature at low zoom levels
+    setAutoFadeIn(false);
+    QObject::connect(&m_border, &QDeclarativeMapLineProperties::colorChanged,
+                     this, &QQuickItem::update);
+    QObject::connect(&m_border, &QDeclarativeMapLineProperties::widthChanged,
+                     this, &QQuickItem::update);
+    QObject::connect(&m_line, &QDeclarativeMapLineProperties::colorChanged,
+                     this, &QDeclarativeGeoJsonLayerMapItem::invalidateData);
+    QObject::connect(&m_line, &QDeclarativeMapLineProperties::widthChanged,
+                     this, &QQuickItem::update);
+}
+
+QDeclarativeGeoJsonLayerMapItem::~QDeclarativeGeoJsonLayerMapItem()
+{
+    // A running builder can't be stopped. It deletes itself when done.
+    if (m_builder)
+        QObject::disconnect(m_builder, nullptr, this, nullptr);
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoJsonLayerMapItem::setMap(QDeclarativeGeoMap *quickMap, QGeoMap *map)
+{
+    QDeclarativeGeoMapItemBase::setMap(quickMap, map);
+    if (!map)
+        return;
+    updateSize();
+    updateLayer();
+    update();
+}
+
+/*!
+    \qmlproperty var MapGeoJsonLayer::geoJson
+
+    This property holds the GeoJSON document to display, as imported by
+    QGeoJson::importGeoJson(). Assigning it starts building the layer on a
+    worker thread, the previous document remains displayed until then.
+*/
+QVariant QDeclarativeGeoJsonLayerMapItem::geoJson() const
+{
+    return m_geoJson;
+}
+
+void QDeclarativeGeoJsonLayerMapItem::setGeoJson(const QVariant &geoJson)
+{
+    QVariant value = geoJson;
+    if (value.metaType() == QMetaType::fromType<QJSValue>())
+        value = value.value<QJSValue>().toVariant();
+    if (value.typeId() == QMetaType::QVariantMap)
+        m_geoJson = QVariantList{ value };
+    else
+        m_geoJson = value.toList();
+    invalidateData();
+    emit geoJsonChanged();
+}
+
+/*!
+    \qmlproperty color MapGeoJsonLayer::color
+
+    This property holds the color used to fill the features without a
+    \l colorProperty. The default value is \c grey, that is \c #808080.
+*/
+QColor QDeclarativeGeoJsonLayerMapItem::color() const
+{
+    return m_color;
+}
+
+void QDeclarativeGeoJsonLayerMapItem::setColor(const QColor &color)
+{
+    if (m_color == color)
+        return;
+    m_color = color;
+    invalidateData();
+    emit colorChanged();
+}
+
+/*!
+    \qmlproperty string MapGeoJsonLayer::colorProperty
+
+    This property holds the name of the feature property overriding \l color
+    and \l line.color. It applies to the geometries nested in the feature
+    holding it too. The default value is \c color. Set it to an empty string
+    to draw every feature with the same colors.
+*/
+QString QDeclarativeGeoJsonLayerMapItem::colorProperty() const
+{
+    return m_colorProperty;
+}
+
+void QDeclarativeGeoJsonLayerMapItem::setColorProperty(const QString &colorProperty)
+{
+    if (m_colorProperty == colorProperty)
+        return;
+    m_colorProperty = colorProperty;
+    invalidateData();
+    emit colorPropertyChanged();
+}
+
+/*!
+    \qmlproperty real MapGeoJsonLayer::pointRadius
+
+    This property holds the radius in meters of the circles drawn for the
+    points without a radius. The default value is 20000.
+*/
+qreal QDeclarativeGeoJsonLayerMapItem::pointRadius() const
+{
+    return m_pointRadius;
+}
+
+void QDeclarativeGeoJsonLayerMapItem::setPointRadius(qreal radius)
+{
+    if (m_pointRadius == radius)
+        return;
+    m_pointRadius = radius;
+    invalidateData();
+    emit pointRadiusChanged();
+}
+
+/*!
+    \qmlpropertygroup Location::MapGeoJsonLayer::border
+    \qmlproperty int MapGeoJsonLayer::border.width
+    \qmlproperty color MapGeoJsonLayer::border.color
+
+    This property is part of the border property group. The border property
+    group holds the width and color used to outline polygons and points.
+
+    The width is in pixels and is independent of the zoom level of the map.
+    The default values correspond to a black border with a width of 1 pixel.
+*/
+QDeclarativeMapLineProperties *QDeclarativeGeoJsonLayerMapItem::border()
+{
+    return &m_border;
+}
+
+/*!
+    \qmlpropertygroup Location::MapGeoJsonLayer::line
+    \qmlproperty int MapGeoJsonLayer::line.width
+    \qmlproperty color MapGeoJsonLayer::line.color
+
+    This property is part of the line property group. The line property
+    group holds the width of lines, and the color of the lines without a
+    \l colorProperty.
+
+    The width is in pixels and is independent of the zoom level of the map.
+    The default values correspond to a black line with a width of 1 pixel.
+*/
+QDeclarativeMapLineProperties *QDeclarativeGeoJsonLayerMapItem::line()
+{
+    return &m_line;
+}
+
+/*!
+    \qmlproperty int MapGeoJsonLayer::featureCount
+
+    This property holds the number of features of the document currently
+    displayed.
+*/
+int QDeclarativeGeoJsonLayerMapItem::featureCount() const
+{
+    return m_data ? int(m_data->features.size()) : 0;
+}
+
+/*!
+    \qmlproperty bool MapGeoJsonLayer::busy
+
+    This property holds whether the layer is being built on a worker thread.
+*/
+bool QDeclarativeGeoJsonLayerMapItem::isBusy() const
+{
+    return m_busy;
+}
+
+void QDeclarativeGeoJsonLayerMapItem::setBusy(bool busy)
+{
+    if (m_busy == busy)
+        return;
+    m_busy = busy;
+    emit busyChanged();
+}
+
+/*!
+    \qmlmethod var MapGeoJsonLayer::featureAt(point position)
+
+    Returns the feature drawn at \a position, in the coordinates of this
+    item, as found in \l geoJson, or \c undefined. When features overlap,
+    the last one in the document is returned.
+*/
+QVariant QDeclarativeGeoJsonLayerMapItem::featureAt(const QPointF &position) const
+{
+    const int index = featureIndexAt(position);
+    if (index < 0)
+        return QVariant();
+    return m_data->features.at(index).item;
+}
+
+/*!
+    \qmlmethod int MapGeoJsonLayer::featureIndexAt(point position)
+
+    Returns the index of the feature drawn at \a position, or -1.
+
+    \sa featureAt()
+*/
+int QDeclarativeGeoJsonLayerMapItem::featureIndexAt(const QPointF &position) const
+{
+    if (!map() || !quickMap() || !m_data)
+        return -1;
+    const QGeoProjectionWebMercator &p =
+            static_cast<const QGeoProjectionWebMercator &>(map()->geoProjection());
+    const QDoubleVector2D wrapped =
+            p.itemPositionToWrappedMapProjection(QDoubleVector2D(mapToItem(quickMap(), position)));
+    if (!p.isProjectable(wrapped))
+        return -1;
+    // Lines are picked within a couple of pixels
+    const double tolerance = (qMax(m_line.width(), m_border.width()) * 0.5 + 2.0) / p.mapWidth();
+    return int(m_data->featureAt(p.unwrapMapProjection(wrapped), tolerance));
+}
+
+bool QDeclarativeGeoJsonLayerMapItem::contains(const QPointF &point) const
+{
+    return featureIndexAt(point) >= 0;
+}
+
+const QGeoShape &QDeclarativeGeoJsonLayerMapItem::geoShape() const
+{
+    return m_geoShape;
+}
+
+void QDeclarativeGeoJsonLayerMapItem::setGeoShape(const QGeoShape &shape)
+{
+    // The shape is the one of the document
+    Q_UNUSED(shape);
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoJsonLayerMapItem::afterViewportChanged(const QGeoMapViewportChangeEvent &event)
+{
+    if (event.mapSizeChanged)
+        updateSize();
+    updateLayer();
+    update();
+}
+
+void QDeclarativeGeoJsonLayerMapItem::updateSize()
+{
+    // The features are drawn with the camera transformation, the item only receives the input
+    setPosition(QPointF(0, 0));
+    setSize(quickMap()->size());
+}
+
+unsigned int QDeclarativeGeoJsonLayerMapItem::currentLOD() const
+{
+    if (!map())
+        return 0;
+    return QGeoMapItemLODGeometry::zoomToLOD(zoomForLOD(int(map()->cameraData().zoomLevel())));
+}
+
+void QDeclarativeGeoJsonLayerMapItem::invalidateData()
+{
+    ++m_serial;
+    m_dataDirty = true;
+    for (auto &lod : m_lods)
+        lod.reset();
+    updateLayer();
+}
+
+/*!
+    \internal
+
+    Displays the geometry for the current level of detail, starting a
+    builder for it if it is missing.
+*/
+void QDeclarativeGeoJsonLayerMapItem::updateLayer()
+{
+    const unsigned int lod = currentLOD();
+    if (!m_dataDirty && m_lods[lod]) {
+        m_geometry = m_lods[lod];
+        return;
+    }
+    if (m_builder) {
+        if (m_builder->serial() == m_serial)
+            return; // the next geometry is selected when it finishes
+        QObject::disconnect(m_builder, nullptr, this, nullptr);
+        m_builder = nullptr;
+    }
+
+    if (m_geoJson.isEmpty()) {
+        m_dataDirty = false;
+        m_data.reset();
+        m_geometry.reset();
+        m_geoShape = QGeoRectangle();
+        setBusy(false);
+        update();
+        emit featureCountChanged();
+        return;
+    }
+
+    QGeoJsonLayerBuilder *builder =
+            new QGeoJsonLayerBuilder(m_dataDirty ? nullptr : m_data, m_geoJson,
+                                     layerStyle(m_color, m_colorProperty, m_line.color(), m_pointRadius),
+                                     lod, m_serial);
+    m_builder = builder;
+    QObject::connect(builder, &QGeoJsonLayerBuilder::finished, this,
+                     [this, builder]() { onBuilderFinished(builder); },
+                     Qt::QueuedConnection);
+    QObject::connect(builder, &QGeoJsonLayerBuilder::finished,
+                     builder, &QObject::deleteLater, Qt::QueuedConnection);
+    setBusy(true);
+    builder->start();
+}
+
+void QDeclarativeGeoJsonLayerMapItem::onBuilderFinished(QGeoJsonLayerBuilder *builder)
+{
+    if (builder != m_builder)
+        return;
+    m_builder = nullptr;
+    if (builder->serial() != m_serial)
+        return;
+
+    const bool dataChanged = m_dataDirty;
+    if (m_dataDirty) {
+        m_data = builder->m_data;
+        m_dataDirty = false;
+        m_geoShape = m_data->boundingRectangle;
+    }
+    m_lods[builder->lod()] = builder->m_geometry;
+    updateLayer();
+    if (!m_builder)
+        setBusy(false);
+    update();
+    if (dataChanged)
+        emit featureCountChanged();
+}
+
+/*!
+    \internal
+*/
+QSGNode *QDeclarativeGeoJsonLayerMapItem::updateMapItemPaintNode(QSGNode *oldNode,
+                                                                 UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+    QGeoJsonLayerNode *node = static_cast<QGeoJsonLayerNode *>(oldNode);
+    if (!m_geometry || !map()) {
+        delete node;
+        return nullptr;
+    }
+    if (!node)
+        node = new QGeoJsonLayerNode();
+
+    node->setGeometry(m_geometry);
+    node->update(static_cast<const QGeoProjectionWebMercator &>(map()->geoProjection()),
+                 m_border.color(), m_border.width(), m_line.width());
+    return node;
+}
+
+QT_END_NAMESPACE
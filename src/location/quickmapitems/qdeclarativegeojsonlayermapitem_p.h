@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QDECLARATIVEGEOJSONLAYERMAPITEM_P_H
+#define QDECLARATIVEGEOJSONLAYERMAPITEM_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qdeclarativegeomapitembase_p.h>
+#include <QtLocation/private/qdeclarativepolylinemapitem_p.h>
+#include <QtPositioning/QGeoRectangle>
+#include <QtCore/QPointer>
+
+#include <array>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoJsonLayerBuilder;
+class QGeoJsonLayerData;
+class QGeoJsonLayerGeometry;
+
+class Q_LOCATION_PRIVATE_EXPORT QDeclarativeGeoJsonLayerMapItem : public QDeclarativeGeoMapItemBase
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(MapGeoJsonLayer)
+    QML_ADDED_IN_VERSION(6, 5)
+
+    Q_PROPERTY(QVariant geoJson READ geoJson WRITE setGeoJson NOTIFY geoJsonChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QString colorProperty READ colorProperty WRITE setColorProperty NOTIFY colorPropertyChanged)
+    Q_PROPERTY(qreal pointRadius READ pointRadius WRITE setPointRadius NOTIFY pointRadiusChanged)
+    Q_PROPERTY(QDeclarativeMapLineProperties *border READ border CONSTANT)
+    Q_PROPERTY(QDeclarativeMapLineProperties *line READ line CONSTANT)
+    Q_PROPERTY(int featureCount READ featureCount NOTIFY featureCountChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+
+public:
+    explicit QDeclarativeGeoJsonLayerMapItem(QQuickItem *parent = nullptr);
+    ~QDeclarativeGeoJsonLayerMapItem() override;
+
+    void setMap(QDeclarativeGeoMap *quickMap, QGeoMap *map) override;
+    QSGNode *updateMapItemPaintNode(QSGNode *, UpdatePaintNodeData *) override;
+
+    QVariant geoJson() const;
+    void setGeoJson(const QVariant &geoJson);
+
+    QColor color() const;
+    void setColor(const QColor &color);
+
+    QString colorProperty() const;
+    void setColorProperty(const QString &colorProperty);
+
+    qreal pointRadius() const;
+    void setPointRadius(qreal radius);
+
+    QDeclarativeMapLineProperties *border();
+    QDeclarativeMapLineProperties *line();
+
+    int featureCount() const;
+    bool isBusy() const;
+
+    Q_INVOKABLE QVariant featureAt(const QPointF &position) const;
+    Q_INVOKABLE int featureIndexAt(const QPointF &position) const;
+
+    bool contains(const QPointF &point) const override;
+    const QGeoShape &geoShape() const override;
+    void setGeoShape(const QGeoShape &shape) override;
+
+Q_SIGNALS:
+    void geoJsonChanged();
+    void colorChanged();
+    void colorPropertyChanged();
+    void pointRadiusChanged();
+    void featureCountChanged();
+    void busyChanged();
+
+protected Q_SLOTS:
+    void afterViewportChanged(const QGeoMapViewportChangeEvent &event) override;
+
+private:
+    void updateSize();
+    void invalidateData();
+    void updateLayer();
+    unsigned int currentLOD() const;
+    void onBuilderFinished(QGeoJsonLayerBuilder *builder);
+    void setBusy(bool busy);
+
+    QVariantList m_geoJson;
+    QColor m_color = QColor(0x80, 0x80, 0x80);
+    QString m_colorProperty = QStringLiteral("color");
+    qreal m_pointRadius = 20000.0;
+    QDeclarativeMapLineProperties m_border;
+    QDeclarativeMapLineProperties m_line;
+    QGeoRectangle m_geoShape;
+
+    std::shared_ptr<const QGeoJsonLayerData> m_data;
+    std::shared_ptr<const QGeoJsonLayerGeometry> m_geometry; // the one being displayed
+    std::array<std::shared_ptr<const QGeoJsonLayerGeometry>, 7> m_lods; // one per LOD
+    QPointer<QGeoJsonLayerBuilder> m_builder;
+    quint64 m_serial = 0;
+    bool m_dataDirty = false;
+    bool m_busy = false;
+};
+
+QT_END_NAMESPACE
+
+QML_DECLARE_TYPE(QDeclarativeGeoJsonLayerMapItem)
+
+#endif // QDECLARATIVEGEOJSONLAYERMAPITEM_P_H
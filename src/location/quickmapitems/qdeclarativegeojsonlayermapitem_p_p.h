@@ -0,0 +1,247 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QDECLARATIVEGEOJSONLAYERMAPITEM_P_P_H
+#define QDECLARATIVEGEOJSONLAYERMAPITEM_P_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QObject>
+#include <QtCore/QRectF>
+#include <QtCore/QRunnable>
+#include <QtCore/QVariantList>
+#include <QtGui/QColor>
+#include <QtQuick/QSGNode>
+#include <QtPositioning/QGeoRectangle>
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qdeclarativegeomapitemutils_p.h>
+#include <QtLocation/private/qdeclarativepolylinemapitem_p_p.h>
+#include <QtLocation/private/qdeclarativepolygonmapitem_p_p.h>
+
+#include <QtPositioning/private/qdoublevector2d_p.h>
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoProjectionWebMercator;
+
+/*
+    The geometry of a feature, in mercator space. Every path of a shape is
+    unwrapped relative to the left bound of the shape, so x is in [0, 2).
+*/
+struct Q_LOCATION_PRIVATE_EXPORT QGeoJsonLayerShape
+{
+    enum Type {
+        Polygon, // perimeter, then holes
+        Line,
+        Circle   // a sampled perimeter, filled like a polygon
+    };
+
+    Type type = Polygon;
+    QColor color; // fill color of polygons and circles, line color of lines
+    double leftBound = 0.0;
+    QList<QList<QDoubleVector2D>> paths;
+};
+
+struct Q_LOCATION_PRIVATE_EXPORT QGeoJsonLayerFeature
+{
+    QVariantMap item; // the imported feature, as returned by featureAt()
+    QList<QGeoJsonLayerShape> shapes;
+    QRectF bounds; // mercator
+};
+
+/*
+    A uniform grid over the two unwrapped copies of the map, holding for every
+    cell the features whose bounds intersect it.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoJsonLayerIndex
+{
+public:
+    static constexpr int Columns = 128; // over x in [0, 2)
+    static constexpr int Rows = 64;     // over y in [0, 1]
+
+    void build(const QList<QGeoJsonLayerFeature> &features);
+    QList<qsizetype> candidates(const QDoubleVector2D &point, double tolerance) const;
+
+private:
+    static int column(double x);
+    static int row(double y);
+
+    QList<QList<qsizetype>> m_cells;
+};
+
+/*
+    A GeoJSON document flattened into styled features. It is built off the GUI
+    thread and never modified afterwards, so that it can be shared with the
+    builders of the geometry and with hit testing.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoJsonLayerData
+{
+public:
+    struct Style {
+        QColor color = QColor(0x80, 0x80, 0x80);
+        QString colorProperty = QStringLiteral("color");
+        QColor lineColor = QColor(Qt::black);
+        qreal pointRadius = 20000.0;
+    };
+
+    static constexpr int CircleSamples = 32;
+
+    static std::shared_ptr<const QGeoJsonLayerData> create(const QVariantList &geoJson,
+                                                           const Style &style);
+
+    qsizetype featureAt(const QDoubleVector2D &mercator, double tolerance) const;
+
+    QList<QGeoJsonLayerFeature> features;
+    QGeoJsonLayerIndex index;
+    QGeoRectangle boundingRectangle;
+
+private:
+    void addItem(const QVariantMap &item, QGeoJsonLayerFeature &feature, QColor color,
+                 const Style &style);
+    static bool contains(const QGeoJsonLayerShape &shape, const QDoubleVector2D &point,
+                         double tolerance);
+};
+
+/*
+    The vertices of a QGeoJsonLayerData at one level of detail, batched by
+    color. Fills are indexed triangles in the MapPolygonMaterial layout, lines
+    and outlines are MapPolylineMaterialExtruded entries.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoJsonLayerGeometry
+{
+public:
+    struct FillBatch {
+        QColor color;
+        QList<QDeclarativeGeoMapItemUtils::vec2> vertices;
+        QList<quint32> indices;
+        double minX = 0.0;
+        double maxX = 0.0;
+    };
+
+    struct LineBatch {
+        QColor color; // invalid for the outlines, drawn with the border color
+        QList<MapPolylineNodeOpenGLExtruded::MapPolylineEntry> entries;
+        double minX = 0.0;
+        double maxX = 0.0;
+    };
+
+    static std::shared_ptr<const QGeoJsonLayerGeometry> create(const QGeoJsonLayerData &data,
+                                                               unsigned int lod);
+
+    qsizetype byteSize() const;
+
+    unsigned int lod = 0;
+    QList<FillBatch> fills;
+    QList<LineBatch> lines;
+    LineBatch outlines;
+};
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoJsonLayerBuilder : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    // Builds the data first when data is null
+    QGeoJsonLayerBuilder(const std::shared_ptr<const QGeoJsonLayerData> &data,
+                         const QVariantList &geoJson, const QGeoJsonLayerData::Style &style,
+                         unsigned int lod, quint64 serial);
+
+    void start();
+    void run() override;
+
+    inline quint64 serial() const { return m_serial; }
+    inline unsigned int lod() const { return m_lod; }
+
+    std::shared_ptr<const QGeoJsonLayerData> m_data;
+    std::shared_ptr<const QGeoJsonLayerGeometry> m_geometry;
+
+signals:
+    void finished();
+
+private:
+    QVariantList m_geoJson;
+    QGeoJsonLayerData::Style m_style;
+    unsigned int m_lod;
+    quint64 m_serial;
+};
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoJsonLayerNode : public QSGNode, public VisibleNode
+{
+public:
+    QGeoJsonLayerNode();
+    ~QGeoJsonLayerNode() override;
+
+    bool isSubtreeBlocked() const override
+    {
+        return subtreeBlocked();
+    }
+
+    void setGeometry(const std::shared_ptr<const QGeoJsonLayerGeometry> &geometry);
+    void update(const QGeoProjectionWebMercator &p, const QColor &borderColor, qreal borderWidth,
+                qreal lineWidth);
+
+private:
+    class FillNode;
+    class LineNode;
+
+    void clearNodes();
+
+    std::shared_ptr<const QGeoJsonLayerGeometry> m_geometry;
+    std::vector<std::unique_ptr<QSGGeometry>> m_fillGeometries;
+    std::vector<std::unique_ptr<QSGGeometry>> m_lineGeometries; // the outlines come last
+    QList<FillNode *> m_fillNodes;
+    QList<LineNode *> m_lineNodes;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDECLARATIVEGEOJSONLAYERMAPITEM_P_P_H
@@ -44,6 +44,8 @@
 #include <QtGui/QAbstractTextDocumentLayout>
 #include <QtGui/QPainter>
 #include <QtGui/QImage>
+#include <QtCore/QCache>
+#include <QtQuick/QQuickWindow>
 #include <QtQuick/private/qquickanchors_p.h>
 #include <QtLocation/private/qdeclarativegeomap_p.h>
 #include <QtQuick/private/qquickpainteditem_p.h>
@@ -57,6 +59,40 @@ public:
     void setVisible(bool visible) override;
 };
 
+namespace {
+
+// Tile based maps re-emit their copyrights while panning across provider
+// regions, usually with a notice that has been shown before. The rendered
+// notices are shared by all the MapCopyrightNotice items.
+struct CopyrightsImageKey
+{
+    QString html;
+    QString styleSheet;
+    qreal textWidth;
+    qreal devicePixelRatio;
+};
+
+bool operator==(const CopyrightsImageKey &a, const CopyrightsImageKey &b)
+{
+    return a.textWidth == b.textWidth && a.devicePixelRatio == b.devicePixelRatio
+            && a.html == b.html && a.styleSheet == b.styleSheet;
+}
+
+size_t qHash(const CopyrightsImageKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.html, key.styleSheet, key.textWidth, key.devicePixelRatio);
+}
+
+class CopyrightsImageCache : public QCache<CopyrightsImageKey, QImage>
+{
+public:
+    CopyrightsImageCache() : QCache<CopyrightsImageKey, QImage>(4096) {} // in KiB
+};
+
+} // anonymous namespace
+
+Q_GLOBAL_STATIC(CopyrightsImageCache, copyrightsImageCache)
+
 /*!
     \qmltype MapCopyrightNotice
     \instantiates QDeclarativeGeoMapCopyrightNotice
@@ -193,13 +229,11 @@ void QDeclarativeGeoMapCopyrightNotice::setStyleSheet(const QString &styleSheet)
 
     m_styleSheet = styleSheet;
     if (!m_html.isEmpty() && m_copyrightsHtml) {
-        delete m_copyrightsHtml;
-        createCopyright();
-#if QT_CONFIG(texthtmlparser)
-        m_copyrightsHtml->setHtml(m_html);
-#else
-        m_copyrightsHtml->setPlainText(m_html);
+#if QT_CONFIG(cssparser)
+        m_copyrightsHtml->setDefaultStyleSheet(m_styleSheet);
 #endif
+        // The default style sheet only applies to content set afterwards
+        setDocumentHtml();
     }
     rasterizeHtmlAndUpdate();
     emit styleSheetChanged(m_styleSheet);
@@ -213,6 +247,17 @@ void QDeclarativeGeoMapCopyrightNotice::paint(QPainter *painter)
     painter->drawImage(0, 0, m_copyrightsImage);
 }
 
+/*!
+    \internal
+*/
+void QDeclarativeGeoMapCopyrightNotice::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    // The notice is rendered for the device pixel ratio of the window it is shown in
+    if (change == ItemSceneChange || change == ItemDevicePixelRatioHasChanged)
+        rasterizeHtmlAndUpdate();
+    QQuickPaintedItem::itemChange(change, value);
+}
+
 void QDeclarativeGeoMapCopyrightNotice::mousePressEvent(QMouseEvent *event)
 {
     if (m_copyrightsHtml) {
@@ -240,22 +285,41 @@ void QDeclarativeGeoMapCopyrightNotice::rasterizeHtmlAndUpdate()
     if (!m_copyrightsHtml || m_copyrightsHtml->isEmpty())
         return;
 
-    m_copyrightsImage = QImage(m_copyrightsHtml->size().toSize(),
-                               QImage::Format_ARGB32_Premultiplied);
+    const CopyrightsImageKey key { m_html, m_styleSheet, m_copyrightsHtml->textWidth(),
+                                   window() ? window()->effectiveDevicePixelRatio() : qreal(1) };
+    QImage copyrightsImage;
+    if (const QImage *cachedImage = copyrightsImageCache()->object(key)) {
+        copyrightsImage = *cachedImage;
+    } else {
+        copyrightsImage = QImage((m_copyrightsHtml->size() * key.devicePixelRatio).toSize(),
+                                 QImage::Format_ARGB32_Premultiplied);
+        copyrightsImage.setDevicePixelRatio(key.devicePixelRatio);
+        copyrightsImage.fill(qPremultiply(QColor(Qt::transparent).rgba()));
+
+        QPainter painter(&copyrightsImage);
+        QAbstractTextDocumentLayout::PaintContext ctx;
+        ctx.palette.setColor(QPalette::Text, QColor::fromString("black"));
+        m_copyrightsHtml->documentLayout()->draw(&painter, ctx);
+        painter.end();
+
+        copyrightsImageCache()->insert(key, new QImage(copyrightsImage),
+                                       qMax<qsizetype>(1, copyrightsImage.sizeInBytes() / 1024));
+    }
 
-    m_copyrightsImage.fill(qPremultiply(QColor(Qt::transparent).rgba()));
-    QPainter painter(&m_copyrightsImage);
-    QAbstractTextDocumentLayout::PaintContext ctx;
-    ctx.palette.setColor(QPalette::Text, QColor::fromString("black"));
-    m_copyrightsHtml->documentLayout()->draw(&painter, ctx);
+    // Copies of the same image share their cacheKey(), so an unchanged notice
+    // does not cause the painted item texture to be uploaded again.
+    const bool changed = copyrightsImage.cacheKey() != m_copyrightsImage.cacheKey();
+    m_copyrightsImage = copyrightsImage;
 
-    setImplicitSize(m_copyrightsImage.width(), m_copyrightsImage.height());
-    setContentsSize(m_copyrightsImage.size());
+    const QSizeF size = m_copyrightsImage.deviceIndependentSize();
+    setImplicitSize(size.width(), size.height());
+    setContentsSize(size.toSize());
 
     setKeepMouseGrab(true);
     setAcceptedMouseButtons(Qt::LeftButton);
 
-    update();
+    if (changed)
+        update();
 }
 
 void QDeclarativeGeoMapCopyrightNotice::createCopyright()
@@ -270,6 +334,15 @@ void QDeclarativeGeoMapCopyrightNotice::createCopyright()
     m_copyrightsHtml->setDocumentMargin(0);
 }
 
+void QDeclarativeGeoMapCopyrightNotice::setDocumentHtml()
+{
+#if QT_CONFIG(texthtmlparser)
+    m_copyrightsHtml->setHtml(m_html);
+#else
+    m_copyrightsHtml->setPlainText(m_html);
+#endif
+}
+
 void QDeclarativeGeoMapCopyrightNoticePrivate::setVisible(bool visible)
 {
     Q_Q(QDeclarativeGeoMapCopyrightNotice);
@@ -311,8 +384,10 @@ void QDeclarativeGeoMapCopyrightNotice::setCopyrightsZ(qreal copyrightsZ)
 void QDeclarativeGeoMapCopyrightNotice::copyrightsImageChanged(const QImage &copyrightsImage)
 {
     Q_D(QDeclarativeGeoMapCopyrightNotice);
-    delete m_copyrightsHtml;
-    m_copyrightsHtml = nullptr;
+    // Keep the document around for when the map switches back to HTML copyrights
+    if (m_copyrightsHtml)
+        m_copyrightsHtml->clear();
+    m_html.clear();
 
     m_copyrightsImage = copyrightsImage;
 
@@ -338,19 +413,20 @@ void QDeclarativeGeoMapCopyrightNotice::copyrightsChanged(const QString &copyrig
     // Divfy, so we can style the background. The extra <span> is a
     // workaround to QTBUG-58838 and should be removed when it gets fixed.
 #if QT_CONFIG(texthtmlparser)
-    m_html = QStringLiteral("<div id='copyright-root'><span>") + copyrightsHtml + QStringLiteral("</span></div>");
+    const QString html = QStringLiteral("<div id='copyright-root'><span>") + copyrightsHtml + QStringLiteral("</span></div>");
 #else
-    m_html = copyrightsHtml;
+    const QString html = copyrightsHtml;
 #endif
 
+    // Maps re-emit the same copyrights while panning, nothing to lay out again then
+    if (html == m_html && m_copyrightsHtml && !m_copyrightsHtml->isEmpty())
+        return;
+    m_html = html;
+
     if (!m_copyrightsHtml)
         createCopyright();
 
-#if QT_CONFIG(texthtmlparser)
-    m_copyrightsHtml->setHtml(m_html);
-#else
-    m_copyrightsHtml->setPlainText(m_html);
-#endif
+    setDocumentHtml();
     rasterizeHtmlAndUpdate();
 }
 
@@ -361,13 +437,11 @@ void QDeclarativeGeoMapCopyrightNotice::onCopyrightsStyleSheetChanged(const QStr
 
     m_styleSheet = styleSheet;
     if (!m_html.isEmpty() && m_copyrightsHtml) {
-        delete m_copyrightsHtml;
-        createCopyright();
-#if QT_CONFIG(texthtmlparser)
-        m_copyrightsHtml->setHtml(m_html);
-#else
-        m_copyrightsHtml->setPlainText(m_html);
+#if QT_CONFIG(cssparser)
+        m_copyrightsHtml->setDefaultStyleSheet(m_styleSheet);
 #endif
+        // The default style sheet only applies to content set afterwards
+        setDocumentHtml();
     }
     rasterizeHtmlAndUpdate();
     emit styleSheetChanged(m_styleSheet);
@@ -105,6 +105,7 @@ signals:
 
 protected:
     void paint(QPainter *painter) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
     void rasterizeHtmlAndUpdate();
@@ -112,6 +113,7 @@ protected:
 
 private:
     void createCopyright();
+    void setDocumentHtml();
 
     QTextDocument *m_copyrightsHtml = nullptr;
     QString m_html;
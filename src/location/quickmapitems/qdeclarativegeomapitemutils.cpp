@@ -39,6 +39,7 @@
 ****************************************************************************/
 
 #include "qdeclarativegeomapitemutils_p.h"
+#include "qgeomapitemclipper_p.h"
 
 #include <QPointF>
 #include <QMatrix4x4>
@@ -46,8 +47,6 @@
 #include <QPainterPathStroker>
 #include <QtPositioning/QGeoCoordinate>
 
-#include <QtPositioning/private/qclipperutils_p.h>
-
 QT_BEGIN_NAMESPACE
 
 namespace QDeclarativeGeoMapItemUtils {
@@ -60,9 +59,7 @@ void wrapPath(const QList<QGeoCoordinate> &perimeter,
               QList<QDoubleVector2D> &wrappedPathPlus1,
               QDoubleVector2D *leftBoundWrapped)
 {
-    QList<QDoubleVector2D> path;
-    for (const QGeoCoordinate &c : perimeter)
-        path << p.geoToMapProjection(c);
+    const QList<QDoubleVector2D> path = p.geoToMapProjection(perimeter);
     const QDoubleVector2D leftBound = p.geoToMapProjection(geoLeftBound);
     wrappedPath.clear();
     wrappedPathPlus1.clear();
@@ -96,9 +93,7 @@ void wrapPath(const QList<QGeoCoordinate> &perimeter,
               QList<QDoubleVector2D> &wrappedPath,
               QDoubleVector2D *leftBoundWrapped)
 {
-    QList<QDoubleVector2D> path;
-    for (const QGeoCoordinate &c : perimeter)
-        path << p.geoToMapProjection(c);
+    const QList<QDoubleVector2D> path = p.geoToMapProjection(perimeter);
     const QDoubleVector2D leftBound = p.geoToMapProjection(geoLeftBound);
     wrapPath(path, leftBound,wrappedPath);
     if (leftBoundWrapped)
@@ -136,11 +131,8 @@ void clipPolygon(const QList<QDoubleVector2D> &wrappedPath,
     clippedPaths.clear();
     const QList<QDoubleVector2D> &visibleRegion = p.projectableGeometry();
     if (visibleRegion.size()) {
-        QClipperUtils clipper;
-        clipper.addSubjectPath(wrappedPath, closed);
-        clipper.addClipPolygon(visibleRegion);
-        clippedPaths = clipper.execute(QClipperUtils::Intersection, QClipperUtils::pftEvenOdd,
-                                       QClipperUtils::pftEvenOdd);
+        const QGeoMapItemClipper clipper(visibleRegion);
+        clippedPaths = closed ? clipper.clipPolygon(wrappedPath) : clipper.clipLine(wrappedPath);
 
         if (leftBoundWrapped) {
             // 2.1) update srcOrigin_ and leftBoundWrapped with the point with minimum X
@@ -174,8 +166,7 @@ void projectBbox(const QList<QDoubleVector2D> &clippedBbox,
 {
     projectedBbox.clear();
     bool first = true;
-    for (const auto &coord : clippedBbox) {
-        QDoubleVector2D point = p.wrappedMapProjectionToItemPosition(coord);
+    for (const QDoubleVector2D &point : p.wrappedMapProjectionToItemPosition(clippedBbox)) {
         if (first) {
             first = false;
             projectedBbox.moveTo(point.toPointF());
@@ -47,9 +47,21 @@
 #include <QtQml/QQmlContext>
 #include <QtQuick/private/qquickanimation_p.h>
 #include <QtQml/QQmlListProperty>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/private/qlocationutils_p.h>
+#include <QtPositioning/private/qwebmercator_p.h>
+
+#include <cmath>
 
 QT_BEGIN_NAMESPACE
 
+// Number of virtualization passes a recycled delegate is kept in the reuse pool
+// before being destroyed.
+static const int kMaxReusePoolTime = 8;
+// The rows are looked up in a grid of 256 pixel cells at zoom level 10
+static const int kRowIndexZoomLevel = 10;
+static const qreal kRowIndexCellSize = 256.0;
+
 /*!
     \qmltype MapItemView
     \instantiates QDeclarativeGeoMapItemView
@@ -93,6 +105,153 @@ QT_BEGIN_NAMESPACE
     \since QtLocation 5.12
 */
 
+/*!
+    \qmlproperty bool QtLocation::MapItemView::virtualizeDelegates
+
+    This property controls whether delegates are instantiated only for the model rows
+    that fall inside the visible region of the map, extended by \l virtualizationMargin.
+    Rows are located through \l coordinateRole, without instantiating their delegates.
+    Delegates of rows that leave the viewport are recycled through a reuse pool and
+    handed to rows that enter it, so that startup time, memory usage and per-frame cost
+    depend on the number of visible rows rather than on the size of the model.
+
+    Virtualization is only active when \l coordinateRole is set.
+    While it is active, \l mapItems contains \c null entries for the rows that are
+    not instantiated, and \l autoFitViewport is ignored.
+
+    Defaults to false.
+
+    \since QtLocation 6.5
+*/
+
+/*!
+    \qmlproperty string QtLocation::MapItemView::coordinateRole
+
+    This property holds the name of the model role used to locate rows when
+    \l virtualizeDelegates is enabled. The role must provide either a
+    \l {coordinate} or a \l {geoshape}; for shapes, the center of the bounding
+    rectangle is used. Rows without a valid coordinate are always instantiated.
+
+    \since QtLocation 6.5
+*/
+
+/*!
+    \qmlproperty real QtLocation::MapItemView::virtualizationMargin
+
+    This property holds the margin added around the visible region when deciding
+    which rows to instantiate, as a fraction of the visible region's width and height.
+    A larger margin instantiates more delegates ahead of the camera, reducing pop-in
+    while panning.
+
+    Defaults to 0.25.
+
+    \since QtLocation 6.5
+*/
+
+/*!
+    \qmlproperty bool QtLocation::MapItemView::clustering
+
+    This property controls whether rows close to each other on screen are grouped
+    into clusters. Rows are grouped on a hierarchical grid with one level per zoom level,
+    up to \l maximumClusterZoomLevel. The grid is built once per model, off the GUI
+    thread, and kept up to date on model insertions and removals, so that zooming
+    only selects another level of it.
+
+    Each group of at least \l minimumClusterSize rows is displayed by an instance of
+    \l clusterDelegate, the other rows by instances of \l delegate.
+    Only the rows and clusters inside the visible region, extended by
+    \l virtualizationMargin, are instantiated, as with \l virtualizeDelegates.
+
+    Clustering is only active when both \l coordinateRole and \l clusterDelegate are set.
+    While it is active, rows without a valid coordinate are not displayed.
+
+    Defaults to false.
+
+    \since QtLocation 6.5
+*/
+
+/*!
+    \qmlproperty Component QtLocation::MapItemView::clusterDelegate
+
+    This property holds the delegate used to display clusters when \l clustering is enabled.
+    The Component must contain exactly one MapItem -derived object as the root object.
+    Within the delegate, the \c cluster object provides:
+
+    \list
+    \li \c cluster.count - the number of rows in the cluster.
+    \li \c cluster.center - the average position of the rows, as a \l coordinate.
+    \li \c cluster.bounds - the bounding \l geoRectangle of the rows.
+    \endlist
+
+    Cluster delegate instances are reused across camera changes.
+
+    \since QtLocation 6.5
+*/
+
+/*!
+    \qmlproperty real QtLocation::MapItemView::clusterRadius
+
+    This property holds the size in pixels of the grid cells used to group rows
+    into clusters.
+
+    Defaults to 60.
+
+    \since QtLocation 6.5
+*/
+
+/*!
+    \qmlproperty int QtLocation::MapItemView::minimumClusterSize
+
+    This property holds the minimum number of rows that are displayed as a cluster.
+    Smaller groups are displayed through \l delegate.
+
+    Defaults to 2.
+
+    \since QtLocation 6.5
+*/
+
+/*!
+    \qmlproperty int QtLocation::MapItemView::maximumClusterZoomLevel
+
+    This property holds the highest zoom level at which rows are clustered.
+    Above it, every row inside the visible region is displayed through \l delegate.
+
+    Defaults to 16.
+
+    \since QtLocation 6.5
+*/
+
+QDeclarativeGeoMapItemCluster::QDeclarativeGeoMapItemCluster(QObject *parent)
+    : QObject(parent)
+{
+}
+
+int QDeclarativeGeoMapItemCluster::count() const
+{
+    return m_count;
+}
+
+QGeoCoordinate QDeclarativeGeoMapItemCluster::center() const
+{
+    return m_center;
+}
+
+QGeoRectangle QDeclarativeGeoMapItemCluster::bounds() const
+{
+    return m_bounds;
+}
+
+void QDeclarativeGeoMapItemCluster::setCluster(int count, const QGeoCoordinate &center,
+                                               const QGeoRectangle &bounds)
+{
+    if (m_count == count && m_center == center && m_bounds == bounds)
+        return;
+    m_count = count;
+    m_center = center;
+    m_bounds = bounds;
+    emit clusterChanged();
+}
+
 QDeclarativeGeoMapItemView::QDeclarativeGeoMapItemView(QQuickItem *parent)
     : QDeclarativeGeoMapItemGroup(parent)
 {
@@ -107,6 +266,7 @@ QDeclarativeGeoMapItemView::QDeclarativeGeoMapItemView(QQuickItem *parent)
 
 QDeclarativeGeoMapItemView::~QDeclarativeGeoMapItemView()
 {
+    resetClusterIndex();
     // No need to remove instantiated items: if the MIV has instantiated items because it has been added
     // to a Map (or is child of a Map), the Map destructor takes care of removing it and the instantiated items.
 }
@@ -166,6 +326,11 @@ void QDeclarativeGeoMapItemView::createdItem(int index, QObject * /*object*/)
         // Falling into case 1. or 3. Returning early to prevent double referencing the delegate instance.
         return;
     }
+    if (isVirtualized() && (index >= m_virtualRows.size() || !m_virtualRows.at(index).active)) {
+        // The row left the viewport while its delegate was incubating.
+        // Not referencing the object lets the delegate model release it.
+        return;
+    }
 
     QQuickItem *item = qobject_cast<QQuickItem *>(m_delegateModel->object(index, m_incubationMode));
     if (item)
@@ -179,6 +344,11 @@ void QDeclarativeGeoMapItemView::modelUpdated(const QQmlChangeSet &changeSet, bo
     if (!m_map) // everything will be done in instantiateAllItems. Removal is done by declarativegeomap.
         return;
 
+    if (isVirtualized()) {
+        virtualizedModelUpdated(changeSet, reset);
+        return;
+    }
+
     // move changes are expressed as one remove + one insert, with the same moveId.
     // For simplicity, they will be treated as remove + insert.
     // Changes will be also ignored, as they represent only data changes, not layout changes
@@ -284,7 +454,7 @@ void QDeclarativeGeoMapItemView::setAutoFitViewport(const bool &fit)
 void QDeclarativeGeoMapItemView::fitViewport()
 {
 
-    if (!m_map || !m_map->mapReady() || !m_fitViewport)
+    if (!m_map || !m_map->mapReady() || !m_fitViewport || isVirtualized())
         return;
 
     if (m_map->mapItems().size() > 0)
@@ -299,6 +469,12 @@ void QDeclarativeGeoMapItemView::setMap(QDeclarativeGeoMap *map)
     if (!map || m_map) // changing map on the fly not supported
         return;
     m_map = map;
+    // These connections are dropped by QDeclarativeGeoMapItemGroup::setQuickMap(nullptr)
+    // when the view is removed from the map.
+    connect(m_map, &QDeclarativeGeoMap::visibleRegionChanged,
+            this, &QDeclarativeGeoMapItemView::onVisibleRegionChanged);
+    connect(m_map, &QDeclarativeGeoMap::mapReadyChanged,
+            this, &QDeclarativeGeoMapItemView::onVisibleRegionChanged);
     instantiateAllItems();
 }
 
@@ -314,6 +490,13 @@ void QDeclarativeGeoMapItemView::removeInstantiatedItems(bool transition)
     // Backward as removeItemFromMap modifies m_instantiatedItems
     for (qsizetype i = m_instantiatedItems.size() -1; i >= 0 ; i--)
         removeDelegateFromMap(i, transition);
+    m_virtualRows.clear();
+    m_activeIds.clear();
+    m_idToRow.clear();
+    m_rowIndex.reset();
+    m_unlocatedIds.clear();
+    resetClusterIndex();
+    clearClusterItems();
 }
 
 /*!
@@ -327,6 +510,21 @@ void QDeclarativeGeoMapItemView::instantiateAllItems()
     if (!m_componentCompleted || !m_map || !m_delegate || m_itemModel.isNull() || !m_instantiatedItems.isEmpty())
         return;
 
+    if (isVirtualized()) {
+        // Only locate the rows here. Delegates are created for the visible ones in updatePolish().
+        const int count = m_delegateModel->count();
+        m_instantiatedItems.fill(nullptr, count);
+        m_virtualRows.fill(VirtualRow(), count);
+        for (int i = 0; i < count; ++i) {
+            assignRowId(i);
+            updateRowCoordinate(i);
+        }
+        updateRowIds(0);
+        rebuildClusterIndex();
+        polish();
+        return;
+    }
+
     // If here, m_delegateModel may contain data, but QQmlInstanceModel::object for each row hasn't been called yet.
     QBoolBlocker createBlocker(m_creatingObject, true);
     for (qsizetype i = 0; i < m_delegateModel->count(); i++) {
@@ -352,11 +550,631 @@ bool QDeclarativeGeoMapItemView::incubateDelegates() const
     return m_incubationMode == QQmlIncubator::Asynchronous;
 }
 
+void QDeclarativeGeoMapItemView::setVirtualizeDelegates(bool virtualize)
+{
+    if (m_virtualize == virtualize)
+        return;
+    resetVirtualization();
+    m_virtualize = virtualize;
+    instantiateAllItems();
+    emit virtualizeDelegatesChanged();
+}
+
+bool QDeclarativeGeoMapItemView::virtualizeDelegates() const
+{
+    return m_virtualize;
+}
+
+void QDeclarativeGeoMapItemView::setCoordinateRole(const QString &role)
+{
+    if (m_coordinateRole == role)
+        return;
+    if (m_virtualize || m_clustering)
+        resetVirtualization();
+    m_coordinateRole = role;
+    if (m_virtualize || m_clustering)
+        instantiateAllItems();
+    emit coordinateRoleChanged();
+}
+
+QString QDeclarativeGeoMapItemView::coordinateRole() const
+{
+    return m_coordinateRole;
+}
+
+void QDeclarativeGeoMapItemView::setVirtualizationMargin(qreal margin)
+{
+    margin = qMax<qreal>(0.0, margin);
+    if (m_virtualizationMargin == margin)
+        return;
+    m_virtualizationMargin = margin;
+    if (isVirtualized())
+        polish();
+    emit virtualizationMarginChanged();
+}
+
+qreal QDeclarativeGeoMapItemView::virtualizationMargin() const
+{
+    return m_virtualizationMargin;
+}
+
+void QDeclarativeGeoMapItemView::setClustering(bool clustering)
+{
+    if (m_clustering == clustering)
+        return;
+    resetVirtualization();
+    m_clustering = clustering;
+    instantiateAllItems();
+    emit clusteringChanged();
+}
+
+bool QDeclarativeGeoMapItemView::clustering() const
+{
+    return m_clustering;
+}
+
+void QDeclarativeGeoMapItemView::setClusterDelegate(QQmlComponent *delegate)
+{
+    if (m_clusterDelegate == delegate)
+        return;
+    if (m_clustering)
+        resetVirtualization();
+    m_clusterDelegate = delegate;
+    for (const ClusterItem &ci : qAsConst(m_clusterItemPool)) {
+        ci.item->deleteLater();
+        ci.cluster->deleteLater();
+    }
+    m_clusterItemPool.clear();
+    if (m_clustering)
+        instantiateAllItems();
+    emit clusterDelegateChanged();
+}
+
+QQmlComponent *QDeclarativeGeoMapItemView::clusterDelegate() const
+{
+    return m_clusterDelegate;
+}
+
+void QDeclarativeGeoMapItemView::setClusterRadius(qreal radius)
+{
+    radius = qMax<qreal>(1.0, radius);
+    if (m_clusterRadius == radius)
+        return;
+    m_clusterRadius = radius;
+    if (isClustering()) {
+        rebuildClusterIndex();
+        polish();
+    }
+    emit clusterRadiusChanged();
+}
+
+qreal QDeclarativeGeoMapItemView::clusterRadius() const
+{
+    return m_clusterRadius;
+}
+
+void QDeclarativeGeoMapItemView::setMinimumClusterSize(int size)
+{
+    size = qMax(2, size);
+    if (m_minimumClusterSize == size)
+        return;
+    m_minimumClusterSize = size;
+    if (isClustering())
+        polish();
+    emit minimumClusterSizeChanged();
+}
+
+int QDeclarativeGeoMapItemView::minimumClusterSize() const
+{
+    return m_minimumClusterSize;
+}
+
+void QDeclarativeGeoMapItemView::setMaximumClusterZoomLevel(int zoomLevel)
+{
+    zoomLevel = qMax(0, zoomLevel);
+    if (m_maximumClusterZoomLevel == zoomLevel)
+        return;
+    m_maximumClusterZoomLevel = zoomLevel;
+    if (isClustering()) {
+        rebuildClusterIndex();
+        polish();
+    }
+    emit maximumClusterZoomLevelChanged();
+}
+
+int QDeclarativeGeoMapItemView::maximumClusterZoomLevel() const
+{
+    return m_maximumClusterZoomLevel;
+}
+
 QList<QQuickItem *> QDeclarativeGeoMapItemView::mapItems()
 {
     return m_instantiatedItems;
 }
 
+/*!
+    \internal
+*/
+void QDeclarativeGeoMapItemView::updatePolish()
+{
+    QDeclarativeGeoMapItemGroup::updatePolish();
+    if (isClustering() && updateClusteredItems())
+        return;
+    clearClusterItems();
+    if (isVirtualized())
+        updateVirtualizedItems();
+}
+
+void QDeclarativeGeoMapItemView::onVisibleRegionChanged()
+{
+    // Camera changes are coalesced into one virtualization pass per frame
+    if (isVirtualized())
+        polish();
+}
+
+bool QDeclarativeGeoMapItemView::isVirtualized() const
+{
+    return (m_virtualize || isClustering()) && !m_coordinateRole.isEmpty();
+}
+
+/*!
+    \internal
+
+    Removes all instantiated delegates, so that they can be instantiated again
+    after a change of the virtualization settings.
+*/
+void QDeclarativeGeoMapItemView::resetVirtualization()
+{
+    if (!m_map)
+        return;
+    removeInstantiatedItems(false);
+}
+
+/*!
+    \internal
+
+    Caches the location of the row at \a index, reading it from the model
+    through the delegate model, without instantiating the delegate.
+*/
+void QDeclarativeGeoMapItemView::updateRowCoordinate(int index)
+{
+    VirtualRow &row = m_virtualRows[index];
+    row.latitude = qQNaN();
+    row.longitude = qQNaN();
+
+    const QVariant value = m_delegateModel->variantValue(index, m_coordinateRole);
+    QGeoCoordinate coordinate;
+    if (value.metaType() == QMetaType::fromType<QGeoCoordinate>())
+        coordinate = value.value<QGeoCoordinate>();
+    else if (value.canConvert<QGeoShape>())
+        coordinate = value.value<QGeoShape>().boundingGeoRectangle().center();
+
+    if (coordinate.isValid()) {
+        row.latitude = coordinate.latitude();
+        row.longitude = coordinate.longitude();
+    }
+
+    if (!m_rowIndex)
+        m_rowIndex.reset(new QGeoMapItemClusterIndex(kRowIndexCellSize, kRowIndexZoomLevel, kRowIndexZoomLevel));
+    if (coordinate.isValid()) {
+        m_unlocatedIds.remove(row.id);
+        m_rowIndex->insert(row.id, QWebMercator::coordToMercator(coordinate));
+    } else {
+        m_rowIndex->remove(row.id);
+        m_unlocatedIds.insert(row.id);
+    }
+
+    if (m_clusterIndex) {
+        m_clusterIndex->remove(row.id);
+        if (coordinate.isValid())
+            m_clusterIndex->insert(row.id, QWebMercator::coordToMercator(coordinate));
+    } else if (m_clusterBuilder) {
+        m_clusterIndexOutdated = true;
+    }
+}
+
+quint32 QDeclarativeGeoMapItemView::assignRowId(int index)
+{
+    m_virtualRows[index].id = m_nextRowId++;
+    return m_virtualRows.at(index).id;
+}
+
+/*!
+    \internal
+
+    Updates the rows of the ids from row \a from on, after rows were inserted or
+    removed there. Rows before it keep their entries.
+*/
+void QDeclarativeGeoMapItemView::updateRowIds(qsizetype from)
+{
+    for (qsizetype i = from; i < m_virtualRows.size(); ++i)
+        m_idToRow.insert(m_virtualRows.at(i).id, int(i));
+}
+
+int QDeclarativeGeoMapItemView::rowForId(quint32 id) const
+{
+    return m_idToRow.value(id, -1);
+}
+
+void QDeclarativeGeoMapItemView::virtualizedModelUpdated(const QQmlChangeSet &changeSet, bool reset)
+{
+    // Rows from there on change index, the ids of the rows before keep theirs
+    qsizetype firstMovedRow = m_virtualRows.size();
+    if (reset) {
+        for (QQuickItem *item : qAsConst(m_instantiatedItems)) {
+            if (item)
+                recycleDelegate(item);
+        }
+        m_instantiatedItems.clear();
+        m_virtualRows.clear();
+        m_activeIds.clear();
+        m_idToRow.clear();
+        m_rowIndex.reset();
+        m_unlocatedIds.clear();
+        resetClusterIndex();
+    } else {
+        // Same back to front processing as in modelUpdated
+        const QList<QQmlChangeSet::Change> &removes = changeSet.removes();
+        std::map<int, int> mapRemoves;
+        for (qsizetype i = 0; i < removes.size(); i++)
+            mapRemoves.insert(std::pair<int, int>(removes.at(i).start(), i));
+
+        for (auto rit = mapRemoves.rbegin(); rit != mapRemoves.rend(); ++rit) {
+            const QQmlChangeSet::Change &c = removes.at(rit->second);
+            for (auto idx = c.end() - 1; idx >= c.start(); --idx) {
+                if (idx >= m_virtualRows.size())
+                    continue;
+                if (QQuickItem *item = m_instantiatedItems.at(idx))
+                    recycleDelegate(item);
+                const quint32 id = m_virtualRows.at(idx).id;
+                m_activeIds.remove(id);
+                if (m_clusterIndex)
+                    m_clusterIndex->remove(id);
+                else if (m_clusterBuilder)
+                    m_clusterIndexOutdated = true;
+                m_idToRow.remove(id);
+                m_unlocatedIds.remove(id);
+                if (m_rowIndex)
+                    m_rowIndex->remove(id);
+                m_instantiatedItems.removeAt(idx);
+                m_virtualRows.removeAt(idx);
+                firstMovedRow = qMin(firstMovedRow, qsizetype(idx));
+            }
+        }
+    }
+
+    for (const QQmlChangeSet::Change &c: changeSet.inserts()) {
+        m_instantiatedItems.insert(c.start(), c.count, nullptr);
+        m_virtualRows.insert(c.start(), c.count, VirtualRow());
+        for (auto idx = c.start(); idx < c.end(); idx++) {
+            assignRowId(idx);
+            updateRowCoordinate(idx);
+        }
+        firstMovedRow = qMin(firstMovedRow, qsizetype(c.start()));
+    }
+    updateRowIds(firstMovedRow);
+
+    for (const QQmlChangeSet::Change &c: changeSet.changes()) {
+        for (auto idx = c.start(); idx < c.end() && idx < m_virtualRows.size(); idx++)
+            updateRowCoordinate(idx);
+    }
+
+    if (reset || m_clusterIndexOutdated || (!m_clusterIndex && !m_clusterBuilder))
+        rebuildClusterIndex();
+    polish();
+}
+
+/*!
+    \internal
+
+    Instantiates the delegates of the rows inside the visible region plus margin,
+    and recycles those of the rows that left it.
+*/
+void QDeclarativeGeoMapItemView::updateVirtualizedItems()
+{
+    if (!m_map || !m_map->mapReady() || m_virtualRows.isEmpty())
+        return;
+
+    QDoubleVector2D topLeft;
+    QDoubleVector2D bottomRight;
+    if (!virtualizationRegion(&topLeft, &bottomRight))
+        return;
+
+    // Rows without a known location are always instantiated
+    QSet<quint32> wanted = m_unlocatedIds;
+    if (m_rowIndex) {
+        const bool crossesDateline = topLeft.x() > bottomRight.x();
+        const auto inRegion = [&](const QDoubleVector2D &p) {
+            if (p.y() < topLeft.y() || p.y() > bottomRight.y())
+                return false;
+            if (crossesDateline)
+                return p.x() >= topLeft.x() || p.x() <= bottomRight.x();
+            return p.x() >= topLeft.x() && p.x() <= bottomRight.x();
+        };
+        const QList<const QGeoMapItemClusterIndex::Cell *> cells =
+                m_rowIndex->cells(kRowIndexZoomLevel, topLeft, bottomRight);
+        for (const QGeoMapItemClusterIndex::Cell *cell : cells) {
+            const bool allInRegion = inRegion(cell->topLeft) && inRegion(cell->bottomRight);
+            for (quint32 id : cell->ids) {
+                if (allInRegion) {
+                    wanted.insert(id);
+                    continue;
+                }
+                const int row = rowForId(id);
+                if (row < 0)
+                    continue;
+                const VirtualRow &r = m_virtualRows.at(row);
+                if (inRegion(QWebMercator::coordToMercator(QGeoCoordinate(r.latitude, r.longitude))))
+                    wanted.insert(id);
+            }
+        }
+    }
+
+    setActiveIds(wanted);
+    m_delegateModel->drainReusableItemsPool(kMaxReusePoolTime);
+}
+
+/*!
+    \internal
+
+    Sets \a topLeft and \a bottomRight to the visible region plus margin, in
+    normalized mercator coordinates. If topLeft.x() > bottomRight.x(), the region
+    crosses the dateline. Returns false if the map has no visible region.
+*/
+bool QDeclarativeGeoMapItemView::virtualizationRegion(QDoubleVector2D *topLeft,
+                                                      QDoubleVector2D *bottomRight) const
+{
+    const QGeoRectangle viewport = m_map->visibleRegion().boundingGeoRectangle();
+    if (!viewport.isValid())
+        return false;
+
+    const double marginLat = viewport.height() * m_virtualizationMargin;
+    const double marginLon = viewport.width() * m_virtualizationMargin;
+    const bool allLongitudes = viewport.width() + 2.0 * marginLon >= 360.0;
+    const QGeoCoordinate geoTopLeft(qMin(90.0, viewport.topLeft().latitude() + marginLat),
+                                    allLongitudes ? -180.0 : QLocationUtils::wrapLong(viewport.topLeft().longitude() - marginLon));
+    const QGeoCoordinate geoBottomRight(qMax(-90.0, viewport.bottomRight().latitude() - marginLat),
+                                        allLongitudes ? 180.0 : QLocationUtils::wrapLong(viewport.bottomRight().longitude() + marginLon));
+    *topLeft = QWebMercator::coordToMercator(geoTopLeft);
+    *bottomRight = QWebMercator::coordToMercator(geoBottomRight);
+    if (allLongitudes) {
+        topLeft->setX(0.0);
+        bottomRight->setX(1.0);
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Instantiates the delegates of the rows in \a ids, and recycles those of the
+    other active rows. Only the active rows and \a ids are visited.
+*/
+void QDeclarativeGeoMapItemView::setActiveIds(const QSet<quint32> &ids)
+{
+    // Release first, so that the delegates can be reused by the rows becoming visible
+    const QSet<quint32> active = m_activeIds;
+    for (quint32 id : active) {
+        if (ids.contains(id))
+            continue;
+        const int row = rowForId(id);
+        if (row >= 0)
+            deactivateRow(row);
+    }
+    for (quint32 id : ids) {
+        if (!m_activeIds.contains(id)) {
+            const int row = rowForId(id);
+            if (row >= 0)
+                activateRow(row);
+        }
+    }
+}
+
+void QDeclarativeGeoMapItemView::activateRow(int index)
+{
+    m_virtualRows[index].active = true;
+    m_activeIds.insert(m_virtualRows.at(index).id);
+    QBoolBlocker createBlocker(m_creatingObject, true);
+    QObject *delegateInstance = m_delegateModel->object(index, m_incubationMode);
+    if (delegateInstance) // otherwise createdItem will fill the placeholder
+        addDelegateToMap(qobject_cast<QQuickItem *>(delegateInstance), index, true);
+}
+
+void QDeclarativeGeoMapItemView::deactivateRow(int index)
+{
+    m_virtualRows[index].active = false;
+    m_activeIds.remove(m_virtualRows.at(index).id);
+    QQuickItem *item = m_instantiatedItems.at(index);
+    if (!item) { // still incubating
+        m_delegateModel->cancel(index);
+        return;
+    }
+    m_instantiatedItems[index] = nullptr;
+    recycleDelegate(item);
+}
+
+/*!
+    \internal
+
+    Removes \a item from the map without exit transition, and hands it back to the
+    delegate model's reuse pool.
+*/
+void QDeclarativeGeoMapItemView::recycleDelegate(QQuickItem *item)
+{
+    terminateExitTransition(item);
+    disconnect(item, 0, this, 0);
+    removeDelegateFromMap(item);
+    item->setParentItem(nullptr);
+    m_delegateModel->release(item, QQmlInstanceModel::Reusable);
+}
+
+bool QDeclarativeGeoMapItemView::isClustering() const
+{
+    return m_clustering && m_clusterDelegate && !m_coordinateRole.isEmpty();
+}
+
+/*!
+    \internal
+
+    Starts building the cluster index for the current rows on the global thread pool.
+    Any index being built is discarded.
+*/
+void QDeclarativeGeoMapItemView::rebuildClusterIndex()
+{
+    resetClusterIndex();
+    if (!isClustering() || m_virtualRows.isEmpty())
+        return;
+
+    QList<std::pair<quint32, QDoubleVector2D>> points;
+    points.reserve(m_virtualRows.size());
+    for (const VirtualRow &row : qAsConst(m_virtualRows)) {
+        if (qIsNaN(row.latitude))
+            continue;
+        points.append({row.id, QWebMercator::coordToMercator(QGeoCoordinate(row.latitude, row.longitude))});
+    }
+
+    m_clusterBuilder = new QGeoMapItemClusterIndexBuilder(points, m_clusterRadius,
+                                                          0, m_maximumClusterZoomLevel);
+    connect(m_clusterBuilder, &QGeoMapItemClusterIndexBuilder::finished,
+            this, &QDeclarativeGeoMapItemView::onClusterIndexBuilt, Qt::QueuedConnection);
+    connect(m_clusterBuilder, &QGeoMapItemClusterIndexBuilder::finished,
+            m_clusterBuilder, &QObject::deleteLater, Qt::QueuedConnection);
+    m_clusterBuilder->start();
+}
+
+void QDeclarativeGeoMapItemView::resetClusterIndex()
+{
+    // A running builder can't be stopped. Its result is ignored, and it deletes itself when done.
+    m_clusterIndex.reset();
+    m_clusterBuilder = nullptr;
+    m_clusterIndexOutdated = false;
+}
+
+void QDeclarativeGeoMapItemView::onClusterIndexBuilt()
+{
+    QGeoMapItemClusterIndexBuilder *builder = qobject_cast<QGeoMapItemClusterIndexBuilder *>(sender());
+    if (!builder || builder != m_clusterBuilder)
+        return;
+    m_clusterBuilder = nullptr;
+    m_clusterIndex.reset(builder->takeIndex());
+    polish();
+}
+
+/*!
+    \internal
+
+    Instantiates the delegates of the unclustered rows, and the cluster delegates of
+    the clusters, inside the visible region plus margin. Returns false if the current
+    zoom level is above maximumClusterZoomLevel, in which case plain virtualization applies.
+*/
+bool QDeclarativeGeoMapItemView::updateClusteredItems()
+{
+    if (!m_map || !m_map->mapReady())
+        return true;
+
+    const int zoomLevel = int(std::floor(m_map->zoomLevel()));
+    if (zoomLevel > m_maximumClusterZoomLevel)
+        return false;
+    if (!m_clusterIndex) // still being built, keep the current items until it is ready
+        return true;
+
+    QDoubleVector2D mercatorTopLeft;
+    QDoubleVector2D mercatorBottomRight;
+    if (!virtualizationRegion(&mercatorTopLeft, &mercatorBottomRight))
+        return true;
+
+    QSet<quint32> wanted;
+    QList<const QGeoMapItemClusterIndex::Cell *> clusters;
+    const QList<const QGeoMapItemClusterIndex::Cell *> cells =
+            m_clusterIndex->cells(zoomLevel, mercatorTopLeft, mercatorBottomRight);
+    for (const QGeoMapItemClusterIndex::Cell *cell : cells) {
+        if (cell->count >= m_minimumClusterSize) {
+            clusters.append(cell);
+        } else {
+            for (quint32 id : cell->ids)
+                wanted.insert(id);
+        }
+    }
+
+    setActiveIds(wanted);
+    updateClusterItems(clusters);
+    m_delegateModel->drainReusableItemsPool(kMaxReusePoolTime);
+    return true;
+}
+
+void QDeclarativeGeoMapItemView::updateClusterItems(const QList<const QGeoMapItemClusterIndex::Cell *> &cells)
+{
+    // Cluster items are interchangeable: existing ones are retargeted to the new clusters
+    for (qsizetype i = 0; i < cells.size(); ++i) {
+        if (i >= m_clusterItems.size()) {
+            const ClusterItem ci = acquireClusterItem();
+            if (!ci.item)
+                break;
+            m_clusterItems.append(ci);
+        }
+        const QGeoMapItemClusterIndex::Cell *cell = cells.at(i);
+        const QGeoCoordinate topLeft = QWebMercator::mercatorToCoord(cell->topLeft);
+        const QGeoCoordinate bottomRight = QWebMercator::mercatorToCoord(cell->bottomRight);
+        m_clusterItems.at(i).cluster->setCluster(cell->count,
+                                                 QWebMercator::mercatorToCoord(cell->center()),
+                                                 QGeoRectangle(topLeft, bottomRight));
+    }
+    releaseClusterItems(cells.size());
+}
+
+QDeclarativeGeoMapItemView::ClusterItem QDeclarativeGeoMapItemView::acquireClusterItem()
+{
+    ClusterItem ci;
+    if (!m_clusterItemPool.isEmpty()) {
+        ci = m_clusterItemPool.takeLast();
+    } else {
+        QQmlContext *parentContext = m_clusterDelegate->creationContext();
+        if (!parentContext)
+            parentContext = qmlContext(this);
+        ci.cluster = new QDeclarativeGeoMapItemCluster(this);
+        QQmlContext *context = new QQmlContext(parentContext, ci.cluster);
+        context->setContextProperty(QStringLiteral("cluster"), ci.cluster);
+        QObject *object = m_clusterDelegate->create(context);
+        ci.item = qobject_cast<QQuickItem *>(object);
+        if (!ci.item) {
+            qWarning() << "MapItemView clusterDelegate must have a map item as root object";
+            delete object;
+            delete ci.cluster;
+            return ClusterItem();
+        }
+        ci.item->setParent(this);
+    }
+
+    ci.item->setParentItem(this);
+    if (QDeclarativeGeoMapItemView *view = qobject_cast<QDeclarativeGeoMapItemView *>(ci.item))
+        m_map->addMapItemView(view);
+    else if (QDeclarativeGeoMapItemGroup *group = qobject_cast<QDeclarativeGeoMapItemGroup *>(ci.item))
+        m_map->addMapItemGroup(group);
+    else if (QDeclarativeGeoMapItemBase *item = qobject_cast<QDeclarativeGeoMapItemBase *>(ci.item))
+        m_map->addMapItem(item);
+    return ci;
+}
+
+/*!
+    \internal
+
+    Removes the cluster items from \a from onwards from the map, and puts them into the pool.
+*/
+void QDeclarativeGeoMapItemView::releaseClusterItems(qsizetype from)
+{
+    while (m_clusterItems.size() > from) {
+        const ClusterItem ci = m_clusterItems.takeLast();
+        removeDelegateFromMap(ci.item);
+        ci.item->setParentItem(nullptr);
+        m_clusterItemPool.append(ci);
+    }
+}
+
+void QDeclarativeGeoMapItemView::clearClusterItems()
+{
+    releaseClusterItems(0);
+}
+
 QQmlInstanceModel::ReleaseFlags QDeclarativeGeoMapItemView::disposeDelegate(QQuickItem *item)
 {
     disconnect(item, 0, this, 0);
@@ -56,12 +56,20 @@
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <map>
 #include <QtCore/QModelIndex>
+#include <QtCore/qnumeric.h>
 #include <QtQml/QQmlParserStatus>
 #include <QtQml/QQmlIncubator>
 #include <QtQml/qqml.h>
 #include <private/qqmldelegatemodel_p.h>
 #include <QtQuick/private/qquicktransition_p.h>
 #include <QtLocation/private/qdeclarativegeomapitemgroup_p.h>
+#include <QtLocation/private/qgeomapitemclusterindex_p.h>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
+
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -77,6 +85,33 @@ class QDeclarativeGeoMapItemViewItemData;
 class QDeclarativeGeoMapItemView;
 class QDeclarativeGeoMapItemGroup;
 
+class Q_LOCATION_PRIVATE_EXPORT QDeclarativeGeoMapItemCluster : public QObject
+{
+    Q_OBJECT
+    QML_ANONYMOUS
+    QML_ADDED_IN_VERSION(6, 5)
+    Q_PROPERTY(int count READ count NOTIFY clusterChanged)
+    Q_PROPERTY(QGeoCoordinate center READ center NOTIFY clusterChanged)
+    Q_PROPERTY(QGeoRectangle bounds READ bounds NOTIFY clusterChanged)
+
+public:
+    explicit QDeclarativeGeoMapItemCluster(QObject *parent = nullptr);
+
+    int count() const;
+    QGeoCoordinate center() const;
+    QGeoRectangle bounds() const;
+
+    void setCluster(int count, const QGeoCoordinate &center, const QGeoRectangle &bounds);
+
+Q_SIGNALS:
+    void clusterChanged();
+
+private:
+    int m_count = 0;
+    QGeoCoordinate m_center;
+    QGeoRectangle m_bounds;
+};
+
 class Q_LOCATION_PRIVATE_EXPORT QDeclarativeGeoMapItemView : public QDeclarativeGeoMapItemGroup
 {
     Q_OBJECT
@@ -89,6 +124,14 @@ class Q_LOCATION_PRIVATE_EXPORT QDeclarativeGeoMapItemView : public QDeclarative
     Q_PROPERTY(QQuickTransition *remove MEMBER m_exit REVISION(5, 12))
     Q_PROPERTY(QList<QQuickItem *> mapItems READ mapItems REVISION(5, 12))
     Q_PROPERTY(bool incubateDelegates READ incubateDelegates WRITE setIncubateDelegates NOTIFY incubateDelegatesChanged REVISION(5, 12))
+    Q_PROPERTY(bool virtualizeDelegates READ virtualizeDelegates WRITE setVirtualizeDelegates NOTIFY virtualizeDelegatesChanged REVISION(6, 5))
+    Q_PROPERTY(QString coordinateRole READ coordinateRole WRITE setCoordinateRole NOTIFY coordinateRoleChanged REVISION(6, 5))
+    Q_PROPERTY(qreal virtualizationMargin READ virtualizationMargin WRITE setVirtualizationMargin NOTIFY virtualizationMarginChanged REVISION(6, 5))
+    Q_PROPERTY(bool clustering READ clustering WRITE setClustering NOTIFY clusteringChanged REVISION(6, 5))
+    Q_PROPERTY(QQmlComponent *clusterDelegate READ clusterDelegate WRITE setClusterDelegate NOTIFY clusterDelegateChanged REVISION(6, 5))
+    Q_PROPERTY(qreal clusterRadius READ clusterRadius WRITE setClusterRadius NOTIFY clusterRadiusChanged REVISION(6, 5))
+    Q_PROPERTY(int minimumClusterSize READ minimumClusterSize WRITE setMinimumClusterSize NOTIFY minimumClusterSizeChanged REVISION(6, 5))
+    Q_PROPERTY(int maximumClusterZoomLevel READ maximumClusterZoomLevel WRITE setMaximumClusterZoomLevel NOTIFY maximumClusterZoomLevelChanged REVISION(6, 5))
 
 public:
     explicit QDeclarativeGeoMapItemView(QQuickItem *parent = nullptr);
@@ -110,6 +153,30 @@ public:
     void setIncubateDelegates(bool useIncubators);
     bool incubateDelegates() const;
 
+    void setVirtualizeDelegates(bool virtualize);
+    bool virtualizeDelegates() const;
+
+    void setCoordinateRole(const QString &role);
+    QString coordinateRole() const;
+
+    void setVirtualizationMargin(qreal margin);
+    qreal virtualizationMargin() const;
+
+    void setClustering(bool clustering);
+    bool clustering() const;
+
+    void setClusterDelegate(QQmlComponent *delegate);
+    QQmlComponent *clusterDelegate() const;
+
+    void setClusterRadius(qreal radius);
+    qreal clusterRadius() const;
+
+    void setMinimumClusterSize(int size);
+    int minimumClusterSize() const;
+
+    void setMaximumClusterZoomLevel(int zoomLevel);
+    int maximumClusterZoomLevel() const;
+
     QList<QQuickItem *> mapItems();
 
     // From QQmlParserStatus
@@ -121,6 +188,17 @@ Q_SIGNALS:
     void delegateChanged();
     void autoFitViewportChanged();
     void incubateDelegatesChanged();
+    Q_REVISION(6, 5) void virtualizeDelegatesChanged();
+    Q_REVISION(6, 5) void coordinateRoleChanged();
+    Q_REVISION(6, 5) void virtualizationMarginChanged();
+    Q_REVISION(6, 5) void clusteringChanged();
+    Q_REVISION(6, 5) void clusterDelegateChanged();
+    Q_REVISION(6, 5) void clusterRadiusChanged();
+    Q_REVISION(6, 5) void minimumClusterSizeChanged();
+    Q_REVISION(6, 5) void maximumClusterZoomLevelChanged();
+
+protected:
+    void updatePolish() override;
 
 private Q_SLOTS:
     void destroyingItem(QObject *object);
@@ -128,6 +206,8 @@ private Q_SLOTS:
     void createdItem(int index, QObject *object);
     void modelUpdated(const QQmlChangeSet &changeSet, bool reset);
     void exitTransitionFinished();
+    void onVisibleRegionChanged();
+    void onClusterIndexBuilt();
 
 private:
     void fitViewport();
@@ -143,6 +223,41 @@ private:
     void addItemGroupToMap(QDeclarativeGeoMapItemGroup *item, int index, bool createdItem);
     void addDelegateToMap(QQuickItem *object, int index, bool createdItem = false);
 
+    // Viewport virtualization
+    struct VirtualRow {
+        double latitude = qQNaN();
+        double longitude = qQNaN();
+        quint32 id = 0; // stable across model inserts and removals
+        bool active = false;
+    };
+    struct ClusterItem {
+        QQuickItem *item = nullptr;
+        QDeclarativeGeoMapItemCluster *cluster = nullptr;
+    };
+    bool isVirtualized() const;
+    void resetVirtualization();
+    void updateRowCoordinate(int index);
+    void virtualizedModelUpdated(const QQmlChangeSet &changeSet, bool reset);
+    void updateVirtualizedItems();
+    bool virtualizationRegion(QDoubleVector2D *topLeft, QDoubleVector2D *bottomRight) const;
+    void setActiveIds(const QSet<quint32> &ids);
+    void activateRow(int index);
+    void deactivateRow(int index);
+    void recycleDelegate(QQuickItem *item);
+    quint32 assignRowId(int index);
+    void updateRowIds(qsizetype from);
+    int rowForId(quint32 id) const;
+
+    // Clustering
+    bool isClustering() const;
+    void rebuildClusterIndex();
+    void resetClusterIndex();
+    bool updateClusteredItems();
+    void updateClusterItems(const QList<const QGeoMapItemClusterIndex::Cell *> &cells);
+    ClusterItem acquireClusterItem();
+    void releaseClusterItems(qsizetype from);
+    void clearClusterItems();
+
     bool m_componentCompleted = false;
     QQmlIncubator::IncubationMode m_incubationMode = QQmlIncubator::Asynchronous;
     QQmlComponent *m_delegate = nullptr;
@@ -154,6 +269,26 @@ private:
     QQmlDelegateModel *m_delegateModel = nullptr;
     QQuickTransition *m_enter = nullptr;
     QQuickTransition *m_exit = nullptr;
+    bool m_virtualize = false;
+    QString m_coordinateRole;
+    qreal m_virtualizationMargin = 0.25;
+    QList<VirtualRow> m_virtualRows; // row aligned with m_instantiatedItems when virtualized
+    QSet<quint32> m_activeIds;
+    QHash<quint32, int> m_idToRow; // kept up to date on inserts and removals
+    std::unique_ptr<QGeoMapItemClusterIndex> m_rowIndex; // located rows, for viewport queries
+    QSet<quint32> m_unlocatedIds;
+    quint32 m_nextRowId = 0;
+
+    bool m_clustering = false;
+    QQmlComponent *m_clusterDelegate = nullptr;
+    qreal m_clusterRadius = 60.0;
+    int m_minimumClusterSize = 2;
+    int m_maximumClusterZoomLevel = 16;
+    std::unique_ptr<QGeoMapItemClusterIndex> m_clusterIndex;
+    QPointer<QGeoMapItemClusterIndexBuilder> m_clusterBuilder;
+    bool m_clusterIndexOutdated = false;
+    QList<ClusterItem> m_clusterItems;
+    QList<ClusterItem> m_clusterItemPool;
 
     friend class QDeclarativeGeoMap;
     friend class QDeclarativeGeoMapItemBase;
@@ -38,6 +38,8 @@
  ****************************************************************************/
 
 #include "qdeclarativegeomapitemutils_p.h"
+#include "qgeomapitemclipper_p.h"
+#include "qgeomapitemearcut_p.h"
 #include "qdeclarativepolygonmapitem_p.h"
 #include "qdeclarativepolylinemapitem_p_p.h"
 #include "qdeclarativepolygonmapitem_p_p.h"
@@ -45,6 +47,7 @@
 #include "error_messages_p.h"
 
 #include <QtCore/QScopedValueRollback>
+#include <QtCore/QThreadPool>
 #include <qnumeric.h>
 #include <QPainter>
 #include <QPainterPath>
@@ -55,12 +58,9 @@
 #include <QtLocation/private/qgeomap_p.h>
 #include <QtPositioning/private/qlocationutils_p.h>
 #include <QtPositioning/private/qdoublevector2d_p.h>
-#include <QtPositioning/private/qclipperutils_p.h>
 #include <QtPositioning/private/qgeopolygon_p.h>
 #include <QtPositioning/private/qwebmercator_p.h>
 
-/* poly2tri triangulator includes */
-#include <earcut.hpp>
 #include <array>
 
 QT_BEGIN_NAMESPACE
@@ -111,9 +111,11 @@ QT_BEGIN_NAMESPACE
     MapPolygons have a rendering cost that is O(n) with respect to the number
     of vertices. This means that the per frame cost of having a Polygon on the
     Map grows in direct proportion to the number of points on the Polygon. There
-    is an additional triangulation cost (approximately O(n log n)) which is
-    currently paid with each frame, but in future may be paid only upon adding
-    or removing points.
+    is an additional triangulation cost (approximately O(n log n)). With the
+    software backend it is paid with each frame. With the OpenGL backend it is
+    paid only when the geometry changes, and for large polygons it is paid on a
+    worker thread, drawing only the outline of the polygon until the triangulation
+    is available.
 
     Like the other map objects, MapPolygon is normally drawn without a smooth
     appearance. Setting the \l {Item::opacity}{opacity} property will force the object to
@@ -176,6 +178,8 @@ void QGeoMapPolygonGeometry::updateSourcePoints(const QGeoMap &map,
     QList<QDoubleVector2D> wrappedPath;
     wrappedPath.reserve(path.size());
     QDoubleVector2D wrappedLeftBound(qInf(), qInf());
+    QDoubleVector2D wrappedMinimum(qInf(), qInf());
+    QDoubleVector2D wrappedMaximum(-qInf(), -qInf());
     // 1)
     for (const auto &coord : path) {
         QDoubleVector2D wrappedProjection = p.wrapMapProjection(coord);
@@ -196,18 +200,20 @@ void QGeoMapPolygonGeometry::updateSourcePoints(const QGeoMap &map,
         if (wrappedProjection.x() < wrappedLeftBound.x() || (wrappedProjection.x() == wrappedLeftBound.x() && wrappedProjection.y() < wrappedLeftBound.y())) {
             wrappedLeftBound = wrappedProjection;
         }
+        wrappedMinimum.setX(qMin(wrappedMinimum.x(), wrappedProjection.x()));
+        wrappedMinimum.setY(qMin(wrappedMinimum.y(), wrappedProjection.y()));
+        wrappedMaximum.setX(qMax(wrappedMaximum.x(), wrappedProjection.x()));
+        wrappedMaximum.setY(qMax(wrappedMaximum.y(), wrappedProjection.y()));
         wrappedPath.append(wrappedProjection);
     }
 
     // 2)
     QList<QList<QDoubleVector2D> > clippedPaths;
-    const QList<QDoubleVector2D> &visibleRegion = p.projectableGeometry();
-    if (visibleRegion.size()) {
-        QClipperUtils clipper;
-        clipper.addSubjectPath(wrappedPath, true);
-        clipper.addClipPolygon(visibleRegion);
-        clippedPaths = clipper.execute(QClipperUtils::Intersection, QClipperUtils::pftEvenOdd,
-                                       QClipperUtils::pftEvenOdd);
+    const QGeoMapItemClipper clipper(p.projectableGeometry());
+    // Nothing to clip if the path lies entirely inside the projectable region,
+    // which is always the case with an untilted camera.
+    if (clipper.contains(wrappedMinimum, wrappedMaximum) != QGeoMapItemClipper::Inside) {
+        clippedPaths = clipper.clipPolygon(wrappedPath, wrappedMinimum, wrappedMaximum);
 
         // 2.1) update srcOrigin_ and leftBoundWrapped with the point with minimum X
         QDoubleVector2D lb(qInf(), qInf());
@@ -233,16 +239,16 @@ void QGeoMapPolygonGeometry::updateSourcePoints(const QGeoMap &map,
     QDoubleVector2D origin = p.wrappedMapProjectionToItemPosition(leftBoundWrapped);
     for (const QList<QDoubleVector2D> &path: clippedPaths) {
         QDoubleVector2D lastAddedPoint;
-        for (qsizetype i = 0; i < path.size(); ++i) {
-            QDoubleVector2D point = p.wrappedMapProjectionToItemPosition(path.at(i));
-            point = point - origin; // (0,0) if point == geoLeftBound_
+        const QList<QDoubleVector2D> points = p.wrappedMapProjectionToItemPosition(path);
+        for (qsizetype i = 0; i < points.size(); ++i) {
+            const QDoubleVector2D point = points.at(i) - origin; // (0,0) if point == geoLeftBound_
 
             if (i == 0) {
                 srcPath_.moveTo(point.toPointF());
                 lastAddedPoint = point;
             } else {
                 if ((point - lastAddedPoint).manhattanLength() > 3 ||
-                        i == path.size() - 1) {
+                        i == points.size() - 1) {
                     srcPath_.lineTo(point.toPointF());
                     lastAddedPoint = point;
                 }
@@ -350,15 +356,7 @@ static void wrapPath(const QGeoPolygon &poly
 {
     QList<QList<QDoubleVector2D> > paths;
     for (qsizetype i = 0; i < 1 + poly.holesCount(); ++i) {
-        QList<QDoubleVector2D> path;
-        if (!i) {
-            for (const QGeoCoordinate &c : poly.perimeter())
-                path << p.geoToMapProjection(c);
-        } else {
-            for (const QGeoCoordinate &c : poly.holePath(i-1))
-                path << p.geoToMapProjection(c);
-        }
-        paths.append(path);
+        paths.append(p.geoToMapProjection(i ? poly.holePath(i - 1) : poly.perimeter()));
     }
 
     const QDoubleVector2D leftBound = p.geoToMapProjection(geoLeftBound);
@@ -389,59 +387,73 @@ static void wrapPath(const QGeoPolygon &poly
         *leftBoundWrapped = leftBound;
 }
 
+static qsizetype vertexCount(const QList<QList<QDoubleVector2D>> &wrappedPaths)
+{
+    qsizetype count = 0;
+    for (const QList<QDoubleVector2D> &wrappedPath: wrappedPaths)
+        count += wrappedPath.size();
+    return count;
+}
+
+// The first path is the perimeter, the following ones are holes.
 static void cutPathEars(const QList<QList<QDoubleVector2D>> &wrappedPaths,
                         QList<QDeclarativeGeoMapItemUtils::vec2> &screenVertices,
                         QList<quint32> &screenIndices)
 {
-    using Coord = double;
-    using N = uint32_t;
-    using Point = std::array<Coord, 2>;
     screenVertices.clear();
-    screenIndices.clear();
-
-    std::vector<std::vector<Point>> polygon;
-    std::vector<Point> poly;
-
+    screenVertices.reserve(vertexCount(wrappedPaths));
     for (const QList<QDoubleVector2D> &wrappedPath: wrappedPaths) {
-        poly.clear();
-        for (const QDoubleVector2D &v: wrappedPath) {
+        for (const QDoubleVector2D &v: wrappedPath)
             screenVertices << v;
-            Point pt = {{ v.x(), v.y() }};
-            poly.push_back( pt );
-        }
-        polygon.push_back(poly);
     }
 
-    std::vector<N> indices = qt_mapbox::earcut<N>(polygon);
-
-    for (const auto &i: indices)
-        screenIndices << quint32(i);
+    const std::vector<quint32> indices = qt_mapbox::earcut<quint32>(wrappedPaths);
+    screenIndices = QList<quint32>(indices.cbegin(), indices.cend());
 }
 
 static void cutPathEars(const QList<QDoubleVector2D> &wrappedPath,
                         QList<QDeclarativeGeoMapItemUtils::vec2> &screenVertices,
                         QList<quint32> &screenIndices)
 {
-    using Coord = double;
-    using N = uint32_t;
-    using Point = std::array<Coord, 2>;
-    screenVertices.clear();
-    screenIndices.clear();
+    cutPathEars(QList<QList<QDoubleVector2D>>{ wrappedPath }, screenVertices, screenIndices);
+}
 
-    std::vector<std::vector<Point>> polygon;
-    std::vector<Point> poly;
+QGeoMapPolygonTriangulator::QGeoMapPolygonTriangulator(const QList<QList<QDoubleVector2D>> &wrappedPaths,
+                                                       quint64 serial)
+    : m_wrappedPaths(wrappedPaths), m_serial(serial)
+{
+    setAutoDelete(false);
+}
 
-    for (const QDoubleVector2D &v: wrappedPath) {
-        screenVertices << v;
-        Point pt = {{ v.x(), v.y() }};
-        poly.push_back( pt );
-    }
-    polygon.push_back(poly);
+void QGeoMapPolygonTriangulator::start()
+{
+    QThreadPool::globalInstance()->start(this);
+}
+
+void QGeoMapPolygonTriangulator::run()
+{
+    cutPathEars(m_wrappedPaths, m_screenVertices, m_screenIndices);
+    emit finished();
+}
 
-    std::vector<N> indices = qt_mapbox::earcut<N>(polygon);
+/*!
+    \internal
 
-    for (const auto &i: indices)
-        screenIndices << quint32(i);
+    Applies a triangulation computed by a QGeoMapPolygonTriangulator.
+    Returns false if the geometry changed since the triangulation was requested.
+*/
+bool QGeoMapPolygonGeometryOpenGL::setTriangulation(quint64 serial,
+                                                    QList<QDeclarativeGeoMapItemUtils::vec2> &&vertices,
+                                                    QList<quint32> &&indices)
+{
+    if (!m_triangulationPending || serial != m_triangulationSerial)
+        return false;
+    m_screenVertices = std::move(vertices);
+    m_screenIndices = std::move(indices);
+    m_triangulated = true;
+    m_triangulationPending = false;
+    m_dataChanged = true;
+    return true;
 }
 
 /*!
@@ -476,6 +488,11 @@ void QGeoMapPolygonGeometryOpenGL::updateSourcePoints(const QGeoMap &map,
     //    the bbox wraps have to be however clipped, and then projected, in order to figure out the geometry.
     //    Note that this might still cause the geometryChange method to fail under some extreme conditions.
     cutPathEars(wrappedPath, m_screenVertices, m_screenIndices);
+    // This triangulation doesn't come from a QGeoPolygon: drop the cached one, and any pending result
+    m_wrappedPaths.clear();
+    m_triangulated = false;
+    m_triangulationPending = false;
+    ++m_triangulationSerial;
 
     m_wrappedPolygons.resize(3);
     m_wrappedPolygons[0].wrappedBboxes = wrappedBboxMinus1;
@@ -494,11 +511,13 @@ void QGeoMapPolygonGeometryOpenGL::updateSourcePoints(const QGeoMap &map, const
     // The approach is the same as described in QGeoMapPolylineGeometry::updateSourcePoints
     srcOrigin_ = geoLeftBound_;
 
-    QDoubleVector2D leftBoundWrapped;
-    QList<QList<QDoubleVector2D>> wrappedPath;
-    // 1) pre-compute 3 sets of "wrapped" coordinates: one w regular mercator, one w regular mercator +- 1.0
-    wrapPath(poly, geoLeftBound_, p,
-             wrappedPath, &leftBoundWrapped);
+    // 1) pre-compute the "wrapped" coordinates, unless the polygon and its left bound are the same
+    //    as for the current triangulation. The mercator paths don't depend on the camera.
+    const bool wrappedPathsValid = (m_triangulated || m_triangulationPending)
+            && m_wrappedSourceSerial == m_sourceSerial
+            && m_wrappedLeftBound == geoLeftBound_;
+    if (!wrappedPathsValid)
+        wrapPath(poly, geoLeftBound_, p, m_wrappedPaths);
 
     // 1.1) do the same for the bbox
     QList<QDoubleVector2D> wrappedBbox, wrappedBboxPlus1, wrappedBboxMinus1;
@@ -510,7 +529,23 @@ void QGeoMapPolygonGeometryOpenGL::updateSourcePoints(const QGeoMap &map, const
     //    the triangulations can be used as they are, as they "bypass" the QtQuick display chain
     //    the bbox wraps have to be however clipped, and then projected, in order to figure out the geometry.
     //    Note that this might still cause the geometryChange method to fail under some extreme conditions.
-    cutPathEars(wrappedPath, m_screenVertices, m_screenIndices);
+    //    The triangulation is reused as long as the mercator paths don't change, even if it is
+    //    empty, and is left to a QGeoMapPolygonTriangulator for large polygons.
+    if (!wrappedPathsValid) {
+        m_wrappedSourceSerial = m_sourceSerial;
+        m_wrappedLeftBound = geoLeftBound_;
+        ++m_triangulationSerial;
+        if (m_asyncTriangulation && vertexCount(m_wrappedPaths) >= AsyncTriangulationThreshold) {
+            m_screenVertices.clear();
+            m_screenIndices.clear();
+            m_triangulated = false;
+            m_triangulationPending = true;
+        } else {
+            cutPathEars(m_wrappedPaths, m_screenVertices, m_screenIndices);
+            m_triangulated = true;
+            m_triangulationPending = false;
+        }
+    }
     m_wrappedPolygons.resize(3);
     m_wrappedPolygons[0].wrappedBboxes = wrappedBboxMinus1;
     m_wrappedPolygons[1].wrappedBboxes = wrappedBbox;
@@ -594,7 +629,46 @@ QDeclarativePolygonMapItemPrivate::~QDeclarativePolygonMapItemPrivate() {}
 
 QDeclarativePolygonMapItemPrivateCPU::~QDeclarativePolygonMapItemPrivateCPU() {}
 
-QDeclarativePolygonMapItemPrivateOpenGL::~QDeclarativePolygonMapItemPrivateOpenGL() {}
+QDeclarativePolygonMapItemPrivateOpenGL::~QDeclarativePolygonMapItemPrivateOpenGL()
+{
+    // A running triangulator can't be stopped. It deletes itself when done.
+    if (m_triangulator)
+        QObject::disconnect(m_triangulator, nullptr, &m_poly, nullptr);
+}
+
+void QDeclarativePolygonMapItemPrivateOpenGL::startTriangulation()
+{
+    if (!m_geometry.isTriangulationPending())
+        return;
+    if (m_triangulator) {
+        if (m_triangulator->serial() == m_geometry.triangulationSerial())
+            return; // already in progress
+        QObject::disconnect(m_triangulator, nullptr, &m_poly, nullptr);
+    }
+
+    QGeoMapPolygonTriangulator *triangulator =
+            new QGeoMapPolygonTriangulator(m_geometry.wrappedPaths(), m_geometry.triangulationSerial());
+    m_triangulator = triangulator;
+    QObject::connect(triangulator, &QGeoMapPolygonTriangulator::finished, &m_poly,
+                     [this, triangulator]() { onTriangulationFinished(triangulator); },
+                     Qt::QueuedConnection);
+    QObject::connect(triangulator, &QGeoMapPolygonTriangulator::finished,
+                     triangulator, &QObject::deleteLater, Qt::QueuedConnection);
+    triangulator->start();
+}
+
+void QDeclarativePolygonMapItemPrivateOpenGL::onTriangulationFinished(QGeoMapPolygonTriangulator *triangulator)
+{
+    if (triangulator != m_triangulator)
+        return;
+    m_triangulator = nullptr;
+    if (m_geometry.setTriangulation(triangulator->serial(),
+                                    std::move(triangulator->m_screenVertices),
+                                    std::move(triangulator->m_screenIndices))) {
+        preserveGeometry();
+        markScreenDirtyAndUpdate();
+    }
+}
 /*
  * QDeclarativePolygonMapItem Implementation
  */
@@ -53,6 +53,9 @@
 //
 
 #include <QList>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QRunnable>
 #include <QtCore/QScopedValueRollback>
 #include <QtGui/QMatrix4x4>
 #include <QColor>
@@ -92,6 +95,29 @@ protected:
     bool assumeSimple_ = false;
 };
 
+class Q_LOCATION_PRIVATE_EXPORT QGeoMapPolygonTriangulator : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    QGeoMapPolygonTriangulator(const QList<QList<QDoubleVector2D>> &wrappedPaths, quint64 serial);
+
+    void start();
+    void run() override;
+
+    inline quint64 serial() const { return m_serial; }
+
+    QList<QDeclarativeGeoMapItemUtils::vec2> m_screenVertices;
+    QList<quint32> m_screenIndices;
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    QList<QList<QDoubleVector2D>> m_wrappedPaths;
+    quint64 m_serial;
+};
+
 class Q_LOCATION_PRIVATE_EXPORT QGeoMapPolygonGeometryOpenGL : public QGeoMapItemGeometry
 {
 public:
@@ -101,6 +127,23 @@ public:
     QGeoMapPolygonGeometryOpenGL();
     ~QGeoMapPolygonGeometryOpenGL() override {}
 
+    // Polygons with at least this many vertices are triangulated by a QGeoMapPolygonTriangulator
+    // when asynchronous triangulation is enabled.
+    static constexpr qsizetype AsyncTriangulationThreshold = 1024;
+
+    inline void setAsyncTriangulation(bool async) { m_asyncTriangulation = async; }
+    inline bool isTriangulated() const { return m_triangulated; }
+    inline bool isTriangulationPending() const { return m_triangulationPending; }
+    inline quint64 triangulationSerial() const { return m_triangulationSerial; }
+    inline const QList<QList<QDoubleVector2D>> &wrappedPaths() const { return m_wrappedPaths; }
+    bool setTriangulation(quint64 serial,
+                          QList<QDeclarativeGeoMapItemUtils::vec2> &&vertices,
+                          QList<quint32> &&indices);
+
+    // Must be called whenever the QGeoPolygon passed to updateSourcePoints changes,
+    // as the triangulation is only recomputed for a new source.
+    inline void markSourceChanged() { ++m_sourceSerial; markSourceDirty(); }
+
     // Temporary method for compatibility in MapCircleObject. Remove when MapObjects are ported.
     void updateSourcePoints(const QGeoMap &map,
                             const QList<QDoubleVector2D> &path);
@@ -122,21 +165,19 @@ public:
 
         const QList<QDeclarativeGeoMapItemUtils::vec2> &vx = m_screenVertices;
         const QList<quint32> &ix = m_screenIndices;
+        static_assert(sizeof(QDeclarativeGeoMapItemUtils::vec2) == sizeof(QSGGeometry::Point2D));
 
-        geom->allocate(vx.size(), ix.size());
+        reserveGeometry(geom, vx.size(), ix.size());
         if (geom->indexType() == QSGGeometry::UnsignedShortType) {
             quint16 *its = geom->indexDataAsUShort();
             for (qsizetype i = 0; i < ix.size(); ++i)
                 its[i] = ix[i];
         } else if (geom->indexType() == QSGGeometry::UnsignedIntType) {
-            quint32 *its = geom->indexDataAsUInt();
-            for (qsizetype i = 0; i < ix.size(); ++i)
-                its[i] = ix[i];
+            memcpy(geom->indexDataAsUInt(), ix.constData(), ix.size() * sizeof(quint32));
         }
 
-        QSGGeometry::Point2D *pts = geom->vertexDataAsPoint2D();
-        for (qsizetype i = 0; i < vx.size(); ++i)
-            pts[i].set(vx[i].x, vx[i].y);
+        memcpy(geom->vertexData(), vx.constData(), vx.size() * sizeof(QSGGeometry::Point2D));
+        commitGeometry(geom, vx.size(), ix.size());
     }
 
     QList<QDeclarativeGeoMapItemUtils::vec2> m_screenVertices;
@@ -144,6 +185,19 @@ public:
     QDoubleVector2D m_bboxLeftBoundWrapped;
     QList<WrappedPolygon> m_wrappedPolygons;
     int m_wrapOffset = 0;
+
+protected:
+    // Mercator paths the current triangulation was computed from, and the source and left bound
+    // they were wrapped for. Since the triangulation is in mercator space, it remains valid
+    // across camera changes.
+    QList<QList<QDoubleVector2D>> m_wrappedPaths;
+    quint64 m_sourceSerial = 0;
+    quint64 m_wrappedSourceSerial = 0;
+    QGeoCoordinate m_wrappedLeftBound;
+    quint64 m_triangulationSerial = 0;
+    bool m_asyncTriangulation = false;
+    bool m_triangulated = false;
+    bool m_triangulationPending = false;
 };
 
 class Q_LOCATION_PRIVATE_EXPORT MapPolygonShader : public QSGMaterialShader
@@ -295,25 +349,16 @@ public:
     }
     void regenerateCache()
     {
-        if (!m_poly.map() || m_poly.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
-            return;
-        const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_poly.map()->geoProjection());
-        m_geopathProjected.clear();
-        m_geopathProjected.reserve(m_poly.m_geopoly.size());
-        for (const QGeoCoordinate &c : m_poly.m_geopoly.perimeter())
-            m_geopathProjected << p.geoToMapProjection(c);
+        m_mercatorPath.setPath(m_poly.m_geopoly.perimeter(), m_poly.m_geopoly.boundingGeoRectangle());
     }
     void updateCache()
     {
-        if (!m_poly.map() || m_poly.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
-            return;
-        const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_poly.map()->geoProjection());
-        m_geopathProjected << p.geoToMapProjection(m_poly.m_geopoly.perimeter().last());
+        m_mercatorPath.append(m_poly.m_geopoly.perimeter().last(), m_poly.m_geopoly.boundingGeoRectangle());
     }
     void preserveGeometry()
     {
-        m_geometry.setPreserveGeometry(true, m_poly.m_geopoly.boundingGeoRectangle().topLeft());
-        m_borderGeometry.setPreserveGeometry(true, m_poly.m_geopoly.boundingGeoRectangle().topLeft());
+        m_geometry.setPreserveGeometry(true, m_mercatorPath.geoLeftBound());
+        m_borderGeometry.setPreserveGeometry(true, m_mercatorPath.geoLeftBound());
     }
     void afterViewportChanged() override
     {
@@ -323,7 +368,7 @@ public:
     }
     void onMapSet() override
     {
-        regenerateCache();
+        // The mercator path does not depend on the map
         markSourceDirtyAndUpdate();
     }
     void onGeoGeometryChanged() override
@@ -357,7 +402,7 @@ public:
         QScopedValueRollback<bool> rollback(m_poly.m_updatingGeometry);
         m_poly.m_updatingGeometry = true;
 
-        m_geometry.updateSourcePoints(*map, m_geopathProjected);
+        m_geometry.updateSourcePoints(*map, m_mercatorPath.path());
         m_geometry.updateScreenPoints(*map, borderWidth);
 
         QList<QGeoMapItemGeometry *> geoms;
@@ -365,10 +410,10 @@ public:
         m_borderGeometry.clear();
 
         if (m_poly.m_border.color().alpha() != 0 && borderWidth > 0) {
-            QList<QDoubleVector2D> closedPath = m_geopathProjected;
+            QList<QDoubleVector2D> closedPath = m_mercatorPath.path();
             closedPath << closedPath.first();
 
-            m_borderGeometry.setPreserveGeometry(true, m_poly.m_geopoly.boundingGeoRectangle().topLeft());
+            m_borderGeometry.setPreserveGeometry(true, m_mercatorPath.geoLeftBound());
 
             const QGeoCoordinate &geometryOrigin = m_geometry.origin();
 
@@ -430,7 +475,7 @@ public:
         return (m_geometry.contains(point) || m_borderGeometry.contains(point));
     }
 
-    QList<QDoubleVector2D> m_geopathProjected;
+    QGeoMapItemMercatorPath m_mercatorPath;
     QGeoMapPolygonGeometry m_geometry;
     QGeoMapPolylineGeometry m_borderGeometry;
     MapPolygonNode *m_node = nullptr;
@@ -451,11 +496,13 @@ public:
 
     QDeclarativePolygonMapItemPrivateOpenGL(QDeclarativePolygonMapItem &polygon) : QDeclarativePolygonMapItemPrivate(polygon)
     {
+        m_geometry.setAsyncTriangulation(true);
     }
 
     QDeclarativePolygonMapItemPrivateOpenGL(QDeclarativePolygonMapItemPrivate &other)
         : QDeclarativePolygonMapItemPrivate(other)
     {
+        m_geometry.setAsyncTriangulation(true);
     }
 
     ~QDeclarativePolygonMapItemPrivateOpenGL() override;
@@ -475,7 +522,7 @@ public:
     void markSourceDirtyAndUpdate() override
     {
         // preserveGeometry is cleared in updateMapItemPaintNode
-        m_geometry.markSourceDirty();
+        m_geometry.markSourceChanged();
         m_borderGeometry.markSourceDirty();
         m_poly.polishAndUpdate();
     }
@@ -520,20 +567,21 @@ public:
 
         QScopedValueRollback<bool> rollback(m_poly.m_updatingGeometry);
         m_poly.m_updatingGeometry = true;
-        const qreal lineWidth = m_poly.m_border.width();
         const QColor &lineColor = m_poly.m_border.color();
         const QColor &fillColor = m_poly.color();
         if (fillColor.alpha() != 0) {
             m_geometry.updateSourcePoints(*m_poly.map(), m_poly.m_geopoly);
             m_geometry.markScreenDirty();
-            m_geometry.updateScreenPoints(*m_poly.map(), lineWidth, lineColor);
+            m_geometry.updateScreenPoints(*m_poly.map(), m_poly.m_border.width(), lineColor);
+            startTriangulation();
         } else {
             m_geometry.clearBounds();
         }
+        const qreal lineWidth = outlineWidth(); // depends on the triangulation being pending
 
         QGeoMapItemGeometry * geom = &m_geometry;
         m_borderGeometry.clearScreen();
-        if (lineColor.alpha() != 0 && lineWidth > 0) {
+        if ((lineColor.alpha() != 0 || isOutlinePlaceholder()) && lineWidth > 0) {
             m_borderGeometry.updateSourcePoints(*m_poly.map(), m_poly.m_geopoly);
             m_borderGeometry.markScreenDirty();
             m_borderGeometry.updateScreenPoints(*m_poly.map(), lineWidth);
@@ -566,8 +614,8 @@ public:
 
         if (m_borderGeometry.isScreenDirty()) {
             /* Do the border update first */
-            m_polylinenode->update(m_poly.m_border.color(),
-                                   float(m_poly.m_border.width()),
+            m_polylinenode->update(isOutlinePlaceholder() ? m_poly.m_color : m_poly.m_border.color(),
+                                   float(outlineWidth()),
                                    &m_borderGeometry,
                                    combinedMatrix,
                                    cameraCenter,
@@ -613,11 +661,26 @@ public:
         return false;
     }
 
+    // While the fill is being triangulated, only the outline is drawn, using the fill color
+    // if the border is not visible.
+    bool isOutlinePlaceholder() const
+    {
+        return m_geometry.isTriangulationPending()
+                && (m_poly.m_border.color().alpha() == 0 || m_poly.m_border.width() <= 0);
+    }
+    qreal outlineWidth() const
+    {
+        return isOutlinePlaceholder() ? 1.0 : m_poly.m_border.width();
+    }
+    void startTriangulation();
+    void onTriangulationFinished(QGeoMapPolygonTriangulator *triangulator);
+
     QGeoMapPolygonGeometryOpenGL m_geometry;
     QGeoMapPolylineGeometryOpenGL m_borderGeometry;
     RootNode *m_rootNode = nullptr;
     MapPolygonNodeGL *m_node = nullptr;
     MapPolylineNodeOpenGLExtruded *m_polylinenode = nullptr;
+    QPointer<QGeoMapPolygonTriangulator> m_triangulator;
 };
 
 QT_END_NAMESPACE
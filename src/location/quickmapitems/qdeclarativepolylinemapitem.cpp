@@ -42,6 +42,7 @@
 #include "qdeclarativerectanglemapitem_p_p.h"
 #include "qdeclarativecirclemapitem_p_p.h"
 #include "qdeclarativegeomapitemutils_p.h"
+#include "qgeomapitemclipper_p.h"
 #include "error_messages_p.h"
 #include "qgeosimplify_p.h"
 
@@ -59,7 +60,6 @@
 #include <QtPositioning/private/qlocationutils_p.h>
 #include <QtPositioning/private/qdoublevector2d_p.h>
 #include <QtPositioning/private/qwebmercator_p.h>
-#include <QtPositioning/private/qclipperutils_p.h>
 #include <QtPositioning/private/qgeopath_p.h>
 #include <QtLocation/private/qgeomapparameter_p.h>
 #include <QtLocation/private/qgeomap_p.h>
@@ -86,164 +86,6 @@ struct ThreadPool // to have a thread pool with max 1 thread for geometry proces
 Q_GLOBAL_STATIC(ThreadPool, threadPool)
 
 
-static bool get_line_intersection(const double p0_x,
-                                 const double p0_y,
-                                 const double p1_x,
-                                 const double p1_y,
-                                 const double p2_x,
-                                 const double p2_y,
-                                 const double p3_x,
-                                 const double p3_y,
-                                 double *i_x,
-                                 double *i_y,
-                                 double *i_t)
-{
-    const double s10_x = p1_x - p0_x;
-    const double s10_y = p1_y - p0_y;
-    const double s32_x = p3_x - p2_x;
-    const double s32_y = p3_y - p2_y;
-
-    const double denom = s10_x * s32_y - s32_x * s10_y;
-    if (denom == 0.0)
-        return false; // Collinear
-    const bool denomPositive = denom > 0;
-
-    const double s02_x = p0_x - p2_x;
-    const double s02_y = p0_y - p2_y;
-    const double s_numer = s10_x * s02_y - s10_y * s02_x;
-    if ((s_numer < 0.0) == denomPositive)
-        return false; // No collision
-
-    const double t_numer = s32_x * s02_y - s32_y * s02_x;
-    if ((t_numer < 0.0) == denomPositive)
-        return false; // No collision
-
-    if (((s_numer > denom) == denomPositive) || ((t_numer > denom) == denomPositive))
-        return false; // No collision
-    // Collision detected
-    *i_t = t_numer / denom;
-    *i_x = p0_x + (*i_t * s10_x);
-    *i_y = p0_y + (*i_t * s10_y);
-
-    return true;
-}
-
-enum SegmentType {
-    NoIntersection,
-    OneIntersection,
-    TwoIntersections
-};
-
-static QList<QList<QDoubleVector2D> > clipLine(
-        const QList<QDoubleVector2D> &l,
-        const QList<QDoubleVector2D> &poly)
-{
-    QList<QList<QDoubleVector2D> > res;
-    if (poly.size() < 2 || l.size() < 2)
-        return res;
-
-    // Step 1: build edges
-    std::vector<std::array<double, 4> > edges;
-    for (qsizetype i = 1; i < poly.size(); i++)
-        edges.push_back({ { poly.at(i-1).x(), poly.at(i-1).y(), poly.at(i).x(), poly.at(i).y() } });
-    edges.push_back({ { poly.at(poly.size()-1).x(), poly.at(poly.size()-1).y(), poly.at(0).x(), poly.at(0).y() } });
-
-    // Step 2: check each segment against each edge
-    QList<QDoubleVector2D> subLine;
-    std::array<double, 4> intersections = { { 0.0, 0.0, 0.0, 0.0 } };
-
-    for (qsizetype i = 0; i < l.size() - 1; ++i) {
-        SegmentType type = NoIntersection;
-        double t = -1; // valid values are in [0, 1]. Only written if intersects
-        double previousT = t;
-        double i_x, i_y;
-
-        const int firstContained = QClipperUtils::pointInPolygon(l.at(i), poly);
-        const int secondContained = QClipperUtils::pointInPolygon(l.at(i+1), poly);
-
-        if (firstContained && secondContained) { // Second most common condition, test early and skip inner loop if possible
-            if (!subLine.size())
-                subLine.push_back(l.at(i)); // the initial element has to be pushed now.
-            subLine.push_back(l.at(i+1));
-            continue;
-        }
-
-        for (unsigned int j = 0; j < edges.size(); ++j) {
-            const bool intersects = get_line_intersection(l.at(i).x(),
-                                                         l.at(i).y(),
-                                                         l.at(i+1).x(),
-                                                         l.at(i+1).y(),
-                                                         edges.at(j).at(0),
-                                                         edges.at(j).at(1),
-                                                         edges.at(j).at(2),
-                                                         edges.at(j).at(3),
-                                                         &i_x,
-                                                         &i_y,
-                                                         &t);
-            if (intersects) {
-                if (previousT >= 0.0) { //One intersection already hit
-                    if (t < previousT) { // Reorder
-                        intersections[2] = intersections[0];
-                        intersections[3] = intersections[1];
-                        intersections[0] = i_x;
-                        intersections[1] = i_y;
-                    } else {
-                        intersections[2] = i_x;
-                        intersections[3] = i_y;
-                    }
-
-                    type = TwoIntersections;
-                    break; // no need to check anything else
-                } else { // First intersection
-                    intersections[0] = i_x;
-                    intersections[1] = i_y;
-                    type = OneIntersection;
-                }
-                previousT = t;
-            }
-        }
-
-        if (type == NoIntersection) {
-            if (!firstContained && !secondContained) { // Both outside
-                subLine.clear();
-            } else if (firstContained && secondContained) {
-                // Handled above already.
-            } else { // Mismatch between PointInPolygon and get_line_intersection. Treat it as no intersection
-                if (subLine.size())
-                    res.push_back(subLine);
-                subLine.clear();
-            }
-        } else if (type == OneIntersection) { // Need to check the following cases to avoid mismatch with PointInPolygon result.
-            if (firstContained <= 0 && secondContained > 0) { // subLine MUST be empty
-                if (!subLine.size())
-                    subLine.push_back(QDoubleVector2D(intersections[0], intersections[1]));
-                subLine.push_back(l.at(i+1));
-            } else if (firstContained > 0 && secondContained <= 0) { // subLine MUST NOT be empty
-                if (!subLine.size())
-                    subLine.push_back(l.at(i));
-                subLine.push_back(QDoubleVector2D(intersections[0], intersections[1]));
-                res.push_back(subLine);
-                subLine.clear();
-            } else {
-                if (subLine.size())
-                    res.push_back(subLine);
-                subLine.clear();
-            }
-        } else { // Two
-            // restart strip
-            subLine.clear();
-            subLine.push_back(QDoubleVector2D(intersections[0], intersections[1]));
-            subLine.push_back(QDoubleVector2D(intersections[2], intersections[3]));
-            res.push_back(subLine);
-            subLine.clear();
-        }
-    }
-
-    if (subLine.size())
-        res.push_back(subLine);
-    return res;
-}
-
 /*!
     \qmltype MapPolyline
     \instantiates QDeclarativePolylineMapItem
@@ -386,6 +228,8 @@ QList<QList<QDoubleVector2D> > QGeoMapPolylineGeometry::clipPath(const QGeoMap &
     QList<QDoubleVector2D> wrappedPath;
     wrappedPath.reserve(path.size());
     QDoubleVector2D wrappedLeftBound(qInf(), qInf());
+    QDoubleVector2D wrappedMinimum(qInf(), qInf());
+    QDoubleVector2D wrappedMaximum(-qInf(), -qInf());
     // 1)
     for (const auto &coord : path) {
         QDoubleVector2D wrappedProjection = p.wrapMapProjection(coord);
@@ -406,6 +250,10 @@ QList<QList<QDoubleVector2D> > QGeoMapPolylineGeometry::clipPath(const QGeoMap &
         if (wrappedProjection.x() < wrappedLeftBound.x() || (wrappedProjection.x() == wrappedLeftBound.x() && wrappedProjection.y() < wrappedLeftBound.y())) {
             wrappedLeftBound = wrappedProjection;
         }
+        wrappedMinimum.setX(qMin(wrappedMinimum.x(), wrappedProjection.x()));
+        wrappedMinimum.setY(qMin(wrappedMinimum.y(), wrappedProjection.y()));
+        wrappedMaximum.setX(qMax(wrappedMaximum.x(), wrappedProjection.x()));
+        wrappedMaximum.setY(qMax(wrappedMaximum.y(), wrappedProjection.y()));
         wrappedPath.append(wrappedProjection);
     }
 
@@ -415,9 +263,11 @@ QList<QList<QDoubleVector2D> > QGeoMapPolylineGeometry::clipPath(const QGeoMap &
 
     // 2)
     QList<QList<QDoubleVector2D> > clippedPaths;
-    const QList<QDoubleVector2D> &visibleRegion = p.projectableGeometry();
-    if (visibleRegion.size()) {
-        clippedPaths = clipLine(wrappedPath, visibleRegion);
+    const QGeoMapItemClipper clipper(p.projectableGeometry());
+    // Nothing to clip if the path lies entirely inside the projectable region,
+    // which is always the case with an untilted camera.
+    if (clipper.contains(wrappedMinimum, wrappedMaximum) != QGeoMapItemClipper::Inside) {
+        clippedPaths = clipper.clipLine(wrappedPath, wrappedMinimum, wrappedMaximum);
 
         // 2.1) update srcOrigin_ and leftBoundWrapped with the point with minimum X
         QDoubleVector2D lb(qInf(), qInf());
@@ -464,9 +314,9 @@ void QGeoMapPolylineGeometry::pathToScreen(const QGeoMap &map,
     QDoubleVector2D origin = p.wrappedMapProjectionToItemPosition(leftBoundWrapped);
     for (const QList<QDoubleVector2D> &path: clippedPaths) {
         QDoubleVector2D lastAddedPoint;
-        for (qsizetype i = 0; i < path.size(); ++i) {
-            QDoubleVector2D point = p.wrappedMapProjectionToItemPosition(path.at(i));
-            point = point - origin; // (0,0) if point == geoLeftBound_
+        const QList<QDoubleVector2D> points = p.wrappedMapProjectionToItemPosition(path);
+        for (qsizetype i = 0; i < points.size(); ++i) {
+            const QDoubleVector2D point = points.at(i) - origin; // (0,0) if point == geoLeftBound_
 
             minX = qMin(point.x(), minX);
             minY = qMin(point.y(), minY);
@@ -479,7 +329,7 @@ void QGeoMapPolylineGeometry::pathToScreen(const QGeoMap &map,
                 lastAddedPoint = point;
             } else {
                 if ((point - lastAddedPoint).manhattanLength() > 3 ||
-                        i == path.size() - 1) {
+                        i == points.size() - 1) {
                     srcPoints_ << point.x() << point.y();
                     srcPointTypes_ << QPainterPath::LineToElement;
                     lastAddedPoint = point;
@@ -1556,18 +1406,34 @@ bool QGeoMapPolylineGeometryOpenGL::allocateAndFillEntries(QSGGeometry *geom,
 
     const QList<QDeclarativeGeoMapItemUtils::vec2> &v = *m_screenVertices;
     if (v.size() < 2) {
-        geom->allocate(0, 0);
+        reserveGeometry(geom, 0);
+        commitGeometry(geom, 0);
         return true;
     }
     const int numSegments = (v.size() - 1);
 
     const int numIndices = numSegments * 6; // six vertices per line segment
-    geom->allocate(numIndices);
-    MapPolylineNodeOpenGLExtruded::MapPolylineEntry *vertices =
-            static_cast<MapPolylineNodeOpenGLExtruded::MapPolylineEntry *>(geom->vertexData());
+    reserveGeometry(geom, numIndices);
+    MapPolylineNodeOpenGLExtruded::fillEntries(
+            static_cast<MapPolylineNodeOpenGLExtruded::MapPolylineEntry *>(geom->vertexData()),
+            v, closed);
+    commitGeometry(geom, numIndices);
+    return true;
+}
 
+/*!
+    \internal
+
+    Writes the six entries of each segment of \a v, that is 6 * (v.size() - 1)
+    entries, to \a vertices. A \a closed path ends with its first point.
+*/
+void MapPolylineNodeOpenGLExtruded::fillEntries(MapPolylineEntry *vertices,
+                                                const QList<QDeclarativeGeoMapItemUtils::vec2> &v,
+                                                bool closed)
+{
+    const int numSegments = (v.size() - 1);
     for (int i = 0; i < numSegments; ++i) {
-        MapPolylineNodeOpenGLExtruded::MapPolylineEntry e;
+        MapPolylineEntry e;
         const QDeclarativeGeoMapItemUtils::vec2 &cur = v[i];
         const QDeclarativeGeoMapItemUtils::vec2 &next = v[i+1];
         e.triangletype = 1.0;
@@ -1612,7 +1478,6 @@ bool QGeoMapPolylineGeometryOpenGL::allocateAndFillEntries(QSGGeometry *geom,
             }
         }
     }
-    return true;
 }
 
 void QGeoMapPolylineGeometryOpenGL::allocateAndFillLineStrip(QSGGeometry *geom,
@@ -1622,11 +1487,10 @@ void QGeoMapPolylineGeometryOpenGL::allocateAndFillLineStrip(QSGGeometry *geom,
     Q_UNUSED(lod);
 
     const QList<QDeclarativeGeoMapItemUtils::vec2> &vx = *m_screenVertices;
-    geom->allocate(vx.size());
-
-    QSGGeometry::Point2D *pts = geom->vertexDataAsPoint2D();
-    for (qsizetype i = 0; i < vx.size(); ++i)
-        pts[i].set(vx[i].x, vx[i].y);
+    static_assert(sizeof(QDeclarativeGeoMapItemUtils::vec2) == sizeof(QSGGeometry::Point2D));
+    reserveGeometry(geom, vx.size());
+    memcpy(geom->vertexData(), vx.constData(), vx.size() * sizeof(QSGGeometry::Point2D));
+    commitGeometry(geom, vx.size());
 }
 
 void MapPolylineNodeOpenGLExtruded::update(const QColor &fillColor,
@@ -474,6 +474,8 @@ public:
                 unsigned int zoom = 30);
 
     static const QSGGeometry::AttributeSet &attributesMapPolylineTriangulated();
+    static void fillEntries(MapPolylineEntry *vertices,
+                            const QList<QDeclarativeGeoMapItemUtils::vec2> &v, bool closed);
 
 protected:
     MapPolylineMaterialExtruded fill_material_;
@@ -531,24 +533,15 @@ public:
     }
     void regenerateCache()
     {
-        if (!m_poly.map() || m_poly.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
-            return;
-        const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_poly.map()->geoProjection());
-        m_geopathProjected.clear();
-        m_geopathProjected.reserve(m_poly.m_geopath.size());
-        for (const QGeoCoordinate &c : m_poly.m_geopath.path())
-            m_geopathProjected << p.geoToMapProjection(c);
+        m_mercatorPath.setPath(m_poly.m_geopath.path(), m_poly.m_geopath.boundingGeoRectangle());
     }
     void updateCache()
     {
-        if (!m_poly.map() || m_poly.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
-            return;
-        const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_poly.map()->geoProjection());
-        m_geopathProjected << p.geoToMapProjection(m_poly.m_geopath.path().last());
+        m_mercatorPath.append(m_poly.m_geopath.path().last(), m_poly.m_geopath.boundingGeoRectangle());
     }
     void preserveGeometry()
     {
-        m_geometry.setPreserveGeometry(true, m_poly.m_geopath.boundingGeoRectangle().topLeft());
+        m_geometry.setPreserveGeometry(true, m_mercatorPath.geoLeftBound());
     }
     void afterViewportChanged() override
     {
@@ -558,7 +551,7 @@ public:
     }
     void onMapSet() override
     {
-        regenerateCache();
+        // The mercator path does not depend on the map
         markSourceDirtyAndUpdate();
     }
     void onGeoGeometryChanged() override
@@ -591,7 +584,7 @@ public:
         const QGeoMap *map = m_poly.map();
         const qreal borderWidth = m_poly.m_line.width();
 
-        m_geometry.updateSourcePoints(*map, m_geopathProjected, m_poly.m_geopath.boundingGeoRectangle().topLeft());
+        m_geometry.updateSourcePoints(*map, m_mercatorPath.path(), m_mercatorPath.geoLeftBound());
         m_geometry.updateScreenPoints(*map, borderWidth);
 
         m_poly.setWidth(m_geometry.sourceBoundingBox().width() + borderWidth);
@@ -626,7 +619,7 @@ public:
         return m_geometry.contains(point);
     }
 
-    QList<QDoubleVector2D> m_geopathProjected;
+    QGeoMapItemMercatorPath m_mercatorPath;
     QGeoMapPolylineGeometry m_geometry;
     MapPolylineNode *m_node = nullptr;
 };
@@ -109,16 +109,22 @@ public:
         m_borderGeometry.markSourceDirty();
         m_rect.polishAndUpdate();
     }
+    void regenerateCache()
+    {
+        m_mercatorPath.setPath(path(m_rect.m_rectangle), m_rect.m_rectangle);
+    }
     void onMapSet() override
     {
         markSourceDirtyAndUpdate();
     }
     void onGeoGeometryChanged() override
     {
+        regenerateCache();
         markSourceDirtyAndUpdate();
     }
     void onItemGeometryChanged() override
     {
+        regenerateCache();
         m_geometry.setPreserveGeometry(true, m_rect.m_rectangle.topLeft());
         m_borderGeometry.setPreserveGeometry(true, m_rect.m_rectangle.topLeft());
         markSourceDirtyAndUpdate();
@@ -144,10 +150,8 @@ public:
         QScopedValueRollback<bool> rollback(m_rect.m_updatingGeometry);
         m_rect.m_updatingGeometry = true;
 
-        const QList<QGeoCoordinate> perimeter = path(m_rect.m_rectangle);
-        const QList<QDoubleVector2D> pathMercator_ = pathMercator(perimeter);
         m_geometry.setPreserveGeometry(true, m_rect.m_rectangle.topLeft());
-        m_geometry.updateSourcePoints(*m_rect.map(), pathMercator_);
+        m_geometry.updateSourcePoints(*m_rect.map(), m_mercatorPath.path());
         m_geometry.updateScreenPoints(*m_rect.map(), m_rect.m_border.width());
 
         QList<QGeoMapItemGeometry *> geoms;
@@ -155,7 +159,7 @@ public:
         m_borderGeometry.clear();
 
         if (m_rect.m_border.color().alpha() != 0 && m_rect.m_border.width() > 0) {
-            QList<QDoubleVector2D> closedPath = pathMercator_;
+            QList<QDoubleVector2D> closedPath = m_mercatorPath.path();
             closedPath << closedPath.first();
 
             m_borderGeometry.setPreserveGeometry(true, m_rect.m_rectangle.topLeft());
@@ -234,14 +238,7 @@ public:
         return res;
     }
 
-    static QList<QDoubleVector2D> pathMercator(const QList<QGeoCoordinate> &p)
-    {
-        QList<QDoubleVector2D> res;
-        for (const auto &c: p)
-            res << QWebMercator::coordToMercator(c);
-        return res;
-    }
-
+    QGeoMapItemMercatorPath m_mercatorPath;
     QGeoMapPolygonGeometry m_geometry;
     QGeoMapPolylineGeometry m_borderGeometry;
     MapPolygonNode *m_node = nullptr;
@@ -0,0 +1,489 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeomapitemclipper_p.h"
+
+#include <QtPositioning/private/qclipperutils_p.h>
+
+#include <array>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+static bool get_line_intersection(const double p0_x,
+                                 const double p0_y,
+                                 const double p1_x,
+                                 const double p1_y,
+                                 const double p2_x,
+                                 const double p2_y,
+                                 const double p3_x,
+                                 const double p3_y,
+                                 double *i_x,
+                                 double *i_y,
+                                 double *i_t)
+{
+    const double s10_x = p1_x - p0_x;
+    const double s10_y = p1_y - p0_y;
+    const double s32_x = p3_x - p2_x;
+    const double s32_y = p3_y - p2_y;
+
+    const double denom = s10_x * s32_y - s32_x * s10_y;
+    if (denom == 0.0)
+        return false; // Collinear
+    const bool denomPositive = denom > 0;
+
+    const double s02_x = p0_x - p2_x;
+    const double s02_y = p0_y - p2_y;
+    const double s_numer = s10_x * s02_y - s10_y * s02_x;
+    if ((s_numer < 0.0) == denomPositive)
+        return false; // No collision
+
+    const double t_numer = s32_x * s02_y - s32_y * s02_x;
+    if ((t_numer < 0.0) == denomPositive)
+        return false; // No collision
+
+    if (((s_numer > denom) == denomPositive) || ((t_numer > denom) == denomPositive))
+        return false; // No collision
+    // Collision detected
+    *i_t = t_numer / denom;
+    *i_x = p0_x + (*i_t * s10_x);
+    *i_y = p0_y + (*i_t * s10_y);
+
+    return true;
+}
+
+enum SegmentType {
+    NoIntersection,
+    OneIntersection,
+    TwoIntersections
+};
+
+static QList<QList<QDoubleVector2D> > clipLineAgainstPolygon(
+        const QList<QDoubleVector2D> &l,
+        const QList<QDoubleVector2D> &poly)
+{
+    QList<QList<QDoubleVector2D> > res;
+    if (poly.size() < 2 || l.size() < 2)
+        return res;
+
+    // Step 1: build edges
+    std::vector<std::array<double, 4> > edges;
+    for (qsizetype i = 1; i < poly.size(); i++)
+        edges.push_back({ { poly.at(i-1).x(), poly.at(i-1).y(), poly.at(i).x(), poly.at(i).y() } });
+    edges.push_back({ { poly.at(poly.size()-1).x(), poly.at(poly.size()-1).y(), poly.at(0).x(), poly.at(0).y() } });
+
+    // Step 2: check each segment against each edge
+    QList<QDoubleVector2D> subLine;
+    std::array<double, 4> intersections = { { 0.0, 0.0, 0.0, 0.0 } };
+
+    for (qsizetype i = 0; i < l.size() - 1; ++i) {
+        SegmentType type = NoIntersection;
+        double t = -1; // valid values are in [0, 1]. Only written if intersects
+        double previousT = t;
+        double i_x, i_y;
+
+        const int firstContained = QClipperUtils::pointInPolygon(l.at(i), poly);
+        const int secondContained = QClipperUtils::pointInPolygon(l.at(i+1), poly);
+
+        if (firstContained && secondContained) { // Second most common condition, test early and skip inner loop if possible
+            if (!subLine.size())
+                subLine.push_back(l.at(i)); // the initial element has to be pushed now.
+            subLine.push_back(l.at(i+1));
+            continue;
+        }
+
+        for (unsigned int j = 0; j < edges.size(); ++j) {
+            const bool intersects = get_line_intersection(l.at(i).x(),
+                                                         l.at(i).y(),
+                                                         l.at(i+1).x(),
+                                                         l.at(i+1).y(),
+                                                         edges.at(j).at(0),
+                                                         edges.at(j).at(1),
+                                                         edges.at(j).at(2),
+                                                         edges.at(j).at(3),
+                                                         &i_x,
+                                                         &i_y,
+                                                         &t);
+            if (intersects) {
+                if (previousT >= 0.0) { //One intersection already hit
+                    if (t < previousT) { // Reorder
+                        intersections[2] = intersections[0];
+                        intersections[3] = intersections[1];
+                        intersections[0] = i_x;
+                        intersections[1] = i_y;
+                    } else {
+                        intersections[2] = i_x;
+                        intersections[3] = i_y;
+                    }
+
+                    type = TwoIntersections;
+                    break; // no need to check anything else
+                } else { // First intersection
+                    intersections[0] = i_x;
+                    intersections[1] = i_y;
+                    type = OneIntersection;
+                }
+                previousT = t;
+            }
+        }
+
+        if (type == NoIntersection) {
+            if (!firstContained && !secondContained) { // Both outside
+                subLine.clear();
+            } else if (firstContained && secondContained) {
+                // Handled above already.
+            } else { // Mismatch between PointInPolygon and get_line_intersection. Treat it as no intersection
+                if (subLine.size())
+                    res.push_back(subLine);
+                subLine.clear();
+            }
+        } else if (type == OneIntersection) { // Need to check the following cases to avoid mismatch with PointInPolygon result.
+            if (firstContained <= 0 && secondContained > 0) { // subLine MUST be empty
+                if (!subLine.size())
+                    subLine.push_back(QDoubleVector2D(intersections[0], intersections[1]));
+                subLine.push_back(l.at(i+1));
+            } else if (firstContained > 0 && secondContained <= 0) { // subLine MUST NOT be empty
+                if (!subLine.size())
+                    subLine.push_back(l.at(i));
+                subLine.push_back(QDoubleVector2D(intersections[0], intersections[1]));
+                res.push_back(subLine);
+                subLine.clear();
+            } else {
+                if (subLine.size())
+                    res.push_back(subLine);
+                subLine.clear();
+            }
+        } else { // Two
+            // restart strip
+            subLine.clear();
+            subLine.push_back(QDoubleVector2D(intersections[0], intersections[1]));
+            subLine.push_back(QDoubleVector2D(intersections[2], intersections[3]));
+            res.push_back(subLine);
+            subLine.clear();
+        }
+    }
+
+    if (subLine.size())
+        res.push_back(subLine);
+    return res;
+}
+
+QGeoMapItemClipper::QGeoMapItemClipper(const QList<QDoubleVector2D> &region)
+    : m_region(region)
+{
+    // Regions from QClipperUtils may repeat their first point
+    while (m_region.size() > 1 && m_region.first() == m_region.last())
+        m_region.removeLast();
+    if (m_region.size() < 3)
+        return;
+
+    bounds(m_region.constData(), m_region.size(), m_minimum, m_maximum);
+
+    // Convex if all turns have the same direction, ignoring collinear points
+    double area = 0.0;
+    bool positive = false;
+    bool negative = false;
+    for (qsizetype i = 0; i < m_region.size(); ++i) {
+        const QDoubleVector2D &a = m_region.at(i);
+        const QDoubleVector2D &b = m_region.at((i + 1) % m_region.size());
+        const QDoubleVector2D &c = m_region.at((i + 2) % m_region.size());
+        const double turn = (b.x() - a.x()) * (c.y() - b.y()) - (b.y() - a.y()) * (c.x() - b.x());
+        positive |= turn > 0.0;
+        negative |= turn < 0.0;
+        area += a.x() * b.y() - b.x() * a.y();
+    }
+    m_convex = !(positive && negative) && area != 0.0;
+    if (!m_convex)
+        return;
+
+    // Orient the edge equations so that the interior is on the positive side,
+    // whichever way the region is wound.
+    const double orientation = (area < 0.0) ? -1.0 : 1.0;
+    m_edges.reserve(m_region.size());
+    for (qsizetype i = 0; i < m_region.size(); ++i) {
+        const QDoubleVector2D &a = m_region.at(i);
+        const QDoubleVector2D &b = m_region.at((i + 1) % m_region.size());
+        if (a == b)
+            continue;
+        const double ea = -orientation * (b.y() - a.y());
+        const double eb = orientation * (b.x() - a.x());
+        m_edges.append({ ea, eb, -(ea * a.x() + eb * a.y()) });
+    }
+}
+
+QGeoMapItemClipper::Containment QGeoMapItemClipper::contains(const QDoubleVector2D &minimum,
+                                                             const QDoubleVector2D &maximum) const
+{
+    if (m_region.isEmpty())
+        return Inside;
+    if (!minimum.isFinite() || !maximum.isFinite() || m_region.size() < 3)
+        return Outside;
+    if (maximum.x() < m_minimum.x() || minimum.x() > m_maximum.x()
+            || maximum.y() < m_minimum.y() || minimum.y() > m_maximum.y()) {
+        return Outside;
+    }
+    if (!m_convex)
+        return Intersecting;
+
+    const QDoubleVector2D corners[] = { minimum,
+                                        QDoubleVector2D(maximum.x(), minimum.y()),
+                                        maximum,
+                                        QDoubleVector2D(minimum.x(), maximum.y()) };
+    bool inside = true;
+    for (const Edge &edge : m_edges) {
+        int cornersInside = 0;
+        for (const QDoubleVector2D &corner : corners) {
+            if (edge.distance(corner) >= 0.0)
+                ++cornersInside;
+        }
+        if (cornersInside == 0)
+            return Outside;
+        inside &= (cornersInside == 4);
+    }
+    return inside ? Inside : Intersecting;
+}
+
+QList<QList<QDoubleVector2D>> QGeoMapItemClipper::clipLine(const QList<QDoubleVector2D> &path) const
+{
+    QDoubleVector2D minimum;
+    QDoubleVector2D maximum;
+    bounds(path.constData(), path.size(), minimum, maximum);
+    return clipLine(path, minimum, maximum);
+}
+
+QList<QList<QDoubleVector2D>> QGeoMapItemClipper::clipLine(const QList<QDoubleVector2D> &path,
+                                                           const QDoubleVector2D &minimum,
+                                                           const QDoubleVector2D &maximum) const
+{
+    QList<QList<QDoubleVector2D>> result;
+    if (path.size() < 2)
+        return result;
+
+    switch (contains(minimum, maximum)) {
+    case Outside:
+        return result;
+    case Inside:
+        result.append(path);
+        return result;
+    case Intersecting:
+        break;
+    }
+
+    if (m_convex)
+        clipConvexLine(path.constData(), path.size(), result);
+    else
+        result = clipLineAgainstPolygon(path, m_region);
+    return result;
+}
+
+QList<QList<QDoubleVector2D>> QGeoMapItemClipper::clipPolygon(const QList<QDoubleVector2D> &path) const
+{
+    QDoubleVector2D minimum;
+    QDoubleVector2D maximum;
+    bounds(path.constData(), path.size(), minimum, maximum);
+    return clipPolygon(path, minimum, maximum);
+}
+
+QList<QList<QDoubleVector2D>> QGeoMapItemClipper::clipPolygon(const QList<QDoubleVector2D> &path,
+                                                              const QDoubleVector2D &minimum,
+                                                              const QDoubleVector2D &maximum) const
+{
+    QList<QList<QDoubleVector2D>> result;
+    if (path.size() < 3)
+        return result;
+
+    switch (contains(minimum, maximum)) {
+    case Outside:
+        return result;
+    case Inside:
+        result.append(path);
+        return result;
+    case Intersecting:
+        break;
+    }
+
+    if (m_convex) {
+        clipConvexPolygon(path.constData(), path.size(), result);
+    } else {
+        QClipperUtils clipper;
+        clipper.addSubjectPath(path, true);
+        clipper.addClipPolygon(m_region);
+        result = clipper.execute(QClipperUtils::Intersection, QClipperUtils::pftEvenOdd,
+                                 QClipperUtils::pftEvenOdd);
+    }
+    return result;
+}
+
+QList<QList<QDoubleVector2D>> QGeoMapItemClipper::clipPolygons(const QList<QList<QDoubleVector2D>> &paths) const
+{
+    QList<QList<QDoubleVector2D>> result;
+    if (m_convex || m_region.isEmpty()) {
+        // With a convex region, clipping each path on its own preserves the
+        // parity of every point inside the region, hence the even-odd fill.
+        for (const QList<QDoubleVector2D> &path : paths)
+            result.append(clipPolygon(path));
+    } else {
+        QClipperUtils clipper;
+        for (const QList<QDoubleVector2D> &path : paths)
+            clipper.addSubjectPath(path, true);
+        clipper.addClipPolygon(m_region);
+        result = clipper.execute(QClipperUtils::Intersection, QClipperUtils::pftEvenOdd,
+                                 QClipperUtils::pftEvenOdd);
+    }
+    return result;
+}
+
+void QGeoMapItemClipper::bounds(const QDoubleVector2D *points, qsizetype count,
+                                QDoubleVector2D &minimum, QDoubleVector2D &maximum)
+{
+    double minX = qInf();
+    double minY = qInf();
+    double maxX = -qInf();
+    double maxY = -qInf();
+    for (qsizetype i = 0; i < count; ++i) {
+        minX = qMin(minX, points[i].x());
+        minY = qMin(minY, points[i].y());
+        maxX = qMax(maxX, points[i].x());
+        maxY = qMax(maxY, points[i].y());
+    }
+    minimum = QDoubleVector2D(minX, minY);
+    maximum = QDoubleVector2D(maxX, maxY);
+}
+
+/*
+    Cyrus-Beck: each segment is parametrized as from + t * (to - from), and
+    every edge of the region narrows the range of t inside it. Consecutive
+    segments that are kept whole are joined into the same sub line.
+*/
+void QGeoMapItemClipper::clipConvexLine(const QDoubleVector2D *points, qsizetype count,
+                                        QList<QList<QDoubleVector2D>> &result) const
+{
+    QList<QDoubleVector2D> subLine;
+    const auto flush = [&result, &subLine]() {
+        if (subLine.size() > 1)
+            result.append(subLine);
+        subLine.clear();
+    };
+
+    for (qsizetype i = 0; i + 1 < count; ++i) {
+        const QDoubleVector2D &from = points[i];
+        const QDoubleVector2D &to = points[i + 1];
+        double tEnter = 0.0;
+        double tExit = 1.0;
+        bool visible = true;
+        for (const Edge &edge : m_edges) {
+            const double dFrom = edge.distance(from);
+            const double dTo = edge.distance(to);
+            if (dFrom < 0.0 && dTo < 0.0) {
+                visible = false;
+                break;
+            }
+            if (dFrom >= 0.0 && dTo >= 0.0)
+                continue;
+            const double t = dFrom / (dFrom - dTo);
+            if (dFrom < 0.0)
+                tEnter = qMax(tEnter, t);
+            else
+                tExit = qMin(tExit, t);
+            if (tEnter > tExit) {
+                visible = false;
+                break;
+            }
+        }
+
+        if (!visible) {
+            flush();
+            continue;
+        }
+        if (tEnter > 0.0 || subLine.isEmpty()) {
+            flush();
+            subLine.append(tEnter > 0.0 ? from + (to - from) * tEnter : from);
+        }
+        subLine.append(tExit < 1.0 ? from + (to - from) * tExit : to);
+        if (tExit < 1.0)
+            flush();
+    }
+    flush();
+}
+
+/*
+    Sutherland-Hodgman: the polygon is clipped by each edge of the region in
+    turn. Where the polygon leaves and re-enters the region, the result runs
+    along the region boundary, which adds no area to an even-odd fill.
+*/
+void QGeoMapItemClipper::clipConvexPolygon(const QDoubleVector2D *points, qsizetype count,
+                                           QList<QList<QDoubleVector2D>> &result) const
+{
+    std::vector<QDoubleVector2D> input(points, points + count);
+    std::vector<QDoubleVector2D> output;
+    output.reserve(count + m_edges.size());
+
+    for (const Edge &edge : m_edges) {
+        output.clear();
+        const size_t size = input.size();
+        for (size_t i = 0; i < size; ++i) {
+            const QDoubleVector2D &previous = input[(i + size - 1) % size];
+            const QDoubleVector2D &current = input[i];
+            const double dPrevious = edge.distance(previous);
+            const double dCurrent = edge.distance(current);
+            if ((dPrevious < 0.0) != (dCurrent < 0.0)) {
+                const double t = dPrevious / (dPrevious - dCurrent);
+                output.push_back(previous + (current - previous) * t);
+            }
+            if (dCurrent >= 0.0)
+                output.push_back(current);
+        }
+        input.swap(output);
+        if (input.size() < 3)
+            return;
+    }
+
+    QList<QDoubleVector2D> polygon;
+    polygon.reserve(qsizetype(input.size()));
+    for (const QDoubleVector2D &point : input) {
+        if (polygon.isEmpty() || polygon.last() != point)
+            polygon.append(point);
+    }
+    while (polygon.size() > 1 && polygon.first() == polygon.last())
+        polygon.removeLast();
+    if (polygon.size() >= 3)
+        result.append(polygon);
+}
+
+QT_END_NAMESPACE
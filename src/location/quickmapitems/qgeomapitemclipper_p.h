@@ -0,0 +1,130 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOMAPITEMCLIPPER_P_H
+#define QGEOMAPITEMCLIPPER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtPositioning/private/qdoublevector2d_p.h>
+
+#include <QtCore/QList>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Clips the wrapped mercator geometry of map items against a region of the
+    projection, such as its projectable or visible geometry.
+
+    These regions are convex quads or polygons, so lines and polygons are
+    clipped one edge of the region at a time, in a single pass over their
+    points. Only a region that is not convex goes through QClipperUtils.
+    An empty region does not clip anything.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoMapItemClipper
+{
+public:
+    enum Containment {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
+    explicit QGeoMapItemClipper(const QList<QDoubleVector2D> &region);
+
+    inline bool isConvex() const { return m_convex; }
+
+    // Where the box spanned by minimum and maximum is relative to the region.
+    // This is conservative: Intersecting may be returned for a box that is
+    // entirely inside or outside.
+    Containment contains(const QDoubleVector2D &minimum, const QDoubleVector2D &maximum) const;
+
+    // The parts of an open path inside the region
+    QList<QList<QDoubleVector2D>> clipLine(const QList<QDoubleVector2D> &path) const;
+    QList<QList<QDoubleVector2D>> clipLine(const QList<QDoubleVector2D> &path,
+                                           const QDoubleVector2D &minimum,
+                                           const QDoubleVector2D &maximum) const;
+
+    // The intersection of a closed path with the region
+    QList<QList<QDoubleVector2D>> clipPolygon(const QList<QDoubleVector2D> &path) const;
+    QList<QList<QDoubleVector2D>> clipPolygon(const QList<QDoubleVector2D> &path,
+                                              const QDoubleVector2D &minimum,
+                                              const QDoubleVector2D &maximum) const;
+
+    // The intersection of the even-odd fill of closed paths with the region
+    QList<QList<QDoubleVector2D>> clipPolygons(const QList<QList<QDoubleVector2D>> &paths) const;
+
+    static void bounds(const QDoubleVector2D *points, qsizetype count,
+                       QDoubleVector2D &minimum, QDoubleVector2D &maximum);
+
+private:
+    // a * x + b * y + c >= 0 inside the edge
+    struct Edge {
+        double a;
+        double b;
+        double c;
+
+        inline double distance(const QDoubleVector2D &p) const { return a * p.x() + b * p.y() + c; }
+    };
+
+    void clipConvexLine(const QDoubleVector2D *points, qsizetype count,
+                        QList<QList<QDoubleVector2D>> &result) const;
+    void clipConvexPolygon(const QDoubleVector2D *points, qsizetype count,
+                           QList<QList<QDoubleVector2D>> &result) const;
+
+    QList<QDoubleVector2D> m_region;
+    QList<Edge> m_edges;
+    QDoubleVector2D m_minimum;
+    QDoubleVector2D m_maximum;
+    bool m_convex = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOMAPITEMCLIPPER_P_H
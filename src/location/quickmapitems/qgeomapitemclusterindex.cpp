@@ -0,0 +1,284 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeomapitemclusterindex_p.h"
+
+#include <QtCore/QThreadPool>
+
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+// Size in pixels of the whole world at zoom level 0, see QGeoProjectionWebMercator
+static const double kWorldSizeAtZoomLevel0 = 256.0;
+// Above this number of cells, cells() scans the whole level instead of the grid range
+static const qint64 kMaxCellLookups = 4096;
+
+QGeoMapItemClusterIndex::QGeoMapItemClusterIndex(qreal radius, int minimumZoomLevel, int maximumZoomLevel)
+    : m_radius(qMax<qreal>(1.0, radius)),
+      m_minimumZoomLevel(qMax(0, minimumZoomLevel)),
+      m_maximumZoomLevel(qMax(m_minimumZoomLevel, maximumZoomLevel))
+{
+    const int levels = m_maximumZoomLevel - m_minimumZoomLevel + 1;
+    m_levels.resize(levels);
+    m_cellSizes.resize(levels);
+    m_cellsPerRow.resize(levels);
+    for (int i = 0; i < levels; ++i) {
+        const double worldSize = kWorldSizeAtZoomLevel0 * std::pow(2.0, m_minimumZoomLevel + i);
+        m_cellSizes[i] = qMin(1.0, m_radius / worldSize);
+        m_cellsPerRow[i] = qint64(std::ceil(1.0 / m_cellSizes[i]));
+    }
+}
+
+qreal QGeoMapItemClusterIndex::radius() const
+{
+    return m_radius;
+}
+
+int QGeoMapItemClusterIndex::minimumZoomLevel() const
+{
+    return m_minimumZoomLevel;
+}
+
+int QGeoMapItemClusterIndex::maximumZoomLevel() const
+{
+    return m_maximumZoomLevel;
+}
+
+qsizetype QGeoMapItemClusterIndex::size() const
+{
+    return m_points.size();
+}
+
+bool QGeoMapItemClusterIndex::contains(quint32 id) const
+{
+    return m_points.contains(id);
+}
+
+qint64 QGeoMapItemClusterIndex::cellKey(int level, const QDoubleVector2D &mercator) const
+{
+    const qint64 cellsPerRow = m_cellsPerRow.at(level);
+    const double cellSize = m_cellSizes.at(level);
+    const qint64 x = qBound<qint64>(0, qint64(mercator.x() / cellSize), cellsPerRow - 1);
+    const qint64 y = qBound<qint64>(0, qint64(mercator.y() / cellSize), cellsPerRow - 1);
+    return y * cellsPerRow + x;
+}
+
+void QGeoMapItemClusterIndex::insert(quint32 id, const QDoubleVector2D &mercator)
+{
+    if (m_points.contains(id))
+        remove(id);
+    Point &point = m_points[id];
+    point.mercator = mercator;
+    point.slots.resize(m_levels.size());
+
+    for (qsizetype level = 0; level < m_levels.size(); ++level) {
+        Cell &cell = m_levels[level][cellKey(level, mercator)];
+        if (cell.count == 0) {
+            cell.topLeft = mercator;
+            cell.bottomRight = mercator;
+        } else if (!cell.boundsOutdated) {
+            cell.topLeft = QDoubleVector2D(qMin(cell.topLeft.x(), mercator.x()),
+                                           qMin(cell.topLeft.y(), mercator.y()));
+            cell.bottomRight = QDoubleVector2D(qMax(cell.bottomRight.x(), mercator.x()),
+                                               qMax(cell.bottomRight.y(), mercator.y()));
+        }
+        ++cell.count;
+        cell.sumX += mercator.x();
+        cell.sumY += mercator.y();
+        point.slots[level] = cell.ids.size();
+        cell.ids.append(id);
+    }
+}
+
+/*
+    The id is swapped with the last one of its cell at every level, and the
+    bounds of a cell are only recomputed, lazily, if the point was on them.
+*/
+void QGeoMapItemClusterIndex::remove(quint32 id)
+{
+    const auto it = m_points.constFind(id);
+    if (it == m_points.constEnd())
+        return;
+    const Point point = it.value();
+    m_points.erase(it);
+    const QDoubleVector2D &mercator = point.mercator;
+
+    for (qsizetype level = 0; level < m_levels.size(); ++level) {
+        QHash<qint64, Cell> &cells = m_levels[level];
+        const auto cellIt = cells.find(cellKey(level, mercator));
+        if (cellIt == cells.end())
+            continue;
+        Cell &cell = cellIt.value();
+        if (--cell.count == 0) {
+            cells.erase(cellIt);
+            continue;
+        }
+        cell.sumX -= mercator.x();
+        cell.sumY -= mercator.y();
+
+        const qsizetype slot = point.slots.at(level);
+        const quint32 last = cell.ids.takeLast();
+        if (last != id) {
+            cell.ids[slot] = last;
+            m_points[last].slots[level] = slot;
+        }
+
+        if (mercator.x() == cell.topLeft.x() || mercator.y() == cell.topLeft.y()
+                || mercator.x() == cell.bottomRight.x() || mercator.y() == cell.bottomRight.y()) {
+            cell.boundsOutdated = true;
+        }
+    }
+}
+
+void QGeoMapItemClusterIndex::updateBounds(const Cell &cell) const
+{
+    bool first = true;
+    for (quint32 id : qAsConst(cell.ids)) {
+        const QDoubleVector2D p = m_points.constFind(id)->mercator;
+        if (first) {
+            cell.topLeft = p;
+            cell.bottomRight = p;
+            first = false;
+            continue;
+        }
+        cell.topLeft = QDoubleVector2D(qMin(cell.topLeft.x(), p.x()), qMin(cell.topLeft.y(), p.y()));
+        cell.bottomRight = QDoubleVector2D(qMax(cell.bottomRight.x(), p.x()), qMax(cell.bottomRight.y(), p.y()));
+    }
+    cell.boundsOutdated = false;
+}
+
+/*
+    Returns the cells of \a zoomLevel (clamped to the indexed range) intersecting the
+    mercator rectangle from \a topLeft to \a bottomRight. If topLeft.x() > bottomRight.x(),
+    the rectangle crosses the dateline.
+*/
+QList<const QGeoMapItemClusterIndex::Cell *> QGeoMapItemClusterIndex::cells(int zoomLevel,
+                                                                            const QDoubleVector2D &topLeft,
+                                                                            const QDoubleVector2D &bottomRight) const
+{
+    QList<const Cell *> res;
+    const int level = qBound(m_minimumZoomLevel, zoomLevel, m_maximumZoomLevel) - m_minimumZoomLevel;
+    const QHash<qint64, Cell> &cells = m_levels.at(level);
+    if (cells.isEmpty())
+        return res;
+
+    const double cellSize = m_cellSizes.at(level);
+    const qint64 cellsPerRow = m_cellsPerRow.at(level);
+    const auto cellIndex = [&](double v) { return qBound<qint64>(0, qint64(v / cellSize), cellsPerRow - 1); };
+
+    const qint64 y0 = cellIndex(topLeft.y());
+    const qint64 y1 = cellIndex(bottomRight.y());
+    QList<std::pair<qint64, qint64>> xRanges;
+    if (topLeft.x() <= bottomRight.x()) {
+        xRanges.append({cellIndex(topLeft.x()), cellIndex(bottomRight.x())});
+    } else {
+        xRanges.append({cellIndex(topLeft.x()), cellsPerRow - 1});
+        xRanges.append({0, cellIndex(bottomRight.x())});
+    }
+
+    qint64 lookups = 0;
+    for (const auto &range : qAsConst(xRanges))
+        lookups += (range.second - range.first + 1) * (y1 - y0 + 1);
+
+    if (lookups > kMaxCellLookups || lookups > cells.size()) {
+        for (auto it = cells.cbegin(); it != cells.cend(); ++it) {
+            const qint64 x = it.key() % cellsPerRow;
+            const qint64 y = it.key() / cellsPerRow;
+            if (y < y0 || y > y1)
+                continue;
+            for (const auto &range : qAsConst(xRanges)) {
+                if (x >= range.first && x <= range.second) {
+                    res.append(&it.value());
+                    break;
+                }
+            }
+        }
+        updateOutdatedBounds(res);
+        return res;
+    }
+
+    for (qint64 y = y0; y <= y1; ++y) {
+        for (const auto &range : qAsConst(xRanges)) {
+            for (qint64 x = range.first; x <= range.second; ++x) {
+                const auto it = cells.constFind(y * cellsPerRow + x);
+                if (it != cells.cend())
+                    res.append(&it.value());
+            }
+        }
+    }
+    updateOutdatedBounds(res);
+    return res;
+}
+
+void QGeoMapItemClusterIndex::updateOutdatedBounds(const QList<const Cell *> &cells) const
+{
+    for (const Cell *cell : cells) {
+        if (cell->boundsOutdated)
+            updateBounds(*cell);
+    }
+}
+
+QGeoMapItemClusterIndexBuilder::QGeoMapItemClusterIndexBuilder(const QList<std::pair<quint32, QDoubleVector2D>> &points,
+                                                               qreal radius, int minimumZoomLevel, int maximumZoomLevel)
+    : m_points(points),
+      m_index(new QGeoMapItemClusterIndex(radius, minimumZoomLevel, maximumZoomLevel))
+{
+    setAutoDelete(false);
+}
+
+void QGeoMapItemClusterIndexBuilder::start()
+{
+    QThreadPool::globalInstance()->start(this);
+}
+
+void QGeoMapItemClusterIndexBuilder::run()
+{
+    for (const auto &point : qAsConst(m_points))
+        m_index->insert(point.first, point.second);
+    m_points.clear();
+    emit finished();
+}
+
+QGeoMapItemClusterIndex *QGeoMapItemClusterIndexBuilder::takeIndex()
+{
+    return m_index.release();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOMAPITEMCLUSTERINDEX_P_H
+#define QGEOMAPITEMCLUSTERINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtPositioning/private/qdoublevector2d_p.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Hierarchical grid of points in normalized web mercator space ([0, 1] on both axes).
+    Level z holds cells whose size corresponds to radius pixels at zoom level z,
+    for every z in [minimumZoomLevel, maximumZoomLevel]. Every level is kept up to date
+    on insertion and removal, so that changing zoom level only selects another level.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoMapItemClusterIndex
+{
+public:
+    struct Cell {
+        int count = 0;
+        double sumX = 0.0;
+        double sumY = 0.0;
+        // Recomputed by cells() when a point on the bounds was removed
+        mutable QDoubleVector2D topLeft;
+        mutable QDoubleVector2D bottomRight;
+        mutable bool boundsOutdated = false;
+        QList<quint32> ids; // in no particular order
+
+        QDoubleVector2D center() const { return QDoubleVector2D(sumX / count, sumY / count); }
+    };
+
+    QGeoMapItemClusterIndex(qreal radius, int minimumZoomLevel, int maximumZoomLevel);
+
+    qreal radius() const;
+    int minimumZoomLevel() const;
+    int maximumZoomLevel() const;
+    qsizetype size() const;
+
+    bool contains(quint32 id) const;
+    void insert(quint32 id, const QDoubleVector2D &mercator);
+    void remove(quint32 id);
+
+    // The returned pointers are valid until the index is modified.
+    QList<const Cell *> cells(int zoomLevel, const QDoubleVector2D &topLeft,
+                              const QDoubleVector2D &bottomRight) const;
+
+private:
+    struct Point {
+        QDoubleVector2D mercator;
+        QList<qsizetype> slots; // index in the ids of its cell, for every level
+    };
+
+    qint64 cellKey(int level, const QDoubleVector2D &mercator) const;
+    void updateBounds(const Cell &cell) const;
+    void updateOutdatedBounds(const QList<const Cell *> &cells) const;
+
+    qreal m_radius;
+    int m_minimumZoomLevel;
+    int m_maximumZoomLevel;
+    QList<double> m_cellSizes;
+    QList<qint64> m_cellsPerRow;
+    QList<QHash<qint64, Cell>> m_levels;
+    QHash<quint32, Point> m_points;
+};
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoMapItemClusterIndexBuilder : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    QGeoMapItemClusterIndexBuilder(const QList<std::pair<quint32, QDoubleVector2D>> &points,
+                                   qreal radius, int minimumZoomLevel, int maximumZoomLevel);
+
+    void start();
+    void run() override;
+
+    QGeoMapItemClusterIndex *takeIndex();
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    QList<std::pair<quint32, QDoubleVector2D>> m_points;
+    std::unique_ptr<QGeoMapItemClusterIndex> m_index;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOMAPITEMCLUSTERINDEX_P_H
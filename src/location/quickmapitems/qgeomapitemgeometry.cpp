@@ -43,9 +43,12 @@
 
 #include <QtPositioning/private/qlocationutils_p.h>
 #include <QtPositioning/private/qdoublevector2d_p.h>
+#include <QtPositioning/private/qwebmercator_p.h>
 #include <QtLocation/private/qgeomap_p.h>
 #include <QtLocation/private/qgeoprojection_p.h>
 
+#include <cstring>
+
 QT_BEGIN_NAMESPACE
 
 QGeoMapItemGeometry::QGeoMapItemGeometry()
@@ -77,25 +80,57 @@ void QGeoMapItemGeometry::allocateAndFill(QSGGeometry *geom) const
 {
     const QList<QPointF> &vx = screenVertices_;
     const QList<quint32> &ix = screenIndices_;
+    const int indexCount = isIndexed() ? ix.size() : 0;
 
-    if (isIndexed()) {
-        geom->allocate(vx.size(), ix.size());
+    reserveGeometry(geom, vx.size(), indexCount);
+    if (indexCount) {
         if (geom->indexType() == QSGGeometry::UnsignedShortType) {
             quint16 *its = geom->indexDataAsUShort();
             for (qsizetype i = 0; i < ix.size(); ++i)
                 its[i] = ix[i];
         } else if (geom->indexType() == QSGGeometry::UnsignedIntType) {
-            quint32 *its = geom->indexDataAsUInt();
-            for (qsizetype i = 0; i < ix.size(); ++i)
-                its[i] = ix[i];
+            memcpy(geom->indexDataAsUInt(), ix.constData(), ix.size() * sizeof(quint32));
         }
-    } else {
-        geom->allocate(vx.size());
     }
 
     QSGGeometry::Point2D *pts = geom->vertexDataAsPoint2D();
     for (qsizetype i = 0; i < vx.size(); ++i)
         pts[i].set(vx[i].x(), vx[i].y());
+    commitGeometry(geom, vx.size(), indexCount);
+}
+
+/*!
+    \internal
+
+    Makes \a geom hold \a vertexCount vertices and \a indexCount indices. The
+    storage is kept when the counts did not change, which is the case for most
+    updates of an item that is only moved by the camera.
+    Returns true if the storage was reallocated.
+*/
+bool QGeoMapItemGeometry::reserveGeometry(QSGGeometry *geom, int vertexCount, int indexCount)
+{
+    if (geom->vertexCount() == vertexCount && geom->indexCount() == indexCount)
+        return false;
+
+    geom->allocate(vertexCount, indexCount);
+    // Only upload when marked dirty by commitGeometry()
+    geom->setVertexDataPattern(QSGGeometry::StaticPattern);
+    geom->setIndexDataPattern(QSGGeometry::StaticPattern);
+    return true;
+}
+
+/*!
+    \internal
+
+    Marks the vertices and indices written to \a geom since reserveGeometry() as dirty.
+    QSGGeometry has no dirty ranges, so the whole buffers are uploaded again.
+*/
+void QGeoMapItemGeometry::commitGeometry(QSGGeometry *geom, int vertexCount, int indexCount)
+{
+    Q_ASSERT(geom->vertexCount() == vertexCount && geom->indexCount() == indexCount);
+    geom->markVertexDataDirty();
+    if (indexCount > 0)
+        geom->markIndexDataDirty();
 }
 
 /*!
@@ -146,4 +181,24 @@ double QGeoMapItemGeometry::geoDistanceToScreenWidth(const QGeoMap &map,
     return halfScreenDist.x() * 2.0;
 }
 
+void QGeoMapItemMercatorPath::setPath(const QList<QGeoCoordinate> &path, const QGeoRectangle &geoBounds)
+{
+    m_path.resize(path.size());
+    for (qsizetype i = 0; i < path.size(); ++i)
+        m_path[i] = QWebMercator::coordToMercator(path.at(i));
+    m_geoBounds = geoBounds;
+}
+
+void QGeoMapItemMercatorPath::append(const QGeoCoordinate &coordinate, const QGeoRectangle &geoBounds)
+{
+    m_path.append(QWebMercator::coordToMercator(coordinate));
+    m_geoBounds = geoBounds;
+}
+
+void QGeoMapItemMercatorPath::clear()
+{
+    m_path.clear();
+    m_geoBounds = QGeoRectangle();
+}
+
 QT_END_NAMESPACE
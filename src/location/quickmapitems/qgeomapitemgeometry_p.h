@@ -58,9 +58,12 @@
 #include <QRectF>
 #include <QList>
 #include <QGeoCoordinate>
+#include <QGeoRectangle>
 #include <QVector2D>
 #include <QList>
 
+#include <QtPositioning/private/qdoublevector2d_p.h>
+
 QT_BEGIN_NAMESPACE
 
 class QSGGeometry;
@@ -128,6 +131,12 @@ public:
 
     void allocateAndFill(QSGGeometry *geom) const;
 
+    // Geometry storage reuse. reserveGeometry() keeps the allocation of geom if the
+    // counts did not change. The caller writes the vertices and indices, then calls
+    // commitGeometry() to flag the changed data.
+    static bool reserveGeometry(QSGGeometry *geom, int vertexCount, int indexCount = 0);
+    static void commitGeometry(QSGGeometry *geom, int vertexCount, int indexCount = 0);
+
     double geoDistanceToScreenWidth(const QGeoMap &map,
                                            const QGeoCoordinate &fromCoord,
                                            const QGeoCoordinate &toCoord);
@@ -159,6 +168,30 @@ protected:
     QList<quint32> screenIndices_;
 };
 
+/*
+    The source path of a map item, projected to web mercator. The projection
+    only depends on the geographic data, so it is computed once when the path
+    changes, together with the geographic bounds, and reused for every camera
+    change and map reset. Only wrapping, clipping and the transformation to
+    item coordinates remain to be done per frame.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoMapItemMercatorPath
+{
+public:
+    void setPath(const QList<QGeoCoordinate> &path, const QGeoRectangle &geoBounds);
+    void append(const QGeoCoordinate &coordinate, const QGeoRectangle &geoBounds);
+    void clear();
+
+    inline bool isEmpty() const { return m_path.isEmpty(); }
+    inline const QList<QDoubleVector2D> &path() const { return m_path; }
+    inline const QGeoRectangle &geoBounds() const { return m_geoBounds; }
+    inline QGeoCoordinate geoLeftBound() const { return m_geoBounds.topLeft(); }
+
+private:
+    QList<QDoubleVector2D> m_path;
+    QGeoRectangle m_geoBounds;
+};
+
 QT_END_NAMESPACE
 
 #endif // QGEOMAPITEMGEOMETRY_H
@@ -997,24 +997,24 @@ void QQuickGeoMapGestureArea::handleWheelEvent(QWheelEvent *event)
         emit rotationStarted(&m_pinch.m_event);
         // First set bearing
         const double bearingDelta = event->angleDelta().y() * qreal(0.05);
-        m_declarativeMap->setBearing(m_declarativeMap->bearing() + bearingDelta,  wheelGeoPos);
+        setCameraBearing(cameraBearing() + bearingDelta, wheelGeoPos);
+        // Signal handlers expect to see the rotated map
+        flushCameraUpdate();
         emit rotationUpdated(&m_pinch.m_event);
         emit rotationFinished(&m_pinch.m_event);
     } else if (event->modifiers() & Qt::ControlModifier && tiltEnabled()) {
         emit tiltStarted(&m_pinch.m_event);
         const double tiltDelta = event->angleDelta().y() * qreal(0.05);
-        m_declarativeMap->setTilt(m_declarativeMap->tilt() + tiltDelta);
+        setCameraTilt(cameraTilt() + tiltDelta);
+        flushCameraUpdate();
         emit tiltUpdated(&m_pinch.m_event);
         emit tiltFinished(&m_pinch.m_event);
     } else if (pinchEnabled()) {
         const double zoomLevelDelta = event->angleDelta().y() * qreal(0.001);
         // Gesture area should always honor maxZL, but Map might not.
-        m_declarativeMap->setZoomLevel(qMin<qreal>(m_declarativeMap->zoomLevel() + zoomLevelDelta, maximumZoomLevel()),
-                                       false);
-        const QPointF &postZoomPoint = m_declarativeMap->fromCoordinate(wheelGeoPos, false);
-
-        if (preZoomPoint != postZoomPoint) // need to re-anchor the wheel geoPos to the event position
-            m_declarativeMap->alignCoordinateToPoint(wheelGeoPos, preZoomPoint);
+        setCameraZoomLevel(qMin<qreal>(cameraZoomLevel() + zoomLevelDelta, maximumZoomLevel()));
+        // need to re-anchor the wheel geoPos to the event position once zoomed
+        alignCameraCoordinateToPoint(wheelGeoPos, preZoomPoint);
     }
     // event->accept();
 }
@@ -1055,6 +1055,125 @@ void QQuickGeoMapGestureArea::updateFlickParameters(const QPointF &pos)
     }
 }
 
+/*!
+    \internal
+    The camera values the gestures build upon: the pending ones if the
+    gestures already changed them during this frame, the map's otherwise.
+*/
+qreal QQuickGeoMapGestureArea::cameraZoomLevel() const
+{
+    return m_cameraUpdate.m_hasZoomLevel ? m_cameraUpdate.m_zoomLevel : m_declarativeMap->zoomLevel();
+}
+
+qreal QQuickGeoMapGestureArea::cameraBearing() const
+{
+    return m_cameraUpdate.m_hasBearing ? m_cameraUpdate.m_bearing : m_declarativeMap->bearing();
+}
+
+qreal QQuickGeoMapGestureArea::cameraTilt() const
+{
+    return m_cameraUpdate.m_hasTilt ? m_cameraUpdate.m_tilt : m_declarativeMap->tilt();
+}
+
+void QQuickGeoMapGestureArea::setCameraZoomLevel(qreal zoomLevel)
+{
+    m_cameraUpdate.m_hasZoomLevel = true;
+    m_cameraUpdate.m_zoomLevel = zoomLevel;
+    scheduleCameraUpdate();
+}
+
+void QQuickGeoMapGestureArea::setCameraBearing(qreal bearing, const QGeoCoordinate &coordinate)
+{
+    m_cameraUpdate.m_hasBearing = true;
+    m_cameraUpdate.m_bearing = bearing;
+    m_cameraUpdate.m_bearingCoordinate = coordinate;
+    scheduleCameraUpdate();
+}
+
+void QQuickGeoMapGestureArea::setCameraTilt(qreal tilt)
+{
+    m_cameraUpdate.m_hasTilt = true;
+    m_cameraUpdate.m_tilt = tilt;
+    scheduleCameraUpdate();
+}
+
+void QQuickGeoMapGestureArea::alignCameraCoordinateToPoint(const QGeoCoordinate &coordinate,
+                                                           const QPointF &point)
+{
+    m_cameraUpdate.m_hasAlignment = true;
+    m_cameraUpdate.m_alignCoordinate = coordinate;
+    m_cameraUpdate.m_alignPoint = point;
+    scheduleCameraUpdate();
+}
+
+/*!
+    \internal
+    Input events can arrive several times per frame. Rather than updating the
+    camera (and with it the tiles and every map item) for each of them, the
+    changes are accumulated and applied once, from the polish pass of the next
+    frame. Map items polished as a consequence are still handled in that pass.
+*/
+void QQuickGeoMapGestureArea::scheduleCameraUpdate()
+{
+    if (!window()) {
+        m_cameraUpdate.m_pending = true;
+        flushCameraUpdate();
+        return;
+    }
+    if (!m_cameraUpdate.m_pending) {
+        m_cameraUpdate.m_pending = true;
+        polish();
+    }
+}
+
+/*!
+    \internal
+    Applies the pending camera changes, in the order the gesture state
+    machines run: tilt, zoom, bearing, then the pan or zoom anchor alignment.
+    The updated signals of the gestures are emitted here too, once per frame,
+    so that they keep their position relative to the camera change.
+*/
+void QQuickGeoMapGestureArea::flushCameraUpdate()
+{
+    if (!m_cameraUpdate.m_pending)
+        return;
+
+    const CameraUpdate cameraUpdate = m_cameraUpdate;
+    m_cameraUpdate = CameraUpdate();
+
+    if (cameraUpdate.m_pinchUpdated)
+        emit pinchUpdated(&m_pinch.m_event);
+
+    if (cameraUpdate.m_hasTilt)
+        m_declarativeMap->setTilt(cameraUpdate.m_tilt);
+    if (cameraUpdate.m_hasZoomLevel)
+        m_declarativeMap->setZoomLevel(cameraUpdate.m_zoomLevel, false);
+    if (cameraUpdate.m_hasBearing) {
+        if (cameraUpdate.m_bearingCoordinate.isValid())
+            m_declarativeMap->setBearing(cameraUpdate.m_bearing, cameraUpdate.m_bearingCoordinate);
+        else
+            m_declarativeMap->setBearing(cameraUpdate.m_bearing);
+    }
+    if (cameraUpdate.m_hasAlignment) {
+        const QPointF point = m_declarativeMap->fromCoordinate(cameraUpdate.m_alignCoordinate, false);
+        if (point != cameraUpdate.m_alignPoint)
+            m_declarativeMap->alignCoordinateToPoint(cameraUpdate.m_alignCoordinate, cameraUpdate.m_alignPoint);
+    }
+
+    if (cameraUpdate.m_tiltUpdated)
+        emit tiltUpdated(&m_pinch.m_event);
+    if (cameraUpdate.m_rotationUpdated)
+        emit rotationUpdated(&m_pinch.m_event);
+}
+
+/*!
+    \internal
+*/
+void QQuickGeoMapGestureArea::updatePolish()
+{
+    flushCameraUpdate();
+}
+
 void QQuickGeoMapGestureArea::setTouchPointState(const QQuickGeoMapGestureArea::TouchPointState state)
 {
     m_touchPointState = state;
@@ -1338,7 +1457,7 @@ void QQuickGeoMapGestureArea::startTilt()
     }
 
     m_pinch.m_tilt.m_startTouchCentroid = m_touchPointsCentroid;
-    m_pinch.m_tilt.m_startTilt = m_declarativeMap->tilt();
+    m_pinch.m_tilt.m_startTilt = cameraTilt();
 }
 
 /*!
@@ -1352,7 +1471,7 @@ void QQuickGeoMapGestureArea::updateTilt()
     // Approach: 10pixel = 1 degree.
     qreal tilt =  verticalDisplacement / 10.0;
     qreal newTilt = m_pinch.m_tilt.m_startTilt - tilt;
-    m_declarativeMap->setTilt(newTilt);
+    setCameraTilt(newTilt);
 
     m_pinch.m_event.setCenter(mapFromScene(m_touchPointsCentroid));
     m_pinch.m_event.setAngle(m_twoTouchAngle);
@@ -1363,7 +1482,9 @@ void QQuickGeoMapGestureArea::updateTilt()
     m_pinch.m_event.setPointCount(m_allPoints.count());
     m_pinch.m_event.setAccepted(true);
 
-    emit tiltUpdated(&m_pinch.m_event);
+    // Emitted once the new tilt is applied, see flushCameraUpdate()
+    m_cameraUpdate.m_tiltUpdated = true;
+    scheduleCameraUpdate();
 }
 
 /*!
@@ -1371,6 +1492,8 @@ void QQuickGeoMapGestureArea::updateTilt()
 */
 void QQuickGeoMapGestureArea::endTilt()
 {
+    // Pending updates are delivered before the gesture ends
+    flushCameraUpdate();
     QPointF p1 = mapFromScene(m_pinch.m_lastPoint1);
     QPointF p2 = mapFromScene(m_pinch.m_lastPoint2);
     m_pinch.m_event.setCenter((p1 + p2) / 2);
@@ -1469,7 +1592,7 @@ bool QQuickGeoMapGestureArea::canStartRotation()
 */
 void QQuickGeoMapGestureArea::startRotation()
 {
-    m_pinch.m_rotation.m_startBearing = m_declarativeMap->bearing();
+    m_pinch.m_rotation.m_startBearing = cameraBearing();
     m_pinch.m_rotation.m_previousTouchAngle = m_twoTouchAngle;
     m_pinch.m_rotation.m_totalAngle = 0.0;
 }
@@ -1487,7 +1610,7 @@ void QQuickGeoMapGestureArea::updateRotation()
     m_pinch.m_rotation.m_previousTouchAngle = m_twoTouchAngle;
     m_pinch.m_rotation.m_totalAngle += angle;
     qreal newBearing = m_pinch.m_rotation.m_startBearing - m_pinch.m_rotation.m_totalAngle;
-    m_declarativeMap->setBearing(newBearing);
+    setCameraBearing(newBearing);
 
     m_pinch.m_event.setCenter(mapFromScene(m_touchPointsCentroid));
     m_pinch.m_event.setAngle(m_twoTouchAngle);
@@ -1498,7 +1621,9 @@ void QQuickGeoMapGestureArea::updateRotation()
     m_pinch.m_event.setPointCount(m_allPoints.count());
     m_pinch.m_event.setAccepted(true);
 
-    emit rotationUpdated(&m_pinch.m_event);
+    // Emitted once the new bearing is applied, see flushCameraUpdate()
+    m_cameraUpdate.m_rotationUpdated = true;
+    scheduleCameraUpdate();
 }
 
 /*!
@@ -1506,6 +1631,8 @@ void QQuickGeoMapGestureArea::updateRotation()
 */
 void QQuickGeoMapGestureArea::endRotation()
 {
+    // Pending updates are delivered before the gesture ends
+    flushCameraUpdate();
     QPointF p1 = mapFromScene(m_pinch.m_lastPoint1);
     QPointF p2 = mapFromScene(m_pinch.m_lastPoint2);
     m_pinch.m_event.setCenter((p1 + p2) / 2);
@@ -1601,13 +1728,13 @@ bool QQuickGeoMapGestureArea::canStartPinch()
 void QQuickGeoMapGestureArea::startPinch()
 {
     m_pinch.m_startDist = m_distanceBetweenTouchPoints;
-    m_pinch.m_zoom.m_previous = m_declarativeMap->zoomLevel();
+    m_pinch.m_zoom.m_previous = cameraZoomLevel();
     m_pinch.m_lastAngle = m_twoTouchAngle;
 
     m_pinch.m_lastPoint1 = mapFromScene(m_allPoints.at(0).scenePosition());
     m_pinch.m_lastPoint2 = mapFromScene(m_allPoints.at(1).scenePosition());
 
-    m_pinch.m_zoom.m_start = m_declarativeMap->zoomLevel();
+    m_pinch.m_zoom.m_start = cameraZoomLevel();
 }
 
 /*!
@@ -1638,14 +1765,16 @@ void QQuickGeoMapGestureArea::updatePinch()
     m_pinch.m_event.setAccepted(true);
 
     m_pinch.m_lastAngle = m_twoTouchAngle;
-    emit pinchUpdated(&m_pinch.m_event);
+    // Emitted ahead of the new zoom level, as it always was, see flushCameraUpdate()
+    m_cameraUpdate.m_pinchUpdated = true;
+    scheduleCameraUpdate();
 
     if (m_acceptedGestures & PinchGesture) {
         // Take maximum and minimumzoomlevel into account
         qreal perPinchMinimumZoomLevel = qMax(m_pinch.m_zoom.m_start - m_pinch.m_zoom.maximumChange, m_pinch.m_zoom.m_minimum);
         qreal perPinchMaximumZoomLevel = qMin(m_pinch.m_zoom.m_start + m_pinch.m_zoom.maximumChange, m_pinch.m_zoom.m_maximum);
         newZoomLevel = qMin(qMax(perPinchMinimumZoomLevel, newZoomLevel), perPinchMaximumZoomLevel);
-        m_declarativeMap->setZoomLevel(qMin<qreal>(newZoomLevel, maximumZoomLevel()), false);
+        setCameraZoomLevel(qMin<qreal>(newZoomLevel, maximumZoomLevel()));
         m_pinch.m_zoom.m_previous = newZoomLevel;
     }
 }
@@ -1655,6 +1784,8 @@ void QQuickGeoMapGestureArea::updatePinch()
 */
 void QQuickGeoMapGestureArea::endPinch()
 {
+    // Pending updates are delivered before the gesture ends
+    flushCameraUpdate();
     QPointF p1 = mapFromScene(m_pinch.m_lastPoint1);
     QPointF p2 = mapFromScene(m_pinch.m_lastPoint2);
     m_pinch.m_event.setCenter((p1 + p2) / 2);
@@ -1679,6 +1810,7 @@ void QQuickGeoMapGestureArea::panStateMachine()
     case flickInactive:
         if (!isTiltActive() && canStartPan()) {
             // Update startCoord_ to ensure smooth start for panning when going over startDragDistance
+            flushCameraUpdate();
             QGeoCoordinate newStartCoord = m_declarativeMap->toCoordinate(m_touchPointsCentroid, false);
             m_startCoord.setLongitude(newStartCoord.longitude());
             m_startCoord.setLatitude(newStartCoord.latitude());
@@ -1689,6 +1821,7 @@ void QQuickGeoMapGestureArea::panStateMachine()
         break;
     case panActive:
         if (m_allPoints.count() == 0) {
+            flushCameraUpdate();
             if (!tryStartFlick())
             {
                 setFlickState(flickInactive);
@@ -1726,8 +1859,10 @@ void QQuickGeoMapGestureArea::panStateMachine()
     case panActive:
         updatePan();
         // this ensures 'panStarted' occurs after the pan has actually started
-        if (lastState != panActive)
+        if (lastState != panActive) {
+            flushCameraUpdate();
             emit panStarted();
+        }
         break;
     case flickActive:
         break;
@@ -1758,7 +1893,7 @@ bool QQuickGeoMapGestureArea::canStartPan()
 */
 void QQuickGeoMapGestureArea::updatePan()
 {
-    m_declarativeMap->alignCoordinateToPoint(m_startCoord, m_touchPointsCentroid);
+    alignCameraCoordinateToPoint(m_startCoord, m_touchPointsCentroid);
 }
 
 /*!
@@ -1839,6 +1974,7 @@ void QQuickGeoMapGestureArea::stopPan()
     if (m_flickState == flickActive) {
         stopFlick();
     } else if (m_flickState == panActive) {
+        flushCameraUpdate();
         m_flickVector = QVector2D();
         setFlickState(flickInactive);
         m_declarativeMap->setKeepMouseGrab(m_preventStealing);
@@ -212,6 +212,9 @@ Q_SIGNALS:
     void tiltUpdated(QGeoMapPinchEvent *pinch);
     void tiltFinished(QGeoMapPinchEvent *pinch);
     void preventStealingChanged();
+protected:
+    void updatePolish() override;
+
 private:
     void update();
 
@@ -272,6 +275,16 @@ private:
     void clearTouchData();
     void updateFlickParameters(const QPointF &pos);
 
+    qreal cameraZoomLevel() const;
+    qreal cameraBearing() const;
+    qreal cameraTilt() const;
+    void setCameraZoomLevel(qreal zoomLevel);
+    void setCameraBearing(qreal bearing, const QGeoCoordinate &coordinate = QGeoCoordinate());
+    void setCameraTilt(qreal tilt);
+    void alignCameraCoordinateToPoint(const QGeoCoordinate &coordinate, const QPointF &point);
+    void scheduleCameraUpdate();
+    void flushCameraUpdate();
+
 private:
     QGeoMap* m_map = nullptr;
     QDeclarativeGeoMap *m_declarativeMap = nullptr;
@@ -323,6 +336,26 @@ private:
         bool m_panEnabled = true;
     } m_flick;
 
+    // Camera changes requested by the gestures since the last frame, and the
+    // updated signals to emit with them. Applied all at once by flushCameraUpdate().
+    struct CameraUpdate
+    {
+        bool m_pending = false;
+        bool m_hasZoomLevel = false;
+        bool m_hasBearing = false;
+        bool m_hasTilt = false;
+        bool m_hasAlignment = false;
+        bool m_pinchUpdated = false;
+        bool m_rotationUpdated = false;
+        bool m_tiltUpdated = false;
+        qreal m_zoomLevel = 0.0;
+        qreal m_bearing = 0.0;
+        qreal m_tilt = 0.0;
+        QGeoCoordinate m_bearingCoordinate;
+        QGeoCoordinate m_alignCoordinate;
+        QPointF m_alignPoint;
+    } m_cameraUpdate;
+
 
     // these are calculated regardless of gesture or number of touch points
     QVector2D m_flickVector;
@@ -0,0 +1,49 @@
+#version 440
+
+layout(location = 0) in highp vec2 offset;
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    mat4 mapProjection;
+    vec4 center;
+    vec4 center_lowpart;
+    vec4 circleCenter; // xy: high part, zw: low part
+    vec4 color;
+    vec4 borderColor;
+    float wrapOffset;
+    float radius;
+    float borderWidth;
+};
+
+const float PI = 3.14159265358979;
+
+void main() {
+    // Latitude of the circle center, and latitude difference to the fragment.
+    // gd(a) - gd(b) = 2 atan(sinh((a - b) / 2) / cosh((a + b) / 2)) avoids
+    // subtracting two nearly equal latitudes for small circles.
+    float mc = PI * (1.0 - 2.0 * (circleCenter.y + circleCenter.w));
+    float latCenter = atan(sinh(mc));
+    float dLat = 2.0 * atan(sinh(-PI * offset.y) / cosh(mc - PI * offset.y));
+    float dLon = 2.0 * PI * offset.x;
+
+    // Great circle distance from the center, as an angle
+    float sinHalfLat = sin(0.5 * dLat);
+    float sinHalfLon = sin(0.5 * dLon);
+    float h = sinHalfLat * sinHalfLat
+            + cos(latCenter) * cos(latCenter + dLat) * sinHalfLon * sinHalfLon;
+    float dist = 2.0 * asin(sqrt(clamp(h, 0.0, 1.0)));
+
+    // Signed distance to the circle, in pixels
+    float pixelSize = max(fwidth(dist), 1e-12);
+    float d = (dist - radius) / pixelSize;
+
+    float fillAlpha = clamp(0.5 - d, 0.0, 1.0);
+    float borderAlpha = borderWidth > 0.0
+            ? clamp(0.5 * borderWidth + 0.5 - abs(d), 0.0, 1.0)
+            : 0.0;
+
+    // colors are premultiplied
+    vec4 border = borderColor * borderAlpha;
+    fragColor = border + color * fillAlpha * (1.0 - border.a);
+}
@@ -0,0 +1,26 @@
+#version 440
+
+layout(location = 0) in highp vec2 vertex;
+layout(location = 0) out highp vec2 offset;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    mat4 mapProjection;
+    vec4 center;
+    vec4 center_lowpart;
+    vec4 circleCenter; // xy: high part, zw: low part
+    vec4 color;
+    vec4 borderColor;
+    float wrapOffset;
+    float radius;
+    float borderWidth;
+};
+
+void main() {
+    // vertex is relative to the circle center, so subtracting the camera center
+    // split in high and low part keeps full precision at high zoom levels.
+    vec2 circleToCamera = (circleCenter.xy - center.xy) + (circleCenter.zw - center_lowpart.xy);
+    vec4 vtx = vec4(vertex + circleToCamera + vec2(wrapOffset, 0.0), -center.z - center_lowpart.z, 1.0);
+    offset = vertex;
+    gl_Position = qt_Matrix * mapProjection * vtx;
+}
@@ -43,6 +43,7 @@
 #include <QGeoRectangle>
 #include <QGeoManeuver>
 #include <QGeoRouteSegment>
+#include <QtLocation/private/qgeoroute_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -230,17 +231,19 @@ void GeoRouteJsonParserEsri::parseRoute(const QJsonObject &route)
 
     if (!paths.isEmpty())
     {
-        QList<QGeoCoordinate> geoCoordinates;
-        for (const QJsonValueRef value : paths.first().toArray()) // only first polyline?
+        QJsonArray path = paths.first().toArray(); // only first polyline?
+        QList<double> geoCoordinates; // packed latitude, longitude
+        geoCoordinates.reserve(2 * path.size());
+        for (const QJsonValueRef value : path)
         {
             QJsonArray geoCoordinate = value.toArray();
             if (geoCoordinate.size() == 2)  // ignore 3rd coordinate
             {
-                geoCoordinates.append(QGeoCoordinate(geoCoordinate[1].toDouble(),
-                                      geoCoordinate[0].toDouble()));
+                geoCoordinates << geoCoordinate[1].toDouble()
+                               << geoCoordinate[0].toDouble();
             }
         }
-        geoRoute.setPath(geoCoordinates);
+        QGeoRoutePrivate::get(geoRoute)->setPackedPath(QGeoPackedPath(geoCoordinates));
     }
 }
 
@@ -38,9 +38,9 @@
 ****************************************************************************/
 
 #include "georoutereply_esri.h"
-#include "georoutejsonparser_esri.h"
+#include "georoutingmanagerengine_esri.h"
 
-#include <QJsonDocument>
+#include <QtLocation/private/qgeorouteparser_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -75,15 +75,20 @@ void GeoRouteReplyEsri::networkReplyFinished()
     if (reply->error() != QNetworkReply::NoError)
         return;
 
-    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
-    GeoRouteJsonParserEsri parser(document);
+    GeoRoutingManagerEngineEsri *engine = qobject_cast<GeoRoutingManagerEngineEsri *>(parent());
+    QGeoRouteParseTask *task = engine->parseReplyAsync(reply->readAll(), request());
+    connect(task, &QGeoRouteParseTask::finished, this, &GeoRouteReplyEsri::routesParsed);
+    connect(this, &QGeoRouteReply::aborted, task, &QGeoRouteParseTask::abort);
+}
 
-    if (parser.isValid())
-    {
-        setRoutes(parser.routes());
+void GeoRouteReplyEsri::routesParsed()
+{
+    QGeoRouteParseTask *task = static_cast<QGeoRouteParseTask *>(sender());
+    if (task->error() == QGeoRouteReply::NoError) {
+        setRoutes(task->routes());
         setFinished(true);
     } else {
-        setError(QGeoRouteReply::ParseError, parser.errorString());
+        setError(task->error(), task->errorString());
     }
 }
 
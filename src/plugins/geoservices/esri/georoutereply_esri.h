@@ -56,6 +56,7 @@ public:
 private Q_SLOTS:
     void networkReplyFinished();
     void networkReplyError(QNetworkReply::NetworkError error);
+    void routesParsed();
 };
 
 QT_END_NAMESPACE
@@ -39,8 +39,11 @@
 
 #include "georoutingmanagerengine_esri.h"
 #include "georoutereply_esri.h"
+#include "georoutejsonparser_esri.h"
 
+#include <QJsonDocument>
 #include <QUrlQuery>
+#include <QtLocation/private/qgeorouteparser_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -69,6 +72,10 @@ GeoRoutingManagerEngineEsri::GeoRoutingManagerEngineEsri(const QVariantMap &para
 
 GeoRoutingManagerEngineEsri::~GeoRoutingManagerEngineEsri()
 {
+    const QList<QGeoRouteParseTask *> tasks = findChildren<QGeoRouteParseTask *>(Qt::FindDirectChildrenOnly);
+    for (QGeoRouteParseTask *task : tasks)
+        task->abort();
+    m_parsePool.waitForDone();
 }
 
 // REST reference:
@@ -111,6 +118,24 @@ QGeoRouteReply *GeoRoutingManagerEngineEsri::calculateRoute(const QGeoRouteReque
     return routeReply;
 }
 
+QGeoRouteParseTask *GeoRoutingManagerEngineEsri::parseReplyAsync(const QByteArray &reply,
+                                                                 const QGeoRouteRequest &request)
+{
+    // The parser only depends on the reply, nothing of the engine is shared with the task
+    QGeoRouteParseTask *task = new QGeoRouteParseTask(reply, request,
+            [](QList<QGeoRoute> &routes, QString &errorString, const QByteArray &data) {
+                GeoRouteJsonParserEsri parser(QJsonDocument::fromJson(data));
+                if (!parser.isValid()) {
+                    errorString = parser.errorString();
+                    return QGeoRouteReply::ParseError;
+                }
+                routes = parser.routes();
+                return QGeoRouteReply::NoError;
+            }, this);
+    task->start(&m_parsePool);
+    return task;
+}
+
 void GeoRoutingManagerEngineEsri::replyFinished()
 {
     QGeoRouteReply *reply = qobject_cast<QGeoRouteReply *>(sender());
@@ -42,10 +42,12 @@
 
 #include <QGeoServiceProvider>
 #include <QGeoRoutingManagerEngine>
+#include <QThreadPool>
 
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
+class QGeoRouteParseTask;
 
 class GeoRoutingManagerEngineEsri : public QGeoRoutingManagerEngine
 {
@@ -57,6 +59,7 @@ public:
     virtual ~GeoRoutingManagerEngineEsri();
 
     QGeoRouteReply *calculateRoute(const QGeoRouteRequest &request) override;
+    QGeoRouteParseTask *parseReplyAsync(const QByteArray &reply, const QGeoRouteRequest &request);
 
 private Q_SLOTS:
     void replyFinished();
@@ -69,6 +72,7 @@ private:
     QNetworkAccessManager *m_networkManager;
     QByteArray m_userAgent;
     QString m_token;
+    QThreadPool m_parsePool; // runs the QGeoRouteParseTasks of this engine
 };
 
 QT_END_NAMESPACE
@@ -76,7 +76,8 @@ static const QUrl kUrlFindAddressCandidates("https://geocode.arcgis.com/arcgis/r
 PlaceManagerEngineEsri::PlaceManagerEngineEsri(const QVariantMap &parameters, QGeoServiceProvider::Error *error,
                                                QString *errorString) :
     QPlaceManagerEngine(parameters),
-    m_networkManager(new QNetworkAccessManager(this))
+    m_networkManager(new QNetworkAccessManager(this)),
+    m_categoryCache(parameters)
 {
     *error = QGeoServiceProvider::NoError;
     errorString->clear();
@@ -181,6 +182,10 @@ void PlaceManagerEngineEsri::replyError(QPlaceReply::Error errorCode, const QStr
 
 QPlaceReply *PlaceManagerEngineEsri::initializeCategories()
 {
+    // Stored categories are used until the geocode server answers, in the background
+    if (m_categories.isEmpty())
+        m_categoryCache.load(this, &m_categories);
+
     initializeGeocodeServer();
 
     PlaceCategoriesReplyEsri *reply = new PlaceCategoriesReplyEsri(this);
@@ -189,15 +194,15 @@ QPlaceReply *PlaceManagerEngineEsri::initializeCategories()
     connect(reply, &PlaceCategoriesReplyEsri::errorOccurred,
             this, &PlaceManagerEngineEsri::replyError);
 
-    // TODO delayed finished() emission
     if (!m_categories.isEmpty())
-        reply->emitFinished();
-
-    m_pendingCategoriesReply.append(reply);
+        QMetaObject::invokeMethod(reply, &PlaceCategoriesReplyEsri::emitFinished, Qt::QueuedConnection);
+    else
+        m_pendingCategoriesReply.append(reply);
     return reply;
 }
 
-void PlaceManagerEngineEsri::parseCategories(const QJsonArray &jsonArray, const QString &parentCategoryId)
+void PlaceManagerEngineEsri::parseCategories(QPlaceCategoryTree *tree, const QJsonArray &jsonArray,
+                                             const QString &parentCategoryId)
 {
     for (const QJsonValueConstRef jsonValue : jsonArray)
     {
@@ -214,40 +219,34 @@ void PlaceManagerEngineEsri::parseCategories(const QJsonArray &jsonArray, const
         QPlaceCategory category;
         category.setCategoryId(key);
         category.setName(localeName.isEmpty() ? key : localeName); // localizedNames
-        m_categories.insert(key, category);
-        m_subcategories[parentCategoryId].append(key);
-        m_parentCategory.insert(key, parentCategoryId);
-        emit categoryAdded(category, parentCategoryId);
+        tree->insert(category, parentCategoryId);
 
         if (jsonCategory.contains(kCategoriesKey))
         {
             const QJsonArray jsonArray = jsonCategory.value(kCategoriesKey).toArray();
-            parseCategories(jsonArray, key);
+            parseCategories(tree, jsonArray, key);
         }
     }
 }
 
 QString PlaceManagerEngineEsri::parentCategoryId(const QString &categoryId) const
 {
-    return m_parentCategory.value(categoryId);
+    return m_categories.parentId(categoryId);
 }
 
 QStringList PlaceManagerEngineEsri::childCategoryIds(const QString &categoryId) const
 {
-    return m_subcategories.value(categoryId);
+    return m_categories.childIds(categoryId);
 }
 
 QPlaceCategory PlaceManagerEngineEsri::category(const QString &categoryId) const
 {
-    return m_categories.value(categoryId);
+    return m_categories.category(categoryId);
 }
 
 QList<QPlaceCategory> PlaceManagerEngineEsri::childCategories(const QString &parentId) const
 {
-    QList<QPlaceCategory> categories;
-    for (const QString &id : m_subcategories.value(parentId))
-        categories.append(m_categories.value(id));
-    return categories;
+    return m_categories.childCategories(parentId);
 }
 
 void PlaceManagerEngineEsri::finishCategories()
@@ -268,7 +267,7 @@ void PlaceManagerEngineEsri::errorCaterogies(const QString &error)
 void PlaceManagerEngineEsri::initializeGeocodeServer()
 {
     // Only fetch categories once
-    if (m_categories.isEmpty() && !m_geocodeServerReply)
+    if (!m_geocodeServerReply)
     {
         m_geocodeServerReply = m_networkManager->get(QNetworkRequest(kUrlGeocodeServer));
         connect(m_geocodeServerReply, &QNetworkReply::finished,
@@ -348,7 +347,10 @@ void PlaceManagerEngineEsri::geocodeServerReplyFinished()
     if (jsonObject.contains(kCategoriesKey))
     {
         const QJsonArray jsonArray = jsonObject.value(kCategoriesKey).toArray();
-        parseCategories(jsonArray, QString());
+        QPlaceCategoryTree categories;
+        parseCategories(&categories, jsonArray, QString());
+        m_categories.update(categories, this);
+        m_categoryCache.save(this, m_categories);
     }
 
     // parse candidateFields
@@ -42,6 +42,7 @@
 
 #include <QtLocation/QPlaceManagerEngine>
 #include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/private/qplacecategorycache_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -86,12 +87,12 @@ private:
     // categories
     void finishCategories();
     void errorCaterogies(const QString &error);
-    void parseCategories(const QJsonArray &jsonArray, const QString &parentCategoryId);
+    void parseCategories(QPlaceCategoryTree *tree, const QJsonArray &jsonArray,
+                         const QString &parentCategoryId);
 
     QList<PlaceCategoriesReplyEsri *> m_pendingCategoriesReply;
-    QHash<QString, QPlaceCategory> m_categories;
-    QHash<QString, QStringList> m_subcategories;
-    QHash<QString, QString> m_parentCategory;
+    QPlaceCategoryTree m_categories;
+    QPlaceCategoryCache m_categoryCache;
 
     // localized names
     QString localizedName(const QJsonObject &jsonObject);
@@ -79,23 +79,19 @@ void QGeoRouteReplyMapbox::networkReplyFinished()
         return;
 
     QGeoRoutingManagerEngineMapbox *engine = qobject_cast<QGeoRoutingManagerEngineMapbox *>(parent());
-    const QGeoRouteParser *parser = engine->routeParser();
-
-    QList<QGeoRoute> routes;
-    QString errorString;
+    QGeoRouteParseTask *task = engine->routeParser()->parseReplyAsync(reply->readAll(), request());
+    connect(task, &QGeoRouteParseTask::finished, this, &QGeoRouteReplyMapbox::routesParsed);
+    connect(this, &QGeoRouteReply::aborted, task, &QGeoRouteParseTask::abort);
+}
 
-    QByteArray routeReply = reply->readAll();
-    QGeoRouteReply::Error error = parser->parseReply(routes, errorString, routeReply);
-    // Setting the request into the result
-    for (QGeoRoute &route : routes) {
-        route.setRequest(request());
-        for (QGeoRoute &leg: route.routeLegs()) {
-            leg.setRequest(request());
-        }
-    }
+void QGeoRouteReplyMapbox::routesParsed()
+{
+    QGeoRouteParseTask *task = static_cast<QGeoRouteParseTask *>(sender());
+    const QList<QGeoRoute> routes = task->routes();
+    const QGeoRouteReply::Error error = task->error();
 
     QVariantMap metadata;
-    metadata["osrm.reply-json"] = routeReply;
+    metadata["osrm.reply-json"] = task->reply();
 
     QVariantMap extAttr;
     extAttr["engine"] = "mapbox";
@@ -113,7 +109,7 @@ void QGeoRouteReplyMapbox::networkReplyFinished()
         // setError(QGeoRouteReply::NoError, status);  // can't do this, or NoError is emitted and does damages
         setFinished(true);
     } else {
-        setError(error, errorString);
+        setError(error, task->errorString());
     }
 }
 
@@ -293,7 +293,7 @@ QGeoRouteReply* QGeoRoutingManagerEngineMapbox::calculateRoute(const QGeoRouteRe
     return routeReply;
 }
 
-const QGeoRouteParser *QGeoRoutingManagerEngineMapbox::routeParser() const
+QGeoRouteParser *QGeoRoutingManagerEngineMapbox::routeParser() const
 {
     return m_routeParser;
 }
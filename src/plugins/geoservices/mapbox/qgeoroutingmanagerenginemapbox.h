@@ -60,7 +60,7 @@ public:
     ~QGeoRoutingManagerEngineMapbox();
 
     QGeoRouteReply *calculateRoute(const QGeoRouteRequest &request) override;
-    const QGeoRouteParser *routeParser() const;
+    QGeoRouteParser *routeParser() const;
 
 private Q_SLOTS:
     void replyFinished();
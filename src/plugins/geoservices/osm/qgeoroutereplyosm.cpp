@@ -71,25 +71,20 @@ void QGeoRouteReplyOsm::networkReplyFinished()
         return;
 
     QGeoRoutingManagerEngineOsm *engine = qobject_cast<QGeoRoutingManagerEngineOsm *>(parent());
-    const QGeoRouteParser *parser = engine->routeParser();
-
-    QList<QGeoRoute> routes;
-    QString errorString;
-    QGeoRouteReply::Error error = parser->parseReply(routes, errorString, reply->readAll());
-    // Setting the request into the result
-    for (QGeoRoute &route : routes) {
-        route.setRequest(request());
-        for (QGeoRoute &leg: route.routeLegs()) {
-            leg.setRequest(request());
-        }
-    }
+    QGeoRouteParseTask *task = engine->routeParser()->parseReplyAsync(reply->readAll(), request());
+    connect(task, &QGeoRouteParseTask::finished, this, &QGeoRouteReplyOsm::routesParsed);
+    connect(this, &QGeoRouteReply::aborted, task, &QGeoRouteParseTask::abort);
+}
 
-    if (error == QGeoRouteReply::NoError) {
-        setRoutes(routes.mid(0, request().numberAlternativeRoutes() + 1));
+void QGeoRouteReplyOsm::routesParsed()
+{
+    QGeoRouteParseTask *task = static_cast<QGeoRouteParseTask *>(sender());
+    if (task->error() == QGeoRouteReply::NoError) {
+        setRoutes(task->routes().mid(0, request().numberAlternativeRoutes() + 1));
         // setError(QGeoRouteReply::NoError, status);  // can't do this, or NoError is emitted and does damages
         setFinished(true);
     } else {
-        setError(error, errorString);
+        setError(task->error(), task->errorString());
     }
 }
 
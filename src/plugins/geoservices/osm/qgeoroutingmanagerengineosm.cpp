@@ -102,7 +102,7 @@ QGeoRouteReply* QGeoRoutingManagerEngineOsm::calculateRoute(const QGeoRouteReque
     return routeReply;
 }
 
-const QGeoRouteParser *QGeoRoutingManagerEngineOsm::routeParser() const
+QGeoRouteParser *QGeoRoutingManagerEngineOsm::routeParser() const
 {
     return m_routeParser;
 }
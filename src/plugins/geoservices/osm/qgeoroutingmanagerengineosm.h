@@ -59,7 +59,7 @@ public:
     ~QGeoRoutingManagerEngineOsm();
 
     QGeoRouteReply *calculateRoute(const QGeoRouteRequest &request) override;
-    const QGeoRouteParser *routeParser() const;
+    QGeoRouteParser *routeParser() const;
 
 private Q_SLOTS:
     void replyFinished();
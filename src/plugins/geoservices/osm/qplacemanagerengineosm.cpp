@@ -101,7 +101,7 @@ QPlaceManagerEngineOsm::QPlaceManagerEngineOsm(const QVariantMap &parameters,
                                                QGeoServiceProvider::Error *error,
                                                QString *errorString)
 :   QPlaceManagerEngine(parameters), m_networkManager(new QNetworkAccessManager(this)),
-    m_categoriesReply(0)
+    m_categoriesReply(0), m_categoryCache(parameters)
 {
     if (parameters.contains(QStringLiteral("osm.useragent")))
         m_userAgent = parameters.value(QStringLiteral("osm.useragent")).toString().toLatin1();
@@ -204,8 +204,12 @@ QPlaceSearchReply *QPlaceManagerEngineOsm::search(const QPlaceSearchRequest &req
 
 QPlaceReply *QPlaceManagerEngineOsm::initializeCategories()
 {
+    // Stored categories are used until they are fetched again, in the background
+    if (m_categories.isEmpty())
+        m_categoryCache.load(this, &m_categories);
+
     // Only fetch categories once
-    if (m_categories.isEmpty() && !m_categoriesReply) {
+    if (!m_categoriesReply) {
         m_categoryLocales = m_locales;
         m_categoryLocales.append(QLocale(QLocale::English));
         fetchNextCategoryLocale();
@@ -217,11 +221,10 @@ QPlaceReply *QPlaceManagerEngineOsm::initializeCategories()
     connect(reply, &QPlaceCategoriesReplyOsm::errorOccurred,
             this, &QPlaceManagerEngineOsm::replyError);
 
-    // TODO delayed finished() emission
     if (!m_categories.isEmpty())
-        reply->emitFinished();
-
-    m_pendingCategoriesReply.append(reply);
+        QMetaObject::invokeMethod(reply, &QPlaceCategoriesReplyOsm::emitFinished, Qt::QueuedConnection);
+    else
+        m_pendingCategoriesReply.append(reply);
     return reply;
 }
 
@@ -235,20 +238,17 @@ QString QPlaceManagerEngineOsm::parentCategoryId(const QString &categoryId) cons
 
 QStringList QPlaceManagerEngineOsm::childCategoryIds(const QString &categoryId) const
 {
-    return m_subcategories.value(categoryId);
+    return m_categories.childIds(categoryId);
 }
 
 QPlaceCategory QPlaceManagerEngineOsm::category(const QString &categoryId) const
 {
-    return m_categories.value(categoryId);
+    return m_categories.category(categoryId);
 }
 
 QList<QPlaceCategory> QPlaceManagerEngineOsm::childCategories(const QString &parentId) const
 {
-    QList<QPlaceCategory> categories;
-    for (const QString &id : m_subcategories.value(parentId))
-        categories.append(m_categories.value(id));
-    return categories;
+    return m_categories.childCategories(parentId);
 }
 
 QList<QLocale> QPlaceManagerEngineOsm::locales() const
@@ -291,37 +291,37 @@ void QPlaceManagerEngineOsm::categoryReplyFinished()
                 if (op != QLatin1String("-") || plural != QLatin1String("Y"))
                     continue;
 
-                if (!m_categories.contains(tagKey)) {
+                if (!m_fetchedCategories.contains(tagKey)) {
                     QPlaceCategory category;
                     category.setCategoryId(tagKey);
                     category.setName(nameForTagKey(tagKey));
-                    m_categories.insert(category.categoryId(), category);
-                    m_subcategories[QString()].append(tagKey);
-                    emit categoryAdded(category, QString());
+                    m_fetchedCategories.insert(category);
                 }
 
                 QPlaceCategory category;
                 category.setCategoryId(tagKey + QLatin1Char('=') + tagValue);
                 category.setName(name);
-
-                if (!m_categories.contains(category.categoryId())) {
-                    m_categories.insert(category.categoryId(), category);
-                    m_subcategories[tagKey].append(category.categoryId());
-                    emit categoryAdded(category, tagKey);
-                }
+                m_fetchedCategories.insert(category, tagKey);
             }
         }
 
         parser.skipCurrentElement();
     }
 
-    if (m_categories.isEmpty() && !m_categoryLocales.isEmpty()) {
+    if (m_fetchedCategories.isEmpty() && !m_categoryLocales.isEmpty()) {
         fetchNextCategoryLocale();
         return;
     } else {
         m_categoryLocales.clear();
     }
 
+    // Stored categories are only replaced by a successful fetch
+    if (!m_fetchedCategories.isEmpty()) {
+        m_categories.update(m_fetchedCategories, this);
+        m_categoryCache.save(this, m_categories);
+        m_fetchedCategories.clear();
+    }
+
     for (QPlaceCategoriesReplyOsm *reply : m_pendingCategoriesReply)
         reply->emitFinished();
     m_pendingCategoriesReply.clear();
@@ -356,7 +356,6 @@ void QPlaceManagerEngineOsm::fetchNextCategoryLocale()
 
     QLocale locale = m_categoryLocales.takeFirst();
 
-    // FIXME: Categories should be cached.
     QUrl requestUrl = QUrl(SpecialPhrasesBaseUrl + locale.name().left(2).toUpper());
 
     m_categoriesReply = m_networkManager->get(QNetworkRequest(requestUrl));
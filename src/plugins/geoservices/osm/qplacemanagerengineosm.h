@@ -42,6 +42,7 @@
 
 #include <QtLocation/QPlaceManagerEngine>
 #include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/private/qplacecategorycache_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -88,8 +89,9 @@ private:
 
     QNetworkReply *m_categoriesReply;
     QList<QPlaceCategoriesReplyOsm *> m_pendingCategoriesReply;
-    QHash<QString, QPlaceCategory> m_categories;
-    QHash<QString, QStringList> m_subcategories;
+    QPlaceCategoryTree m_categories;
+    QPlaceCategoryTree m_fetchedCategories;
+    QPlaceCategoryCache m_categoryCache;
 
     QList<QLocale> m_categoryLocales;
 };
@@ -204,6 +204,94 @@ TestCase {
         compare(categoryModel.model.status, CategoryModel.Error);
     }
 
+    function saveCategory(plugin, categoryId, name, parentId) {
+        var category = Qt.createQmlObject('import QtLocation; Category {}', testCase, "Category");
+        category.plugin = plugin;
+        category.categoryId = categoryId;
+        category.name = name;
+        category.save(parentId);
+        tryCompare(category, "status", Category.Ready);
+        category.destroy();
+    }
+
+    function removeCategory(plugin, categoryId) {
+        var category = Qt.createQmlObject('import QtLocation; Category {}', testCase, "Category");
+        category.plugin = plugin;
+        category.categoryId = categoryId;
+        category.remove();
+        tryCompare(category, "status", Category.Ready);
+        category.destroy();
+    }
+
+    function childNames(model, parent) {
+        var names = [];
+        for (var i = 0; i < model.rowCount(parent); ++i)
+            names.push(model.data(model.index(i, 0, parent), CategoryModel.CategoryRole).name);
+        return names;
+    }
+
+    function test_incrementalUpdate() {
+        // A plugin of its own, as categories are changed
+        var plugin = Qt.createQmlObject('import QtLocation; Plugin { name: "qmlgeo.test.plugin"; allowExperimental: true; '
+                                        + 'parameters: [ PluginParameter { name: "initializePlaceData"; value: true } ] }',
+                                        testCase, "Plugin");
+        var model = Qt.createQmlObject('import QtLocation; CategoryModel {}', testCase, "CategoryModel");
+        model.plugin = plugin;
+        model.update();
+        tryCompare(model, "status", CategoryModel.Ready);
+        compare(childNames(model, model.index(-1, -1)), [ "Accommodation", "Park" ]);
+
+        var hotelId = "70ab5807-26d2-46be-a860-dc48f17133f0";
+        var motelId = "e0478f8a-fe8f-4bf9-8392-c1910e49223f";
+        var parkId = "c2e1252c-b997-44fc-8165-e53dd00f66a7";
+
+        var spies = {};
+        var signalNames = [ "rowsInserted", "rowsRemoved", "rowsMoved", "dataChanged", "modelReset" ];
+        for (var i = 0; i < signalNames.length; ++i) {
+            spies[signalNames[i]] = Qt.createQmlObject('import QtTest; SignalSpy {}', testCase, "SignalSpy");
+            spies[signalNames[i]].target = model;
+            spies[signalNames[i]].signalName = signalNames[i];
+        }
+
+        saveCategory(plugin, "", "Beach", "");        // added
+        removeCategory(plugin, motelId);              // removed
+        saveCategory(plugin, parkId, "Parks", "");    // renamed
+        saveCategory(plugin, hotelId, "Hotel", parkId); // re-parented
+
+        model.update();
+        tryCompare(model, "status", CategoryModel.Ready);
+
+        compare(spies.modelReset.count, 0);
+        compare(spies.rowsMoved.count, 0);
+        // Beach, and Hotel in Parks
+        compare(spies.rowsInserted.count, 2);
+        // Motel, and Hotel in Accommodation
+        compare(spies.rowsRemoved.count, 2);
+        // The name of Parks, and its children it did not have before
+        compare(spies.dataChanged.count, 2);
+
+        var root = model.index(-1, -1);
+        compare(childNames(model, root), [ "Accommodation", "Beach", "Parks" ]);
+        compare(childNames(model, model.index(0, 0, root)), [ "Camping" ]);
+        compare(childNames(model, model.index(1, 0, root)), [ ]);
+        compare(childNames(model, model.index(2, 0, root)), [ "Hotel" ]);
+        compare(model.data(model.index(0, 0, model.index(2, 0, root)), CategoryModel.ParentCategoryRole).categoryId,
+                parkId);
+
+        // Reloading the same categories changes nothing
+        for (i = 0; i < signalNames.length; ++i)
+            spies[signalNames[i]].clear();
+        model.update();
+        tryCompare(model, "status", CategoryModel.Ready);
+        for (i = 0; i < signalNames.length; ++i)
+            compare(spies[signalNames[i]].count, 0, signalNames[i]);
+
+        for (i = 0; i < signalNames.length; ++i)
+            spies[signalNames[i]].destroy();
+        model.destroy();
+        plugin.destroy();
+    }
+
     function test_error() {
         var testModel = Qt.createQmlObject('import QtLocation 5.3; CategoryModel {}', testCase, "CategoryModel");
 
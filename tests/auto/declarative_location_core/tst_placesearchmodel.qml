@@ -70,6 +70,68 @@ TestCase {
         name: "Test Category 2"
     }
 
+    // Places of the test plugin whose recommendations are used as paged searches
+    readonly property string pagingStart: "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7100"
+    readonly property string pagingRepeat: "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7105"
+    readonly property var pagingNames: ({
+        "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7101": "Paging Stop 1",
+        "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7102": "Paging Stop 2",
+        "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7103": "Paging Stop 3",
+        "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7104": "Paging Stop 4",
+        "4dcc74ce-fdeb-443e-827c-367438017cf1": "Park View Hotel",
+        "8f72057a-54b2-4e95-a7bb-97b4d2b5721e": "Sea View Hotel"
+    })
+    readonly property string stop1: "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7101"
+    readonly property string stop2: "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7102"
+    readonly property string stop3: "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7103"
+    readonly property string stop4: "2f3e41f4-4c6a-4d0e-9d0a-5b8e3c2a7104"
+    readonly property string parkView: "4dcc74ce-fdeb-443e-827c-367438017cf1"
+    readonly property string seaView: "8f72057a-54b2-4e95-a7bb-97b4d2b5721e"
+
+    // Each model gets its own plugin instance, as places are removed from it
+    function createPagedModel(recommendationId) {
+        var plugin = Qt.createQmlObject('import QtLocation; Plugin { name: "qmlgeo.test.plugin"; allowExperimental: true; '
+                                        + 'parameters: [ PluginParameter { name: "initializePlaceData"; value: true } ] }',
+                                        testCase, "Plugin");
+        var model = Qt.createQmlObject('import QtLocation; PlaceSearchModel { incremental: true; limit: 2 }',
+                                       testCase, "PlaceSearchModel");
+        model.plugin = plugin;
+        model.recommendationId = recommendationId;
+        model.update();
+        tryCompare(model, "status", PlaceSearchModel.Ready);
+        return model;
+    }
+
+    function loadNextPage(model) {
+        var count = model.count;
+        model.nextPage();
+        tryVerify(function() { return model.count > count && model.status === PlaceSearchModel.Ready; });
+    }
+
+    // Places removed before are saved again, so that they can be removed again
+    function removePlace(model, placeId, removedBefore) {
+        var place = Qt.createQmlObject('import QtLocation; Place {}', testCase, "Place");
+        place.plugin = model.plugin;
+        place.placeId = placeId;
+        if (removedBefore) {
+            place.save();
+            tryCompare(place, "status", Place.Ready);
+        }
+        var count = model.count;
+        place.remove();
+        tryCompare(place, "status", Place.Ready);
+        compare(model.count, count - 1);
+        place.destroy();
+    }
+
+    function comparePlaceIds(model, placeIds) {
+        compare(model.count, placeIds.length);
+        for (var i = 0; i < placeIds.length; ++i) {
+            compare(model.data(i, "title"), pagingNames[placeIds[i]]);
+            compare(model.data(i, "place").placeId, placeIds[i]);
+        }
+    }
+
     function compareArray(a, b) {
         if (a.length !== b.length)
             return false;
@@ -234,6 +296,102 @@ TestCase {
         delete countChangedSpy;
     }
 
+    function test_lazyPlaces() {
+        var testModel = Qt.createQmlObject('import QtLocation; PlaceSearchModel {}', testCase, "PlaceSearchModel");
+        var center = QtPositioning.coordinate(0.1, 0.1);
+        testModel.plugin = testPlugin;
+        testModel.searchTerm = "view";
+        testModel.searchArea = QtPositioning.circle(center, 5000);
+        testModel.update();
+        tryCompare(testModel, "status", PlaceSearchModel.Ready);
+        compare(testModel.count, 2);
+
+        // The roles of the results are served before any place is accessed
+        var titles = [];
+        var distances = [];
+        for (var i = 0; i < testModel.count; ++i) {
+            compare(testModel.data(i, "type"), PlaceSearchModel.PlaceResult);
+            titles.push(testModel.data(i, "title"));
+            distances.push(testModel.data(i, "distance"));
+            verify(distances[i] > 0);
+            compare(testModel.data(i, "sponsored"), false);
+        }
+        verify(compareArray(titles, [ "Park View Hotel", "Sea View Hotel" ]));
+
+        // Places are created on first access and kept
+        for (var j = 0; j < testModel.count; ++j) {
+            var place = testModel.data(j, "place");
+            verify(place);
+            verify(place === testModel.data(j, "place"));
+            compare(place.name, titles[j]);
+            fuzzyCompare(place.location.coordinate.distanceTo(center), distances[j], 0.01);
+        }
+        verify(testModel.data(0, "place") !== testModel.data(1, "place"));
+
+        // A new search creates new places
+        var first = testModel.data(0, "place");
+        testModel.update();
+        tryCompare(testModel, "status", PlaceSearchModel.Ready);
+        verify(testModel.data(0, "place") !== first);
+
+        testModel.destroy();
+    }
+
+    function test_removePagedPlaces() {
+        var model = createPagedModel(pagingStart);
+        loadNextPage(model);
+        loadNextPage(model);
+        comparePlaceIds(model, [ stop1, stop2, parkView, stop3, seaView, stop4 ]);
+
+        // Middle page
+        removePlace(model, parkView);
+        comparePlaceIds(model, [ stop1, stop2, stop3, seaView, stop4 ]);
+
+        // Last page
+        removePlace(model, stop4);
+        comparePlaceIds(model, [ stop1, stop2, stop3, seaView ]);
+
+        // First page
+        removePlace(model, stop1);
+        comparePlaceIds(model, [ stop2, stop3, seaView ]);
+
+        removePlace(model, stop3);
+        removePlace(model, stop2);
+        comparePlaceIds(model, [ seaView ]);
+
+        var plugin = model.plugin;
+        model.destroy();
+        plugin.destroy();
+    }
+
+    function test_removeRepeatedPlaces() {
+        var model = createPagedModel(pagingRepeat);
+        loadNextPage(model);
+        comparePlaceIds(model, [ stop1, stop2, stop1, stop3 ]);
+
+        // Pages appended after a removal
+        removePlace(model, stop3);
+        comparePlaceIds(model, [ stop1, stop2, stop1 ]);
+        loadNextPage(model);
+        comparePlaceIds(model, [ stop1, stop2, stop1, stop2, stop1 ]);
+
+        // The first row of a place is removed, the other ones move up
+        removePlace(model, stop1);
+        comparePlaceIds(model, [ stop2, stop1, stop2, stop1 ]);
+        removePlace(model, stop1, true);
+        comparePlaceIds(model, [ stop2, stop2, stop1 ]);
+        removePlace(model, stop2);
+        comparePlaceIds(model, [ stop2, stop1 ]);
+        removePlace(model, stop1, true);
+        comparePlaceIds(model, [ stop2 ]);
+        removePlace(model, stop2, true);
+        compare(model.count, 0);
+
+        var plugin = model.plugin;
+        model.destroy();
+        plugin.destroy();
+    }
+
     function test_cancel() {
         var testModel = Qt.createQmlObject('import QtLocation 5.3; PlaceSearchModel {}', testCase, "PlaceSearchModel");
         testModel.plugin = testPlugin;
@@ -123,6 +123,45 @@ TestCase {
         compare(testModel.status, PlaceSearchSuggestionModel.Error);
     }
 
+    PlaceSearchSuggestionModel {
+        id: delayedModel
+        plugin: testPlugin
+        updateDelay: 50
+        limit: 5
+    }
+
+    SignalSpy { id: delayedSuggestionsSpy; target: delayedModel; signalName: "suggestionsChanged" }
+
+    function test_updateDelay() {
+        // Updates closer than the delay send a single request, for the last term
+        delayedModel.searchTerm = "t";
+        delayedModel.update();
+        compare(delayedModel.status, PlaceSearchSuggestionModel.Loading);
+        delayedModel.searchTerm = "te";
+        delayedModel.update();
+        delayedModel.searchTerm = "test";
+        delayedModel.update();
+        tryCompare(delayedModel, "status", PlaceSearchSuggestionModel.Ready);
+        compare(delayedSuggestionsSpy.count, 1);
+        compare(delayedModel.suggestions, [ "test1", "test2", "test3" ]);
+
+        // Fewer suggestions than the limit, those of longer terms are filtered from them.
+        // The test plugin itself has no suggestions for "test2".
+        delayedModel.searchTerm = "test2";
+        delayedModel.update();
+        tryCompare(delayedModel, "status", PlaceSearchSuggestionModel.Ready);
+        compare(delayedModel.suggestions, [ "test2" ]);
+
+        // Cancelling before the delay sends nothing
+        delayedModel.searchTerm = "test";
+        delayedModel.update();
+        delayedModel.cancel();
+        compare(delayedModel.status, PlaceSearchSuggestionModel.Ready);
+        wait(100);
+        compare(delayedModel.suggestions, [ "test2" ]);
+        delayedModel.reset();
+    }
+
     SignalSpy { id: statusChangedSpyError; target: testModelError; signalName: "statusChanged" }
 
     function test_error() {
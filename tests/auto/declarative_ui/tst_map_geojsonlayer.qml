@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick
+import QtTest
+import QtLocation
+import QtPositioning
+
+Item {
+    id: page
+    width: 400
+    height: 400
+
+    Plugin { id: testPlugin; name: "qmlgeo.test.plugin"; allowExperimental: true }
+
+    // A GeoJSON document as imported by QGeoJson::importGeoJson(): a grid of squares
+    function squares(count) {
+        var features = []
+        var side = Math.ceil(Math.sqrt(count))
+        for (var i = 0; i < count; ++i) {
+            var lat = -40 + 80 * Math.floor(i / side) / side
+            var lon = -40 + 80 * (i % side) / side
+            var size = 60 / side
+            features.push({
+                type: "Polygon",
+                data: QtPositioning.polygon([QtPositioning.coordinate(lat, lon),
+                                             QtPositioning.coordinate(lat, lon + size),
+                                             QtPositioning.coordinate(lat + size, lon + size),
+                                             QtPositioning.coordinate(lat + size, lon)]),
+                properties: { name: "square " + i, color: (i % 2) ? "red" : "blue" }
+            })
+        }
+        return [{ type: "FeatureCollection", data: features }]
+    }
+
+    Map {
+        id: map
+        plugin: testPlugin
+        anchors.fill: parent
+        center: QtPositioning.coordinate(0, 0)
+        zoomLevel: 2
+
+        MapGeoJsonLayer {
+            id: layer
+        }
+
+        MapItemView {
+            id: view
+            delegate: MapPolygon {
+                geoShape: modelData.data
+                color: modelData.properties.color
+                border.color: "black"
+                backend: MapPolygon.OpenGL
+            }
+        }
+    }
+
+    TestCase {
+        name: "MapGeoJsonLayer"
+        when: windowShown && map.mapReady
+
+        function init() {
+            layer.geoJson = []
+            view.model = []
+            tryCompare(layer, "busy", false)
+        }
+
+        function test_features() {
+            layer.geoJson = squares(4)
+            tryCompare(layer, "busy", false)
+            compare(layer.featureCount, 4)
+            verify(layer.geoShape.isValid)
+
+            var center = QtPositioning.coordinate(-40 + 15, -40 + 15)
+            var feature = layer.featureAt(map.fromCoordinate(center, false))
+            compare(feature.properties.name, "square 0")
+            compare(layer.featureIndexAt(map.fromCoordinate(center, false)), 0)
+            compare(layer.featureAt(map.fromCoordinate(QtPositioning.coordinate(70, 0), false)),
+                    undefined)
+            compare(layer.featureIndexAt(map.fromCoordinate(QtPositioning.coordinate(70, 0), false)),
+                    -1)
+
+            layer.geoJson = []
+            tryCompare(layer, "featureCount", 0)
+        }
+
+        function test_style() {
+            layer.geoJson = squares(4)
+            layer.colorProperty = ""
+            tryCompare(layer, "busy", false)
+            compare(layer.featureCount, 4)
+            layer.colorProperty = "color"
+            tryCompare(layer, "busy", false)
+        }
+
+        // The cost of displaying 1000 features through the layer, and through a delegate each
+        function benchmark_layer() {
+            layer.geoJson = squares(1000)
+            tryCompare(layer, "busy", false, 10000)
+            waitForRendering(map)
+            layer.geoJson = []
+            tryCompare(layer, "busy", false)
+        }
+
+        function benchmark_delegates() {
+            view.model = squares(1000)[0].data
+            waitForRendering(map)
+            view.model = []
+        }
+    }
+}
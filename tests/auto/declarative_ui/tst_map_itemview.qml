@@ -45,6 +45,9 @@ Item {
                                 && mapForView.mapReady
                                 && mapForTestingListModel.mapReady
                                 && mapForTestingRouteModel.mapReady
+                                && mapForVirtualization.mapReady
+                                && mapForClustering.mapReady
+                                && mapForClusteringWithoutDelegate.mapReady
 
     MapItemView {
         id: routeItemViewExtra
@@ -299,6 +302,102 @@ Item {
         }
     }
 
+    Map {
+        id: mapForVirtualization
+
+        center: mapDefaultCenter
+        plugin: testPlugin
+        width: 100
+        height: 100
+        zoomLevel: 8
+
+        MapItemView {
+            id: virtualizedItemView
+            incubateDelegates: false
+            virtualizeDelegates: true
+            coordinateRole: "coordinate"
+            virtualizationMargin: 0
+            add: null
+            remove: null
+            model: ListModel {
+                id: virtualizedListModel
+            }
+            delegate: Component {
+                MapCircle {
+                    radius: 100
+                    center: coordinate
+                }
+            }
+        }
+    }
+
+    Map {
+        id: mapForClustering
+
+        center: mapDefaultCenter
+        plugin: testPlugin
+        width: 100
+        height: 100
+        zoomLevel: 8
+
+        MapItemView {
+            id: clusteredItemView
+            incubateDelegates: false
+            clustering: true
+            coordinateRole: "coordinate"
+            maximumClusterZoomLevel: 8
+            virtualizationMargin: 0
+            add: null
+            remove: null
+            model: ListModel {
+                id: clusteredListModel
+            }
+            delegate: Component {
+                MapCircle {
+                    radius: 10
+                    center: coordinate
+                }
+            }
+            clusterDelegate: Component {
+                MapQuickItem {
+                    objectName: "cluster"
+                    property int clusterCount: cluster.count
+                    coordinate: cluster.center
+                    sourceItem: Rectangle { width: 20; height: 20 }
+                }
+            }
+        }
+    }
+
+    Map {
+        id: mapForClusteringWithoutDelegate
+
+        center: mapDefaultCenter
+        plugin: testPlugin
+        width: 100
+        height: 100
+        zoomLevel: 8
+
+        MapItemView {
+            id: clusteredItemViewWithoutDelegate
+            incubateDelegates: false
+            clustering: true
+            coordinateRole: "coordinate"
+            virtualizationMargin: 0
+            add: null
+            remove: null
+            model: ListModel {
+                id: clusteredListModelWithoutDelegate
+            }
+            delegate: Component {
+                MapCircle {
+                    radius: 10
+                    center: coordinate
+                }
+            }
+        }
+    }
+
     TestCase {
         name: "MapItem"
         when: windowShown && allMapsReady
@@ -509,6 +608,105 @@ Item {
             tryCompare(mapForTestingListModel, "mapItemsLength", 3)
         }
 
+        function instantiatedCount(view) {
+            var count = 0
+            for (var i = 0; i < view.mapItems.length; ++i) {
+                if (view.mapItems[i])
+                    ++count
+            }
+            return count
+        }
+
+        function test_virtualized_delegates() {
+            virtualizedListModel.append({ coordinate: QtPositioning.coordinate(10, 30) })
+            virtualizedListModel.append({ coordinate: QtPositioning.coordinate(10.05, 30.05) })
+            virtualizedListModel.append({ coordinate: QtPositioning.coordinate(40, -70) })
+            virtualizedListModel.append({ coordinate: QtPositioning.coordinate(-30, 100) })
+            compare(virtualizedItemView.mapItems.length, 4)
+            tryVerify(function() { return instantiatedCount(virtualizedItemView) === 2 })
+            verify(virtualizedItemView.mapItems[0])
+            verify(!virtualizedItemView.mapItems[2])
+
+            mapForVirtualization.center = QtPositioning.coordinate(40, -70)
+            tryVerify(function() { return instantiatedCount(virtualizedItemView) === 1 })
+            verify(!virtualizedItemView.mapItems[0])
+            verify(virtualizedItemView.mapItems[2])
+            compare(mapForVirtualization.mapItems.length, 1)
+
+            virtualizedListModel.remove(2)
+            tryVerify(function() { return instantiatedCount(virtualizedItemView) === 0 })
+            compare(virtualizedItemView.mapItems.length, 3)
+
+            virtualizedItemView.virtualizeDelegates = false
+            tryVerify(function() { return instantiatedCount(virtualizedItemView) === 3 })
+            virtualizedItemView.virtualizeDelegates = true
+            tryVerify(function() { return instantiatedCount(virtualizedItemView) === 0 })
+            mapForVirtualization.center = mapDefaultCenter
+            tryVerify(function() { return instantiatedCount(virtualizedItemView) === 2 })
+            virtualizedListModel.clear()
+            tryVerify(function() { return instantiatedCount(virtualizedItemView) === 0 })
+        }
+
+        function clusterItems(map) {
+            var res = []
+            for (var i = 0; i < map.mapItems.length; ++i) {
+                if (map.mapItems[i].objectName === "cluster")
+                    res.push(map.mapItems[i])
+            }
+            return res
+        }
+
+        function test_clustered_delegates() {
+            clusteredListModel.append({ coordinate: QtPositioning.coordinate(10, 30) })
+            clusteredListModel.append({ coordinate: QtPositioning.coordinate(10.001, 30.001) })
+            clusteredListModel.append({ coordinate: QtPositioning.coordinate(10.002, 30.002) })
+            clusteredListModel.append({ coordinate: QtPositioning.coordinate(10.1, 29.8) })
+
+            // Three rows grouped into a cluster, the last one on its own
+            tryVerify(function() { return clusterItems(mapForClustering).length === 1 })
+            tryVerify(function() { return instantiatedCount(clusteredItemView) === 1 })
+            verify(clusteredItemView.mapItems[3])
+            compare(clusterItems(mapForClustering)[0].clusterCount, 3)
+
+            // Incremental insertion
+            clusteredListModel.append({ coordinate: QtPositioning.coordinate(10.001, 30.002) })
+            tryCompare(clusterItems(mapForClustering)[0], "clusterCount", 4)
+
+            // Incremental removal
+            clusteredListModel.remove(4)
+            tryCompare(clusterItems(mapForClustering)[0], "clusterCount", 3)
+
+            // Above maximumClusterZoomLevel rows are displayed on their own
+            mapForClustering.zoomLevel = 9
+            tryVerify(function() { return clusterItems(mapForClustering).length === 0 })
+            tryVerify(function() { return instantiatedCount(clusteredItemView) === 3 })
+
+            mapForClustering.zoomLevel = 8
+            tryVerify(function() { return clusterItems(mapForClustering).length === 1 })
+            tryVerify(function() { return instantiatedCount(clusteredItemView) === 1 })
+
+            clusteredListModel.clear()
+            tryVerify(function() { return clusterItems(mapForClustering).length === 0 })
+            tryVerify(function() { return instantiatedCount(clusteredItemView) === 0 })
+        }
+
+        function test_clustering_without_cluster_delegate() {
+            // Clustering is inactive without a clusterDelegate, all the rows are displayed
+            clusteredListModelWithoutDelegate.append({ coordinate: QtPositioning.coordinate(10, 30) })
+            clusteredListModelWithoutDelegate.append({ coordinate: QtPositioning.coordinate(10.001, 30.001) })
+            clusteredListModelWithoutDelegate.append({ coordinate: QtPositioning.coordinate(40, -70) })
+            compare(clusteredItemViewWithoutDelegate.mapItems.length, 3)
+            tryVerify(function() { return instantiatedCount(clusteredItemViewWithoutDelegate) === 3 })
+            compare(mapForClusteringWithoutDelegate.mapItems.length, 3)
+
+            mapForClusteringWithoutDelegate.center = QtPositioning.coordinate(40, -70)
+            wait(50)
+            compare(instantiatedCount(clusteredItemViewWithoutDelegate), 3)
+
+            clusteredListModelWithoutDelegate.clear()
+            tryVerify(function() { return clusteredItemViewWithoutDelegate.mapItems.length === 0 })
+        }
+
         function test_routemodel() {
             testModel.reset();
             mapItemsChangedSpy.clear()
@@ -51,6 +51,7 @@
 #include <QtLocation/QPlaceCategory>
 #include <QtLocation/QPlace>
 #include <QtLocation/private/qplace_p.h>
+#include <QtLocation/private/qplacesearchrequest_p.h>
 #include <QtTest/QTest>
 
 QT_BEGIN_NAMESPACE
@@ -108,6 +109,7 @@ public:
 
     Q_INVOKABLE void emitFinished()
     {
+        setFinished(true);
         emit finished();
     }
 };
@@ -130,6 +132,7 @@ public:
 
     Q_INVOKABLE void emitFinished()
     {
+        setFinished(true);
         emit finished();
     }
 };
@@ -152,6 +155,7 @@ public:
 
     Q_INVOKABLE void emitFinished()
     {
+        setFinished(true);
         emit finished();
     }
 };
@@ -174,6 +178,7 @@ public:
 
     Q_INVOKABLE void emitFinished()
     {
+        setFinished(true);
         emit finished();
     }
 };
@@ -189,6 +194,9 @@ public:
         setResults(results);
     }
 
+    using QPlaceSearchReply::setRequest;
+    using QPlaceSearchReply::setNextPageRequest;
+
     Q_INVOKABLE void emitError()
     {
         emit errorOccurred(error(), errorString());
@@ -196,6 +204,7 @@ public:
 
     Q_INVOKABLE void emitFinished()
     {
+        setFinished(true);
         emit finished();
     }
 };
@@ -218,6 +227,7 @@ public:
 
     Q_INVOKABLE void emitFinished()
     {
+        setFinished(true);
         emit finished();
     }
 };
@@ -523,7 +533,37 @@ public:
             }
         }
 
+        if (query.searchArea().isValid()) {
+            const QGeoCoordinate center = query.searchArea().center();
+            for (QPlaceSearchResult &result : results) {
+                QPlaceResult placeResult(result);
+                placeResult.setDistance(center.distanceTo(placeResult.place().location().coordinate()));
+                result = placeResult;
+            }
+        }
+
+        // Results are paged by limit, the offset of a page is in the search context
+        QPlaceSearchRequest nextPage;
+        bool hasNextPage = false;
+        if (query.limit() > 0) {
+            const int offset = query.searchContext().toMap().value(QStringLiteral("offset")).toInt();
+            if (offset + query.limit() < results.count()) {
+                hasNextPage = true;
+                nextPage = query;
+                QVariantMap context;
+                context.insert(QStringLiteral("offset"), offset + query.limit());
+                nextPage.setSearchContext(context);
+                QPlaceSearchRequestPrivate *rpimpl = QPlaceSearchRequestPrivate::get(nextPage);
+                rpimpl->related = true;
+                rpimpl->page++;
+            }
+            results = results.mid(offset, query.limit());
+        }
+
         PlaceSearchReply *reply = new PlaceSearchReply(results, this);
+        reply->setRequest(query);
+        if (hasNextPage)
+            reply->setNextPageRequest(nextPage);
 
         QMetaObject::invokeMethod(reply, "emitFinished", Qt::QueuedConnection);
 
@@ -550,7 +590,9 @@ public:
     {
         IdReply *reply = new IdReply(QPlaceIdReply::SavePlace, this);
 
-        if (!place.placeId().isEmpty() && !m_places.contains(place.placeId())) {
+        // Removed places can be saved again, with their id
+        if (!place.placeId().isEmpty() && !m_places.contains(place.placeId())
+                && !m_removedPlaceIds.contains(place.placeId())) {
             reply->setError(QPlaceReply::PlaceDoesNotExistError, tr("Place does not exist"));
             QMetaObject::invokeMethod(reply, "emitError", Qt::QueuedConnection);
         } else if (!place.placeId().isEmpty()) {
@@ -579,6 +621,10 @@ public:
             QMetaObject::invokeMethod(reply, "emitError", Qt::QueuedConnection);
         } else {
             m_places.remove(placeId);
+            m_removedPlaceIds.insert(placeId);
+            QMetaObject::invokeMethod(this, [this, placeId]() {
+                emit placeRemoved(placeId);
+            }, Qt::QueuedConnection);
         }
 
         QMetaObject::invokeMethod(reply, "emitFinished", Qt::QueuedConnection);
@@ -596,14 +642,12 @@ public:
             QMetaObject::invokeMethod(reply, "emitError", Qt::QueuedConnection);
         } else if (!category.categoryId().isEmpty()) {
             m_categories.insert(category.categoryId(), category);
-            QStringList children = m_childCategories.value(parentId);
 
-            for (QStringList &c : m_childCategories)
-                c.removeAll(category.categoryId());
-
-            if (!children.contains(category.categoryId())) {
-                children.append(category.categoryId());
-                m_childCategories.insert(parentId, children);
+            // Moves the category if it has another parent now
+            if (!m_childCategories.value(parentId).contains(category.categoryId())) {
+                for (QStringList &c : m_childCategories)
+                    c.removeAll(category.categoryId());
+                m_childCategories[parentId].append(category.categoryId());
             }
             reply->setId(category.categoryId());
         } else {
@@ -737,6 +781,7 @@ public:
 private:
     QList<QLocale> m_locales;
     QHash<QString, QPlace> m_places;
+    QSet<QString> m_removedPlaceIds;
     QHash<QString, QPlaceCategory> m_categories;
     QHash<QString, QStringList> m_childCategories;
     QHash<QString, QStringList> m_placeRecommendations;
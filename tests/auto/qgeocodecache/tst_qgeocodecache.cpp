@@ -0,0 +1,280 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/location/maps
+
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QGeoCodingManager>
+#include <QtLocation/QGeoCodingManagerEngine>
+#include <QtLocation/private/qgeocodecache_p.h>
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoCoordinate>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoCodeCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void memoryCache();
+    void reverseGeocodeGrid();
+    void requestKey();
+    void expiry();
+    void inFlight();
+    void inFlightFromFinished();
+    void inFlightAborted();
+
+private:
+    static bool isCached(QGeoCodeReply *reply);
+};
+
+bool tst_QGeoCodeCache::isCached(QGeoCodeReply *reply)
+{
+    return qobject_cast<QGeoCodeCacheReply *>(reply) != nullptr;
+}
+
+void tst_QGeoCodeCache::initTestCase()
+{
+#if QT_CONFIG(library)
+    // Set custom path since CI doesn't install test plugins
+#ifdef Q_OS_WIN
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../../plugins"));
+#else
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../plugins"));
+#endif
+#endif
+}
+
+void tst_QGeoCodeCache::memoryCache()
+{
+    QVariantMap parameters;
+    parameters["geocoding.cache.size"] = 4;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoCodingManager *manager = provider.geocodingManager();
+    QVERIFY(manager);
+    QSignalSpy finishedSpy(manager, &QGeoCodingManager::finished);
+
+    // The test plugin returns as many locations as the limit
+    std::unique_ptr<QGeoCodeReply> first(manager->geocode("Some Street", 2, 0));
+    QVERIFY(first->isFinished());
+    QVERIFY(!isCached(first.get()));
+    QCOMPARE(first->locations().size(), 2);
+
+    // Addresses are normalized. Cached replies finish from the event loop, like network ones.
+    std::unique_ptr<QGeoCodeReply> second(manager->geocode("  some   STREET ", 2, 0));
+    QVERIFY(isCached(second.get()));
+    QVERIFY(!second->isFinished());
+    QSignalSpy secondFinishedSpy(second.get(), &QGeoCodeReply::finished);
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(secondFinishedSpy.size(), 1);
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(finishedSpy.first().first().value<QGeoCodeReply *>(), second.get());
+    QCOMPARE(second->error(), QGeoCodeReply::NoError);
+    QCOMPARE(second->locations(), first->locations());
+    QCOMPARE(second->limit(), first->limit());
+
+    std::unique_ptr<QGeoCodeReply> offset(manager->geocode("Some Street", 2, 2));
+    QVERIFY(!isCached(offset.get()));
+
+    // The test plugin returns as many locations as the county number
+    QGeoAddress address;
+    address.setStreet("Main Street");
+    address.setCity("Springfield");
+    address.setCounty("3");
+    std::unique_ptr<QGeoCodeReply> third(manager->geocode(address));
+    QVERIFY(!isCached(third.get()));
+    QCOMPARE(third->locations().size(), 3);
+
+    address.setCity(" springfield");
+    std::unique_ptr<QGeoCodeReply> fourth(manager->geocode(address));
+    QVERIFY(isCached(fourth.get()));
+    QCOMPARE(fourth->locations().size(), 3);
+
+    address.setCity("Shelbyville");
+    std::unique_ptr<QGeoCodeReply> other(manager->geocode(address));
+    QVERIFY(!isCached(other.get()));
+
+    // Errors are not cached
+    std::unique_ptr<QGeoCodeReply> error(manager->geocode("2", 2, 0));
+    QCOMPARE(error->error(), QGeoCodeReply::CommunicationError);
+    std::unique_ptr<QGeoCodeReply> errorAgain(manager->geocode("2", 2, 0));
+    QVERIFY(!isCached(errorAgain.get()));
+}
+
+void tst_QGeoCodeCache::reverseGeocodeGrid()
+{
+    QVariantMap parameters;
+    parameters["geocoding.cache.size"] = 4;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoCodingManager *manager = provider.geocodingManager();
+    QVERIFY(manager);
+
+    // The test plugin returns as many locations as the longitude
+    std::unique_ptr<QGeoCodeReply> first(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    QVERIFY(!isCached(first.get()));
+    QCOMPARE(first->locations().size(), 4);
+    QCOMPARE(first->error(), QGeoCodeReply::NoError);
+
+    // A few meters away, in the same cell
+    std::unique_ptr<QGeoCodeReply> close(manager->reverseGeocode(QGeoCoordinate(12.12002, 3.30003)));
+    QVERIFY(isCached(close.get()));
+    QCOMPARE(close->locations(), first->locations());
+
+    std::unique_ptr<QGeoCodeReply> far(manager->reverseGeocode(QGeoCoordinate(12.121, 3.3)));
+    QVERIFY(!isCached(far.get()));
+}
+
+void tst_QGeoCodeCache::requestKey()
+{
+    QVariantMap parameters;
+    parameters["geocoding.cache.size"] = 4;
+    parameters["geocoding.cache.precision"] = 2;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QVERIFY(provider.geocodingManager());
+    QGeoCodingManagerEngine *engine = provider.geocodingManager()->findChild<QGeoCodingManagerEngine *>();
+    QVERIFY(engine);
+    QGeoCodeCache *cache = engine->findChild<QGeoCodeCache *>();
+    QVERIFY(cache);
+
+    QCOMPARE(cache->coordinateKey(QGeoCoordinate(12.121, 3.3), QGeoShape()),
+             cache->coordinateKey(QGeoCoordinate(12.1249, 3.3), QGeoShape()));
+    QVERIFY(cache->coordinateKey(QGeoCoordinate(12.121, 3.3), QGeoShape())
+            != cache->coordinateKey(QGeoCoordinate(12.13, 3.3), QGeoShape()));
+
+    QCOMPARE(cache->addressKey("Some\tStreet", 2, 0, QGeoShape()),
+             cache->addressKey("some street", 2, 0, QGeoShape()));
+    QVERIFY(cache->addressKey("Some Street", 2, 0, QGeoShape())
+            != cache->addressKey("Some Street", 2, 0, QGeoCircle(QGeoCoordinate(1, 1), 100)));
+
+    // The fields of an address are not mixed up
+    QGeoAddress a;
+    a.setCity("Springfield");
+    QGeoAddress b;
+    b.setStreet("Springfield");
+    QVERIFY(cache->addressKey(a, QGeoShape()) != cache->addressKey(b, QGeoShape()));
+}
+
+void tst_QGeoCodeCache::expiry()
+{
+    QVariantMap parameters;
+    parameters["geocoding.cache.size"] = 4;
+    parameters["geocoding.cache.ttl"] = 0;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoCodingManager *manager = provider.geocodingManager();
+    QVERIFY(manager);
+
+    std::unique_ptr<QGeoCodeReply> first(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    std::unique_ptr<QGeoCodeReply> second(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    QVERIFY(!isCached(second.get()));
+}
+
+void tst_QGeoCodeCache::inFlight()
+{
+    QVariantMap parameters;
+    parameters["geocoding.cache.size"] = 4;
+    parameters["finishRequestImmediately"] = false;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoCodingManager *manager = provider.geocodingManager();
+    QVERIFY(manager);
+    QSignalSpy finishedSpy(manager, &QGeoCodingManager::finished);
+
+    // The test engine asserts that it only has one request at a time
+    std::unique_ptr<QGeoCodeReply> first(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    std::unique_ptr<QGeoCodeReply> second(manager->reverseGeocode(QGeoCoordinate(12.12001, 3.3)));
+    QVERIFY(!first->isFinished());
+    QVERIFY(!second->isFinished());
+    QVERIFY(isCached(second.get()));
+
+    QTRY_VERIFY(second->isFinished());
+    QVERIFY(first->isFinished());
+    QCOMPARE(finishedSpy.size(), 2);
+    QCOMPARE(second->locations(), first->locations());
+
+    // Answered from memory now
+    std::unique_ptr<QGeoCodeReply> third(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    QVERIFY(isCached(third.get()));
+    QTRY_VERIFY(third->isFinished());
+    QCOMPARE(third->locations(), first->locations());
+}
+
+void tst_QGeoCodeCache::inFlightFromFinished()
+{
+    QVariantMap parameters;
+    parameters["geocoding.cache.size"] = 4;
+    parameters["finishRequestImmediately"] = false;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoCodingManager *manager = provider.geocodingManager();
+    QVERIFY(manager);
+
+    // A request made while the first one finishes reuses its result
+    std::unique_ptr<QGeoCodeReply> first(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    std::unique_ptr<QGeoCodeReply> second;
+    connect(first.get(), &QGeoCodeReply::finished, this, [&]() {
+        if (!second)
+            second.reset(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    });
+    QTRY_VERIFY(second);
+    QVERIFY(isCached(second.get()));
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(second->error(), QGeoCodeReply::NoError);
+    QCOMPARE(second->locations(), first->locations());
+}
+
+void tst_QGeoCodeCache::inFlightAborted()
+{
+    QVariantMap parameters;
+    parameters["geocoding.cache.size"] = 4;
+    parameters["finishRequestImmediately"] = false;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoCodingManager *manager = provider.geocodingManager();
+    QVERIFY(manager);
+
+    std::unique_ptr<QGeoCodeReply> first(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    std::unique_ptr<QGeoCodeReply> second(manager->reverseGeocode(QGeoCoordinate(12.12, 3.3)));
+    QVERIFY(isCached(second.get()));
+
+    // The reply that was shared is aborted by its owner, the other one still gets locations.
+    // Aborting also emits finished(), what the aborted reply holds must not be shared.
+    first->abort();
+    QCoreApplication::processEvents();
+    QVERIFY(!second->isFinished());
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(second->error(), QGeoCodeReply::NoError);
+    QCOMPARE(second->locations().size(), 4);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoCodeCache)
+
+#include "tst_qgeocodecache.moc"
@@ -28,7 +28,11 @@
 
 #include <QtTest/QtTest>
 #include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoPath>
+#include <QtPositioning/QGeoRectangle>
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QVariant>
 #include <QtCore/QList>
 #include <QtLocation/private/qgeojson_p.h>
@@ -41,6 +45,23 @@ class tst_QGeoJson : public QObject
 
 private Q_SLOTS:
     void testGeojson();
+    void streamingImport_data();
+    void streamingImport();
+    void streamingImportErrors();
+    void importBenchmark_data();
+    void importBenchmark();
+    void asyncImport_data();
+    void asyncImport();
+    void asyncImportAbort();
+    void asyncImportDeleted();
+    void asyncImportBenchmark_data();
+    void asyncImportBenchmark();
+    void geometryCache_data();
+    void geometryCache();
+    void geometryCacheInvalidation();
+    void geometryCacheBounds();
+    void geometryCacheBenchmark_data();
+    void geometryCacheBenchmark();
 
 private:
     QString testDataDir;
@@ -85,5 +106,349 @@ void tst_QGeoJson::testGeojson()
     }
 }
 
+void tst_QGeoJson::streamingImport_data()
+{
+    QTest::addColumn<QString>("fileName");
+
+    const QString dataDir = QFileInfo(QFINDTESTDATA("01-point.json")).absolutePath();
+    const QStringList files = QDir(dataDir).entryList({ QStringLiteral("*.json") }, QDir::Files);
+    QVERIFY(!files.isEmpty());
+    for (const QString &file : files)
+        QTest::newRow(qPrintable(file)) << dataDir + QStringLiteral("/") + file;
+}
+
+void tst_QGeoJson::streamingImport()
+{
+    QFETCH(QString, fileName);
+
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QByteArray json = file.readAll();
+    const QJsonDocument originalDocument = QJsonDocument::fromJson(json);
+    const QJsonDocument expected = QGeoJson::exportGeoJson(QGeoJson::importGeoJson(originalDocument));
+
+    QString errorString;
+    const QVariantList fromData = QGeoJson::importGeoJson(json, &errorString);
+    QVERIFY2(errorString.isEmpty(), qPrintable(errorString));
+    QCOMPARE(QGeoJson::exportGeoJson(fromData), expected);
+
+    QVERIFY(file.seek(0));
+    const QVariantList fromDevice = QGeoJson::importGeoJson(&file, &errorString);
+    QVERIFY2(errorString.isEmpty(), qPrintable(errorString));
+    QCOMPARE(QGeoJson::exportGeoJson(fromDevice), expected);
+}
+
+void tst_QGeoJson::streamingImportErrors()
+{
+    QString errorString;
+    QVERIFY(QGeoJson::importGeoJson(QByteArray("{ \"type\": \"Point\", \"coordinates\": [1, 2"),
+                                    &errorString).isEmpty());
+    QVERIFY(!errorString.isEmpty());
+
+    QVERIFY(QGeoJson::importGeoJson(QByteArray("[1, 2]"), &errorString).isEmpty());
+    QVERIFY(!errorString.isEmpty());
+
+    // Members may come in any order, and escaped keys are decoded
+    const QVariantList imported = QGeoJson::importGeoJson(
+                QByteArray("{ \"coordinates\": [[1, 2], [3, 4.5e1]], \"ty\\u0070e\": \"LineString\" }"),
+                &errorString);
+    QVERIFY2(errorString.isEmpty(), qPrintable(errorString));
+    QCOMPARE(imported.size(), 1);
+    const QVariantMap lineString = imported.first().toMap();
+    QCOMPARE(lineString.value(QStringLiteral("type")).toString(), QStringLiteral("LineString"));
+    const QGeoPath path = lineString.value(QStringLiteral("data")).value<QGeoPath>();
+    QCOMPARE(path.path(), QList<QGeoCoordinate>({ QGeoCoordinate(2, 1), QGeoCoordinate(45, 3) }));
+}
+
+void tst_QGeoJson::importBenchmark_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<bool>("streaming");
+
+    const QString fileName = QFINDTESTDATA("10-countries.json");
+    QTest::newRow("document") << fileName << false;
+    QTest::newRow("streaming") << fileName << true;
+}
+
+void tst_QGeoJson::importBenchmark()
+{
+    QFETCH(QString, fileName);
+    QFETCH(bool, streaming);
+
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+
+    QVariantList modelList;
+    QBENCHMARK {
+        file.seek(0);
+        if (streaming)
+            modelList = QGeoJson::importGeoJson(&file);
+        else
+            modelList = QGeoJson::importGeoJson(QJsonDocument::fromJson(file.readAll()));
+    }
+    QCOMPARE(modelList.size(), 1);
+}
+
+void tst_QGeoJson::asyncImport_data()
+{
+    streamingImport_data();
+}
+
+void tst_QGeoJson::asyncImport()
+{
+    QFETCH(QString, fileName);
+
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QByteArray json = file.readAll();
+    const QJsonDocument expected = QGeoJson::exportGeoJson(
+                QGeoJson::importGeoJson(QJsonDocument::fromJson(json)));
+
+    QGeoJsonImportTask *task = QGeoJson::importGeoJsonAsync(json);
+    QSignalSpy progressSpy(task, &QGeoJsonImportTask::progress);
+    QSignalSpy finishedSpy(task, &QGeoJsonImportTask::finished);
+    QVariantList result;
+    QString errorString;
+    connect(task, &QGeoJsonImportTask::finished, this, [&]() {
+        result = task->result();
+        errorString = task->errorString();
+    });
+    QTRY_COMPARE(finishedSpy.count(), 1);
+
+    QVERIFY2(errorString.isEmpty(), qPrintable(errorString));
+    QCOMPARE(QGeoJson::exportGeoJson(result), expected);
+
+    // Progress ends with every feature of a FeatureCollection
+    if (!progressSpy.isEmpty()) {
+        const QList<QVariant> last = progressSpy.last();
+        QCOMPARE(last.at(0).value<qsizetype>(), last.at(1).value<qsizetype>());
+    }
+}
+
+void tst_QGeoJson::asyncImportAbort()
+{
+    QFile file(QFINDTESTDATA("10-countries.json"));
+    QVERIFY(file.open(QFile::ReadOnly));
+
+    QGeoJsonImportTask *task = QGeoJson::importGeoJsonAsync(file.readAll());
+    QPointer<QGeoJsonImportTask> guard(task);
+    QSignalSpy finishedSpy(task, &QGeoJsonImportTask::finished);
+    task->abort();
+    QVERIFY(task->isAborted());
+
+    // The task deletes itself without reporting anything
+    QTRY_VERIFY(guard.isNull());
+    QCOMPARE(finishedSpy.count(), 0);
+}
+
+void tst_QGeoJson::asyncImportDeleted()
+{
+    QFile file(QFINDTESTDATA("10-countries.json"));
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QByteArray json = file.readAll();
+
+    // Deleting the parent while the document is imported waits for the threads
+    for (int i = 0; i < 10; ++i) {
+        std::unique_ptr<QObject> parent(new QObject);
+        QGeoJsonImportTask *task = QGeoJson::importGeoJsonAsync(json, parent.get());
+        QSignalSpy finishedSpy(task, &QGeoJsonImportTask::finished);
+        if (i % 2)
+            QThread::msleep(1);
+        parent.reset();
+        QCoreApplication::processEvents();
+        QCOMPARE(finishedSpy.count(), 0);
+    }
+}
+
+void tst_QGeoJson::asyncImportBenchmark_data()
+{
+    QTest::addColumn<int>("threads");
+
+    for (int threads = 1; threads <= qMax(1, QThread::idealThreadCount()); threads *= 2)
+        QTest::addRow("%d threads", threads) << threads;
+}
+
+/*
+    A FeatureCollection with the countries repeated many times, so that the
+    import lasts long enough to compare thread counts.
+*/
+void tst_QGeoJson::asyncImportBenchmark()
+{
+    QFETCH(int, threads);
+
+    QFile file(QFINDTESTDATA("10-countries.json"));
+    QVERIFY(file.open(QFile::ReadOnly));
+    QJsonObject collection = QJsonDocument::fromJson(file.readAll()).object();
+    const QJsonArray countries = collection.value(QStringLiteral("features")).toArray();
+    QJsonArray features;
+    for (int i = 0; i < 20; ++i) {
+        for (const QJsonValue &country : countries)
+            features.append(country);
+    }
+    collection.insert(QStringLiteral("features"), features);
+    const QByteArray json = QJsonDocument(collection).toJson(QJsonDocument::Compact);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    QBENCHMARK {
+        QGeoJsonImportTask *task = new QGeoJsonImportTask(json);
+        QSignalSpy finishedSpy(task, &QGeoJsonImportTask::finished);
+        task->start(&pool);
+        QVERIFY(finishedSpy.wait(60000));
+    }
+}
+
+void tst_QGeoJson::geometryCache_data()
+{
+    streamingImport_data();
+}
+
+void tst_QGeoJson::geometryCache()
+{
+    QFETCH(QString, fileName);
+
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QVariantList imported = QGeoJson::importGeoJson(&file);
+    const QJsonDocument expected = QGeoJson::exportGeoJson(imported);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cacheFile = dir.filePath(QStringLiteral("cache"));
+    QVERIFY(QGeoJsonCache::write(cacheFile, fileName, imported));
+
+    QGeoJsonCache cache;
+    QVERIFY(cache.open(cacheFile, fileName));
+    const QVariantList cached = cache.read();
+    QCOMPARE(QGeoJson::exportGeoJson(cached), expected);
+    QCOMPARE(QGeoJson::toString(cached), QGeoJson::toString(imported));
+
+    const QVariantMap root = imported.first().toMap();
+    if (root.value(QStringLiteral("type")).toString() == QStringLiteral("FeatureCollection"))
+        QCOMPARE(cache.featureCount(), root.value(QStringLiteral("data")).toList().size());
+    else
+        QCOMPARE(cache.featureCount(), 0);
+}
+
+void tst_QGeoJson::geometryCacheInvalidation()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString sourceFile = dir.filePath(QStringLiteral("source.json"));
+    const QString cacheFile = dir.filePath(QStringLiteral("cache/source.cache"));
+    QVERIFY(QFile::copy(QFINDTESTDATA("09-featurecollection.json"), sourceFile));
+    QVERIFY(QFile::setPermissions(sourceFile, QFile::ReadOwner | QFile::WriteOwner));
+
+    // The first import writes the cache, the second one reads it
+    QString errorString;
+    const QVariantList imported = QGeoJson::importGeoJsonCached(sourceFile, cacheFile, &errorString);
+    QVERIFY2(errorString.isEmpty(), qPrintable(errorString));
+    QVERIFY(QFile::exists(cacheFile));
+    QCOMPARE(QGeoJson::exportGeoJson(QGeoJson::importGeoJsonCached(sourceFile, cacheFile)),
+             QGeoJson::exportGeoJson(imported));
+
+    QGeoJsonCache cache;
+    QVERIFY(cache.open(cacheFile, sourceFile));
+    cache.close();
+    QVERIFY(!cache.isOpen());
+    QVERIFY(!cache.open(cacheFile, QFINDTESTDATA("01-point.json")));
+
+    // Changing the source file, keeping its size, invalidates the cache
+    QFile source(sourceFile);
+    QVERIFY(source.open(QFile::ReadWrite));
+    QByteArray json = source.readAll();
+    QVERIFY(json.contains("\"Poly\""));
+    json.replace("\"Poly\"", "\"Pole\"");
+    QVERIFY(source.seek(0));
+    QCOMPARE(source.write(json), json.size());
+    source.close();
+    QVERIFY(!cache.open(cacheFile, sourceFile));
+
+    const QVariantList updated = QGeoJson::importGeoJsonCached(sourceFile, cacheFile);
+    const QVariantMap feature = updated.first().toMap()
+            .value(QStringLiteral("data")).toList().first().toMap();
+    QCOMPARE(feature.value(QStringLiteral("id")).toString(), QStringLiteral("Pole"));
+    QVERIFY(cache.open(cacheFile, sourceFile));
+
+    // A truncated cache is rejected
+    cache.close();
+    QFile truncated(cacheFile);
+    QVERIFY(truncated.open(QFile::ReadWrite));
+    QVERIFY(truncated.resize(truncated.size() / 2));
+    truncated.close();
+    QVERIFY(!cache.open(cacheFile, sourceFile));
+}
+
+void tst_QGeoJson::geometryCacheBounds()
+{
+    const QString fileName = QFINDTESTDATA("10-countries.json");
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QVariantList imported = QGeoJson::importGeoJson(&file);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cacheFile = dir.filePath(QStringLiteral("cache"));
+    QVERIFY(QGeoJsonCache::write(cacheFile, fileName, imported));
+    QGeoJsonCache cache;
+    QVERIFY(cache.open(cacheFile, fileName));
+
+    const QGeoRectangle area(QGeoCoordinate(60, 0), QGeoCoordinate(40, 20));
+    qsizetype intersecting = 0;
+    for (qsizetype i = 0; i < cache.featureCount(); ++i) {
+        if (area.intersects(cache.featureBounds(i)))
+            ++intersecting;
+    }
+    QVERIFY(intersecting > 0);
+    QVERIFY(intersecting < cache.featureCount());
+
+    const QVariantList selected = cache.read(area);
+    QCOMPARE(selected.size(), 1);
+    const QVariantList features = selected.first().toMap().value(QStringLiteral("data")).toList();
+    QCOMPARE(features.size(), intersecting);
+
+    // An area without any feature keeps the root
+    const QVariantList none = cache.read(QGeoRectangle(QGeoCoordinate(1, -150),
+                                                       QGeoCoordinate(0, -149)));
+    QCOMPARE(none.size(), 1);
+    QVERIFY(none.first().toMap().value(QStringLiteral("data")).toList().isEmpty());
+}
+
+void tst_QGeoJson::geometryCacheBenchmark_data()
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("import") << false;
+    QTest::newRow("cache") << true;
+}
+
+/*
+    Compares a warm start from the cache, including the validation against
+    the source file, with parsing the source file.
+*/
+void tst_QGeoJson::geometryCacheBenchmark()
+{
+    QFETCH(bool, cached);
+
+    const QString fileName = QFINDTESTDATA("10-countries.json");
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cacheFile = dir.filePath(QStringLiteral("cache"));
+    QGeoJson::importGeoJsonCached(fileName, cacheFile);
+
+    QVariantList modelList;
+    QBENCHMARK {
+        if (cached) {
+            modelList = QGeoJson::importGeoJsonCached(fileName, cacheFile);
+        } else {
+            QFile file(fileName);
+            QVERIFY(file.open(QFile::ReadOnly));
+            modelList = QGeoJson::importGeoJson(&file);
+        }
+    }
+    QCOMPARE(modelList.size(), 1);
+}
+
 QTEST_MAIN(tst_QGeoJson)
 #include "tst_qgeojson.moc"
@@ -0,0 +1,255 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/location/quickmapitems
+
+#include <QtTest/QtTest>
+#include <QtLocation/private/qgeojson_p.h>
+#include <QtLocation/private/qdeclarativegeojsonlayermapitem_p_p.h>
+#include <QtPositioning/private/qwebmercator_p.h>
+
+QT_USE_NAMESPACE
+
+static const char collection[] = R"({
+    "type": "FeatureCollection",
+    "features": [
+        {
+            "type": "Feature",
+            "properties": { "color": "red" },
+            "geometry": {
+                "type": "Polygon",
+                "coordinates": [
+                    [[10, 10], [20, 10], [20, 20], [10, 20], [10, 10]],
+                    [[14, 14], [16, 14], [16, 16], [14, 16], [14, 14]]
+                ]
+            }
+        },
+        {
+            "type": "Feature",
+            "properties": { },
+            "geometry": {
+                "type": "MultiLineString",
+                "coordinates": [
+                    [[30, 0], [30, 10]],
+                    [[35, 0], [35, 10], [36, 12]]
+                ]
+            }
+        },
+        {
+            "type": "Feature",
+            "properties": { "color": "red" },
+            "geometry": { "type": "Point", "coordinates": [-40, 40] }
+        },
+        {
+            "type": "Feature",
+            "properties": { "color": "green" },
+            "geometry": {
+                "type": "Polygon",
+                "coordinates": [[[170, -10], [-170, -10], [-170, 10], [170, 10], [170, -10]]]
+            }
+        }
+    ]
+})";
+
+class tst_QGeoJsonLayer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void flatten();
+    void style();
+    void batches();
+    void featureAt_data();
+    void featureAt();
+    void buildBenchmark_data();
+    void buildBenchmark();
+
+private:
+    std::shared_ptr<const QGeoJsonLayerData> m_data;
+};
+
+static QDoubleVector2D mercator(double latitude, double longitude)
+{
+    return QWebMercator::coordToMercator(QGeoCoordinate(latitude, longitude));
+}
+
+void tst_QGeoJsonLayer::initTestCase()
+{
+    QString errorString;
+    const QVariantList geoJson = QGeoJson::importGeoJson(QByteArray(collection), &errorString);
+    QVERIFY2(!geoJson.isEmpty(), qPrintable(errorString));
+    m_data = QGeoJsonLayerData::create(geoJson, QGeoJsonLayerData::Style());
+}
+
+void tst_QGeoJsonLayer::flatten()
+{
+    QCOMPARE(m_data->features.size(), 4);
+
+    const QGeoJsonLayerFeature &polygon = m_data->features.at(0);
+    QCOMPARE(polygon.item.value(QStringLiteral("type")).toString(), QStringLiteral("Polygon"));
+    QCOMPARE(polygon.shapes.size(), 1);
+    QCOMPARE(polygon.shapes.first().type, QGeoJsonLayerShape::Polygon);
+    QCOMPARE(polygon.shapes.first().paths.size(), 2); // perimeter and hole
+
+    const QGeoJsonLayerFeature &lines = m_data->features.at(1);
+    QCOMPARE(lines.shapes.size(), 2);
+    QCOMPARE(lines.shapes.at(0).type, QGeoJsonLayerShape::Line);
+    QCOMPARE(lines.shapes.at(1).paths.first().size(), 3);
+
+    const QGeoJsonLayerFeature &point = m_data->features.at(2);
+    QCOMPARE(point.shapes.size(), 1);
+    QCOMPARE(point.shapes.first().type, QGeoJsonLayerShape::Circle);
+    QCOMPARE(point.shapes.first().paths.first().size(), QGeoJsonLayerData::CircleSamples);
+
+    // Unwrapped relative to the left bound, across the antimeridian
+    const QGeoJsonLayerFeature &pacific = m_data->features.at(3);
+    QVERIFY(pacific.bounds.left() < 1.0);
+    QVERIFY(pacific.bounds.right() > 1.0);
+    QVERIFY(pacific.bounds.width() < 0.1);
+
+    QVERIFY(m_data->boundingRectangle.contains(QGeoCoordinate(15, 15)));
+    QVERIFY(m_data->boundingRectangle.contains(QGeoCoordinate(40, -40)));
+}
+
+void tst_QGeoJsonLayer::style()
+{
+    // Feature colors override the style
+    QCOMPARE(m_data->features.at(0).shapes.first().color, QColor(Qt::red));
+    QCOMPARE(m_data->features.at(1).shapes.first().color, QColor(Qt::black));
+    QCOMPARE(m_data->features.at(3).shapes.first().color, QColor(Qt::green));
+
+    QGeoJsonLayerData::Style style;
+    style.colorProperty = QString();
+    style.color = Qt::yellow;
+    style.lineColor = Qt::cyan;
+    const std::shared_ptr<const QGeoJsonLayerData> data =
+            QGeoJsonLayerData::create(QGeoJson::importGeoJson(QByteArray(collection)), style);
+    QCOMPARE(data->features.at(0).shapes.first().color, QColor(Qt::yellow));
+    QCOMPARE(data->features.at(1).shapes.first().color, QColor(Qt::cyan));
+    QCOMPARE(data->features.at(2).shapes.first().color, QColor(Qt::yellow));
+}
+
+void tst_QGeoJsonLayer::batches()
+{
+    const std::shared_ptr<const QGeoJsonLayerGeometry> geometry =
+            QGeoJsonLayerGeometry::create(*m_data, 0);
+
+    // The polygon and the point share a batch, being both red
+    QCOMPARE(geometry->fills.size(), 2);
+    QCOMPARE(geometry->fills.at(0).color, QColor(Qt::red));
+    QCOMPARE(geometry->fills.at(1).color, QColor(Qt::green));
+    const QGeoJsonLayerShape &polygon = m_data->features.at(0).shapes.first();
+    const QGeoJsonLayerShape &point = m_data->features.at(2).shapes.first();
+    QCOMPARE(geometry->fills.at(0).vertices.size(),
+             polygon.paths.at(0).size() + polygon.paths.at(1).size() + point.paths.first().size());
+    QVERIFY(!geometry->fills.at(0).indices.isEmpty());
+    QCOMPARE(geometry->fills.at(0).indices.size() % 3, 0);
+    for (const quint32 index : geometry->fills.at(0).indices)
+        QVERIFY(index < quint32(geometry->fills.at(0).vertices.size()));
+
+    // One batch for both lines, six entries per segment
+    QCOMPARE(geometry->lines.size(), 1);
+    QCOMPARE(geometry->lines.first().entries.size(), (1 + 2) * 6);
+
+    // Outlines are closed rings
+    qsizetype outlineSegments = 0;
+    for (const QGeoJsonLayerFeature &feature : m_data->features) {
+        for (const QGeoJsonLayerShape &shape : feature.shapes) {
+            if (shape.type == QGeoJsonLayerShape::Line)
+                continue;
+            for (const QList<QDoubleVector2D> &path : shape.paths)
+                outlineSegments += path.size();
+        }
+    }
+    QCOMPARE(geometry->outlines.entries.size(), outlineSegments * 6);
+
+    QVERIFY(geometry->fills.at(1).maxX > 1.0);
+    QVERIFY(geometry->byteSize() > 0);
+}
+
+void tst_QGeoJsonLayer::featureAt_data()
+{
+    QTest::addColumn<double>("latitude");
+    QTest::addColumn<double>("longitude");
+    QTest::addColumn<qsizetype>("feature");
+
+    QTest::newRow("polygon") << 12.0 << 12.0 << qsizetype(0);
+    QTest::newRow("hole") << 15.0 << 15.0 << qsizetype(-1);
+    QTest::newRow("outside") << 25.0 << 12.0 << qsizetype(-1);
+    QTest::newRow("line") << 5.0 << 30.001 << qsizetype(1);
+    QTest::newRow("second line") << 5.0 << 34.999 << qsizetype(1);
+    QTest::newRow("beside the line") << 5.0 << 31.0 << qsizetype(-1);
+    QTest::newRow("point") << 40.0 << -40.0 << qsizetype(2);
+    QTest::newRow("west of the antimeridian") << 0.0 << 179.0 << qsizetype(3);
+    QTest::newRow("east of the antimeridian") << 0.0 << -179.0 << qsizetype(3);
+}
+
+void tst_QGeoJsonLayer::featureAt()
+{
+    QFETCH(double, latitude);
+    QFETCH(double, longitude);
+    QFETCH(qsizetype, feature);
+
+    const double tolerance = 0.0001; // about 4 km at the equator
+    QCOMPARE(m_data->featureAt(mercator(latitude, longitude), tolerance), feature);
+}
+
+void tst_QGeoJsonLayer::buildBenchmark_data()
+{
+    QTest::addColumn<unsigned int>("lod");
+
+    QTest::newRow("LOD 0") << 0u;
+    QTest::newRow("LOD 2") << 2u;
+}
+
+void tst_QGeoJsonLayer::buildBenchmark()
+{
+    QFETCH(unsigned int, lod);
+
+    QFile file(QFINDTESTDATA("../qgeojson/10-countries.json"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QVariantList geoJson = QGeoJson::importGeoJson(file.readAll());
+    QVERIFY(!geoJson.isEmpty());
+
+    std::shared_ptr<const QGeoJsonLayerGeometry> geometry;
+    QBENCHMARK {
+        const std::shared_ptr<const QGeoJsonLayerData> data =
+                QGeoJsonLayerData::create(geoJson, QGeoJsonLayerData::Style());
+        geometry = QGeoJsonLayerGeometry::create(*data, lod);
+    }
+    QVERIFY(!geometry->fills.isEmpty());
+    // What a MapItemView would instead spread over a QML object and a node per geometry
+    qInfo("%lld fill batches, %lld line batches, %lld bytes of vertices",
+          qlonglong(geometry->fills.size()), qlonglong(geometry->lines.size()),
+          qlonglong(geometry->byteSize()));
+}
+
+QTEST_APPLESS_MAIN(tst_QGeoJsonLayer)
+
+#include "tst_qgeojsonlayer.moc"
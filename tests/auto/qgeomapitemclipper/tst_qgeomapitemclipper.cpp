@@ -0,0 +1,323 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/location/quickmapitems
+
+#include <QtTest/QtTest>
+#include <QtLocation/private/qgeomapitemclipper_p.h>
+#include <QtPositioning/private/qclipperutils_p.h>
+
+#include <algorithm>
+#include <cmath>
+
+QT_USE_NAMESPACE
+
+using Path = QList<QDoubleVector2D>;
+
+class tst_QGeoMapItemClipper : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void convexity();
+    void contains_data();
+    void contains();
+    void clipPolygon_data();
+    void clipPolygon();
+    void clipPolygons();
+    void clipLine_data();
+    void clipLine();
+    void benchmarkClipPolygon_data();
+    void benchmarkClipPolygon();
+};
+
+// The projectable region of an untilted camera, of a tilted one (wound the other
+// way), and a region that is not convex.
+static const Path regions[] = {
+    { QDoubleVector2D(-1.0, 1.0), QDoubleVector2D(2.0, 1.0),
+      QDoubleVector2D(2.0, 0.0), QDoubleVector2D(-1.0, 0.0) },
+    { QDoubleVector2D(0.2, 0.6), QDoubleVector2D(0.8, 0.6),
+      QDoubleVector2D(0.6, 0.2), QDoubleVector2D(0.4, 0.2) },
+    { QDoubleVector2D(0.2, 0.2), QDoubleVector2D(0.8, 0.2), QDoubleVector2D(0.8, 0.8),
+      QDoubleVector2D(0.5, 0.4), QDoubleVector2D(0.2, 0.8) },
+    { }
+};
+
+// A star with the given number of branches, concave for more than two
+static Path star(const QDoubleVector2D &center, double radius, int branches, double rotation = 0.0)
+{
+    Path path;
+    for (int i = 0; i < 2 * branches; ++i) {
+        const double angle = rotation + M_PI * i / branches;
+        const double r = (i % 2) ? radius * 0.4 : radius;
+        path << center + QDoubleVector2D(std::cos(angle), std::sin(angle)) * r;
+    }
+    return path;
+}
+
+static double signedArea(const Path &path)
+{
+    double area = 0.0;
+    for (qsizetype i = 0; i < path.size(); ++i) {
+        const QDoubleVector2D &a = path.at(i);
+        const QDoubleVector2D &b = path.at((i + 1) % path.size());
+        area += a.x() * b.y() - b.x() * a.y();
+    }
+    return area * 0.5;
+}
+
+// The area of the even-odd fill of paths that do not overlap, or are holes of
+// each other, as both QClipperUtils and QGeoMapItemClipper produce.
+static double area(const QList<Path> &paths)
+{
+    double result = 0.0;
+    for (const Path &path : paths)
+        result += signedArea(path);
+    return qAbs(result);
+}
+
+static double length(const QList<Path> &paths)
+{
+    double result = 0.0;
+    for (const Path &path : paths) {
+        for (qsizetype i = 1; i < path.size(); ++i)
+            result += (path.at(i) - path.at(i - 1)).length();
+    }
+    return result;
+}
+
+void tst_QGeoMapItemClipper::convexity()
+{
+    QVERIFY(QGeoMapItemClipper(regions[0]).isConvex());
+    QVERIFY(QGeoMapItemClipper(regions[1]).isConvex());
+    QVERIFY(!QGeoMapItemClipper(regions[2]).isConvex());
+    QVERIFY(!QGeoMapItemClipper(regions[3]).isConvex());
+
+    // Closed, and with collinear points, as QClipperUtils may return regions
+    Path closed = regions[1];
+    closed.insert(1, QDoubleVector2D(0.5, 0.6));
+    closed << closed.first();
+    QVERIFY(QGeoMapItemClipper(closed).isConvex());
+}
+
+void tst_QGeoMapItemClipper::contains_data()
+{
+    QTest::addColumn<int>("region");
+    QTest::addColumn<double>("minimumX");
+    QTest::addColumn<double>("minimumY");
+    QTest::addColumn<double>("maximumX");
+    QTest::addColumn<double>("maximumY");
+    QTest::addColumn<int>("containment");
+
+    QTest::newRow("whole map") << 0 << 0.0 << 0.0 << 1.0 << 1.0 << int(QGeoMapItemClipper::Inside);
+    QTest::newRow("wrapped") << 0 << 0.8 << 0.3 << 1.3 << 0.4 << int(QGeoMapItemClipper::Inside);
+    QTest::newRow("beyond the pole") << 0 << 0.2 << -0.1 << 0.3 << 0.4 << int(QGeoMapItemClipper::Intersecting);
+    QTest::newRow("inside") << 1 << 0.45 << 0.3 << 0.55 << 0.5 << int(QGeoMapItemClipper::Inside);
+    QTest::newRow("corner outside") << 1 << 0.3 << 0.3 << 0.55 << 0.5 << int(QGeoMapItemClipper::Intersecting);
+    QTest::newRow("disjoint") << 1 << 0.9 << 0.9 << 1.0 << 1.0 << int(QGeoMapItemClipper::Outside);
+    QTest::newRow("outside an edge") << 1 << 0.1 << 0.2 << 0.25 << 0.3 << int(QGeoMapItemClipper::Outside);
+    QTest::newRow("empty path") << 1 << qInf() << qInf() << -qInf() << -qInf() << int(QGeoMapItemClipper::Outside);
+    QTest::newRow("not convex") << 2 << 0.4 << 0.3 << 0.6 << 0.35 << int(QGeoMapItemClipper::Intersecting);
+    QTest::newRow("not convex, disjoint") << 2 << 0.9 << 0.9 << 1.0 << 1.0 << int(QGeoMapItemClipper::Outside);
+    QTest::newRow("no region") << 3 << 0.4 << 0.4 << 0.5 << 0.5 << int(QGeoMapItemClipper::Inside);
+}
+
+void tst_QGeoMapItemClipper::contains()
+{
+    QFETCH(int, region);
+    QFETCH(double, minimumX);
+    QFETCH(double, minimumY);
+    QFETCH(double, maximumX);
+    QFETCH(double, maximumY);
+    QFETCH(int, containment);
+
+    const QGeoMapItemClipper clipper(regions[region]);
+    QCOMPARE(int(clipper.contains(QDoubleVector2D(minimumX, minimumY),
+                                  QDoubleVector2D(maximumX, maximumY))),
+             containment);
+}
+
+void tst_QGeoMapItemClipper::clipPolygon_data()
+{
+    QTest::addColumn<int>("region");
+    QTest::addColumn<double>("centerX");
+    QTest::addColumn<double>("centerY");
+    QTest::addColumn<double>("radius");
+    QTest::addColumn<int>("branches");
+
+    QTest::newRow("inside") << 1 << 0.5 << 0.4 << 0.05 << 5;
+    QTest::newRow("outside") << 1 << 0.9 << 0.9 << 0.05 << 5;
+    QTest::newRow("triangle across an edge") << 1 << 0.5 << 0.6 << 0.1 << 3;
+    QTest::newRow("star across a corner") << 1 << 0.62 << 0.22 << 0.12 << 7;
+    QTest::newRow("star around the region") << 1 << 0.5 << 0.4 << 0.5 << 9;
+    QTest::newRow("star beyond the pole") << 0 << 0.5 << 0.0 << 0.3 << 6;
+    QTest::newRow("star, region not convex") << 2 << 0.5 << 0.5 << 0.3 << 6;
+}
+
+void tst_QGeoMapItemClipper::clipPolygon()
+{
+    QFETCH(int, region);
+    QFETCH(double, centerX);
+    QFETCH(double, centerY);
+    QFETCH(double, radius);
+    QFETCH(int, branches);
+
+    // Both windings
+    for (bool reversed : { false, true }) {
+        Path path = star(QDoubleVector2D(centerX, centerY), radius, branches, 0.1);
+        if (reversed)
+            std::reverse(path.begin(), path.end());
+
+        QClipperUtils reference;
+        reference.addSubjectPath(path, true);
+        reference.addClipPolygon(regions[region]);
+        const QList<Path> expected = reference.execute(QClipperUtils::Intersection,
+                                                       QClipperUtils::pftEvenOdd,
+                                                       QClipperUtils::pftEvenOdd);
+
+        const QList<Path> clipped = QGeoMapItemClipper(regions[region]).clipPolygon(path);
+        QCOMPARE(clipped.isEmpty(), expected.isEmpty());
+        QVERIFY2(qAbs(area(clipped) - area(expected)) <= 1e-9,
+                 qPrintable(QStringLiteral("area %1 instead of %2").arg(area(clipped)).arg(area(expected))));
+
+    }
+}
+
+void tst_QGeoMapItemClipper::clipPolygons()
+{
+    // A rectangle with a hole, as MapCircle clips it with an inverted fill. The
+    // hole is wound the other way, for area() to measure the even-odd fill.
+    const Path outer = { QDoubleVector2D(0.0, 0.0), QDoubleVector2D(1.0, 0.0),
+                         QDoubleVector2D(1.0, 1.0), QDoubleVector2D(0.0, 1.0) };
+    Path hole = star(QDoubleVector2D(0.55, 0.45), 0.1, 8);
+    std::reverse(hole.begin(), hole.end());
+    const QList<Path> paths = { outer, hole };
+
+    for (const Path &region : { regions[1], regions[2] }) {
+        QClipperUtils reference;
+        for (const Path &path : paths)
+            reference.addSubjectPath(path, true);
+        reference.addClipPolygon(region);
+        const QList<Path> expected = reference.execute(QClipperUtils::Intersection,
+                                                       QClipperUtils::pftEvenOdd,
+                                                       QClipperUtils::pftEvenOdd);
+
+        const QList<Path> clipped = QGeoMapItemClipper(region).clipPolygons(paths);
+        QVERIFY(!clipped.isEmpty());
+        QVERIFY2(qAbs(area(clipped) - area(expected)) <= 1e-9,
+                 qPrintable(QStringLiteral("area %1 instead of %2").arg(area(clipped)).arg(area(expected))));
+    }
+}
+
+static const Path lines[] = {
+    { QDoubleVector2D(0.45, 0.3), QDoubleVector2D(0.5, 0.5), QDoubleVector2D(0.55, 0.3) },
+    { QDoubleVector2D(0.0, 0.0), QDoubleVector2D(0.1, 0.9), QDoubleVector2D(0.0, 1.0) },
+    { QDoubleVector2D(0.0, 0.4), QDoubleVector2D(1.0, 0.4) },
+    { QDoubleVector2D(0.5, 0.4), QDoubleVector2D(0.5, 0.9), QDoubleVector2D(0.55, 0.9),
+      QDoubleVector2D(0.55, 0.3) },
+    { QDoubleVector2D(0.3, 0.1), QDoubleVector2D(0.4, 0.7), QDoubleVector2D(0.5, 0.1),
+      QDoubleVector2D(0.6, 0.7), QDoubleVector2D(0.7, 0.1) },
+    { QDoubleVector2D(0.1, 0.6), QDoubleVector2D(0.5, 0.6), QDoubleVector2D(0.9, 0.6) }
+};
+
+void tst_QGeoMapItemClipper::clipLine_data()
+{
+    QTest::addColumn<int>("region");
+    QTest::addColumn<int>("line");
+    QTest::addColumn<int>("parts");
+
+    QTest::newRow("inside") << 1 << 0 << 1;
+    QTest::newRow("outside") << 1 << 1 << 0;
+    QTest::newRow("through") << 1 << 2 << 1;
+    QTest::newRow("in and out") << 1 << 3 << 2;
+    QTest::newRow("zigzag") << 1 << 4 << 4;
+    QTest::newRow("not convex") << 2 << 5 << 2;
+}
+
+void tst_QGeoMapItemClipper::clipLine()
+{
+    QFETCH(int, region);
+    QFETCH(int, line);
+    QFETCH(int, parts);
+
+    const Path &path = lines[line];
+    const QList<Path> clipped = QGeoMapItemClipper(regions[region]).clipLine(path);
+    QCOMPARE(clipped.size(), qsizetype(parts));
+
+    // The clipped length matches the length of the path inside the region,
+    // measured by sampling each segment.
+    const int samples = 100000;
+    double expectedLength = 0.0;
+    for (qsizetype i = 1; i < path.size(); ++i) {
+        const QDoubleVector2D segment = path.at(i) - path.at(i - 1);
+        int inside = 0;
+        for (int s = 0; s < samples; ++s) {
+            const QDoubleVector2D point = path.at(i - 1) + segment * ((s + 0.5) / samples);
+            if (QClipperUtils::pointInPolygon(point, regions[region]) != 0)
+                ++inside;
+        }
+        expectedLength += segment.length() * inside / samples;
+    }
+    QVERIFY2(qAbs(length(clipped) - expectedLength) <= 1e-4,
+             qPrintable(QStringLiteral("length %1 instead of %2").arg(length(clipped)).arg(expectedLength)));
+}
+
+void tst_QGeoMapItemClipper::benchmarkClipPolygon_data()
+{
+    QTest::addColumn<bool>("convex");
+
+    QTest::newRow("QClipperUtils") << false;
+    QTest::newRow("QGeoMapItemClipper") << true;
+}
+
+void tst_QGeoMapItemClipper::benchmarkClipPolygon()
+{
+    QFETCH(bool, convex);
+
+    const Path path = star(QDoubleVector2D(0.62, 0.22), 0.12, 5000);
+    QList<Path> clipped;
+    if (convex) {
+        const QGeoMapItemClipper clipper(regions[1]);
+        QBENCHMARK {
+            clipped = clipper.clipPolygon(path);
+        }
+    } else {
+        QBENCHMARK {
+            QClipperUtils clipper;
+            clipper.addSubjectPath(path, true);
+            clipper.addClipPolygon(regions[1]);
+            clipped = clipper.execute(QClipperUtils::Intersection, QClipperUtils::pftEvenOdd,
+                                      QClipperUtils::pftEvenOdd);
+        }
+    }
+    QVERIFY(!clipped.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_QGeoMapItemClipper)
+#include "tst_qgeomapitemclipper.moc"
@@ -0,0 +1,349 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/location/quickmapitems
+
+#include <QtTest/QtTest>
+#include <QtQuick/QSGGeometry>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/private/qgeomap_p.h>
+#include <QtLocation/private/qgeomappingmanager_p.h>
+#include <QtLocation/private/qgeomapitemgeometry_p.h>
+#include <QtLocation/private/qdeclarativepolygonmapitem_p_p.h>
+#include <QtPositioning/QGeoPolygon>
+#include <QtPositioning/private/qwebmercator_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoMapItemGeometry : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void reserveGeometry();
+    void commitGeometry();
+    void fillPolygon_data();
+    void fillPolygon();
+    void mercatorPath();
+    void triangulationCache();
+    void emptyTriangulation();
+    void asyncTriangulation();
+    void triangulationHoles();
+
+private:
+    static double triangulatedArea(const QGeoMapPolygonGeometryOpenGL &geometry);
+
+    std::unique_ptr<QGeoServiceProvider> m_provider;
+    std::unique_ptr<QGeoMap> m_map;
+};
+
+void tst_QGeoMapItemGeometry::initTestCase()
+{
+#if QT_CONFIG(library)
+    // Set custom path since CI doesn't install test plugins
+#ifdef Q_OS_WIN
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../../plugins"));
+#else
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../plugins"));
+#endif
+#endif
+    QVariantMap parameters;
+    parameters["tileSize"] = 256;
+    parameters["maxZoomLevel"] = 8;
+    m_provider.reset(new QGeoServiceProvider("qmlgeo.test.plugin", parameters));
+    m_provider->setAllowExperimental(true);
+    QGeoMappingManager *mappingManager = m_provider->mappingManager();
+    QVERIFY2(m_provider->error() == QGeoServiceProvider::NoError,
+             "Could not load plugin: " + m_provider->errorString().toLatin1());
+    m_map.reset(mappingManager->createMap(this));
+    QVERIFY(m_map);
+    m_map->setViewportSize(QSize(256, 256));
+}
+
+double tst_QGeoMapItemGeometry::triangulatedArea(const QGeoMapPolygonGeometryOpenGL &geometry)
+{
+    double area = 0.0;
+    const QList<QDeclarativeGeoMapItemUtils::vec2> &v = geometry.m_screenVertices;
+    const QList<quint32> &ix = geometry.m_screenIndices;
+    for (qsizetype i = 0; i + 2 < ix.size(); i += 3) {
+        const auto &a = v.at(ix.at(i));
+        const auto &b = v.at(ix.at(i + 1));
+        const auto &c = v.at(ix.at(i + 2));
+        area += std::abs(double(b.x - a.x) * double(c.y - a.y)
+                         - double(c.x - a.x) * double(b.y - a.y)) / 2.0;
+    }
+    return area;
+}
+
+void tst_QGeoMapItemGeometry::reserveGeometry()
+{
+    QSGGeometry geometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+
+    QVERIFY(QGeoMapItemGeometry::reserveGeometry(&geometry, 100));
+    QCOMPARE(geometry.vertexCount(), 100);
+    QCOMPARE(geometry.indexCount(), 0);
+
+    // The same counts keep the storage
+    const void *data = geometry.vertexData();
+    QVERIFY(!QGeoMapItemGeometry::reserveGeometry(&geometry, 100));
+    QVERIFY(geometry.vertexData() == data);
+
+    // Other counts reallocate, the geometry always reports the used counts
+    QVERIFY(QGeoMapItemGeometry::reserveGeometry(&geometry, 40));
+    QCOMPARE(geometry.vertexCount(), 40);
+    QVERIFY(QGeoMapItemGeometry::reserveGeometry(&geometry, 0));
+    QCOMPARE(geometry.vertexCount(), 0);
+}
+
+void tst_QGeoMapItemGeometry::commitGeometry()
+{
+    QSGGeometry geometry(QSGGeometry::defaultAttributes_Point2D(), 0, 0, QSGGeometry::UnsignedIntType);
+    QGeoMapItemGeometry::reserveGeometry(&geometry, 4, 6);
+    QCOMPARE(geometry.vertexCount(), 4);
+    QCOMPARE(geometry.indexCount(), 6);
+    QCOMPARE(geometry.vertexDataPattern(), QSGGeometry::StaticPattern);
+    QCOMPARE(geometry.indexDataPattern(), QSGGeometry::StaticPattern);
+
+    QSGGeometry::Point2D *vertices = geometry.vertexDataAsPoint2D();
+    vertices[0].set(0, 0);
+    vertices[1].set(1, 0);
+    vertices[2].set(1, 1);
+    vertices[3].set(0, 1);
+    const quint32 indices[] = { 0, 1, 2, 0, 2, 3 };
+    memcpy(geometry.indexDataAsUInt(), indices, sizeof(indices));
+    QGeoMapItemGeometry::commitGeometry(&geometry, 4, 6);
+
+    QCOMPARE(geometry.vertexDataAsPoint2D()[3].y, 1.0f);
+    QCOMPARE(geometry.indexDataAsUInt()[5], 3u);
+}
+
+void tst_QGeoMapItemGeometry::fillPolygon_data()
+{
+    QTest::addColumn<int>("vertexCount");
+    QTest::addColumn<bool>("changingSize");
+    QTest::newRow("small") << 64 << false;
+    QTest::newRow("small, changing size") << 64 << true;
+    QTest::newRow("large") << 65536 << false;
+    QTest::newRow("large, changing size") << 65536 << true;
+}
+
+void tst_QGeoMapItemGeometry::fillPolygon()
+{
+    QFETCH(int, vertexCount);
+    QFETCH(bool, changingSize);
+
+    // A fan, changing size by a few vertices at every update if clipped, like a polygon
+    // moved across the edge of the map does
+    QGeoMapPolygonGeometryOpenGL polygon;
+    QList<QDeclarativeGeoMapItemUtils::vec2> vertices;
+    QList<quint32> indices;
+    for (int i = 0; i < vertexCount; ++i) {
+        const double angle = 2.0 * M_PI * i / vertexCount;
+        vertices << QDoubleVector2D(0.5 + 0.1 * std::cos(angle), 0.5 + 0.1 * std::sin(angle));
+    }
+    for (int i = 1; i + 1 < vertexCount; ++i)
+        indices << 0 << i << i + 1;
+
+    QSGGeometry geometry(QSGGeometry::defaultAttributes_Point2D(), 0, 0, QSGGeometry::UnsignedIntType);
+    int fills = 0;
+    int allocations = 0;
+    quint64 bytesWritten = 0;
+    QBENCHMARK {
+        const int removed = changingSize ? fills % 8 : 0;
+        ++fills;
+        polygon.m_screenVertices = vertices.mid(0, vertexCount - removed);
+        polygon.m_screenIndices = indices.mid(0, indices.size() - 3 * removed);
+        const void *data = geometry.vertexData();
+        polygon.allocateAndFillPolygon(&geometry);
+        if (geometry.vertexData() != data)
+            ++allocations;
+        bytesWritten += quint64(geometry.vertexCount()) * geometry.sizeOfVertex()
+                + quint64(geometry.indexCount()) * geometry.sizeOfIndex();
+    }
+
+    qInfo("%d fills, %d allocations, %llu bytes written per fill", fills, allocations,
+          bytesWritten / quint64(fills));
+    QCOMPARE(geometry.vertexCount(), int(polygon.m_screenVertices.size()));
+    QCOMPARE(geometry.indexCount(), int(polygon.m_screenIndices.size()));
+    if (!changingSize)
+        QCOMPARE(allocations, 1);
+}
+
+void tst_QGeoMapItemGeometry::mercatorPath()
+{
+    const QList<QGeoCoordinate> path = { QGeoCoordinate(10, 170), QGeoCoordinate(20, -170),
+                                         QGeoCoordinate(-5, 175) };
+    const QGeoPath geoPath(path);
+
+    QGeoMapItemMercatorPath mercatorPath;
+    QVERIFY(mercatorPath.isEmpty());
+    mercatorPath.setPath(path, geoPath.boundingGeoRectangle());
+    QCOMPARE(mercatorPath.path().size(), path.size());
+    for (qsizetype i = 0; i < path.size(); ++i)
+        QCOMPARE(mercatorPath.path().at(i), QWebMercator::coordToMercator(path.at(i)));
+    QCOMPARE(mercatorPath.geoLeftBound(), geoPath.boundingGeoRectangle().topLeft());
+
+    const QGeoCoordinate appended(30, -160);
+    QGeoPath longerPath = geoPath;
+    longerPath.addCoordinate(appended);
+    mercatorPath.append(appended, longerPath.boundingGeoRectangle());
+    QCOMPARE(mercatorPath.path().size(), path.size() + 1);
+    QCOMPARE(mercatorPath.path().last(), QWebMercator::coordToMercator(appended));
+    QCOMPARE(mercatorPath.geoBounds(), longerPath.boundingGeoRectangle());
+
+    mercatorPath.clear();
+    QVERIFY(mercatorPath.isEmpty());
+}
+
+void tst_QGeoMapItemGeometry::triangulationCache()
+{
+    const QGeoPolygon polygon({ QGeoCoordinate(0, 0), QGeoCoordinate(0, 10),
+                                QGeoCoordinate(10, 10), QGeoCoordinate(10, 0) });
+    QGeoMapPolygonGeometryOpenGL geometry;
+    geometry.setPreserveGeometry(true, polygon.boundingGeoRectangle().topLeft());
+    geometry.markSourceChanged();
+    geometry.updateSourcePoints(*m_map, polygon);
+    QVERIFY(geometry.isTriangulated());
+    QCOMPARE(geometry.m_screenIndices.size(), 6);
+    const quint64 serial = geometry.triangulationSerial();
+
+    // Camera changes only mark the source dirty, the triangulation is kept
+    geometry.markSourceDirty();
+    geometry.updateSourcePoints(*m_map, polygon);
+    QCOMPARE(geometry.triangulationSerial(), serial);
+    QCOMPARE(geometry.m_screenIndices.size(), 6);
+
+    // A new source, or a new left bound, is triangulated again
+    const QGeoPolygon triangle({ QGeoCoordinate(0, 0), QGeoCoordinate(0, 10),
+                                 QGeoCoordinate(10, 10) });
+    geometry.markSourceChanged();
+    geometry.updateSourcePoints(*m_map, triangle);
+    QVERIFY(geometry.triangulationSerial() != serial);
+    QCOMPARE(geometry.m_screenIndices.size(), 3);
+
+    const quint64 triangleSerial = geometry.triangulationSerial();
+    geometry.setPreserveGeometry(true, QGeoCoordinate(10, 5));
+    geometry.markSourceDirty();
+    geometry.updateSourcePoints(*m_map, triangle);
+    QVERIFY(geometry.triangulationSerial() != triangleSerial);
+}
+
+void tst_QGeoMapItemGeometry::emptyTriangulation()
+{
+    // Collinear vertices have no triangles
+    const QGeoPolygon polygon({ QGeoCoordinate(0, 0), QGeoCoordinate(0, 5),
+                                QGeoCoordinate(0, 10) });
+    QGeoMapPolygonGeometryOpenGL geometry;
+    geometry.setPreserveGeometry(true, polygon.boundingGeoRectangle().topLeft());
+    geometry.markSourceChanged();
+    geometry.updateSourcePoints(*m_map, polygon);
+    QVERIFY(geometry.isTriangulated());
+    QVERIFY(geometry.m_screenIndices.isEmpty());
+    const quint64 serial = geometry.triangulationSerial();
+
+    geometry.markSourceDirty();
+    geometry.updateSourcePoints(*m_map, polygon);
+    QVERIFY(geometry.isTriangulated());
+    QCOMPARE(geometry.triangulationSerial(), serial);
+}
+
+void tst_QGeoMapItemGeometry::asyncTriangulation()
+{
+    QGeoPolygon polygon;
+    for (int i = 0; i < QGeoMapPolygonGeometryOpenGL::AsyncTriangulationThreshold; ++i) {
+        const double angle = 2.0 * M_PI * i / QGeoMapPolygonGeometryOpenGL::AsyncTriangulationThreshold;
+        polygon.addCoordinate(QGeoCoordinate(10 * std::sin(angle), 10 * std::cos(angle)));
+    }
+    QGeoMapPolygonGeometryOpenGL geometry;
+    geometry.setAsyncTriangulation(true);
+    geometry.setPreserveGeometry(true, polygon.boundingGeoRectangle().topLeft());
+    geometry.markSourceChanged();
+    geometry.updateSourcePoints(*m_map, polygon);
+    QVERIFY(geometry.isTriangulationPending());
+    QVERIFY(!geometry.isTriangulated());
+    const quint64 serial = geometry.triangulationSerial();
+
+    // Polishing again while pending doesn't start over
+    geometry.markSourceDirty();
+    geometry.updateSourcePoints(*m_map, polygon);
+    QVERIFY(geometry.isTriangulationPending());
+    QCOMPARE(geometry.triangulationSerial(), serial);
+
+    QGeoMapPolygonTriangulator triangulator(geometry.wrappedPaths(), serial);
+    triangulator.run();
+    QList<QDeclarativeGeoMapItemUtils::vec2> vertices = triangulator.m_screenVertices;
+    QList<quint32> indices = triangulator.m_screenIndices;
+    QVERIFY(!geometry.setTriangulation(serial - 1, std::move(vertices), std::move(indices)));
+    QVERIFY(geometry.isTriangulationPending());
+    QVERIFY(geometry.setTriangulation(serial, std::move(triangulator.m_screenVertices),
+                                      std::move(triangulator.m_screenIndices)));
+    QVERIFY(geometry.isTriangulated());
+    QVERIFY(!geometry.isTriangulationPending());
+    QCOMPARE(geometry.m_screenVertices.size(), polygon.perimeter().size());
+    QCOMPARE(geometry.m_screenIndices.size(), 3 * (polygon.perimeter().size() - 2));
+}
+
+void tst_QGeoMapItemGeometry::triangulationHoles()
+{
+    QGeoPolygon polygon({ QGeoCoordinate(0, 0), QGeoCoordinate(0, 10),
+                          QGeoCoordinate(10, 10), QGeoCoordinate(10, 0) });
+    const QList<QGeoCoordinate> hole = { QGeoCoordinate(4, 4), QGeoCoordinate(4, 6),
+                                         QGeoCoordinate(6, 6), QGeoCoordinate(6, 4) };
+    QGeoMapPolygonGeometryOpenGL geometry;
+    geometry.setPreserveGeometry(true, polygon.boundingGeoRectangle().topLeft());
+    geometry.markSourceChanged();
+    geometry.updateSourcePoints(*m_map, polygon);
+    const double area = triangulatedArea(geometry);
+
+    polygon.addHole(hole);
+    geometry.markSourceChanged();
+    geometry.updateSourcePoints(*m_map, polygon);
+    QVERIFY(geometry.isTriangulated());
+    QCOMPARE(geometry.m_screenVertices.size(), 8);
+    // Hole vertices follow the perimeter ones
+    for (qsizetype i = 0; i < hole.size(); ++i) {
+        const QDoubleVector2D expected = QWebMercator::coordToMercator(hole.at(i));
+        QVERIFY(qAbs(geometry.m_screenVertices.at(4 + i).x - expected.x()) < 1e-6);
+        QVERIFY(qAbs(geometry.m_screenVertices.at(4 + i).y - expected.y()) < 1e-6);
+    }
+
+    // The triangles cover the perimeter without the hole
+    const QDoubleVector2D holeCorner = QWebMercator::coordToMercator(hole.at(0));
+    const QDoubleVector2D holeOppositeCorner = QWebMercator::coordToMercator(hole.at(2));
+    const double holeArea = qAbs((holeOppositeCorner.x() - holeCorner.x())
+                                 * (holeOppositeCorner.y() - holeCorner.y()));
+    QVERIFY(holeArea > 0.0);
+    QVERIFY(qAbs(triangulatedArea(geometry) - (area - holeArea)) < 1e-4 * area);
+}
+
+QTEST_MAIN(tst_QGeoMapItemGeometry)
+
+#include "tst_qgeomapitemgeometry.moc"
@@ -0,0 +1,226 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/location/maps
+
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoManeuver>
+#include <QtLocation/private/qgeopolylinedecoder_p.h>
+#include <QtLocation/private/qgeorouteparserosrmv5_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoPolylineDecoder : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void decodePolyline5();
+    void decodePolyline6();
+    void decodeSequence();
+    void parseOsrmV5();
+    void parseOsrmV5Async();
+    void benchmarkDecode();
+    void benchmarkParseOsrmV5();
+
+private:
+    QByteArray m_reply;
+    QList<QByteArray> m_geometries;
+};
+
+void tst_QGeoPolylineDecoder::initTestCase()
+{
+    // A synthetic, but OSRM v5 shaped, reply with 2 routes of 3 legs of 41 steps
+    QFile file(QStringLiteral(":/route_osrmv5.json"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    m_reply = file.readAll();
+
+    const QJsonArray routes = QJsonDocument::fromJson(m_reply).object().value(QLatin1String("routes")).toArray();
+    for (const QJsonValue &route : routes) {
+        const QJsonArray legs = route.toObject().value(QLatin1String("legs")).toArray();
+        for (const QJsonValue &leg : legs) {
+            const QJsonArray steps = leg.toObject().value(QLatin1String("steps")).toArray();
+            for (const QJsonValue &step : steps)
+                m_geometries << step.toObject().value(QLatin1String("geometry")).toString().toLatin1();
+        }
+    }
+    QCOMPARE(m_geometries.size(), 2 * 3 * 41);
+}
+
+void tst_QGeoPolylineDecoder::decodePolyline5()
+{
+    // The example of the encoded polyline algorithm documentation
+    const QByteArray polyline("_p~iF~ps|U_ulLnnqC_mqNvxq`@");
+    QCOMPARE(QGeoPolylineDecoder::pointCount(polyline), 3);
+
+    const QList<QGeoCoordinate> path =
+            QGeoPolylineDecoder::decodeCoordinates(polyline, QGeoPolylineDecoder::Polyline5);
+    QCOMPARE(path.size(), 3);
+    QCOMPARE(path.at(0), QGeoCoordinate(38.5, -120.2));
+    QCOMPARE(path.at(1), QGeoCoordinate(40.7, -120.95));
+    QCOMPARE(path.at(2), QGeoCoordinate(43.252, -126.453));
+}
+
+void tst_QGeoPolylineDecoder::decodePolyline6()
+{
+    // Same points as above, with 6 decimals
+    const QByteArray polyline("_izlhA~rlgdF_{geC~ywl@_kwzCn`{nI");
+    const QList<QGeoCoordinate> path =
+            QGeoPolylineDecoder::decodeCoordinates(polyline, QGeoPolylineDecoder::Polyline6);
+    QCOMPARE(path.size(), 3);
+    QCOMPARE(path.at(0), QGeoCoordinate(38.5, -120.2));
+    QCOMPARE(path.at(1), QGeoCoordinate(40.7, -120.95));
+    QCOMPARE(path.at(2), QGeoCoordinate(43.252, -126.453));
+
+    QVERIFY(QGeoPolylineDecoder::decodeCoordinates(QByteArray()).isEmpty());
+}
+
+void tst_QGeoPolylineDecoder::decodeSequence()
+{
+    // Every polyline restarts from 0, 0 and is appended to the buffer
+    QGeoPolylineDecoder decoder(QGeoPolylineDecoder::Polyline5);
+    QCOMPARE(decoder.decode("_p~iF~ps|U_ulLnnqC_mqNvxq`@"), 3);
+    QCOMPARE(decoder.decode("_p~iF~ps|U"), 1);
+    QCOMPARE(decoder.size(), 4);
+    QCOMPARE(decoder.at(3), QGeoCoordinate(38.5, -120.2));
+
+    const QList<QGeoCoordinate> slice = decoder.coordinates(2, 2);
+    QCOMPARE(slice.size(), 2);
+    QCOMPARE(slice.at(0), QGeoCoordinate(43.252, -126.453));
+    QCOMPARE(decoder.coordinates(3).size(), 1);
+    QVERIFY(decoder.coordinates(4).isEmpty());
+
+    decoder.clear();
+    QVERIFY(decoder.isEmpty());
+}
+
+void tst_QGeoPolylineDecoder::parseOsrmV5()
+{
+    QGeoRouteParserOsrmV5 parser;
+    QList<QGeoRoute> routes;
+    QString errorString;
+    QCOMPARE(parser.parseReply(routes, errorString, m_reply), QGeoRouteReply::NoError);
+    QCOMPARE(routes.size(), 2);
+
+    // Route and leg paths are the concatenation of the step paths
+    const QGeoRoute &route = routes.first();
+    QCOMPARE(route.routeLegs().size(), 3);
+    qsizetype legPoints = 0;
+    for (const QGeoRoute &leg : route.routeLegs())
+        legPoints += leg.path().size();
+    QCOMPARE(route.path().size(), legPoints);
+
+    qsizetype segmentPoints = 0;
+    for (QGeoRouteSegment segment = route.firstRouteSegment(); segment.isValid();
+         segment = segment.nextRouteSegment()) {
+        segmentPoints += segment.path().size();
+    }
+    QCOMPARE(segmentPoints, legPoints);
+
+    const QList<QGeoCoordinate> firstStep = QGeoPolylineDecoder::decodeCoordinates(m_geometries.first());
+    QCOMPARE(route.firstRouteSegment().path(), firstStep);
+    QCOMPARE(route.path().first(), firstStep.first());
+}
+
+void tst_QGeoPolylineDecoder::parseOsrmV5Async()
+{
+    // U-turns are the maneuvers whose direction depends on the traffic side
+    const QByteArray reply = QByteArray(m_reply).replace("\"modifier\":\"right\"", "\"modifier\":\"uturn\"");
+    const QGeoRouteRequest request(QGeoCoordinate(12.12, 23.23), QGeoCoordinate(34.34, 89.32));
+
+    QGeoRouteParserOsrmV5 parser;
+    parser.setTrafficSide(QGeoRouteParser::LeftHandTraffic);
+    QList<QGeoRoute> routes;
+    QString errorString;
+    QCOMPARE(parser.parseReply(routes, errorString, reply), QGeoRouteReply::NoError);
+    for (QGeoRoute &route : routes) {
+        route.setRequest(request);
+        for (QGeoRoute &leg : route.routeLegs())
+            leg.setRequest(request);
+    }
+    QCOMPARE(routes.first().firstRouteSegment().nextRouteSegment().maneuver().direction(),
+             QGeoManeuver::DirectionUTurnRight);
+
+    // The task keeps the settings the parser had when it was created
+    QGeoRouteParseTask *task = parser.parseReplyAsync(reply, request);
+    parser.setTrafficSide(QGeoRouteParser::RightHandTraffic);
+    QList<QGeoRoute> asyncRoutes;
+    QGeoRouteReply::Error asyncError = QGeoRouteReply::UnknownError;
+    connect(task, &QGeoRouteParseTask::finished, this, [&]() {
+        asyncRoutes = task->routes();
+        asyncError = task->error();
+    });
+    QSignalSpy finishedSpy(task, &QGeoRouteParseTask::finished);
+    QTRY_COMPARE(finishedSpy.size(), 1);
+    QCOMPARE(asyncError, QGeoRouteReply::NoError);
+    QCOMPARE(asyncRoutes.size(), routes.size());
+    QCOMPARE(asyncRoutes, routes);
+
+    // Aborted tasks don't finish
+    task = parser.parseReplyAsync(reply, request);
+    QSignalSpy abortedSpy(task, &QGeoRouteParseTask::finished);
+    QSignalSpy destroyedSpy(task, &QObject::destroyed);
+    task->abort();
+    QTRY_COMPARE(destroyedSpy.size(), 1);
+    QCOMPARE(abortedSpy.size(), 0);
+}
+
+void tst_QGeoPolylineDecoder::benchmarkDecode()
+{
+    QGeoPolylineDecoder decoder;
+    QBENCHMARK {
+        decoder.clear();
+        for (const QByteArray &geometry : qAsConst(m_geometries))
+            decoder.decode(geometry);
+    }
+    QCOMPARE(decoder.size(), 2 * 3 * (40 * 61 + 2));
+}
+
+void tst_QGeoPolylineDecoder::benchmarkParseOsrmV5()
+{
+    QGeoRouteParserOsrmV5 parser;
+    QList<QGeoRoute> routes;
+    QString errorString;
+    QBENCHMARK {
+        routes.clear();
+        parser.parseReply(routes, errorString, m_reply);
+    }
+    QCOMPARE(routes.size(), 2);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoPolylineDecoder)
+
+#include "tst_qgeopolylinedecoder.moc"
@@ -0,0 +1,193 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/location/maps
+
+#include <QtTest/QtTest>
+#include <QtLocation/private/qgeocameradata_p.h>
+#include <QtLocation/private/qgeoprojection_p.h>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/private/qdoublevector2d_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoProjection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void batchedProjection_data();
+    void batchedProjection();
+    void benchmarkProjection_data();
+    void benchmarkProjection();
+
+private:
+    void setupProjection(QGeoProjectionWebMercator &projection, const QGeoCameraData &camera) const;
+};
+
+static QList<QGeoCoordinate> coordinateGrid(int rows, int columns)
+{
+    QList<QGeoCoordinate> coordinates;
+    coordinates.reserve(rows * columns + 1);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < columns; ++j) {
+            coordinates << QGeoCoordinate(-85.0 + 170.0 * i / (rows - 1),
+                                          -180.0 + 360.0 * j / (columns - 1));
+        }
+    }
+    coordinates << QGeoCoordinate(); // not projectable
+    return coordinates;
+}
+
+static bool sameValue(double a, double b)
+{
+    if (qIsNaN(a) || qIsNaN(b))
+        return qIsNaN(a) && qIsNaN(b);
+    return qAbs(a - b) <= 1e-9 * qMax(1.0, qAbs(a));
+}
+
+static bool samePoint(const QDoubleVector2D &a, const QDoubleVector2D &b)
+{
+    return sameValue(a.x(), b.x()) && sameValue(a.y(), b.y());
+}
+
+static QGeoCameraData makeCamera(const QGeoCoordinate &center, double zoom,
+                                 double bearing = 0.0, double tilt = 0.0)
+{
+    QGeoCameraData camera;
+    camera.setCenter(center);
+    camera.setZoomLevel(zoom);
+    camera.setBearing(bearing);
+    camera.setTilt(tilt);
+    return camera;
+}
+
+void tst_QGeoProjection::setupProjection(QGeoProjectionWebMercator &projection,
+                                         const QGeoCameraData &camera) const
+{
+    projection.setViewportSize(QSize(800, 600));
+    projection.setCameraData(camera);
+}
+
+void tst_QGeoProjection::batchedProjection_data()
+{
+    QTest::addColumn<QGeoCameraData>("camera");
+
+    QTest::newRow("world") << makeCamera(QGeoCoordinate(0, 0), 2.0);
+    QTest::newRow("centered east") << makeCamera(QGeoCoordinate(20, 150), 3.5);
+    QTest::newRow("centered west") << makeCamera(QGeoCoordinate(-20, -170), 4.0);
+    QTest::newRow("bearing") << makeCamera(QGeoCoordinate(45, 10), 5.0, 37.0);
+    QTest::newRow("tilt") << makeCamera(QGeoCoordinate(45, 10), 3.0, 0.0, 60.0);
+    QTest::newRow("bearing and tilt") << makeCamera(QGeoCoordinate(-60, 179), 2.5, 200.0, 45.0);
+}
+
+void tst_QGeoProjection::batchedProjection()
+{
+    QFETCH(QGeoCameraData, camera);
+
+    QGeoProjectionWebMercator projection;
+    setupProjection(projection, camera);
+
+    const QList<QGeoCoordinate> coordinates = coordinateGrid(31, 61);
+
+    const QList<QDoubleVector2D> mercator = projection.geoToMapProjection(coordinates);
+    QCOMPARE(mercator.size(), coordinates.size());
+    for (qsizetype i = 0; i < coordinates.size(); ++i)
+        QVERIFY(samePoint(mercator.at(i), projection.geoToMapProjection(coordinates.at(i))));
+
+    QList<QDoubleVector2D> wrapped;
+    for (qsizetype i = 0; i < coordinates.size() - 1; ++i)
+        wrapped << projection.geoToWrappedMapProjection(coordinates.at(i));
+    const QList<QDoubleVector2D> positions = projection.wrappedMapProjectionToItemPosition(wrapped);
+    QCOMPARE(positions.size(), wrapped.size());
+    for (qsizetype i = 0; i < wrapped.size(); ++i)
+        QVERIFY(samePoint(positions.at(i), projection.wrappedMapProjectionToItemPosition(wrapped.at(i))));
+
+    // In place
+    projection.wrappedMapProjectionToItemPosition(wrapped.constData(), wrapped.data(), wrapped.size());
+    QCOMPARE(wrapped, positions);
+
+    for (bool clip : { false, true }) {
+        const QList<QDoubleVector2D> items = projection.coordinateToItemPosition(coordinates, clip);
+        QCOMPARE(items.size(), coordinates.size());
+        qsizetype projected = 0;
+        for (qsizetype i = 0; i < coordinates.size(); ++i) {
+            const QDoubleVector2D expected = projection.coordinateToItemPosition(coordinates.at(i), clip);
+            QVERIFY2(samePoint(items.at(i), expected),
+                     qPrintable(QStringLiteral("%1: (%2, %3) instead of (%4, %5)")
+                                .arg(i).arg(items.at(i).x()).arg(items.at(i).y())
+                                .arg(expected.x()).arg(expected.y())));
+            if (!qIsNaN(expected.x()))
+                ++projected;
+        }
+        QVERIFY(projected > 0);
+        QVERIFY(qIsNaN(items.last().x()));
+    }
+}
+
+void tst_QGeoProjection::benchmarkProjection_data()
+{
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("per point") << false;
+    QTest::newRow("batched") << true;
+}
+
+void tst_QGeoProjection::benchmarkProjection()
+{
+    QFETCH(bool, batched);
+
+    QGeoProjectionWebMercator projection;
+    setupProjection(projection, makeCamera(QGeoCoordinate(45, 10), 3.0, 30.0, 45.0));
+
+    const QList<QGeoCoordinate> coordinates = coordinateGrid(200, 500);
+    QList<QDoubleVector2D> wrapped;
+    wrapped.reserve(coordinates.size());
+    for (const QGeoCoordinate &c : coordinates)
+        wrapped << projection.geoToWrappedMapProjection(c);
+    QList<QDoubleVector2D> positions(wrapped.size());
+
+    // The map to item transformation is what the item backends run on every
+    // camera change, on paths that were projected to mercator beforehand.
+    if (batched) {
+        QBENCHMARK {
+            projection.wrappedMapProjectionToItemPosition(wrapped.constData(), positions.data(),
+                                                          wrapped.size());
+        }
+    } else {
+        QBENCHMARK {
+            for (qsizetype i = 0; i < wrapped.size(); ++i)
+                positions[i] = projection.wrappedMapProjectionToItemPosition(wrapped.at(i));
+        }
+    }
+    QVERIFY(!positions.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_QGeoProjection)
+#include "tst_qgeoprojection.moc"
@@ -132,6 +132,53 @@ void tst_QGeoRoute::path_data()
     QTest::newRow("path5") << coordinates ;
 }
 
+void tst_QGeoRoute::packedPath()
+{
+    const QList<double> values { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    const QGeoPackedPath packed(values);
+    QCOMPARE(packed.size(), 3);
+    QCOMPARE(packed.mid(1).at(0), QGeoCoordinate(3.0, 4.0));
+    QCOMPARE(packed.mid(2, 5).size(), 1);
+
+    // Legs and segments share the buffer of the route
+    QGeoRoute route;
+    QGeoRoute leg;
+    QGeoRouteSegment segment;
+    segment.setDistance(1.0);
+    QGeoRoutePrivate::get(route)->setPackedPath(packed);
+    QGeoRoutePrivate::get(leg)->setPackedPath(packed.mid(0, 2));
+    QGeoRouteSegmentPrivate::get(segment)->setPackedPath(packed.mid(1, 2));
+    QVERIFY(QGeoRoutePrivate::get(leg)->packedPath().constData() == values.constData());
+    QVERIFY(QGeoRouteSegmentPrivate::get(segment)->packedPath().constData() == values.constData() + 2);
+
+    const QList<QGeoCoordinate> path { QGeoCoordinate(1.0, 2.0), QGeoCoordinate(3.0, 4.0),
+                                       QGeoCoordinate(5.0, 6.0) };
+    QCOMPARE(route.path(), path);
+    QCOMPARE(leg.path(), path.mid(0, 2));
+    QCOMPARE(segment.path(), path.mid(1, 2));
+
+    // Packed and unpacked paths compare alike
+    QGeoRoute unpacked;
+    unpacked.setPath(path);
+    QVERIFY(route == unpacked);
+    QGeoRouteSegment unpackedSegment;
+    unpackedSegment.setDistance(1.0);
+    unpackedSegment.setPath(path.mid(1, 2));
+    QVERIFY(segment == unpackedSegment);
+
+    // The bounds are those of the unpacked path, also across the antimeridian
+    const QList<double> crossing { 10.0, 170.0, 20.0, -170.0, -5.0, 175.0, 0.0, -160.0 };
+    const QGeoPackedPath crossingPath(crossing);
+    QCOMPARE(crossingPath.boundingGeoRectangle(),
+             QGeoPath(crossingPath.coordinates()).boundingGeoRectangle());
+    QCOMPARE(packed.boundingGeoRectangle(), QGeoPath(path).boundingGeoRectangle());
+
+    // Setting a path replaces the packed one
+    route.setPath(path.mid(2));
+    QCOMPARE(route.path(), path.mid(2));
+    QCOMPARE(QGeoRoutePrivate::get(route)->packedPath(), packed.mid(2));
+}
+
 void tst_QGeoRoute::request()
 {
     QGeoRoute qgeoroute;
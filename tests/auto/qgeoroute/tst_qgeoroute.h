@@ -34,10 +34,13 @@
 #include <QMetaType>
 
 #include <qgeoroute.h>
+#include <QtPositioning/QGeoPath>
 #include <QtPositioning/QGeoRectangle>
 #include <qgeocoordinate.h>
 #include <qgeorouterequest.h>
 #include <qgeoroutesegment.h>
+#include <QtLocation/private/qgeoroute_p.h>
+#include <QtLocation/private/qgeoroutesegment_p.h>
 
 
 QT_USE_NAMESPACE
@@ -57,6 +60,7 @@ private Q_SLOTS:
     void distance();
     void path();
     void path_data();
+    void packedPath();
     void request();
     void routeId();
     void firstrouteSegments();
@@ -0,0 +1,324 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/location/maps
+
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtCore/QTemporaryDir>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QGeoRoutingManager>
+#include <QtLocation/private/qgeoroutecache_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoRouteCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void memoryCache();
+    void requestKey();
+    void expiry();
+    void inFlight();
+    void inFlightAborted();
+    void updateRoute();
+    void diskCache();
+    void diskSize();
+
+private:
+    static QGeoRouteRequest routeRequest(double latitude = 12.12);
+    static bool isCached(QGeoRouteReply *reply);
+};
+
+QGeoRouteRequest tst_QGeoRouteCache::routeRequest(double latitude)
+{
+    QGeoRouteRequest request(QGeoCoordinate(latitude, 23.23), QGeoCoordinate(34.34, 89.32));
+    // The test plugin returns as many routes as alternatives are asked for
+    request.setNumberAlternativeRoutes(1);
+    return request;
+}
+
+bool tst_QGeoRouteCache::isCached(QGeoRouteReply *reply)
+{
+    return qobject_cast<QGeoRouteCacheReply *>(reply) != nullptr;
+}
+
+void tst_QGeoRouteCache::initTestCase()
+{
+#if QT_CONFIG(library)
+    // Set custom path since CI doesn't install test plugins
+#ifdef Q_OS_WIN
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../../plugins"));
+#else
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../plugins"));
+#endif
+#endif
+}
+
+void tst_QGeoRouteCache::memoryCache()
+{
+    QVariantMap parameters;
+    parameters["routing.cache.size"] = 4;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoRoutingManager *manager = provider.routingManager();
+    QVERIFY(manager);
+    QSignalSpy finishedSpy(manager, &QGeoRoutingManager::finished);
+
+    std::unique_ptr<QGeoRouteReply> first(manager->calculateRoute(routeRequest()));
+    QVERIFY(first->isFinished());
+    QVERIFY(!isCached(first.get()));
+    QCOMPARE(first->routes().size(), 1);
+    finishedSpy.clear();
+
+    // Hits finish from the event loop, like the replies of the engine
+    std::unique_ptr<QGeoRouteReply> second(manager->calculateRoute(routeRequest()));
+    QVERIFY(isCached(second.get()));
+    QVERIFY(!second->isFinished());
+    QSignalSpy secondFinishedSpy(second.get(), &QGeoRouteReply::finished);
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(secondFinishedSpy.size(), 1);
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(second->error(), QGeoRouteReply::NoError);
+    QCOMPARE(second->routes().size(), 1);
+    QCOMPARE(second->routes().first().path(), first->routes().first().path());
+
+    // Routes handed out don't share their data with the cache
+    const int travelTime = second->routes().first().travelTime();
+    QGeoRoute changed = second->routes().first();
+    changed.setTravelTime(travelTime + 100);
+    std::unique_ptr<QGeoRouteReply> third(manager->calculateRoute(routeRequest()));
+    QVERIFY(isCached(third.get()));
+    QTRY_VERIFY(third->isFinished());
+    QCOMPARE(third->routes().first().travelTime(), travelTime);
+
+    // Differences below the precision hit the cache, others don't
+    const QGeoRouteRequest closeRequest = routeRequest(12.120001);
+    std::unique_ptr<QGeoRouteReply> close(manager->calculateRoute(closeRequest));
+    QVERIFY(isCached(close.get()));
+    QTRY_VERIFY(close->isFinished());
+    QCOMPARE(close->routes().first().request(), closeRequest);
+
+    // Aborted hits never finish
+    std::unique_ptr<QGeoRouteReply> aborted(manager->calculateRoute(routeRequest()));
+    QSignalSpy abortedFinishedSpy(aborted.get(), &QGeoRouteReply::finished);
+    aborted->abort();
+    QCoreApplication::processEvents();
+    QVERIFY(!aborted->isFinished());
+    QCOMPARE(abortedFinishedSpy.size(), 0);
+    std::unique_ptr<QGeoRouteReply> far(manager->calculateRoute(routeRequest(12.13)));
+    QVERIFY(!isCached(far.get()));
+
+    QGeoRouteRequest pedestrian = routeRequest();
+    pedestrian.setTravelModes(QGeoRouteRequest::PedestrianTravel);
+    std::unique_ptr<QGeoRouteReply> other(manager->calculateRoute(pedestrian));
+    QVERIFY(!isCached(other.get()));
+}
+
+void tst_QGeoRouteCache::requestKey()
+{
+    QVariantMap parameters;
+    parameters["routing.cache.size"] = 4;
+    parameters["routing.cache.precision"] = 2;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QVERIFY(provider.routingManager());
+    QGeoRoutingManagerEngine *engine = provider.routingManager()->findChild<QGeoRoutingManagerEngine *>();
+    QVERIFY(engine);
+    QGeoRouteCache *cache = engine->findChild<QGeoRouteCache *>();
+    QVERIFY(cache);
+
+    QCOMPARE(cache->requestKey(routeRequest(12.121)), cache->requestKey(routeRequest(12.1249)));
+    QVERIFY(cache->requestKey(routeRequest(12.121)) != cache->requestKey(routeRequest(12.13)));
+
+    // The order in which features are set does not matter
+    QGeoRouteRequest a = routeRequest();
+    a.setFeatureWeight(QGeoRouteRequest::TollFeature, QGeoRouteRequest::AvoidFeatureWeight);
+    a.setFeatureWeight(QGeoRouteRequest::FerryFeature, QGeoRouteRequest::AvoidFeatureWeight);
+    QGeoRouteRequest b = routeRequest();
+    b.setFeatureWeight(QGeoRouteRequest::FerryFeature, QGeoRouteRequest::AvoidFeatureWeight);
+    b.setFeatureWeight(QGeoRouteRequest::TollFeature, QGeoRouteRequest::AvoidFeatureWeight);
+    QCOMPARE(cache->requestKey(a), cache->requestKey(b));
+    QVERIFY(cache->requestKey(a) != cache->requestKey(routeRequest()));
+}
+
+void tst_QGeoRouteCache::expiry()
+{
+    QVariantMap parameters;
+    parameters["routing.cache.size"] = 4;
+    parameters["routing.cache.ttl"] = 0;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoRoutingManager *manager = provider.routingManager();
+    QVERIFY(manager);
+
+    std::unique_ptr<QGeoRouteReply> first(manager->calculateRoute(routeRequest()));
+    std::unique_ptr<QGeoRouteReply> second(manager->calculateRoute(routeRequest()));
+    QVERIFY(!isCached(second.get()));
+}
+
+void tst_QGeoRouteCache::inFlight()
+{
+    QVariantMap parameters;
+    parameters["routing.cache.size"] = 4;
+    parameters["gc_finishRequestImmediately"] = false;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoRoutingManager *manager = provider.routingManager();
+    QVERIFY(manager);
+    QSignalSpy finishedSpy(manager, &QGeoRoutingManager::finished);
+
+    // The test engine asserts that it only has one request at a time
+    std::unique_ptr<QGeoRouteReply> first(manager->calculateRoute(routeRequest()));
+    std::unique_ptr<QGeoRouteReply> second(manager->calculateRoute(routeRequest()));
+    QVERIFY(!first->isFinished());
+    QVERIFY(!second->isFinished());
+    QVERIFY(isCached(second.get()));
+
+    QTRY_VERIFY(second->isFinished());
+    QVERIFY(first->isFinished());
+    QCOMPARE(finishedSpy.size(), 2);
+    QCOMPARE(second->routes().first().path(), first->routes().first().path());
+
+    // Answered from memory now
+    std::unique_ptr<QGeoRouteReply> third(manager->calculateRoute(routeRequest()));
+    QVERIFY(isCached(third.get()));
+    QTRY_VERIFY(third->isFinished());
+    QCOMPARE(finishedSpy.size(), 3);
+}
+
+void tst_QGeoRouteCache::inFlightAborted()
+{
+    QVariantMap parameters;
+    parameters["routing.cache.size"] = 4;
+    parameters["gc_finishRequestImmediately"] = false;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoRoutingManager *manager = provider.routingManager();
+    QVERIFY(manager);
+
+    std::unique_ptr<QGeoRouteReply> first(manager->calculateRoute(routeRequest()));
+    std::unique_ptr<QGeoRouteReply> second(manager->calculateRoute(routeRequest()));
+    QVERIFY(isCached(second.get()));
+
+    // The reply that was shared is aborted by its owner, the other one still gets routes
+    first->abort();
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(second->error(), QGeoRouteReply::NoError);
+    QCOMPARE(second->routes().size(), 1);
+}
+
+void tst_QGeoRouteCache::updateRoute()
+{
+    QVariantMap parameters;
+    parameters["routing.cache.size"] = 4;
+    parameters["routing.refresh.tolerance"] = 30;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoRoutingManager *manager = provider.routingManager();
+    QVERIFY(manager);
+
+    // Routes handed out by the cache carry their request
+    std::unique_ptr<QGeoRouteReply> first(manager->calculateRoute(routeRequest()));
+    std::unique_ptr<QGeoRouteReply> cached(manager->calculateRoute(routeRequest()));
+    QVERIFY(isCached(cached.get()));
+    QTRY_VERIFY(cached->isFinished());
+    const QGeoRoute route = cached->routes().first();
+
+    // Re-routing from off the route goes through the cache too
+    const QGeoCoordinate offRoute(1.0, 1.0);
+    std::unique_ptr<QGeoRouteReply> update(manager->updateRoute(route, offRoute));
+    QVERIFY(!isCached(update.get()));
+    QVERIFY(update->isFinished());
+    QCOMPARE(update->routes().size(), 1);
+    QCOMPARE(update->routes().first().path().first(), offRoute);
+    std::unique_ptr<QGeoRouteReply> again(manager->updateRoute(route, offRoute));
+    QVERIFY(isCached(again.get()));
+    QTRY_VERIFY(again->isFinished());
+    QCOMPARE(again->routes().first().path(), update->routes().first().path());
+}
+
+void tst_QGeoRouteCache::diskCache()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QVariantMap parameters;
+    parameters["routing.cache.size"] = 4;
+    parameters["routing.cache.directory"] = directory.path();
+
+    QList<QGeoCoordinate> path;
+    {
+        QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+        QVERIFY(provider.routingManager());
+        std::unique_ptr<QGeoRouteReply> reply(provider.routingManager()->calculateRoute(routeRequest()));
+        QVERIFY(!isCached(reply.get()));
+        path = reply->routes().first().path();
+    }
+
+    // Another provider finds the routes on disk
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QVERIFY(provider.routingManager());
+    const QGeoRouteRequest request = routeRequest();
+    std::unique_ptr<QGeoRouteReply> reply(provider.routingManager()->calculateRoute(request));
+    QVERIFY(isCached(reply.get()));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->routes().size(), 1);
+    QCOMPARE(reply->routes().first().path(), path);
+    QCOMPARE(reply->routes().first().request(), request);
+}
+
+void tst_QGeoRouteCache::diskSize()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    // Files that are not, or no longer, valid entries are removed at startup
+    QFile invalid(directory.filePath(QStringLiteral("0123.route")));
+    QVERIFY(invalid.open(QIODevice::WriteOnly));
+    invalid.write("not a route");
+    invalid.close();
+
+    QVariantMap parameters;
+    parameters["routing.cache.size"] = 4;
+    parameters["routing.cache.directory"] = directory.path();
+    parameters["routing.cache.disk.size"] = 1;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QGeoRoutingManager *manager = provider.routingManager();
+    QVERIFY(manager);
+    QTRY_VERIFY(!QFile::exists(invalid.fileName()));
+
+    std::unique_ptr<QGeoRouteReply> reply(manager->calculateRoute(routeRequest()));
+    QVERIFY(reply->isFinished());
+
+    // Files above the limit are removed, the entries stay in memory
+    QTRY_COMPARE(QDir(directory.path()).entryList(QDir::Files).size(), 0);
+    std::unique_ptr<QGeoRouteReply> cached(manager->calculateRoute(routeRequest()));
+    QVERIFY(isCached(cached.get()));
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoRouteCache)
+
+#include "tst_qgeoroutecache.moc"
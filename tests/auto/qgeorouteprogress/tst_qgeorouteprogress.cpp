@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/location/maps
+
+//TESTED_COMPONENT=src/location/maps
+
+#include <QtTest/QtTest>
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteSegment>
+#include <QtLocation/private/qgeoroute_p.h>
+#include <QtLocation/private/qgeoroutesegment_p.h>
+#include <QtLocation/private/qgeorouteprogress_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoRouteProgress : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void withoutPath();
+    void onRoute();
+    void betweenSegments();
+    void nextLeg();
+    void offRoute();
+    void withoutWaypoints();
+
+private:
+    static QGeoRoute route();
+};
+
+/*
+    A route along the equator, with waypoints at longitudes 0, 0.03 and 0.05.
+    Its three segments have two vertices each; the first leg has the first
+    two segments.
+*/
+QGeoRoute tst_QGeoRouteProgress::route()
+{
+    QList<double> values;
+    for (int i = 0; i < 6; ++i)
+        values << 0.0 << 0.01 * i;
+    const QGeoPackedPath path(values);
+
+    QList<QGeoRouteSegment> segments(3);
+    for (int i = 0; i < 3; ++i) {
+        QGeoRouteSegment &segment = segments[i];
+        segment.setDistance(1000.0);
+        segment.setTravelTime(100);
+        QGeoRouteSegmentPrivate::get(segment)->setPackedPath(path.mid(2 * i, 2));
+        if (i > 0)
+            segments[i - 1].setNextRouteSegment(segment);
+    }
+    QGeoRouteSegmentPrivate::get(segments[1])->setLegLastSegment(true);
+    QGeoRouteSegmentPrivate::get(segments[2])->setLegLastSegment(true);
+
+    QGeoRoute route;
+    route.setRequest(QGeoRouteRequest({ QGeoCoordinate(0.0, 0.0), QGeoCoordinate(0.0, 0.03),
+                                        QGeoCoordinate(0.0, 0.05) }));
+    route.setDistance(3000.0);
+    route.setTravelTime(300);
+    route.setFirstRouteSegment(segments.first());
+    QGeoRoutePrivate::get(route)->setPackedPath(path);
+
+    QGeoRoute firstLeg;
+    firstLeg.setLegIndex(0);
+    firstLeg.setDistance(2000.0);
+    firstLeg.setTravelTime(200);
+    firstLeg.setFirstRouteSegment(segments[0]);
+    QGeoRoutePrivate::get(firstLeg)->setPackedPath(path.mid(0, 4));
+    QGeoRoute secondLeg;
+    secondLeg.setLegIndex(1);
+    secondLeg.setDistance(1000.0);
+    secondLeg.setTravelTime(100);
+    secondLeg.setFirstRouteSegment(segments[2]);
+    QGeoRoutePrivate::get(secondLeg)->setPackedPath(path.mid(4, 2));
+    route.setRouteLegs({ firstLeg, secondLeg });
+    return route;
+}
+
+void tst_QGeoRouteProgress::withoutPath()
+{
+    const QGeoRouteProgress progress(QGeoRoute(), QGeoCoordinate(0.0, 0.0));
+    QVERIFY(!progress.isValid());
+    QVERIFY(!progress.isOnRoute(100.0));
+}
+
+void tst_QGeoRouteProgress::onRoute()
+{
+    // About 11 m north of the middle of the first segment
+    const QGeoCoordinate position(0.0001, 0.005);
+    const QGeoRouteProgress progress(route(), position);
+    QVERIFY(progress.isValid());
+    QVERIFY(qAbs(progress.distanceFromRoute() - 11.1) < 0.1);
+    QVERIFY(progress.isOnRoute(30.0));
+    QVERIFY(!progress.isOnRoute(5.0));
+    QCOMPARE(progress.legIndex(), 0);
+
+    const QGeoRoute remaining = progress.remainingRoute();
+    QCOMPARE(remaining.distance(), 2500.0);
+    QCOMPARE(remaining.travelTime(), 250);
+    const QList<QGeoCoordinate> path = remaining.path();
+    QCOMPARE(path.size(), 6);
+    QVERIFY(path.first().distanceTo(QGeoCoordinate(0.0, 0.005)) < 0.01);
+    QCOMPARE(path.last(), QGeoCoordinate(0.0, 0.05));
+
+    const QGeoRouteSegment first = remaining.firstRouteSegment();
+    QCOMPARE(first.distance(), 500.0);
+    QCOMPARE(first.travelTime(), 50);
+    QCOMPARE(first.path().size(), 2);
+    QCOMPARE(first.nextRouteSegment().distance(), 1000.0);
+
+    const QList<QGeoRoute> legs = remaining.routeLegs();
+    QCOMPARE(legs.size(), 2);
+    QCOMPARE(legs.first().distance(), 1500.0);
+    QCOMPARE(legs.first().travelTime(), 150);
+    QCOMPARE(legs.first().path().size(), 4);
+    QCOMPARE(legs.last().legIndex(), 1);
+    QCOMPARE(legs.last().distance(), 1000.0);
+    // Every leg belongs to the remaining route
+    for (const QGeoRoute &leg : legs)
+        QCOMPARE(leg.overallRoute().distance(), remaining.distance());
+
+    const QList<QGeoCoordinate> waypoints = remaining.request().waypoints();
+    QCOMPARE(waypoints.size(), 3);
+    QCOMPARE(waypoints.first(), position);
+    QCOMPARE(waypoints.at(1), QGeoCoordinate(0.0, 0.03));
+}
+
+void tst_QGeoRouteProgress::betweenSegments()
+{
+    // On the edge joining the first two segments, which belongs to the second
+    const QGeoRouteProgress progress(route(), QGeoCoordinate(0.0, 0.015));
+    QVERIFY(progress.isOnRoute(1.0));
+
+    const QGeoRoute remaining = progress.remainingRoute();
+    QCOMPARE(remaining.distance(), 2000.0);
+    QCOMPARE(remaining.travelTime(), 200);
+    QCOMPARE(remaining.firstRouteSegment().distance(), 1000.0);
+    QCOMPARE(remaining.firstRouteSegment().path().size(), 3);
+    QCOMPARE(remaining.routeLegs().first().path().size(), 3);
+}
+
+void tst_QGeoRouteProgress::nextLeg()
+{
+    // Past the second waypoint
+    const QGeoCoordinate position(0.0, 0.045);
+    const QGeoRouteProgress progress(route(), position);
+    QVERIFY(progress.isOnRoute(1.0));
+    QCOMPARE(progress.legIndex(), 1);
+
+    const QGeoRoute remaining = progress.remainingRoute();
+    QCOMPARE(remaining.distance(), 500.0);
+    QCOMPARE(remaining.travelTime(), 50);
+    QCOMPARE(remaining.routeLegs().size(), 1);
+    QCOMPARE(remaining.routeLegs().first().legIndex(), 1);
+    QVERIFY(!remaining.firstRouteSegment().nextRouteSegment().isValid());
+
+    const QList<QGeoCoordinate> waypoints = progress.remainingRequest().waypoints();
+    QCOMPARE(waypoints, QList<QGeoCoordinate>({ position, QGeoCoordinate(0.0, 0.05) }));
+}
+
+void tst_QGeoRouteProgress::offRoute()
+{
+    // About 1 km north of the route
+    const QGeoCoordinate position(0.01, 0.02);
+    const QGeoRouteProgress progress(route(), position);
+    QVERIFY(progress.isValid());
+    QVERIFY(!progress.isOnRoute(30.0));
+    QVERIFY(progress.distanceFromRoute() > 1000.0);
+
+    // Routing again starts from the position, to the waypoints still ahead
+    const QList<QGeoCoordinate> waypoints = progress.remainingRequest().waypoints();
+    QCOMPARE(waypoints, QList<QGeoCoordinate>({ position, QGeoCoordinate(0.0, 0.03),
+                                                QGeoCoordinate(0.0, 0.05) }));
+}
+
+void tst_QGeoRouteProgress::withoutWaypoints()
+{
+    QGeoRoute withoutRequest = route();
+    withoutRequest.setRequest(QGeoRouteRequest());
+    const QGeoCoordinate position(0.01, 0.02);
+    const QGeoRouteProgress progress(withoutRequest, position);
+
+    // The route is calculated again to its end
+    const QList<QGeoCoordinate> waypoints = progress.remainingRequest().waypoints();
+    QCOMPARE(waypoints, QList<QGeoCoordinate>({ position, QGeoCoordinate(0.0, 0.05) }));
+}
+
+QTEST_APPLESS_MAIN(tst_QGeoRouteProgress)
+
+#include "tst_qgeorouteprogress.moc"
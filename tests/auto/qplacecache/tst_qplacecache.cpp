@@ -0,0 +1,351 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/location/places
+
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtCore/QTemporaryDir>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QPlaceCategory>
+#include <QtLocation/QPlaceManager>
+#include <QtLocation/QPlaceManagerEngine>
+#include <QtLocation/QPlaceResult>
+#include <QtLocation/private/qplacecache_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QPlaceCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void search();
+    void details();
+    void expiry();
+    void inFlight();
+    void invalidation();
+    void diskCache();
+    void diskInvalidation();
+    void diskSize();
+    void unwritableContext();
+
+private:
+    static QVariantMap parameters(int size);
+    static QPlaceSearchRequest searchRequest(const QString &term);
+
+    static constexpr char parkViewHotel[] = "4dcc74ce-fdeb-443e-827c-367438017cf1";
+};
+
+QVariantMap tst_QPlaceCache::parameters(int size)
+{
+    QVariantMap parameters;
+    parameters["initializePlaceData"] = true;
+    parameters["places.cache.size"] = size;
+    return parameters;
+}
+
+QPlaceSearchRequest tst_QPlaceCache::searchRequest(const QString &term)
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(term);
+    return request;
+}
+
+void tst_QPlaceCache::initTestCase()
+{
+#if QT_CONFIG(library)
+    // Set custom path since CI doesn't install test plugins
+#ifdef Q_OS_WIN
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../../plugins"));
+#else
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../plugins"));
+#endif
+#endif
+}
+
+void tst_QPlaceCache::search()
+{
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters(4), true);
+    QPlaceManager *manager = provider.placeManager();
+    QVERIFY(manager);
+    QSignalSpy finishedSpy(manager, &QPlaceManager::finished);
+
+    std::unique_ptr<QPlaceSearchReply> first(manager->search(searchRequest("hotel")));
+    QVERIFY(!qobject_cast<QPlaceSearchCacheReply *>(first.get()));
+    QTRY_VERIFY(first->isFinished());
+    QCOMPARE(first->results().size(), 2);
+
+    // Answered from the cache, but still finished from the event loop
+    std::unique_ptr<QPlaceSearchReply> second(manager->search(searchRequest("hotel")));
+    QVERIFY(qobject_cast<QPlaceSearchCacheReply *>(second.get()));
+    QVERIFY(!second->isFinished());
+    QSignalSpy replySpy(second.get(), &QPlaceReply::finished);
+    QTRY_COMPARE(replySpy.size(), 1);
+    QCOMPARE(finishedSpy.size(), 2);
+    QCOMPARE(second->error(), QPlaceReply::NoError);
+    QCOMPARE(second->results(), first->results());
+    QCOMPARE(second->request(), searchRequest("hotel"));
+
+    std::unique_ptr<QPlaceSearchReply> other(manager->search(searchRequest("park")));
+    QVERIFY(!qobject_cast<QPlaceSearchCacheReply *>(other.get()));
+
+    // Aborted cached replies don't finish
+    std::unique_ptr<QPlaceSearchReply> aborted(manager->search(searchRequest("hotel")));
+    QSignalSpy abortedSpy(aborted.get(), &QPlaceReply::finished);
+    aborted->abort();
+    QTest::qWait(0);
+    QCOMPARE(abortedSpy.size(), 0);
+}
+
+void tst_QPlaceCache::details()
+{
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters(4), true);
+    QPlaceManager *manager = provider.placeManager();
+    QVERIFY(manager);
+
+    std::unique_ptr<QPlaceDetailsReply> first(manager->getPlaceDetails(parkViewHotel));
+    QTRY_VERIFY(first->isFinished());
+    QCOMPARE(first->place().name(), QStringLiteral("Park View Hotel"));
+
+    std::unique_ptr<QPlaceDetailsReply> second(manager->getPlaceDetails(parkViewHotel));
+    QVERIFY(qobject_cast<QPlaceDetailsCacheReply *>(second.get()));
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(second->place(), first->place());
+
+    // Errors are not cached
+    std::unique_ptr<QPlaceDetailsReply> missing(manager->getPlaceDetails("missing"));
+    QTRY_VERIFY(missing->isFinished());
+    QCOMPARE(missing->error(), QPlaceReply::PlaceDoesNotExistError);
+    std::unique_ptr<QPlaceDetailsReply> missingAgain(manager->getPlaceDetails("missing"));
+    QVERIFY(!qobject_cast<QPlaceDetailsCacheReply *>(missingAgain.get()));
+}
+
+void tst_QPlaceCache::expiry()
+{
+    QVariantMap parameters = tst_QPlaceCache::parameters(4);
+    parameters["places.cache.ttl.search"] = 0;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QPlaceManager *manager = provider.placeManager();
+    QVERIFY(manager);
+
+    std::unique_ptr<QPlaceSearchReply> first(manager->search(searchRequest("hotel")));
+    QTRY_VERIFY(first->isFinished());
+    std::unique_ptr<QPlaceSearchReply> second(manager->search(searchRequest("hotel")));
+    QVERIFY(!qobject_cast<QPlaceSearchCacheReply *>(second.get()));
+
+    // Details have their own time to live
+    std::unique_ptr<QPlaceDetailsReply> details(manager->getPlaceDetails(parkViewHotel));
+    QTRY_VERIFY(details->isFinished());
+    std::unique_ptr<QPlaceDetailsReply> cached(manager->getPlaceDetails(parkViewHotel));
+    QVERIFY(qobject_cast<QPlaceDetailsCacheReply *>(cached.get()));
+}
+
+void tst_QPlaceCache::inFlight()
+{
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters(4), true);
+    QPlaceManager *manager = provider.placeManager();
+    QVERIFY(manager);
+    QSignalSpy finishedSpy(manager, &QPlaceManager::finished);
+
+    // The second search follows the first one, which is still in progress
+    std::unique_ptr<QPlaceSearchReply> first(manager->search(searchRequest("hotel")));
+    std::unique_ptr<QPlaceSearchReply> second(manager->search(searchRequest("hotel")));
+    QVERIFY(!qobject_cast<QPlaceSearchCacheReply *>(first.get()));
+    QVERIFY(qobject_cast<QPlaceSearchCacheReply *>(second.get()));
+    QTRY_VERIFY(second->isFinished());
+    QVERIFY(first->isFinished());
+    QCOMPARE(finishedSpy.size(), 2);
+    QCOMPARE(second->results(), first->results());
+    QCOMPARE(second->request(), searchRequest("hotel"));
+
+    // The one that was shared is aborted by its owner, the other one still gets the place
+    std::unique_ptr<QPlaceDetailsReply> details(manager->getPlaceDetails(parkViewHotel));
+    std::unique_ptr<QPlaceDetailsReply> follower(manager->getPlaceDetails(parkViewHotel));
+    QVERIFY(qobject_cast<QPlaceDetailsCacheReply *>(follower.get()));
+    details->abort();
+    QTRY_VERIFY(follower->isFinished());
+    QCOMPARE(follower->error(), QPlaceReply::NoError);
+    QCOMPARE(follower->place().name(), QStringLiteral("Park View Hotel"));
+}
+
+void tst_QPlaceCache::invalidation()
+{
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters(4), true);
+    QPlaceManager *manager = provider.placeManager();
+    QVERIFY(manager);
+    QPlaceManagerEngine *engine = manager->findChild<QPlaceManagerEngine *>();
+    QVERIFY(engine);
+    QPlaceCache *cache = engine->findChild<QPlaceCache *>();
+    QVERIFY(cache);
+
+    std::unique_ptr<QPlaceSearchReply> search(manager->search(searchRequest("hotel")));
+    std::unique_ptr<QPlaceDetailsReply> details(manager->getPlaceDetails(parkViewHotel));
+    QTRY_VERIFY(search->isFinished() && details->isFinished());
+    QCOMPARE(cache->size(), 2);
+
+    emit engine->placeUpdated(parkViewHotel);
+    QCOMPARE(cache->size(), 0);
+
+    search.reset(manager->search(searchRequest("hotel")));
+    QTRY_VERIFY(search->isFinished());
+    emit engine->dataChanged();
+    QCOMPARE(cache->size(), 0);
+}
+
+void tst_QPlaceCache::diskCache()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QVariantMap parameters = tst_QPlaceCache::parameters(4);
+    parameters["places.cache.directory"] = directory.path();
+
+    QList<QPlaceSearchResult> results;
+    QPlace place;
+    {
+        QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+        QPlaceManager *manager = provider.placeManager();
+        QVERIFY(manager);
+        std::unique_ptr<QPlaceSearchReply> search(manager->search(searchRequest("hotel")));
+        std::unique_ptr<QPlaceDetailsReply> details(manager->getPlaceDetails(parkViewHotel));
+        QTRY_VERIFY(search->isFinished() && details->isFinished());
+        results = search->results();
+        place = details->place();
+    }
+    QCOMPARE(QDir(directory.path()).entryList(QDir::Files).size(), 2);
+
+    // Another provider reads the replies back from disk
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QPlaceManager *manager = provider.placeManager();
+    QVERIFY(manager);
+    std::unique_ptr<QPlaceSearchReply> search(manager->search(searchRequest("hotel")));
+    QVERIFY(qobject_cast<QPlaceSearchCacheReply *>(search.get()));
+    std::unique_ptr<QPlaceDetailsReply> details(manager->getPlaceDetails(parkViewHotel));
+    QVERIFY(qobject_cast<QPlaceDetailsCacheReply *>(details.get()));
+    QTRY_VERIFY(search->isFinished() && details->isFinished());
+
+    QCOMPARE(search->results().size(), results.size());
+    for (qsizetype i = 0; i < results.size(); ++i) {
+        QCOMPARE(search->results().at(i).title(), results.at(i).title());
+        QCOMPARE(QPlaceResult(search->results().at(i)).place().placeId(),
+                 QPlaceResult(results.at(i)).place().placeId());
+    }
+    QCOMPARE(details->place().name(), place.name());
+    QCOMPARE(details->place().categories(), place.categories());
+    QCOMPARE(details->place().location().coordinate(), place.location().coordinate());
+}
+
+void tst_QPlaceCache::diskInvalidation()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QVariantMap parameters = tst_QPlaceCache::parameters(4);
+    parameters["places.cache.directory"] = directory.path();
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QPlaceManager *manager = provider.placeManager();
+    QVERIFY(manager);
+    QPlaceManagerEngine *engine = manager->findChild<QPlaceManagerEngine *>();
+    QVERIFY(engine);
+
+    std::unique_ptr<QPlaceSearchReply> search(manager->search(searchRequest("hotel")));
+    QTRY_VERIFY(search->isFinished());
+    QCOMPARE(QDir(directory.path()).entryList(QDir::Files).size(), 1);
+
+    // The files of invalidated searches are removed from the event loop
+    emit engine->categoryAdded(QPlaceCategory(), QString());
+    emit engine->categoryRemoved(QString(), QString());
+    QCOMPARE(QDir(directory.path()).entryList(QDir::Files).size(), 1);
+    QTRY_COMPARE(QDir(directory.path()).entryList(QDir::Files).size(), 0);
+
+    std::unique_ptr<QPlaceSearchReply> again(manager->search(searchRequest("hotel")));
+    QVERIFY(!qobject_cast<QPlaceSearchCacheReply *>(again.get()));
+    QTRY_VERIFY(again->isFinished());
+    QCOMPARE(QDir(directory.path()).entryList(QDir::Files).size(), 1);
+    std::unique_ptr<QPlaceSearchReply> cached(manager->search(searchRequest("hotel")));
+    QVERIFY(qobject_cast<QPlaceSearchCacheReply *>(cached.get()));
+
+    // Only the files written before an invalidation are removed by its sweep,
+    // not the ones written while it waits for the event loop
+    const QStringList stale = QDir(directory.path()).entryList(QDir::Files);
+    QMetaObject::invokeMethod(engine, [engine]() {
+        emit engine->categoryUpdated(QPlaceCategory(), QString());
+    }, Qt::QueuedConnection);
+    std::unique_ptr<QPlaceSearchReply> park(manager->search(searchRequest("park")));
+    QTRY_VERIFY(park->isFinished());
+    QTRY_VERIFY(!QDir(directory.path()).entryList(QDir::Files).contains(stale.first()));
+    QCOMPARE(QDir(directory.path()).entryList(QDir::Files).size(), 1);
+}
+
+void tst_QPlaceCache::diskSize()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QVariantMap parameters = tst_QPlaceCache::parameters(4);
+    parameters["places.cache.directory"] = directory.path();
+    parameters["places.cache.disk.size"] = 1;
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters, true);
+    QPlaceManager *manager = provider.placeManager();
+    QVERIFY(manager);
+
+    std::unique_ptr<QPlaceSearchReply> search(manager->search(searchRequest("hotel")));
+    std::unique_ptr<QPlaceDetailsReply> details(manager->getPlaceDetails(parkViewHotel));
+    QTRY_VERIFY(search->isFinished() && details->isFinished());
+
+    // Files above the limit are removed, the entries stay in memory
+    QTRY_COMPARE(QDir(directory.path()).entryList(QDir::Files).size(), 0);
+    std::unique_ptr<QPlaceSearchReply> cached(manager->search(searchRequest("hotel")));
+    QVERIFY(qobject_cast<QPlaceSearchCacheReply *>(cached.get()));
+}
+
+void tst_QPlaceCache::unwritableContext()
+{
+    QGeoServiceProvider provider("qmlgeo.test.plugin", parameters(4), true);
+    QVERIFY(provider.placeManager());
+    QPlaceManagerEngine *engine = provider.placeManager()->findChild<QPlaceManagerEngine *>();
+    QVERIFY(engine);
+    QPlaceCache *cache = engine->findChild<QPlaceCache *>();
+    QVERIFY(cache);
+
+    // Contexts without stream operators are neither keyed nor stored
+    QPlaceSearchRequest request = searchRequest("hotel");
+    QVERIFY(!cache->searchKey(request).isEmpty());
+    request.setSearchContext(QVariant::fromValue(static_cast<QObject *>(this)));
+    QVERIFY(cache->searchKey(request).isEmpty());
+    request.setSearchContext(QVariantMap{ { "page", QVariant::fromValue(static_cast<QObject *>(this)) } });
+    QVERIFY(cache->searchKey(request).isEmpty());
+    request.setSearchContext(QVariantMap{ { "page", 2 } });
+    QVERIFY(!cache->searchKey(request).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(tst_QPlaceCache)
+
+#include "tst_qplacecache.moc"
@@ -0,0 +1,201 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/location/maps
+
+//TESTED_COMPONENT=src/location/places
+
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtCore/QTemporaryDir>
+#include <QtLocation/QPlaceManagerEngine>
+#include <QtLocation/private/qplacecategorycache_p.h>
+
+QT_USE_NAMESPACE
+
+class LocaleEngine : public QPlaceManagerEngine
+{
+public:
+    LocaleEngine() : QPlaceManagerEngine(QVariantMap()) {}
+
+    QList<QLocale> locales() const override { return m_locales; }
+    void setLocales(const QList<QLocale> &locales) override { m_locales = locales; }
+
+private:
+    QList<QLocale> m_locales;
+};
+
+class tst_QPlaceCategoryCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void tree();
+    void update();
+    void diskCache();
+
+private:
+    static QPlaceCategory category(const QString &id, const QString &name);
+};
+
+QPlaceCategory tst_QPlaceCategoryCache::category(const QString &id, const QString &name)
+{
+    QPlaceCategory category;
+    category.setCategoryId(id);
+    category.setName(name);
+    return category;
+}
+
+void tst_QPlaceCategoryCache::tree()
+{
+    QPlaceCategoryTree tree;
+    QVERIFY(tree.isEmpty());
+
+    tree.insert(category("amenity", "Amenity"));
+    tree.insert(category("amenity=cafe", "Cafe"), "amenity");
+    tree.insert(category("amenity=bar", "Bar"), "amenity");
+    tree.insert(category("shop=bakery", "Bakery"), "shop"); // unknown parent
+    tree.insert(category("amenity", "Other")); // already there
+
+    QVERIFY(!tree.isEmpty());
+    QVERIFY(tree.contains("amenity=bar"));
+    QVERIFY(!tree.contains("shop=bakery"));
+    QCOMPARE(tree.childIds(QString()), QStringList({ "amenity" }));
+    QCOMPARE(tree.childIds("amenity"), QStringList({ "amenity=cafe", "amenity=bar" }));
+    QCOMPARE(tree.parentId("amenity=cafe"), QString("amenity"));
+    QCOMPARE(tree.category("amenity").name(), QString("Amenity"));
+    QCOMPARE(tree.childCategories("amenity").value(1).name(), QString("Bar"));
+
+    tree.clear();
+    QVERIFY(tree.isEmpty());
+}
+
+void tst_QPlaceCategoryCache::update()
+{
+    QPlaceManagerEngine engine{QVariantMap()};
+    QSignalSpy addedSpy(&engine, &QPlaceManagerEngine::categoryAdded);
+    QSignalSpy updatedSpy(&engine, &QPlaceManagerEngine::categoryUpdated);
+    QSignalSpy removedSpy(&engine, &QPlaceManagerEngine::categoryRemoved);
+
+    QPlaceCategoryTree tree;
+    tree.insert(category("amenity", "Amenity"));
+    tree.insert(category("amenity=cafe", "Cafe"), "amenity");
+    tree.insert(category("amenity=bar", "Bar"), "amenity");
+    tree.insert(category("shop", "Shop"));
+
+    QPlaceCategoryTree fetched;
+    fetched.insert(category("amenity", "Amenity"));
+    fetched.insert(category("amenity=cafe", "Coffee shop"), "amenity");
+    fetched.insert(category("tourism", "Tourism"));
+    fetched.insert(category("amenity=bar", "Bar"), "tourism");
+    fetched.insert(category("tourism=hotel", "Hotel"), "tourism");
+
+    tree.update(fetched, &engine);
+    QCOMPARE(tree.childIds(QString()), QStringList({ "amenity", "tourism" }));
+    QCOMPARE(tree.childIds("tourism"), QStringList({ "amenity=bar", "tourism=hotel" }));
+
+    // Parents are added before their children
+    QCOMPARE(addedSpy.count(), 2);
+    QCOMPARE(addedSpy.at(0).at(0).value<QPlaceCategory>().categoryId(), QString("tourism"));
+    QCOMPARE(addedSpy.at(1).at(0).value<QPlaceCategory>().categoryId(), QString("tourism=hotel"));
+    QCOMPARE(addedSpy.at(1).at(1).toString(), QString("tourism"));
+
+    // Renamed and moved categories are updated
+    QCOMPARE(updatedSpy.count(), 2);
+    QCOMPARE(updatedSpy.at(0).at(0).value<QPlaceCategory>().name(), QString("Coffee shop"));
+    QCOMPARE(updatedSpy.at(1).at(0).value<QPlaceCategory>().categoryId(), QString("amenity=bar"));
+    QCOMPARE(updatedSpy.at(1).at(1).toString(), QString("tourism"));
+
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(0).toString(), QString("shop"));
+
+    // Nothing is reported when nothing changed
+    tree.update(fetched, &engine);
+    QCOMPARE(addedSpy.count(), 2);
+    QCOMPARE(updatedSpy.count(), 2);
+    QCOMPARE(removedSpy.count(), 1);
+}
+
+void tst_QPlaceCategoryCache::diskCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QVariantMap parameters;
+    parameters["places.cache.directory"] = dir.path();
+    parameters["places.host"] = "http://example.com";
+
+    LocaleEngine engine;
+    QPlaceCategoryTree tree;
+    tree.insert(category("amenity", "Amenity"));
+    tree.insert(category("amenity=cafe", "Cafe"), "amenity");
+    tree.insert(category("amenity=bar", "Bar"), "amenity");
+
+    QPlaceCategoryTree loaded;
+    QVERIFY(!QPlaceCategoryCache(QVariantMap()).isEnabled());
+    QVERIFY(!QPlaceCategoryCache(QVariantMap()).save(&engine, tree));
+
+    QPlaceCategoryCache cache(parameters);
+    QVERIFY(cache.isEnabled());
+    QVERIFY(!cache.load(&engine, &loaded));
+    QVERIFY(cache.save(&engine, tree));
+    QVERIFY(QFile::exists(cache.fileName(&engine)));
+
+    // Another cache with the same parameters reads the same tree, in order
+    QVERIFY(QPlaceCategoryCache(parameters).load(&engine, &loaded));
+    QCOMPARE(loaded.childIds(QString()), tree.childIds(QString()));
+    QCOMPARE(loaded.childIds("amenity"), tree.childIds("amenity"));
+    QCOMPARE(loaded.category("amenity=bar"), tree.category("amenity=bar"));
+
+    // Cache tuning does not change the key, other parameters and locales do
+    QVariantMap tuned = parameters;
+    tuned["places.cache.size"] = 10;
+    QCOMPARE(QPlaceCategoryCache(tuned).fileName(&engine), cache.fileName(&engine));
+
+    QVariantMap other = parameters;
+    other["places.host"] = "http://example.org";
+    QVERIFY(QPlaceCategoryCache(other).fileName(&engine) != cache.fileName(&engine));
+
+    const QString fileName = cache.fileName(&engine);
+    engine.setLocales({ QLocale(QLocale::French) });
+    QVERIFY(cache.fileName(&engine) != fileName);
+    QVERIFY(!cache.load(&engine, &loaded));
+
+    // Files that are not category trees are ignored
+    engine.setLocales({});
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("garbage");
+    file.close();
+    QVERIFY(!cache.load(&engine, &loaded));
+}
+
+QTEST_GUILESS_MAIN(tst_QPlaceCategoryCache)
+
+#include "tst_qplacecategorycache.moc"